@@ -0,0 +1,182 @@
+#include "agc.h"
+#include "dsp_kernels.h"
+#include <string.h>
+
+#define GAIN_FRAC_SHIFT    8        // Q20 = Q12 << 8: шаг рампы внутри блока не обнуляется
+#define AGC_GATE_RMS       104      // Тише (~-50 дБ) уровень не измеряется
+#define AGC_SMOOTH_DOWN    4        // Уменьшение АРУ x громкость: до 1/16 за блок (~30 дБ за 55 мс)
+#define AGC_RISE           6        // Любой рост: до 1/64 за блок (~30 дБ за 220 мс)
+
+// Громкость HFP 0..15 с шагом 2 дБ в Q12
+static const int16_t s_volume_gain[16] = {
+    130, 163, 205, 258, 325, 410, 516, 649,
+    817, 1029, 1295, 1631, 2053, 2584, 3254, 4096,
+};
+
+static inline int16_t clamp16(int32_t v)
+{
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+void agc_init(agc_t *agc, uint32_t sample_rate)
+{
+    memset(agc, 0, sizeof(*agc));
+    uint32_t block = sample_rate / 1000;
+    agc->block = (uint16_t)(block < 1 ? 1 : (block > AGC_BLOCK_MAX ? AGC_BLOCK_MAX : block));
+    agc->agc_gain = AGC_GAIN_UNITY;
+    agc->volume = AGC_GAIN_UNITY;
+    agc->gain = AGC_GAIN_UNITY << GAIN_FRAC_SHIFT;
+    agc->smooth = agc->gain;
+    agc->gain_end = agc->gain;
+    agc->agc_enabled = true;
+    agc->attack_samples = sample_rate * AGC_ATTACK_MS / 1000;
+    agc->release_samples = sample_rate * AGC_RELEASE_MS / 1000;
+}
+
+void agc_set_enabled(agc_t *agc, bool enabled)
+{
+    agc->agc_enabled = enabled;
+    if (!enabled) {
+        agc->agc_gain = AGC_GAIN_UNITY;
+    }
+}
+
+void agc_set_volume(agc_t *agc, int32_t gain)
+{
+    agc->volume = gain < 0 ? 0 : (gain > AGC_GAIN_UNITY ? AGC_GAIN_UNITY : gain);
+}
+
+int32_t agc_volume_gain(int volume)
+{
+    if (volume < 0) {
+        return AGC_GAIN_UNITY;
+    }
+    return s_volume_gain[volume > 15 ? 15 : volume];
+}
+
+// Уровень речи кадра -> усиление АРУ: быстрое снижение, медленный подъем
+static void agc_update_level(agc_t *agc, const int16_t *in, uint32_t n)
+{
+    uint32_t rms = dsp_rms_q15(in, n);
+    if (rms < AGC_GATE_RMS) {
+        return;
+    }
+    int32_t desired = (int32_t)((AGC_TARGET_RMS << AGC_GAIN_SHIFT) / rms);
+    desired = desired < AGC_GAIN_MIN ? AGC_GAIN_MIN : (desired > AGC_GAIN_MAX ? AGC_GAIN_MAX : desired);
+
+    // Экспоненциальное сглаживание, коэффициент n / tau в Q15
+    uint32_t tau = desired < agc->agc_gain ? agc->attack_samples : agc->release_samples;
+    int32_t alpha = tau > n ? (int32_t)((n << 15) / tau) : (1 << 15);
+    agc->agc_gain += (int32_t)(((int64_t)(desired - agc->agc_gain) * alpha) >> 15);
+}
+
+// Граница блока: новая цель усиления для следующей рампы
+static void agc_block(agc_t *agc)
+{
+    // Конец рампы точно в заданной точке: ошибка округления шага не копится
+    int32_t prev = agc->gain_end;
+
+    int32_t target = ((agc->agc_gain * agc->volume) >> AGC_GAIN_SHIFT) << GAIN_FRAC_SHIFT;
+    if (target < agc->smooth) {
+        int32_t floor = agc->smooth - (agc->smooth >> AGC_SMOOTH_DOWN);
+        agc->smooth = target > floor ? target : floor;
+    } else {
+        int32_t ceil = agc->smooth + (agc->smooth >> AGC_RISE) + (1 << GAIN_FRAC_SHIFT);
+        agc->smooth = target < ceil ? target : ceil;
+    }
+
+    // Пик блока, который сейчас выйдет, и следующего за ним
+    uint32_t peak = agc->peak_prev > agc->peak_cur ? agc->peak_prev : agc->peak_cur;
+    agc->peak_prev = agc->peak_cur;
+    agc->peak_cur = 0;
+
+    int32_t next = agc->smooth;
+    if (peak > 0) {
+        // Сравнение в Q12: для тихого блока потолок / пик в Q20 не помещается в int32
+        int32_t limit = (int32_t)(((uint32_t)AGC_LIMIT << AGC_GAIN_SHIFT) / peak);
+        if (limit < (next >> GAIN_FRAC_SHIFT)) {
+            next = limit << GAIN_FRAC_SHIFT;
+            agc->limited_blocks++;
+        }
+    }
+    // Восстановление после лимитера не быстрее роста smooth
+    if (next > prev) {
+        int32_t ceil = prev + (prev >> AGC_RISE) + (1 << GAIN_FRAC_SHIFT);
+        next = next < ceil ? next : ceil;
+    }
+
+    agc->gain = prev;
+    agc->gain_end = next;
+    agc->step = (next - prev) / agc->block;
+    agc->blocks++;
+}
+
+void agc_process(agc_t *agc, int16_t *out, const int16_t *in, uint32_t n, bool speech)
+{
+    if (agc->agc_enabled && speech) {
+        agc_update_level(agc, in, n);
+    }
+
+    const uint32_t len = 2u * agc->block;
+    for (uint32_t i = 0; i < n; ) {
+        // Участок до границы блока: усиление линейно, пик копится в локальной переменной
+        uint32_t run = agc->block - agc->phase;
+        run = run < n - i ? run : n - i;
+        int32_t gain = agc->gain;
+        int32_t step = agc->step;
+        uint32_t peak = agc->peak_cur;
+        uint32_t pos = agc->pos;
+        for (uint32_t k = 0; k < run; k++) {
+            int32_t x = in[i + k];
+            int32_t d = agc->delay[pos];
+            agc->delay[pos] = (int16_t)x;
+            pos = pos + 1 == len ? 0 : pos + 1;
+            out[i + k] = clamp16((d * (gain >> GAIN_FRAC_SHIFT)) >> AGC_GAIN_SHIFT);
+            gain += step;
+            uint32_t a = (uint32_t)(x < 0 ? -x : x);
+            peak = a > peak ? a : peak;
+        }
+        agc->gain = gain;
+        agc->peak_cur = (uint16_t)(peak > INT16_MAX ? INT16_MAX : peak);
+        agc->pos = (uint16_t)pos;
+        agc->phase += (uint16_t)run;
+        i += run;
+        if (agc->phase == agc->block) {
+            agc->phase = 0;
+            agc_block(agc);
+        }
+    }
+}
+
+void agc_ramp_init(agc_ramp_t *ramp, int32_t gain)
+{
+    ramp->gain = gain;
+    ramp->target = gain;
+}
+
+void agc_ramp_process(agc_ramp_t *ramp, int16_t *buf, uint32_t n)
+{
+    int32_t from = ramp->gain;
+    int32_t to = ramp->target;
+    if (from == to) {
+        if (from != AGC_GAIN_UNITY) {
+            // Q12 -> Q15; громкость не выше 1.0, поэтому int16 не переполняется
+            dsp_scale_q15(buf, buf, n, (int16_t)(from << 3));
+        }
+        return;
+    }
+    if (n == 0) {
+        return;
+    }
+
+    // Не больше четверти за кадр (7.5 мс): 30 дБ вниз за ~0.2 с
+    int32_t delta = (from >> 2) + 1;
+    to = to < from - delta ? from - delta : (to > from + delta ? from + delta : to);
+    int32_t gain = from << GAIN_FRAC_SHIFT;
+    int32_t step = ((to - from) << GAIN_FRAC_SHIFT) / (int32_t)n;
+    for (uint32_t i = 0; i < n; i++) {
+        gain += step;
+        buf[i] = clamp16((buf[i] * (gain >> GAIN_FRAC_SHIFT)) >> AGC_GAIN_SHIFT);
+    }
+    ramp->gain = to;
+}
@@ -0,0 +1,101 @@
+#ifndef AGC_H
+#define AGC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AGC_GAIN_SHIFT     12
+#define AGC_GAIN_UNITY     (1 << AGC_GAIN_SHIFT)   // Усиление 1.0 в формате Q12
+#define AGC_GAIN_MIN       1029                    // -12 дБ
+#define AGC_GAIN_MAX       (8 << AGC_GAIN_SHIFT)   // +18 дБ
+#define AGC_TARGET_RMS     4125                    // Уровень речи на выходе, -18 дБ от полной шкалы
+#define AGC_LIMIT          29204                   // Потолок лимитера, -1 дБ от полной шкалы
+#define AGC_BLOCK_MAX      32                      // Блок лимитера 1 мс при 32 кГц
+#define AGC_ATTACK_MS      50
+#define AGC_RELEASE_MS     800
+
+/*
+ * АРУ и лимитер с упреждением для тракта микрофона гарнитуры.
+ *
+ * Усиления считаются раз в блок (1 мс), внутри блока усиление меняется
+ * линейно - на отсчет одно умножение и сложение. Вход задерживается на два
+ * блока: к моменту вывода блока известны пики его и следующего блока, и обе
+ * точки рампы не выше потолок / пик, поэтому выход не превышает AGC_LIMIT.
+ * Громкость гарнитуры входит в то же усиление и меняется ограниченной по
+ * скорости рампой, без щелчков.
+ */
+
+typedef struct {
+    uint16_t block;                 // Отсчетов в блоке (1 мс)
+    uint16_t phase;                 // Позиция внутри текущего блока
+    uint16_t pos;                   // Позиция в линии задержки (2 блока)
+    int16_t delay[2 * AGC_BLOCK_MAX];
+    uint16_t peak_prev;             // Пик предыдущего входного блока
+    uint16_t peak_cur;              // Пик текущего входного блока
+
+    int32_t gain;                   // Текущее усиление, Q20
+    int32_t step;                   // Приращение на отсчет, Q20
+    int32_t gain_end;               // Усиление в конце текущей рампы, Q20
+    int32_t smooth;                 // АРУ x громкость после ограничения скорости, Q20
+    int32_t agc_gain;               // Усиление АРУ, Q12
+    volatile int32_t volume;        // Громкость гарнитуры, Q12 (пишет другой поток)
+    bool agc_enabled;
+
+    uint32_t attack_samples;
+    uint32_t release_samples;
+    uint32_t blocks;
+    uint32_t limited_blocks;        // Блоков, где лимитер снизил усиление
+} agc_t;
+
+// Рампа громкости для тракта без АРУ (динамик гарнитуры)
+typedef struct {
+    int32_t gain;                   // Текущее усиление, Q12
+    volatile int32_t target;        // Цель, Q12 (пишет другой поток)
+} agc_ramp_t;
+
+/**
+ * @brief Инициализация: усиление 1.0, АРУ включена
+ * @param sample_rate Частота потока (8..32 кГц)
+ */
+void agc_init(agc_t *agc, uint32_t sample_rate);
+
+/**
+ * @brief Включение АРУ; лимитер и громкость работают всегда
+ */
+void agc_set_enabled(agc_t *agc, bool enabled);
+
+/**
+ * @brief Громкость гарнитуры; можно вызывать из другого потока
+ * @param gain Q12, обычно agc_volume_gain()
+ */
+void agc_set_volume(agc_t *agc, int32_t gain);
+
+/**
+ * @brief Обработка кадра с задержкой на два блока
+ * @param speech Решение VAD: в паузах АРУ замирает, чтобы не поднимать шум
+ */
+void agc_process(agc_t *agc, int16_t *out, const int16_t *in, uint32_t n, bool speech);
+
+/**
+ * @brief Усиление для громкости HFP (AT+VGS/AT+VGM)
+ * @param volume 0..15 с шагом 2 дБ, 15 - 0 дБ; отрицательное (неизвестно) - 1.0
+ * @return Усиление Q12
+ */
+int32_t agc_volume_gain(int volume);
+
+void agc_ramp_init(agc_ramp_t *ramp, int32_t gain);
+
+/**
+ * @brief Применение рампы к кадру на месте; за кадр усиление меняется не больше чем на четверть
+ */
+void agc_ramp_process(agc_ramp_t *ramp, int16_t *buf, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGC_H */
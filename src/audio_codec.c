@@ -0,0 +1,81 @@
+#include "audio_codec.h"
+#include "paired_devices.h"
+
+/*
+ * Bluedroid HFP AG (ESP-IDF 5.x) согласует только CVSD и mSBC и сообщает о
+ * них через ESP_HF_AUDIO_STATE_CONNECTED(_MSBC).
+ */
+
+typedef struct {
+    const char *name;
+    uint32_t sample_rate;
+    uint8_t paired;
+} codec_desc_t;
+
+static const codec_desc_t s_codecs[AUDIO_CODEC_COUNT] = {
+    [AUDIO_CODEC_CVSD] = { "CVSD", 8000,  PAIRED_CODEC_CVSD },
+    [AUDIO_CODEC_MSBC] = { "mSBC", 16000, PAIRED_CODEC_MSBC },
+};
+
+static const codec_desc_t *codec_desc(audio_codec_t codec)
+{
+    return &s_codecs[codec < AUDIO_CODEC_COUNT ? codec : AUDIO_CODEC_CVSD];
+}
+
+const char *audio_codec_name(audio_codec_t codec)
+{
+    return codec_desc(codec)->name;
+}
+
+uint32_t audio_codec_sample_rate(audio_codec_t codec)
+{
+    return codec_desc(codec)->sample_rate;
+}
+
+uint32_t audio_codec_frame_samples(audio_codec_t codec)
+{
+    return codec_desc(codec)->sample_rate * 75 / 10000;
+}
+
+bool audio_codec_supported(audio_codec_t codec)
+{
+    switch (codec) {
+    case AUDIO_CODEC_CVSD:
+    case AUDIO_CODEC_MSBC:
+        return true;
+    default:
+        return false;
+    }
+}
+
+audio_codec_t audio_codec_from_audio_state(esp_hf_audio_state_t state)
+{
+    return state == ESP_HF_AUDIO_STATE_CONNECTED_MSBC ? AUDIO_CODEC_MSBC : AUDIO_CODEC_CVSD;
+}
+
+uint8_t audio_codec_to_paired(audio_codec_t codec)
+{
+    return codec_desc(codec)->paired;
+}
+
+audio_codec_t audio_codec_from_paired(uint8_t paired_codec)
+{
+    for (int i = 0; i < AUDIO_CODEC_COUNT; i++) {
+        if (s_codecs[i].paired == paired_codec) {
+            return (audio_codec_t)i;
+        }
+    }
+    return AUDIO_CODEC_CVSD;
+}
+
+audio_codec_t audio_codec_select(uint32_t peer_feat, uint8_t cached_codec)
+{
+    if (cached_codec != 0) {
+        audio_codec_t cached = audio_codec_from_paired(cached_codec);
+        if (audio_codec_supported(cached)) {
+            return cached;
+        }
+    }
+    // mSBC требует согласования кодеков (AT+BAC)
+    return (peer_feat & ESP_HF_PEER_FEAT_CODEC) != 0 ? AUDIO_CODEC_MSBC : AUDIO_CODEC_CVSD;
+}
@@ -0,0 +1,59 @@
+#ifndef AUDIO_CODEC_H
+#define AUDIO_CODEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_hf_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Кодеки речи HFP: все работают кадрами по 7.5 мс, отличается частота тракта
+typedef enum {
+    AUDIO_CODEC_CVSD = 0,           // 8 кГц, узкая полоса
+    AUDIO_CODEC_MSBC,               // 16 кГц, HFP 1.6+
+    AUDIO_CODEC_COUNT,
+} audio_codec_t;
+
+const char *audio_codec_name(audio_codec_t codec);
+
+/**
+ * @brief Частота дискретизации PCM тракта для кодека
+ */
+uint32_t audio_codec_sample_rate(audio_codec_t codec);
+
+/**
+ * @brief Отсчетов в кадре SCO (7.5 мс): 60 или 120
+ */
+uint32_t audio_codec_frame_samples(audio_codec_t codec);
+
+/**
+ * @brief Может ли кодек быть выбран: его должен согласовывать стек
+ */
+bool audio_codec_supported(audio_codec_t codec);
+
+/**
+ * @brief Кодек открытого SCO по состоянию из события ESP_HF_AUDIO_STATE_EVT
+ */
+audio_codec_t audio_codec_from_audio_state(esp_hf_audio_state_t state);
+
+/**
+ * @brief Преобразование в бит PAIRED_CODEC_* кэша гарнитуры и обратно
+ */
+uint8_t audio_codec_to_paired(audio_codec_t codec);
+audio_codec_t audio_codec_from_paired(uint8_t paired_codec);
+
+/**
+ * @brief Выбор ожидаемого кодека при подключении SLC
+ * @param peer_feat Биты возможностей HF (AT+BRSF)
+ * @param cached_codec Бит PAIRED_CODEC_* последнего удачного SCO (0 - нет кэша)
+ * @return Кодек из кэша, если он поддерживается, иначе лучший из доступных гарнитуре
+ */
+audio_codec_t audio_codec_select(uint32_t peer_feat, uint8_t cached_codec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_CODEC_H */
@@ -0,0 +1,177 @@
+#include "audio_frame.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "AUDIO_FRAME";
+
+_Static_assert(AUDIO_FRAME_POOL_SIZE <= 32, "free mask is 32 bits");
+_Static_assert(AUDIO_FRAME_MAX_CONSUMERS <= 32, "consumer mask is 32 bits");
+
+#define POOL_ALL_FREE  ((uint32_t)(((uint64_t)1 << AUDIO_FRAME_POOL_SIZE) - 1))
+#define QUIESCE_SPINS  64     // Столько уступок ядра, дальше ожидание тиками
+
+typedef struct {
+    audio_frame_consumer_cb_t cb;  // NULL - слот свободен; публикуется release-записью
+    void *ctx;
+    uint8_t stream;
+    uint32_t busy;                 // Производителей внутри слота: отписка ждет нуля
+} consumer_t;
+
+static audio_frame_t s_frames[AUDIO_FRAME_POOL_SIZE];
+static uint32_t s_free_mask = POOL_ALL_FREE;
+static uint32_t s_consumer_mask = 0;          // Занятые слоты потребителей
+static consumer_t s_consumers[AUDIO_FRAME_MAX_CONSUMERS];
+static uint32_t s_seq[AUDIO_FRAME_STREAM_COUNT];
+
+static uint32_t s_in_use = 0;
+static uint32_t s_peak = 0;
+static uint32_t s_exhausted = 0;
+
+void audio_frame_init(void)
+{
+    memset(s_frames, 0, sizeof(s_frames));
+    memset(s_seq, 0, sizeof(s_seq));
+    __atomic_store_n(&s_in_use, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_peak, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_exhausted, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_free_mask, POOL_ALL_FREE, __ATOMIC_RELEASE);
+    ESP_LOGI(TAG, "Frame pool: %d frames x %u bytes", AUDIO_FRAME_POOL_SIZE, (unsigned)sizeof(audio_frame_t));
+}
+
+audio_frame_t *audio_frame_alloc(audio_frame_stream_t stream)
+{
+    uint32_t mask = __atomic_load_n(&s_free_mask, __ATOMIC_ACQUIRE);
+    int idx;
+    do {
+        if (mask == 0) {
+            __atomic_fetch_add(&s_exhausted, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        idx = __builtin_ctz(mask);
+    } while (!__atomic_compare_exchange_n(&s_free_mask, &mask, mask & ~(1u << idx), true,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    uint32_t used = __atomic_add_fetch(&s_in_use, 1, __ATOMIC_RELAXED);
+    uint32_t peak = __atomic_load_n(&s_peak, __ATOMIC_RELAXED);
+    while (used > peak && !__atomic_compare_exchange_n(&s_peak, &peak, used, true,
+                                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+
+    audio_frame_t *frame = &s_frames[idx];
+    frame->refs = 1;
+    frame->stream = (uint8_t)stream;
+    frame->speech = true;
+    frame->count = 0;
+    frame->sample_rate = 0;
+    frame->seq = 0;
+    frame->timestamp_us = esp_timer_get_time();
+    return frame;
+}
+
+void audio_frame_ref(audio_frame_t *frame)
+{
+    __atomic_fetch_add(&frame->refs, 1, __ATOMIC_RELAXED);
+}
+
+void audio_frame_unref(audio_frame_t *frame)
+{
+    if (frame == NULL) {
+        return;
+    }
+    // acq_rel: записи последнего владельца видны тому, кто возьмет кадр из пула
+    if (__atomic_sub_fetch(&frame->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+    int idx = (int)(frame - s_frames);
+    __atomic_fetch_sub(&s_in_use, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&s_free_mask, 1u << idx, __ATOMIC_RELEASE);
+}
+
+esp_err_t audio_frame_subscribe(audio_frame_stream_t stream, audio_frame_consumer_cb_t cb, void *ctx, int *out_id)
+{
+    if (stream >= AUDIO_FRAME_STREAM_COUNT || cb == NULL || out_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t mask = __atomic_load_n(&s_consumer_mask, __ATOMIC_ACQUIRE);
+    int idx;
+    do {
+        uint32_t free_slots = ~mask & (uint32_t)((1u << AUDIO_FRAME_MAX_CONSUMERS) - 1);
+        if (free_slots == 0) {
+            return ESP_ERR_NO_MEM;
+        }
+        idx = __builtin_ctz(free_slots);
+    } while (!__atomic_compare_exchange_n(&s_consumer_mask, &mask, mask | (1u << idx), true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    consumer_t *c = &s_consumers[idx];
+    c->ctx = ctx;
+    c->stream = (uint8_t)stream;
+    __atomic_store_n(&c->cb, cb, __ATOMIC_RELEASE);
+    *out_id = idx;
+    return ESP_OK;
+}
+
+void audio_frame_unsubscribe(int id)
+{
+    if (id < 0 || id >= AUDIO_FRAME_MAX_CONSUMERS) {
+        return;
+    }
+    consumer_t *c = &s_consumers[id];
+    // Пара с audio_frame_publish (SEQ_CST с обеих сторон): либо производитель
+    // увидит NULL, либо отписка увидит его в busy и дождется выхода из callback
+    __atomic_store_n(&c->cb, NULL, __ATOMIC_SEQ_CST);
+    for (int spins = 0; __atomic_load_n(&c->busy, __ATOMIC_SEQ_CST) != 0; spins++) {
+        if (spins < QUIESCE_SPINS) {
+            taskYIELD();
+        } else {
+            vTaskDelay(1);
+        }
+    }
+    // Слот свободен только после выхода производителей: новый потребитель не получит чужой кадр
+    __atomic_fetch_and(&s_consumer_mask, ~(1u << id), __ATOMIC_RELEASE);
+}
+
+bool audio_frame_has_consumers(audio_frame_stream_t stream)
+{
+    for (int i = 0; i < AUDIO_FRAME_MAX_CONSUMERS; i++) {
+        if (__atomic_load_n(&s_consumers[i].cb, __ATOMIC_ACQUIRE) != NULL && s_consumers[i].stream == stream) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void audio_frame_publish(audio_frame_t *frame)
+{
+    // Номер кадра ставит единственный производитель потока
+    frame->seq = s_seq[frame->stream]++;
+    uint32_t mask = __atomic_load_n(&s_consumer_mask, __ATOMIC_ACQUIRE);
+    while (mask != 0) {
+        consumer_t *c = &s_consumers[__builtin_ctz(mask)];
+        mask &= mask - 1;
+        __atomic_add_fetch(&c->busy, 1, __ATOMIC_SEQ_CST);
+        audio_frame_consumer_cb_t cb = __atomic_load_n(&c->cb, __ATOMIC_SEQ_CST);
+        if (cb != NULL && c->stream == frame->stream) {
+            cb(frame, c->ctx);
+        }
+        __atomic_sub_fetch(&c->busy, 1, __ATOMIC_RELEASE);
+    }
+    audio_frame_unref(frame);
+}
+
+void audio_frame_usage(uint32_t *in_use, uint32_t *peak, uint32_t *exhausted)
+{
+    if (in_use != NULL) {
+        *in_use = __atomic_load_n(&s_in_use, __ATOMIC_RELAXED);
+    }
+    if (peak != NULL) {
+        *peak = __atomic_load_n(&s_peak, __ATOMIC_RELAXED);
+    }
+    if (exhausted != NULL) {
+        *exhausted = __atomic_load_n(&s_exhausted, __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef AUDIO_FRAME_H
+#define AUDIO_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "audio_worker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_FRAME_POOL_SIZE      16     // Кадров в пуле (не больше 32 - битовая маска свободных)
+#define AUDIO_FRAME_MAX_CONSUMERS  4
+
+/*
+ * Пул кадров со счетчиком ссылок: производитель заполняет кадр один раз,
+ * потребители (запись, измерения, отвод в UART, DSP) держат ссылки вместо
+ * копий, кадр возвращается в пул с последней ссылкой. Выделение - CAS по
+ * маске свободных кадров, ссылки - атомарные счетчики: без блокировок и
+ * без кучи, память не зависит от числа потребителей.
+ */
+
+typedef enum {
+    AUDIO_FRAME_RX = 0,            // Микрофон гарнитуры после АРУ
+    AUDIO_FRAME_TX,                // Исходящий поток в динамик гарнитуры
+    AUDIO_FRAME_RX_RAW,            // Микрофон до DTMF/VAD/АРУ; публикуется только при наличии потребителей
+    AUDIO_FRAME_STREAM_COUNT,
+} audio_frame_stream_t;
+
+typedef struct {
+    uint32_t refs;                 // Меняется только атомарно
+    uint8_t stream;                // audio_frame_stream_t
+    bool speech;                   // Решение VAD (для RX)
+    uint16_t count;
+    uint32_t sample_rate;
+    uint32_t seq;                  // Номер кадра в потоке
+    int64_t timestamp_us;
+    int16_t samples[AUDIO_WORKER_FRAME_MAX];
+} audio_frame_t;
+
+/**
+ * @brief Потребитель кадров: вызывается в потоке производителя
+ *
+ * Кадр только для чтения. Чтобы обработать его позже (в своей задаче),
+ * потребитель берет audio_frame_ref() и отпускает audio_frame_unref().
+ * Callback не должен блокироваться.
+ */
+typedef void (*audio_frame_consumer_cb_t)(audio_frame_t *frame, void *ctx);
+
+/**
+ * @brief Инициализация пула (все кадры свободны)
+ */
+void audio_frame_init(void);
+
+/**
+ * @brief Кадр из пула с одной ссылкой (у вызывающего)
+ * @return NULL если пул исчерпан
+ */
+audio_frame_t *audio_frame_alloc(audio_frame_stream_t stream);
+
+void audio_frame_ref(audio_frame_t *frame);
+
+/**
+ * @brief Отпустить ссылку; последняя возвращает кадр в пул (из любого потока)
+ */
+void audio_frame_unref(audio_frame_t *frame);
+
+/**
+ * @brief Регистрация потребителя потока
+ * @param ctx Должен оставаться валидным до возврата из audio_frame_unsubscribe()
+ * @return ESP_OK, ESP_ERR_NO_MEM если слотов нет
+ */
+esp_err_t audio_frame_subscribe(audio_frame_stream_t stream, audio_frame_consumer_cb_t cb, void *ctx, int *out_id);
+
+/**
+ * @brief Отписка потребителя
+ *
+ * Ждет, пока производители, уже взявшие callback, выйдут из него: после
+ * возврата callback больше не вызывается и ctx можно освободить. Не
+ * вызывается из callback потребителя и из потоков-производителей кадров.
+ */
+void audio_frame_unsubscribe(int id);
+
+/**
+ * @brief Есть ли потребители потока (иначе производителю незачем занимать кадр)
+ */
+bool audio_frame_has_consumers(audio_frame_stream_t stream);
+
+/**
+ * @brief Раздать кадр потребителям потока и отпустить ссылку производителя
+ */
+void audio_frame_publish(audio_frame_t *frame);
+
+/**
+ * @brief Занято кадров сейчас и максимум с момента инициализации
+ */
+void audio_frame_usage(uint32_t *in_use, uint32_t *peak, uint32_t *exhausted);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRAME_H */
@@ -1,5 +1,19 @@
 #include "audio_handler.h"
+#include "audio_mixer.h"
+#include "call_recorder.h"
+#include "prompts.h"
+#include "hf_conn.h"
+#include "conn_state.h"
+#include "metrics.h"
+#include "trace.h"
+#include "audio_worker.h"
+#include "bt_app_core.h"
+#include "dsp_kernels.h"
+#include "agc.h"
+#include "audio_frame.h"
+#include "call_qoe.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_hf_ag_api.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -9,100 +23,693 @@
 
 static const char *TAG = "AUDIO_HANDLER";
 
-static uint16_t s_sync_conn_handle = 0;
-static bool s_audio_connected = false;
-static bool s_msbc_mode = false;
+// Жизненный цикл аудио сессии - флаги общего слова conn_state:
+// AUDIO_ARMED - тракт настроен под SLC, AUDIO_ACTIVE - SCO открыт
+static inline bool audio_session_active(void)
+{
+    return (CONN_WORD_FLAGS(conn_state_load()) & CONN_FLAG_AUDIO_ACTIVE) != 0;
+}
+
+static audio_codec_t s_codec = AUDIO_CODEC_CVSD;
+static bool s_rate_configured = false;
+static uint16_t s_active_handle = 0xFFFF;
+static esp_timer_handle_t s_pump_timer = NULL;
+static int64_t s_session_start_us = 0;
+static volatile int64_t s_first_frame_us = 0;   // Задержка первого кадра после открытия SCO
+
+#define AUDIO_PUMP_PERIOD_US  7500   // Один кадр SCO (7.5 мс)
+#define AUDIO_LATE_US         (AUDIO_PUMP_PERIOD_US * 3 / 2)   // Кадр позже этого - стек отправил без наших данных
+#define AUDIO_QOE_JOB_TIMEOUT_MS  100   // Задача обработки берет задание не позже следующего кадра
+
+static struct {
+    metric_t *rx_frames;
+    metric_t *tx_frames;
+    metric_t *underruns;
+    metric_t *tx_interval;
+    metric_t *tx_cb;
+    metric_t *vad_speech;
+    metric_t *vad_pause;
+    metric_t *dtmf_digits;
+    metric_t *fax_tones;
+    metric_t *dtmf_dropped;
+    metric_t *pool_exhausted;
+} s_m;
+static bool s_vad_enabled = true;
+static bool s_agc_enabled = true;
+static agc_ramp_t s_spk_ramp = { AGC_GAIN_UNITY, AGC_GAIN_UNITY };   // Громкость динамика (AT+VGS)
+static int16_t s_rx_spare[AUDIO_WORKER_FRAME_MAX];    // Микрофон после АРУ, если пул кадров исчерпан
+static int64_t s_last_tx_us = 0;
+static int s_rate_request = 0;       // Смена частоты для задачи обработки: кодек + 1, 0 - нет запроса
+static call_qoe_session_t s_qoe;     // Итог звонка для журнала качества; владеет задача обработки
+static bool s_tx_primed = false;     // В сессии уже выдан готовый кадр: дальше тишина - недобор
+
+#define AUDIO_DTMF_HISTORY    32
+#define AUDIO_DTMF_RING       8     // Степень двойки; цифра не чаще раза в 26 мс, задаче bt_app хватает с запасом
+
+// Событие детектора тонов для задачи bt_app
+typedef struct {
+    esp_bd_addr_t bda;
+    dtmf_event_t event;
+} audio_dtmf_msg_t;
+
+/*
+ * Кольцо событий от задачи обработки к задаче bt_app: один писатель, один
+ * читатель, без блокировок и malloc. Писатель двигает head, читатель - tail.
+ * s_dtmf_wake поднят, пока читателю отправлено непрочитанное пробуждение.
+ */
+static audio_dtmf_msg_t s_dtmf_ring[AUDIO_DTMF_RING];
+static uint32_t s_dtmf_head = 0;
+static uint32_t s_dtmf_tail = 0;
+static bool s_dtmf_wake = false;
+
+// Принятые цифры текущей сессии; пишет и читает только задача bt_app
+static char s_dtmf_history[AUDIO_DTMF_HISTORY + 1];
+static uint32_t s_dtmf_len = 0;
+
+#define AUDIO_TEST_TONE_HZ    440
+#define AUDIO_TEST_TONE_GAIN  ((AGC_TARGET_RMS * 46341) >> 15)   // Q15: тот же RMS, что у речи после АРУ (x sqrt 2)
+#define SINE_LUT_BITS         8
+#define SINE_LUT_SIZE         (1 << SINE_LUT_BITS)
+
+// Тестовый тон как обычный источник микшера
+typedef struct {
+    uint32_t phase;
+    uint32_t phase_inc;
+} tone_source_t;
+
+static int16_t s_sine_lut[SINE_LUT_SIZE + 1];
+static tone_source_t s_test_tone;
+static int s_test_tone_id = -1;
+
+static uint32_t audio_sample_rate(void)
+{
+    return audio_codec_sample_rate(s_codec);
+}
+
+static void tone_set_frequency(tone_source_t *tone, uint32_t freq_hz, uint32_t sample_rate)
+{
+    tone->phase_inc = (uint32_t)(((uint64_t)freq_hz << 32) / sample_rate);
+}
+
+// Синус по таблице с линейной интерполяцией, фаза - 32-битный аккумулятор
+static uint32_t tone_source_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    tone_source_t *tone = (tone_source_t *)ctx;
+    uint32_t phase = tone->phase;
+
+    for (uint32_t i = 0; i < samples; i++) {
+        uint32_t idx = phase >> (32 - SINE_LUT_BITS);
+        int32_t frac = (phase >> (32 - SINE_LUT_BITS - 15)) & 0x7FFF;
+        int32_t a = s_sine_lut[idx];
+        int32_t b = s_sine_lut[idx + 1];
+        buf[i] = (int16_t)(a + (((b - a) * frac) >> 15));
+        phase += tone->phase_inc;
+    }
+
+    tone->phase = phase;
+    return samples;
+}
+
+static void audio_configure_sources(audio_codec_t codec)
+{
+    uint32_t rate = audio_codec_sample_rate(codec);
+    audio_mixer_set_sample_rate(rate);
+    tone_set_frequency(&s_test_tone, AUDIO_TEST_TONE_HZ, rate);
+    prompts_set_output_rate(rate);
+}
+
+// Обработчик в задаче bt_app: журнал и история цифр (сюда же ляжет IVR логика)
+static void audio_dtmf_handle(const audio_dtmf_msg_t *msg)
+{
+    if (msg->event.type == DTMF_EVENT_DIGIT) {
+        if (s_dtmf_len < AUDIO_DTMF_HISTORY) {
+            s_dtmf_history[s_dtmf_len++] = msg->event.digit;
+            s_dtmf_history[s_dtmf_len] = '\0';
+        }
+        ESP_LOGI(TAG, "☎️ DTMF '%c' (%d dBFS) from " ESP_BD_ADDR_STR,
+                 msg->event.digit, msg->event.level_db, ESP_BD_ADDR_HEX(msg->bda));
+    } else {
+        ESP_LOGI(TAG, "📠 %s tone (%d dBFS) from " ESP_BD_ADDR_STR,
+                 dtmf_event_name(msg->event.type), msg->event.level_db, ESP_BD_ADDR_HEX(msg->bda));
+    }
+}
+
+// Разбор кольца в задаче bt_app. Флаг снимается до чтения: событие, записанное
+// после последней проверки head, отправит новое пробуждение
+static void audio_dtmf_drain_hdl(uint16_t event, void *param)
+{
+    __atomic_store_n(&s_dtmf_wake, false, __ATOMIC_SEQ_CST);
+    uint32_t tail = s_dtmf_tail;
+    while (tail != __atomic_load_n(&s_dtmf_head, __ATOMIC_ACQUIRE)) {
+        audio_dtmf_handle(&s_dtmf_ring[tail % AUDIO_DTMF_RING]);
+        tail++;
+        __atomic_store_n(&s_dtmf_tail, tail, __ATOMIC_RELEASE);
+    }
+}
+
+static void audio_dtmf_reset_hdl(uint16_t event, void *param)
+{
+    s_dtmf_len = 0;
+    s_dtmf_history[0] = '\0';
+}
+
+// Вызывается из задачи обработки: не ждет ни очереди bt_app, ни кучи. При
+// полном кольце событие теряется (dtmf.dropped); при полной очереди bt_app
+// события ждут в кольце следующего пробуждения
+static void audio_dtmf_cb(const dtmf_event_t *event, void *ctx)
+{
+    hf_conn_t *conn = (hf_conn_t *)ctx;
+    metrics_inc(event->type == DTMF_EVENT_DIGIT ? s_m.dtmf_digits : s_m.fax_tones);
+
+    uint32_t head = s_dtmf_head;
+    if (head - __atomic_load_n(&s_dtmf_tail, __ATOMIC_ACQUIRE) >= AUDIO_DTMF_RING) {
+        metrics_inc(s_m.dtmf_dropped);
+        return;
+    }
+    audio_dtmf_msg_t *msg = &s_dtmf_ring[head % AUDIO_DTMF_RING];
+    memcpy(msg->bda, conn->bda, sizeof(esp_bd_addr_t));
+    msg->event = *event;
+    __atomic_store_n(&s_dtmf_head, head + 1, __ATOMIC_SEQ_CST);
+
+    if (!__atomic_exchange_n(&s_dtmf_wake, true, __ATOMIC_SEQ_CST) &&
+        !bt_app_work_post(audio_dtmf_drain_hdl, 0)) {
+        __atomic_store_n(&s_dtmf_wake, false, __ATOMIC_SEQ_CST);
+    }
+}
+
+// Копия кадра для потребителей пула; без потребителей кадр не занимается
+static void audio_publish_copy(audio_frame_stream_t stream, const int16_t *samples, uint32_t count)
+{
+    if (!audio_frame_has_consumers(stream)) {
+        return;
+    }
+    audio_frame_t *frame = audio_frame_alloc(stream);
+    if (frame == NULL) {
+        metrics_inc(s_m.pool_exhausted);
+        return;
+    }
+    memcpy(frame->samples, samples, count * sizeof(int16_t));
+    frame->count = (uint16_t)count;
+    frame->sample_rate = audio_sample_rate();
+    audio_frame_publish(frame);
+}
+
+// Обработка принятого кадра (задача обработки или, без нее, HCI callback)
+static void audio_rx_process(const int16_t *samples, uint32_t count)
+{
+    // Legacy HCI callback не передает дескриптор: данные принадлежат SCO,
+    // который сейчас обслуживает data path
+    if (count > AUDIO_WORKER_FRAME_MAX) {
+        audio_rx_process(samples, AUDIO_WORKER_FRAME_MAX);
+        audio_rx_process(samples + AUDIO_WORKER_FRAME_MAX, count - AUDIO_WORKER_FRAME_MAX);
+        return;
+    }
+    audio_publish_copy(AUDIO_FRAME_RX_RAW, samples, count);
+    // Эхо оценивается по захвату до АРУ: усиление исказило бы затухание пути
+    call_qoe_on_rx(&s_qoe, samples, count);
+
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    bool speech = true;
+    if (conn != NULL) {
+        hf_conn_rx_sync(conn);
+    }
+    // Тоны детектируются до VAD: пауза для VAD может быть тоном для детектора
+    if (conn != NULL && conn->dtmf_enabled) {
+        dtmf_process(&conn->dtmf, samples, count, audio_dtmf_cb, conn);
+    }
+    if (conn != NULL && s_vad_enabled) {
+        speech = vad_process(&conn->vad, samples, count);
+    }
+    metrics_inc(speech ? s_m.vad_speech : s_m.vad_pause);
+
+    // Кадр заполняется один раз; запись, отвод и прочие потребители держат ссылки на него
+    audio_frame_t *frame = audio_frame_alloc(AUDIO_FRAME_RX);
+    int16_t *out = s_rx_spare;
+    if (frame != NULL) {
+        frame->count = (uint16_t)count;
+        frame->speech = speech;
+        frame->sample_rate = audio_sample_rate();
+        out = frame->samples;
+    } else {
+        metrics_inc(s_m.pool_exhausted);
+    }
+
+    // АРУ и лимитер идут и в паузах: линия задержки лимитера остается непрерывной
+    if (conn != NULL) {
+        if (conn->agc.agc_enabled != s_agc_enabled) {
+            agc_set_enabled(&conn->agc, s_agc_enabled);
+        }
+        agc_process(&conn->agc, out, samples, count, speech);
+    } else {
+        memcpy(out, samples, count * sizeof(int16_t));
+    }
+
+    // Паузу запись кодирует нулями из кэша кодера
+    if (frame != NULL) {
+        audio_frame_publish(frame);
+    }
+}
+
+// Формирование исходящего кадра (задача обработки или, без нее, HCI callback)
+static void audio_tx_produce(int16_t *out, uint32_t samples)
+{
+    // Кадры пула и кольца не длиннее AUDIO_WORKER_FRAME_MAX: длинный буфер стека - частями, как на приеме
+    if (samples > AUDIO_WORKER_FRAME_MAX) {
+        audio_tx_produce(out, AUDIO_WORKER_FRAME_MAX);
+        audio_tx_produce(out + AUDIO_WORKER_FRAME_MAX, samples - AUDIO_WORKER_FRAME_MAX);
+        return;
+    }
+    // Источники перенастраиваются в том же потоке, что их микширует
+    int request = __atomic_exchange_n(&s_rate_request, 0, __ATOMIC_ACQUIRE);
+    if (request != 0) {
+        audio_configure_sources((audio_codec_t)(request - 1));
+    }
+
+    if (!audio_session_active()) {
+        memset(out, 0, samples * sizeof(int16_t));
+        return;
+    }
+
+    // Все источники (тон, подсказки, поток) сводятся микшером; выход - только активному SCO
+    audio_mixer_mix(out, samples);
+    agc_ramp_process(&s_spk_ramp, out, samples);
+    call_qoe_on_tx(&s_qoe, out, samples);
+
+    // Кадр уходит в кольцо задачи обработки; потребителям - одна общая копия, если они есть
+    audio_publish_copy(AUDIO_FRAME_TX, out, samples);
+}
 
 // Callback для входящих аудио данных (с микрофона устройства)
 static void audio_data_callback(const uint8_t *data, uint32_t len)
 {
-    ESP_LOGI(TAG, "📡 Received audio data: %" PRIu32 " bytes", len);
-    
-    // Здесь можно обработать полученные аудио данные
-    // Например, сохранить в буфер, записать в файл, отправить по сети и т.д.
-    
-    // Пример простого логирования первых нескольких байт
-    if (len >= 4) {
-        ESP_LOGI(TAG, "First 4 bytes: %02X %02X %02X %02X", 
-                 data[0], data[1], data[2], data[3]);
+    // Лог на каждый кадр только на уровне DEBUG: вывод в UART блокирует HCI callback
+    ESP_LOGD(TAG, "📡 Received audio data: %" PRIu32 " bytes", len);
+    metrics_inc(s_m.rx_frames);
+    if (audio_session_active()) {
+        call_qoe_count(&s_qoe.rx_frames);
+    }
+
+    // Джиттер меряется по приходу кадра, до очереди задачи обработки
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    if (conn != NULL) {
+        uint32_t frame_us = (uint32_t)((uint64_t)(len / sizeof(int16_t)) * 1000000 / audio_sample_rate());
+        link_quality_on_frame(&conn->link, esp_timer_get_time(), frame_us);
+    }
+
+    if (audio_worker_running()) {
+        audio_worker_push_rx((const int16_t *)data, len / sizeof(int16_t));
+    } else {
+        audio_rx_process((const int16_t *)data, len / sizeof(int16_t));
     }
 }
 
 // Callback для исходящих аудио данных (в динамик устройства)
 static uint32_t audio_outgoing_callback(uint8_t *buf, uint32_t len)
 {
-    if (!s_audio_connected) {
+    if (!audio_session_active()) {
         // Заполняем буфер тишиной даже если не подключено
         memset(buf, 0, len);
         return len;
     }
+    int64_t now = esp_timer_get_time();
+    if (s_first_frame_us == 0) {
+        s_first_frame_us = now - s_session_start_us;
+        trace_instant(TRACE_TRACK_AUDIO, "first_frame", (uint32_t)s_first_frame_us);
+    } else {
+        uint32_t interval = (uint32_t)(now - s_last_tx_us);
+        metrics_observe(s_m.tx_interval, interval);
+        if (interval > AUDIO_LATE_US) {
+            metrics_inc(s_m.underruns);
+            call_qoe_count(&s_qoe.late_callbacks);
+            trace_instant(TRACE_TRACK_AUDIO, "late_frame", interval);
+        }
+    }
+    s_last_tx_us = now;
+    metrics_inc(s_m.tx_frames);
+    call_qoe_count(&s_qoe.tx_frames);
 
-    ESP_LOGI(TAG, "📤 Sending audio data: %" PRIu32 " bytes", len);
-    
-    // Пример: генерируем простой тестовый сигнал (синусоиду)
-    static uint32_t sample_count = 0;
-    int16_t *samples = (int16_t *)buf;
-    uint32_t sample_len = len / 2; // 16-bit samples
-    
-    for (uint32_t i = 0; i < sample_len; i++) {
-        // Генерируем 440 Hz тон на частоте 8 kHz (для CVSD) или 16 kHz (для mSBC)
-        double sample_rate = s_msbc_mode ? 16000.0 : 8000.0;
-        double phase = 2.0 * M_PI * 440.0 * (sample_count + i) / sample_rate;
-        samples[i] = (int16_t)(8000.0 * sin(phase)); // Уменьшаем амплитуду для комфортного звука
+    ESP_LOGD(TAG, "📤 Sending audio data: %" PRIu32 " bytes", len);
+
+    // Кадр готовит задача обработки на ядре 1; callback только копирует его
+    if (audio_worker_running()) {
+        if (audio_worker_pop_tx((int16_t *)buf, len / sizeof(int16_t))) {
+            s_tx_primed = true;
+        } else if (s_tx_primed) {
+            call_qoe_count(&s_qoe.ring_underruns);
+        }
+    } else {
+        audio_tx_produce((int16_t *)buf, len / sizeof(int16_t));
     }
-    
-    sample_count += sample_len;
-    
+
+    metrics_observe(s_m.tx_cb, (uint32_t)(esp_timer_get_time() - now));
     return len;
 }
 
+// Стек забирает исходящий кадр только после esp_hf_ag_outgoing_data_ready()
+static void audio_pump_cb(void *arg)
+{
+    esp_hf_ag_outgoing_data_ready();
+}
+
+// Настройка частоты всех источников; выполняется вне активной сессии
+static void audio_apply_rate(audio_codec_t codec)
+{
+    if (s_rate_configured && s_codec == codec) {
+        return;
+    }
+    s_codec = codec;
+    s_rate_configured = true;
+
+    if (audio_worker_running()) {
+        __atomic_store_n(&s_rate_request, (int)codec + 1, __ATOMIC_RELEASE);
+    } else {
+        audio_configure_sources(codec);
+    }
+}
+
+static esp_err_t audio_add_test_tone(void)
+{
+    if (audio_mixer_is_active(s_test_tone_id)) {
+        return ESP_OK;
+    }
+
+    tone_set_frequency(&s_test_tone, AUDIO_TEST_TONE_HZ, audio_sample_rate());
+    const audio_mixer_source_cfg_t cfg = {
+        .cb = tone_source_cb,
+        .ctx = &s_test_tone,
+        .priority = 0,
+        .gain = AUDIO_TEST_TONE_GAIN,
+        .duck_gain = AUDIO_MIXER_GAIN_UNITY / 4,
+        .fade_in_ms = 20,
+    };
+    return audio_mixer_add_source(&cfg, &s_test_tone_id);
+}
+
+static int32_t sample_pool_in_use(void)
+{
+    uint32_t in_use;
+    audio_frame_usage(&in_use, NULL, NULL);
+    return (int32_t)in_use;
+}
+
+static int32_t sample_pool_peak(void)
+{
+    uint32_t peak;
+    audio_frame_usage(NULL, &peak, NULL);
+    return (int32_t)peak;
+}
+
 void audio_handler_init(void)
 {
-    ESP_LOGI(TAG, "Initializing audio handler for HCI data path...");
-    
+    ESP_LOGI(TAG, "Initializing audio pipeline...");
+
+    for (int i = 0; i <= SINE_LUT_SIZE; i++) {
+        s_sine_lut[i] = (int16_t)(32767.0f * sinf(2.0f * (float)M_PI * i / SINE_LUT_SIZE));
+    }
+
+    dsp_init();
+
+    s_m.rx_frames = metrics_counter("audio.rx_frames");
+    s_m.tx_frames = metrics_counter("audio.tx_frames");
+    s_m.underruns = metrics_counter("audio.underruns");
+    s_m.tx_interval = metrics_histogram("audio.tx_interval", "us");
+    s_m.tx_cb = metrics_histogram("audio.tx_cb", "us");
+    s_m.vad_speech = metrics_counter("vad.speech_frames");
+    s_m.vad_pause = metrics_counter("vad.pause_frames");
+    s_m.dtmf_digits = metrics_counter("dtmf.digits");
+    s_m.fax_tones = metrics_counter("dtmf.fax_tones");
+    s_m.dtmf_dropped = metrics_counter("dtmf.dropped");
+    s_m.pool_exhausted = metrics_counter("frame_pool.exhausted");
+    if (call_qoe_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Call quality log will not survive reboot");
+    }
+    metrics_gauge("frame_pool.in_use", sample_pool_in_use);
+    metrics_gauge("frame_pool.peak", sample_pool_peak);
+    audio_frame_init();
+
+    audio_mixer_init(audio_sample_rate());
+    if (call_recorder_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Call recorder unavailable");
+    }
+    prompts_set_output_rate(audio_sample_rate());
+    prompts_init();
+    if (audio_add_test_tone() != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to add test tone source");
+    }
+
+    const esp_timer_create_args_t pump_args = {
+        .callback = audio_pump_cb,
+        .name = "audio_pump",
+    };
+    if (esp_timer_create(&pump_args, &s_pump_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create audio pump timer");
+        return;
+    }
+
+    // Без задачи обработки тракт работает по-старому, прямо в HCI callbacks
+    if (audio_worker_init(audio_rx_process, audio_tx_produce) != ESP_OK) {
+        ESP_LOGW(TAG, "Audio worker unavailable, processing inline");
+    }
+
+    ESP_LOGI(TAG, "✅ Audio pipeline ready");
+}
+
+esp_err_t audio_handler_attach(void)
+{
     // Регистрируем callback для HCI данных
     esp_err_t ret = esp_hf_ag_register_data_callback(audio_data_callback, audio_outgoing_callback);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register HCI data callback: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "✅ Audio handler attached to HCI data path");
+    return ESP_OK;
+}
+
+void audio_handler_prepare(audio_codec_t codec)
+{
+    if (audio_session_active()) {
+        // Тракт уже занят другой гарнитурой - настроимся при открытии SCO
         return;
     }
-    
-    ESP_LOGI(TAG, "✅ Audio handler initialized successfully");
+
+    audio_apply_rate(codec);
+    audio_mixer_reset_stats();
+    conn_state_dispatch(CONN_EVT_AUDIO_ARM, NULL, NULL);
+
+    ESP_LOGI(TAG, "Audio pipeline armed for %s (%" PRIu32 " kHz)", audio_codec_name(codec),
+             audio_codec_sample_rate(codec) / 1000);
 }
 
-void audio_handler_set_connection_state(bool connected, uint16_t sync_conn_hdl, bool msbc_mode)
+void audio_handler_disarm(void)
 {
-    s_audio_connected = connected;
-    s_sync_conn_handle = sync_conn_hdl;
-    s_msbc_mode = msbc_mode;
-    
-    ESP_LOGI(TAG, "Audio connection state: %s, sync_conn_hdl: %d, codec: %s", 
-             connected ? "CONNECTED" : "DISCONNECTED", 
-             sync_conn_hdl,
-             msbc_mode ? "mSBC" : "CVSD");
-    
-    if (connected) {
-        ESP_LOGI(TAG, "🎙️ Audio recording is now available!");
-        ESP_LOGI(TAG, "📊 Audio will be processed through HCI callbacks");
-        ESP_LOGI(TAG, "🔊 Sample rate: %s", msbc_mode ? "16 kHz" : "8 kHz");
-        ESP_LOGI(TAG, "🎵 Ready to process audio data!");
-    } else {
+    if (audio_session_active()) {
+        audio_handler_set_connection_state(false, HF_CONN_HANDLE_NONE, s_codec);
+    }
+    conn_state_dispatch(CONN_EVT_AUDIO_DISARM, NULL, NULL);
+}
+
+static void audio_qoe_store_hdl(uint16_t event, void *param)
+{
+    call_qoe_store((const call_qoe_record_t *)param);
+}
+
+// Итог сессии и начало следующей - в задаче обработки, между кадрами
+typedef struct {
+    bool begin;
+    esp_bd_addr_t bda;
+    audio_codec_t codec;
+    bool have_rec;
+    call_qoe_record_t rec;
+} audio_qoe_job_t;
+
+static void audio_qoe_job(void *arg)
+{
+    audio_qoe_job_t *job = (audio_qoe_job_t *)arg;
+    audio_worker_latency_t tx_lat;
+    audio_worker_latency_t rx_lat;
+    audio_worker_get_latency(&tx_lat, &rx_lat);
+    // Монитор канала пишет обработчик событий, а он ждет конца задания
+    hf_conn_t *conn = hf_conn_get(s_qoe.bda);
+    job->have_rec = call_qoe_finish(&s_qoe, conn != NULL ? &conn->link : NULL, &tx_lat, &rx_lat, &job->rec);
+    if (job->begin) {
+        call_qoe_begin(&s_qoe, job->bda, job->codec);
+    }
+}
+
+// Вызывается после выключения тракта; conn != NULL - сразу начинается новая сессия.
+// Журнал и NVS - в задаче bt_app
+static void audio_qoe_switch(const hf_conn_t *conn, audio_codec_t codec)
+{
+    audio_qoe_job_t job = {
+        .begin = conn != NULL,
+        .codec = codec,
+    };
+    if (conn != NULL) {
+        memcpy(job.bda, conn->bda, sizeof(esp_bd_addr_t));
+    }
+    if (audio_worker_run(audio_qoe_job, &job, AUDIO_QOE_JOB_TIMEOUT_MS) != ESP_OK) {
+        ESP_LOGW(TAG, "Call quality session not switched");
+        return;
+    }
+    if (job.have_rec) {
+        bt_app_work_dispatch(audio_qoe_store_hdl, 0, &job.rec, sizeof(job.rec), NULL);
+    }
+}
+
+void audio_handler_set_connection_state(bool connected, uint16_t sync_conn_hdl, audio_codec_t codec)
+{
+    if (!connected) {
+        // Сначала выключаем выдачу кадров, затем останавливаем насос - без ожиданий
+        conn_state_dispatch(CONN_EVT_AUDIO_OFF, NULL, NULL);
+        trace_end(TRACE_TRACK_AUDIO, "sco");
+        if (s_pump_timer != NULL) {
+            esp_timer_stop(s_pump_timer);
+        }
+        s_active_handle = 0xFFFF;
+        audio_qoe_switch(NULL, s_codec);
         ESP_LOGI(TAG, "🔇 Audio processing stopped");
+        return;
+    }
+
+    if (audio_session_active() && s_active_handle == sync_conn_hdl && s_codec == codec) {
+        return;  // Закрылся чужой SCO, обслуживаемый канал не меняется
+    }
+
+    // Смена кодека на лету (SCO другой гарнитуры): на время перенастройки кадры - тишина
+    conn_state_dispatch(CONN_EVT_AUDIO_OFF, NULL, NULL);
+    audio_apply_rate(codec);
+
+    hf_conn_t *conn = hf_conn_get_by_handle(sync_conn_hdl);
+    audio_qoe_switch(conn, codec);
+    s_active_handle = sync_conn_hdl;
+    s_first_frame_us = 0;
+    s_session_start_us = esp_timer_get_time();
+    s_tx_primed = false;
+    bt_app_work_dispatch(audio_dtmf_reset_hdl, 0, NULL, 0, NULL);
+    // Release в CAS публикует настройки тракта раньше флага для callback'ов HCI
+    conn_state_dispatch(CONN_EVT_AUDIO_ON, NULL, NULL);
+    // Кадры, подготовленные до переключения, отбрасываются; кадр SCO - 7.5 мс
+    audio_worker_start_session(audio_codec_frame_samples(codec));
+    trace_end(TRACE_TRACK_AUDIO, "sco");
+    trace_begin(TRACE_TRACK_AUDIO, "sco");
+
+    // Первый кадр запрашиваем сразу, не дожидаясь периода таймера
+    esp_hf_ag_outgoing_data_ready();
+    if (s_pump_timer != NULL) {
+        if (esp_timer_is_active(s_pump_timer)) {
+            esp_timer_stop(s_pump_timer);
+        }
+        esp_timer_start_periodic(s_pump_timer, AUDIO_PUMP_PERIOD_US);
+    }
+
+    ESP_LOGI(TAG, "🎙️ Audio active: sync_conn_hdl 0x%04x, codec %s, %" PRIu32 " kHz",
+             sync_conn_hdl, audio_codec_name(codec), audio_codec_sample_rate(codec) / 1000);
+    if (conn != NULL) {
+        ESP_LOGI(TAG, "🎧 Link " ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(conn->bda));
+        audio_handler_apply_volume(conn);
+    }
+}
+
+void audio_handler_apply_volume(hf_conn_t *conn)
+{
+    if (conn == NULL) {
+        return;
+    }
+    agc_set_volume(&conn->agc, agc_volume_gain(conn->mic_volume));
+    // Исходящий поток один - громкость динамика берется у гарнитуры, которую обслуживает data path
+    if (conn == hf_conn_get_audio_active()) {
+        s_spk_ramp.target = agc_volume_gain(conn->spk_volume);
     }
 }
 
 void audio_handler_send_test_audio(void)
 {
-    if (!s_audio_connected) {
+    if (!audio_session_active()) {
         ESP_LOGW(TAG, "Audio not connected, cannot send test audio");
         return;
     }
     
+    if (audio_add_test_tone() != ESP_OK) {
+        ESP_LOGW(TAG, "No free mixer slot for test audio");
+        return;
+    }
     ESP_LOGI(TAG, "🔊 Test audio will be generated in outgoing callback");
-    ESP_LOGI(TAG, "📈 Codec: %s, Handle: %d", s_msbc_mode ? "mSBC" : "CVSD", s_sync_conn_handle);
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    ESP_LOGI(TAG, "📈 Codec: %s, Handle: %d", audio_codec_name(s_codec),
+             conn != NULL ? conn->sync_conn_handle : HF_CONN_HANDLE_NONE);
+}
+
+void audio_handler_set_vad(bool enabled)
+{
+    s_vad_enabled = enabled;
+    ESP_LOGI(TAG, "Voice activity detection %s", enabled ? "enabled" : "disabled");
+}
+
+void audio_handler_print_vad(void)
+{
+    ESP_LOGI(TAG, "=== VAD: %s ===", s_vad_enabled ? "on" : "off");
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    if (conn == NULL || conn->vad.frames == 0) {
+        ESP_LOGI(TAG, "No capture frames yet");
+        return;
+    }
+    const vad_t *vad = &conn->vad;
+    ESP_LOGI(TAG, "%s, %" PRIu32 " frames, speech %" PRIu32 "%%, noise rms %" PRIu32 " LSB",
+             vad->speech ? "speech" : "pause", vad->frames, vad->speech_frames * 100 / vad->frames,
+             vad_noise_rms(vad));
+}
+
+void audio_handler_set_agc(bool enabled)
+{
+    s_agc_enabled = enabled;
+    ESP_LOGI(TAG, "Automatic gain control %s", enabled ? "enabled" : "disabled");
+}
+
+static int gain_db(int32_t gain_q12)
+{
+    return gain_q12 > 0 ? (int)lroundf(20.0f * log10f((float)gain_q12 / AGC_GAIN_UNITY)) : -99;
+}
+
+void audio_handler_print_agc(void)
+{
+    ESP_LOGI(TAG, "=== AGC: %s ===", s_agc_enabled ? "on" : "off");
+    ESP_LOGI(TAG, "Speaker volume %d dB (target %d dB)", gain_db(s_spk_ramp.gain), gain_db(s_spk_ramp.target));
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    if (conn == NULL || conn->agc.blocks == 0) {
+        ESP_LOGI(TAG, "No capture frames yet");
+        return;
+    }
+    const agc_t *agc = &conn->agc;
+    ESP_LOGI(TAG, "AGC %+d dB, mic volume %d dB, limiter active %" PRIu32 "%% of %" PRIu32 " ms",
+             gain_db(agc->agc_gain), gain_db(agc->volume),
+             agc->limited_blocks * 100 / agc->blocks, agc->blocks);
+}
+
+void audio_handler_print_dtmf(void)
+{
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    ESP_LOGI(TAG, "=== DTMF ===");
+    ESP_LOGI(TAG, "Digits: \"%s\"%s", s_dtmf_history, s_dtmf_len == AUDIO_DTMF_HISTORY ? " (history full)" : "");
+    if (conn != NULL && conn->dtmf_enabled) {
+        ESP_LOGI(TAG, "%" PRIu32 " blocks, %" PRIu32 " digits this session", conn->dtmf.blocks, conn->dtmf.digits);
+    } else {
+        ESP_LOGI(TAG, "Detector idle (no SCO or unsupported rate)");
+    }
 }
 
 bool audio_handler_is_connected(void)
 {
-    return s_audio_connected;
+    return audio_session_active();
+}
+
+uint32_t audio_handler_get_first_frame_us(void)
+{
+    return (uint32_t)s_first_frame_us;
+}
+
+uint32_t audio_handler_get_sample_rate(void)
+{
+    return audio_sample_rate();
 }
@@ -4,31 +4,96 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <math.h>
+#include "esp_err.h"
 #include "esp_hf_ag_api.h"
 #include "esp_hf_defs.h"
+#include "audio_codec.h"
+#include "hf_conn.h"
 
 /**
- * @brief Инициализация аудио обработчика для HCI data path
+ * @brief Сборка аудио тракта (микшер, подсказки, запись, таймер насоса)
+ *
+ * Не зависит от стека Bluetooth и может выполняться параллельно с его запуском.
  */
 void audio_handler_init(void);
 
+/**
+ * @brief Регистрация callbacks HCI data path (после esp_hf_ag_init)
+ * @return ESP_OK при успехе
+ */
+esp_err_t audio_handler_attach(void);
+
+/**
+ * @brief Подготовка аудио тракта при подключении SLC (до открытия SCO)
+ * @param codec Ожидаемый кодек
+ */
+void audio_handler_prepare(audio_codec_t codec);
+
+/**
+ * @brief Сброс подготовленного тракта, когда не осталось ни одного SLC
+ */
+void audio_handler_disarm(void);
+
 /**
  * @brief Установка состояния аудио соединения
  * @param connected Статус соединения (true = подключено, false = отключено)
  * @param sync_conn_hdl Дескриптор SCO соединения
- * @param msbc_mode Режим кодека (true = mSBC, false = CVSD)
+ * @param codec Кодек SCO
  */
-void audio_handler_set_connection_state(bool connected, uint16_t sync_conn_hdl, bool msbc_mode);
+void audio_handler_set_connection_state(bool connected, uint16_t sync_conn_hdl, audio_codec_t codec);
 
 /**
  * @brief Отправка тестового аудио сигнала
  */
 void audio_handler_send_test_audio(void);
 
+/**
+ * @brief Включение детектора речи на приеме: паузы кодер записи заменяет кэшированной тишиной
+ */
+void audio_handler_set_vad(bool enabled);
+
+/**
+ * @brief Состояние детектора речи, оценка шума и доля речи активной гарнитуры
+ */
+void audio_handler_print_vad(void);
+
+/**
+ * @brief Включение АРУ на приеме; лимитер и громкость работают всегда
+ */
+void audio_handler_set_agc(bool enabled);
+
+/**
+ * @brief Усиление АРУ, работа лимитера и громкость активной гарнитуры
+ */
+void audio_handler_print_agc(void);
+
+/**
+ * @brief Громкость гарнитуры (AT+VGS/AT+VGM) -> рампы усиления соответствующих трактов
+ * @param conn Соединение, чья громкость изменилась
+ */
+void audio_handler_apply_volume(hf_conn_t *conn);
+
+/**
+ * @brief Цифры DTMF и тоны факса, принятые в текущей аудио сессии
+ */
+void audio_handler_print_dtmf(void);
+
 /**
  * @brief Проверка состояния аудио соединения
  * @return true если аудио соединение активно, false иначе
  */
 bool audio_handler_is_connected(void);
 
+/**
+ * @brief Задержка выдачи первого кадра после открытия SCO
+ * @return Микросекунды (0 - кадр еще не запрошен)
+ */
+uint32_t audio_handler_get_first_frame_us(void);
+
+/**
+ * @brief Текущая частота дискретизации аудио тракта
+ * @return 8000 для CVSD, 16000 для mSBC
+ */
+uint32_t audio_handler_get_sample_rate(void);
+
 #endif // AUDIO_HANDLER_H
@@ -0,0 +1,388 @@
+#include "audio_mixer.h"
+#include "dsp_kernels.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "AUDIO_MIXER";
+
+// Усиление хранится в Q23 (Q15 << 8), чтобы шаг рампы не обнулялся на длинных рампах
+#define GAIN_FRAC_SHIFT 8
+#define QUIESCE_SPINS   64      // Столько уступок ядра, дальше ожидание тиками
+
+typedef struct {
+    // Конфигурация: меняется под s_mixer_lock
+    audio_mixer_source_cb_t cb;
+    void *ctx;
+    uint8_t priority;
+    uint8_t flags;
+    bool active;
+    bool removing;
+    bool restart;
+    int32_t target_gain;
+    int32_t duck_gain;
+    uint32_t ramp_samples;
+    uint32_t gen;
+
+    // Состояние рампы: трогает только поток микширования
+    int32_t gain;
+    int32_t step;
+    int32_t eff_target;
+    uint32_t ramp_left;
+    uint32_t seen_gen;
+    bool ducked;
+    bool produced;
+    bool busy;                  // Источник в снимке текущего блока; снимает поток микширования
+} mixer_slot_t;
+
+static mixer_slot_t s_slots[AUDIO_MIXER_MAX_SOURCES];
+static portMUX_TYPE s_mixer_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_sample_rate = 8000;
+static uint8_t s_duck_priority = 0;
+static bool s_duck_any = false;
+
+static int32_t s_acc[AUDIO_MIXER_MAX_BLOCK_SAMPLES];
+static int16_t s_scratch[AUDIO_MIXER_MAX_BLOCK_SAMPLES];
+
+static audio_mixer_stats_t s_stats;
+
+static inline uint32_t ms_to_samples(uint32_t ms)
+{
+    return (uint32_t)(((uint64_t)ms * s_sample_rate) / 1000);
+}
+
+static inline bool valid_id(int id)
+{
+    return id >= 0 && id < AUDIO_MIXER_MAX_SOURCES;
+}
+
+// Начать рампу к новой цели (цель в Q15)
+static void slot_start_ramp(mixer_slot_t *slot, int32_t target_q15, uint32_t ramp_samples)
+{
+    slot->eff_target = target_q15 << GAIN_FRAC_SHIFT;
+    if (ramp_samples == 0) {
+        slot->gain = slot->eff_target;
+        slot->step = 0;
+        slot->ramp_left = 0;
+        return;
+    }
+    slot->ramp_left = ramp_samples;
+    slot->step = (slot->eff_target - slot->gain) / (int32_t)ramp_samples;
+    if (slot->step == 0) {
+        slot->gain = slot->eff_target;
+        slot->ramp_left = 0;
+    }
+}
+
+// acc += src * gain с линейным изменением gain на step каждый отсчет, gain в Q23
+static int32_t accumulate_ramp(int32_t *restrict acc, const int16_t *restrict src, uint32_t n,
+                               int32_t gain, int32_t step)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        gain += step;
+        acc[i] += (int32_t)(((int64_t)src[i] * gain) >> (15 + GAIN_FRAC_SHIFT));
+    }
+    return gain;
+}
+
+// Источник на время блока: слот может быть удален и занят заново, пока идет микширование
+typedef struct {
+    int id;
+    audio_mixer_source_cb_t cb;
+    void *ctx;
+    uint32_t gen;
+    uint8_t priority;
+    uint8_t flags;
+    bool removing;              // Затухание перед удалением; флаг слота пишет поток удаления
+} mix_entry_t;
+
+static uint32_t mix_block(int16_t *out, uint32_t n)
+{
+    mix_entry_t entries[AUDIO_MIXER_MAX_SOURCES];
+    int count = 0;
+
+    // Снимок конфигурации под коротким спинлоком; сами источники вызываются без блокировки
+    portENTER_CRITICAL(&s_mixer_lock);
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        mixer_slot_t *slot = &s_slots[i];
+        if (!slot->active) {
+            continue;
+        }
+        if (slot->restart) {
+            slot->restart = false;
+            slot->gain = 0;
+            slot->ducked = false;
+            slot->produced = false;
+            slot->seen_gen = slot->gen - 1;
+        }
+        bool duck = s_duck_any && slot->priority < s_duck_priority && slot->duck_gain != AUDIO_MIXER_GAIN_UNITY;
+        if (slot->seen_gen != slot->gen) {
+            slot->seen_gen = slot->gen;
+            slot->ducked = duck;
+            int32_t target = duck ? (int32_t)(((int64_t)slot->target_gain * slot->duck_gain) >> 15) : slot->target_gain;
+            slot_start_ramp(slot, target, slot->ramp_samples);
+        } else if (duck != slot->ducked) {
+            slot->ducked = duck;
+            int32_t target = duck ? (int32_t)(((int64_t)slot->target_gain * slot->duck_gain) >> 15) : slot->target_gain;
+            slot_start_ramp(slot, target, ms_to_samples(AUDIO_MIXER_DUCK_RAMP_MS));
+        }
+        __atomic_store_n(&slot->busy, true, __ATOMIC_RELAXED);
+        entries[count].id = i;
+        entries[count].cb = slot->cb;
+        entries[count].ctx = slot->ctx;
+        entries[count].gen = slot->gen;
+        entries[count].priority = slot->priority;
+        entries[count].flags = slot->flags;
+        entries[count].removing = slot->removing;
+        count++;
+    }
+    portEXIT_CRITICAL(&s_mixer_lock);
+
+    if (count == 0) {
+        memset(out, 0, n * sizeof(int16_t));
+        return 0;
+    }
+
+    memset(s_acc, 0, n * sizeof(int32_t));
+
+    uint32_t producing = 0;
+    uint8_t top_priority = 0;
+    bool any = false;
+
+    for (int k = 0; k < count; k++) {
+        mixer_slot_t *slot = &s_slots[entries[k].id];
+        uint32_t got = entries[k].cb(entries[k].ctx, s_scratch, n);
+        if (got > n) {
+            got = n;
+        }
+
+        slot->produced = got > 0;
+        if (got > 0) {
+            producing++;
+            if (!any || entries[k].priority > top_priority) {
+                top_priority = entries[k].priority;
+            }
+            any = true;
+
+            uint32_t done = 0;
+            if (slot->ramp_left > 0) {
+                uint32_t r = slot->ramp_left < got ? slot->ramp_left : got;
+                slot->gain = accumulate_ramp(s_acc, s_scratch, r, slot->gain, slot->step);
+                slot->ramp_left -= r;
+                if (slot->ramp_left == 0) {
+                    slot->gain = slot->eff_target;
+                }
+                done = r;
+            }
+            if (done < got) {
+                int32_t g = slot->gain >> GAIN_FRAC_SHIFT;
+                if (g != 0) {
+                    dsp_mac_q15(s_acc + done, s_scratch + done, got - done, g);
+                }
+            }
+        }
+
+        bool finished = (entries[k].flags & AUDIO_MIXER_FLAG_ONESHOT) && got < n;
+        // Молчащему источнику затухать нечего - удаляем сразу
+        bool faded = entries[k].removing && (got == 0 || (slot->ramp_left == 0 && slot->gain == 0));
+        if (finished || faded) {
+            // Слот за время блока занял новый источник (или сменилась его настройка) - не трогаем
+            portENTER_CRITICAL(&s_mixer_lock);
+            if (slot->gen == entries[k].gen) {
+                slot->active = false;
+                slot->removing = false;
+            }
+            portEXIT_CRITICAL(&s_mixer_lock);
+        }
+        // Подтверждение для audio_mixer_remove_source_sync: cb и ctx источника больше не нужны
+        __atomic_store_n(&slot->busy, false, __ATOMIC_RELEASE);
+    }
+
+    // Приоритет для приглушения применяется со следующего блока
+    s_duck_any = any;
+    s_duck_priority = top_priority;
+
+    s_stats.clipped += dsp_sat16(out, s_acc, n);
+    return producing;
+}
+
+esp_err_t audio_mixer_init(uint32_t sample_rate)
+{
+    portENTER_CRITICAL(&s_mixer_lock);
+    memset(s_slots, 0, sizeof(s_slots));
+    s_duck_any = false;
+    s_duck_priority = 0;
+    portEXIT_CRITICAL(&s_mixer_lock);
+
+    audio_mixer_set_sample_rate(sample_rate);
+    audio_mixer_reset_stats();
+
+    ESP_LOGI(TAG, "Mixer initialized: %d sources, block %d samples, %" PRIu32 " Hz",
+             AUDIO_MIXER_MAX_SOURCES, AUDIO_MIXER_MAX_BLOCK_SAMPLES, sample_rate);
+    return ESP_OK;
+}
+
+void audio_mixer_set_sample_rate(uint32_t sample_rate)
+{
+    if (sample_rate == 0) {
+        return;
+    }
+    s_sample_rate = sample_rate;
+}
+
+esp_err_t audio_mixer_add_source(const audio_mixer_source_cfg_t *cfg, int *out_id)
+{
+    if (cfg == NULL || cfg->cb == NULL || out_id == NULL ||
+        cfg->gain < 0 || cfg->gain > AUDIO_MIXER_GAIN_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int id = -1;
+    portENTER_CRITICAL(&s_mixer_lock);
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        if (!s_slots[i].active) {
+            mixer_slot_t *slot = &s_slots[i];
+            slot->cb = cfg->cb;
+            slot->ctx = cfg->ctx;
+            slot->priority = cfg->priority;
+            slot->flags = cfg->flags;
+            slot->target_gain = cfg->gain;
+            slot->duck_gain = cfg->duck_gain;
+            slot->ramp_samples = ms_to_samples(cfg->fade_in_ms);
+            slot->removing = false;
+            slot->restart = true;
+            slot->gen++;
+            slot->active = true;
+            id = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_mixer_lock);
+
+    if (id < 0) {
+        ESP_LOGW(TAG, "No free mixer slots (%d in use)", AUDIO_MIXER_MAX_SOURCES);
+        return ESP_ERR_NO_MEM;
+    }
+
+    *out_id = id;
+    ESP_LOGD(TAG, "Source %d added, priority %d", id, cfg->priority);
+    return ESP_OK;
+}
+
+esp_err_t audio_mixer_remove_source(int id, uint32_t fade_ms)
+{
+    if (!valid_id(id)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL(&s_mixer_lock);
+    mixer_slot_t *slot = &s_slots[id];
+    if (!slot->active) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else if (fade_ms == 0) {
+        slot->active = false;
+        slot->removing = false;
+    } else {
+        slot->target_gain = 0;
+        slot->ramp_samples = ms_to_samples(fade_ms);
+        slot->removing = true;
+        slot->gen++;
+    }
+    portEXIT_CRITICAL(&s_mixer_lock);
+    return ret;
+}
+
+esp_err_t audio_mixer_remove_source_sync(int id)
+{
+    if (!valid_id(id)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Источник мог уже удалиться сам (ONESHOT), но блок с ним еще идет - ждем в любом случае
+    audio_mixer_remove_source(id, 0);
+
+    // Снимок блока и удаление - под s_mixer_lock: после удаления источник
+    // попадает только в блок, который уже идет, и его конец снимает busy
+    mixer_slot_t *slot = &s_slots[id];
+    for (int spins = 0; __atomic_load_n(&slot->busy, __ATOMIC_ACQUIRE); spins++) {
+        if (spins < QUIESCE_SPINS) {
+            taskYIELD();
+        } else {
+            vTaskDelay(1);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t audio_mixer_set_gain(int id, int32_t gain, uint32_t ramp_ms)
+{
+    if (!valid_id(id) || gain < 0 || gain > AUDIO_MIXER_GAIN_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL(&s_mixer_lock);
+    mixer_slot_t *slot = &s_slots[id];
+    if (!slot->active || slot->removing) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        slot->target_gain = gain;
+        slot->ramp_samples = ms_to_samples(ramp_ms);
+        slot->gen++;
+    }
+    portEXIT_CRITICAL(&s_mixer_lock);
+    return ret;
+}
+
+bool audio_mixer_is_active(int id)
+{
+    return valid_id(id) && s_slots[id].active;
+}
+
+uint32_t audio_mixer_mix(int16_t *out, uint32_t samples)
+{
+    int64_t start = esp_timer_get_time();
+    uint32_t producing = 0;
+
+    while (samples > 0) {
+        uint32_t n = samples < AUDIO_MIXER_MAX_BLOCK_SAMPLES ? samples : AUDIO_MIXER_MAX_BLOCK_SAMPLES;
+        uint32_t p = mix_block(out, n);
+        if (p > producing) {
+            producing = p;
+        }
+        out += n;
+        samples -= n;
+        s_stats.samples += n;
+    }
+
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+    s_stats.blocks++;
+    s_stats.total_us += elapsed;
+    if (elapsed > s_stats.max_block_us) {
+        s_stats.max_block_us = elapsed;
+    }
+    return producing;
+}
+
+void audio_mixer_get_stats(audio_mixer_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    *stats = s_stats;
+
+    uint8_t active = 0;
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        if (s_slots[i].active) {
+            active++;
+        }
+    }
+    stats->active_sources = active;
+}
+
+void audio_mixer_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
@@ -0,0 +1,128 @@
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_MIXER_MAX_SOURCES        8     // Максимум одновременных источников
+#define AUDIO_MIXER_MAX_BLOCK_SAMPLES  240   // Размер внутреннего блока микширования
+#define AUDIO_MIXER_GAIN_UNITY         (1 << 15)  // Усиление 1.0 в формате Q15
+#define AUDIO_MIXER_GAIN_MAX           (2 << 15)  // Максимальное усиление 2.0
+#define AUDIO_MIXER_DUCK_RAMP_MS       30    // Длительность рампы приглушения
+
+#define AUDIO_MIXER_FLAG_ONESHOT       0x01  // Удалить источник, когда он выдал меньше, чем просили
+
+/**
+ * @brief Callback источника: заполняет buf не более чем samples отсчетами
+ * @param ctx Пользовательский контекст источника
+ * @param buf Буфер для 16-битных отсчетов
+ * @param samples Запрошенное количество отсчетов
+ * @return Количество реально выданных отсчетов (0 - источник молчит)
+ */
+typedef uint32_t (*audio_mixer_source_cb_t)(void *ctx, int16_t *buf, uint32_t samples);
+
+typedef struct {
+    audio_mixer_source_cb_t cb;
+    void *ctx;
+    uint8_t priority;     // Более приоритетный источник приглушает менее приоритетные
+    uint8_t flags;        // AUDIO_MIXER_FLAG_*
+    int32_t gain;         // Целевое усиление, Q15
+    int32_t duck_gain;    // Усиление при приглушении, Q15 (UNITY - не приглушать)
+    uint32_t fade_in_ms;  // Плавное нарастание при добавлении
+} audio_mixer_source_cfg_t;
+
+typedef struct {
+    uint32_t blocks;          // Обработано блоков
+    uint32_t samples;         // Обработано отсчетов
+    uint32_t clipped;         // Отсчетов, ушедших в насыщение
+    uint32_t max_block_us;    // Максимальное время блока
+    uint64_t total_us;        // Суммарное время микширования
+    uint8_t active_sources;   // Активных источников сейчас
+} audio_mixer_stats_t;
+
+/**
+ * @brief Инициализация микшера
+ * @param sample_rate Частота дискретизации, Гц
+ * @return ESP_OK при успехе
+ */
+esp_err_t audio_mixer_init(uint32_t sample_rate);
+
+/**
+ * @brief Смена частоты дискретизации (влияет на пересчет длительности рамп)
+ * @param sample_rate Частота дискретизации, Гц
+ */
+void audio_mixer_set_sample_rate(uint32_t sample_rate);
+
+/**
+ * @brief Добавление источника. Без выделения памяти - используется свободный слот
+ * @param cfg Конфигурация источника
+ * @param out_id Идентификатор источника
+ * @return ESP_OK при успехе, ESP_ERR_NO_MEM если свободных слотов нет
+ */
+esp_err_t audio_mixer_add_source(const audio_mixer_source_cfg_t *cfg, int *out_id);
+
+/**
+ * @brief Удаление источника с плавным затуханием
+ * @param id Идентификатор источника
+ * @param fade_ms Длительность затухания (0 - удалить сразу)
+ * @return ESP_OK при успехе
+ *
+ * Контекст источника должен оставаться валидным до конца текущего блока микширования.
+ */
+esp_err_t audio_mixer_remove_source(int id, uint32_t fade_ms);
+
+/**
+ * @brief Удаление источника сразу, с подтверждением от потока микширования
+ * @param id Идентификатор источника
+ * @return ESP_OK после того, как поток микширования вышел из callback источника
+ *
+ * После возврата callback больше не вызывается и контекст можно освободить.
+ * Не вызывается из callback источника и из потока микширования.
+ */
+esp_err_t audio_mixer_remove_source_sync(int id);
+
+/**
+ * @brief Установка усиления источника с линейной рампой
+ * @param id Идентификатор источника
+ * @param gain Целевое усиление, Q15
+ * @param ramp_ms Длительность рампы
+ * @return ESP_OK при успехе
+ */
+esp_err_t audio_mixer_set_gain(int id, int32_t gain, uint32_t ramp_ms);
+
+/**
+ * @brief Проверка, активен ли источник
+ * @param id Идентификатор источника
+ * @return true если источник еще в микшере
+ */
+bool audio_mixer_is_active(int id);
+
+/**
+ * @brief Микширование всех активных источников в выходной буфер
+ * @param out Выходной буфер
+ * @param samples Количество отсчетов
+ * @return Количество источников, выдавших звук
+ */
+uint32_t audio_mixer_mix(int16_t *out, uint32_t samples);
+
+/**
+ * @brief Получение статистики микшера
+ * @param stats Структура для записи статистики
+ */
+void audio_mixer_get_stats(audio_mixer_stats_t *stats);
+
+/**
+ * @brief Сброс статистики микшера
+ */
+void audio_mixer_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_MIXER_H */
@@ -0,0 +1,385 @@
+#include "audio_tap.h"
+#include "audio_frame.h"
+#include "ima_adpcm.h"
+#include "metrics.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <string.h>
+#include <inttypes.h>
+
+static const char *TAG = "AUDIO_TAP";
+
+#define TAP_PACKET_MAX     (AUDIO_TAP_HEADER_SIZE + AUDIO_WORKER_FRAME_MAX * sizeof(int16_t) + 2)
+#define TAP_LINK_BYTES_S   (AUDIO_TAP_BAUD / 10)   // 8N1: 10 бит на байт
+#define TAP_WINDOW_US      1000000                 // Окно оценки загрузки канала
+#define TAP_STOP_TIMEOUT_MS 1000                   // Ожидание задачи при остановке (пакет в UART)
+
+#define TAP_CODEC_PCM      0                       // Значения поля codec в пакете
+#define TAP_CODEC_ADPCM    1
+#define TAP_FLAG_SPEECH    0x01
+#define TAP_FLAG_START     0x02                    // Первый пакет точки после audio_tap_start
+
+typedef struct {
+    uint32_t packets;
+    uint32_t bytes;
+    uint32_t dropped;              // Пишут потоки аудио, только атомарно
+    bool started;                  // Первый пакет сессии уже ушел
+    ima_adpcm_state_t adpcm;
+} tap_point_state_t;
+
+static const char *s_point_names[AUDIO_TAP_POINT_COUNT] = { "raw", "rx", "tx" };
+static const audio_frame_stream_t s_point_streams[AUDIO_TAP_POINT_COUNT] = {
+    AUDIO_FRAME_RX_RAW, AUDIO_FRAME_RX, AUDIO_FRAME_TX,
+};
+
+static QueueHandle_t s_queue = NULL;           // audio_frame_t *; NULL - метка остановки
+static SemaphoreHandle_t s_idle_sem = NULL;     // Задача дошла до метки и не держит кадров
+static TaskHandle_t s_task = NULL;
+static int s_consumer_ids[AUDIO_TAP_POINT_COUNT] = { -1, -1, -1 };
+static bool s_active = false;                   // Пишет консоль, читает задача отвода
+static uint8_t s_point_mask = 0;
+static audio_tap_codec_t s_codec_mode = AUDIO_TAP_CODEC_AUTO;
+static bool s_congested = false;           // Кадр отброшен с прошлого пакета; сбрасывает задача
+static tap_point_state_t s_points[AUDIO_TAP_POINT_COUNT];
+
+// Состояние задачи отвода
+static bool s_adpcm = false;
+static int64_t s_backoff_until_us = 0;
+static int64_t s_window_start_us = 0;
+static uint32_t s_window_bytes = 0;        // Отправлено за окно
+static uint32_t s_window_pcm_bytes = 0;    // Столько же кадров без сжатия
+static uint32_t s_link_load = 0;           // Байт/с за последнее окно
+static uint32_t s_pcm_load = 0;
+static uint8_t s_packet[TAP_PACKET_MAX];
+
+static struct {
+    metric_t *packets;
+    metric_t *dropped;
+    metric_t *bytes;
+} s_m;
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    put_le16(p, (uint16_t)v);
+    put_le16(p + 2, (uint16_t)(v >> 16));
+}
+
+// CRC-16/CCITT-FALSE по полубайтам: таблица 32 байта, два шага на байт
+static uint16_t tap_crc16(const uint8_t *data, size_t len)
+{
+    static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+static int tap_point_of(const audio_frame_t *frame)
+{
+    for (int i = 0; i < AUDIO_TAP_POINT_COUNT; i++) {
+        if (s_point_streams[i] == frame->stream) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Потребитель пула: в потоке аудио только ссылка и очередь без ожидания
+static void tap_frame_cb(audio_frame_t *frame, void *ctx)
+{
+    tap_point_state_t *pt = (tap_point_state_t *)ctx;
+    uint32_t in_use;
+    audio_frame_usage(&in_use, NULL, NULL);
+
+    // Отвод не занимает последние кадры пула: они нужны тракту
+    if (in_use + AUDIO_TAP_POOL_RESERVE <= AUDIO_FRAME_POOL_SIZE) {
+        audio_frame_ref(frame);
+        if (xQueueSend(s_queue, &frame, 0) == pdTRUE) {
+            return;
+        }
+        audio_frame_unref(frame);
+    }
+    __atomic_fetch_add(&pt->dropped, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_congested, true, __ATOMIC_RELAXED);
+    metrics_inc(s_m.dropped);
+}
+
+// Выбор сжатия перед пакетом: ADPCM после переполнения, PCM - когда канал его вытянет
+static void tap_update_codec(int64_t now)
+{
+    int64_t elapsed = now - s_window_start_us;
+    if (elapsed >= TAP_WINDOW_US) {
+        s_link_load = (uint32_t)((uint64_t)s_window_bytes * TAP_WINDOW_US / elapsed);
+        s_pcm_load = (uint32_t)((uint64_t)s_window_pcm_bytes * TAP_WINDOW_US / elapsed);
+        s_window_bytes = 0;
+        s_window_pcm_bytes = 0;
+        s_window_start_us = now;
+    }
+
+    if (s_codec_mode != AUDIO_TAP_CODEC_AUTO) {
+        s_adpcm = s_codec_mode == AUDIO_TAP_CODEC_ADPCM;
+        return;
+    }
+    if (__atomic_exchange_n(&s_congested, false, __ATOMIC_RELAXED)) {
+        if (!s_adpcm) {
+            ESP_LOGW(TAG, "⚠️ Tap link saturated, switching to ADPCM");
+        }
+        s_adpcm = true;
+        s_backoff_until_us = now + AUDIO_TAP_BACKOFF_MS * 1000LL;
+    } else if (s_adpcm && now >= s_backoff_until_us && s_pcm_load * 5 <= TAP_LINK_BYTES_S * 4) {
+        // Возврат к PCM, только если он займет не больше 80% канала
+        s_adpcm = false;
+        ESP_LOGI(TAG, "Tap link has headroom, back to PCM");
+    }
+}
+
+static size_t tap_encode(const audio_frame_t *frame, int point)
+{
+    tap_point_state_t *pt = &s_points[point];
+    uint32_t n = frame->count;
+    uint8_t *payload = s_packet + AUDIO_TAP_HEADER_SIZE;
+    uint32_t payload_len;
+
+    if (s_adpcm) {
+        // Состояние кодера в начале пакета: каждый пакет декодируется сам по себе
+        put_le16(payload, (uint16_t)pt->adpcm.predictor);
+        payload[2] = (uint8_t)pt->adpcm.step_index;
+        payload[3] = 0;
+        uint8_t *p = payload + 4;
+        for (uint32_t i = 0; i < n; i += 2) {
+            uint8_t lo = ima_adpcm_encode_sample(&pt->adpcm, frame->samples[i]);
+            uint8_t hi = i + 1 < n ? ima_adpcm_encode_sample(&pt->adpcm, frame->samples[i + 1]) : 0;
+            *p++ = (uint8_t)(lo | (hi << 4));
+        }
+        payload_len = (uint32_t)(p - payload);
+    } else {
+        // ESP32 little-endian: отсчеты уже в порядке пакета
+        memcpy(payload, frame->samples, n * sizeof(int16_t));
+        payload_len = n * sizeof(int16_t);
+    }
+
+    uint8_t flags = frame->speech ? TAP_FLAG_SPEECH : 0;
+    if (!pt->started) {
+        pt->started = true;
+        flags |= TAP_FLAG_START;
+    }
+    put_le16(s_packet, AUDIO_TAP_MAGIC);
+    s_packet[2] = AUDIO_TAP_VERSION;
+    s_packet[3] = (uint8_t)point;
+    s_packet[4] = s_adpcm ? TAP_CODEC_ADPCM : TAP_CODEC_PCM;
+    s_packet[5] = flags;
+    put_le16(s_packet + 6, (uint16_t)n);
+    put_le16(s_packet + 8, (uint16_t)frame->sample_rate);
+    put_le16(s_packet + 10, (uint16_t)payload_len);
+    put_le32(s_packet + 12, frame->seq);
+    put_le32(s_packet + 16, __atomic_load_n(&pt->dropped, __ATOMIC_RELAXED));
+    put_le32(s_packet + 20, (uint32_t)frame->timestamp_us);
+
+    size_t len = AUDIO_TAP_HEADER_SIZE + payload_len;
+    put_le16(s_packet + len, tap_crc16(s_packet, len));
+    len += 2;
+
+    s_window_pcm_bytes += AUDIO_TAP_HEADER_SIZE + n * sizeof(int16_t) + 2;
+    s_window_bytes += (uint32_t)len;
+    pt->packets++;
+    pt->bytes += (uint32_t)len;
+    return len;
+}
+
+static void audio_tap_task(void *arg)
+{
+    audio_frame_t *frame = NULL;
+    for (;;) {
+        if (xQueueReceive(s_queue, &frame, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (frame == NULL) {
+            // Метка audio_tap_stop: все кадры до нее закодированы или отброшены
+            xSemaphoreGive(s_idle_sem);
+            continue;
+        }
+        int point = tap_point_of(frame);
+        // Кадр callback, начатого до отписки: состояние точек уже не его
+        if (point < 0 || !__atomic_load_n(&s_active, __ATOMIC_ACQUIRE)) {
+            audio_frame_unref(frame);
+            continue;
+        }
+        tap_update_codec(esp_timer_get_time());
+        size_t len = tap_encode(frame, point);
+        // Кадр возвращается в пул до вывода: пул не ждет UART
+        audio_frame_unref(frame);
+
+        // Блокируется, пока кольцо драйвера занято; тем временем очередь копит кадры или отбрасывает их
+        uart_write_bytes(AUDIO_TAP_UART_NUM, s_packet, len);
+        metrics_inc(s_m.packets);
+        metrics_add(s_m.bytes, (uint32_t)len);
+    }
+}
+
+// UART и задача создаются при первом включении: без отвода вывод GPIO не занят
+static esp_err_t tap_setup(void)
+{
+    if (s_task != NULL) {
+        return ESP_OK;
+    }
+
+    const uart_config_t cfg = {
+        .baud_rate = AUDIO_TAP_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+    };
+    // Прием не нужен, но драйвер требует буфер больше аппаратного FIFO
+    esp_err_t ret = uart_driver_install(AUDIO_TAP_UART_NUM, 256, AUDIO_TAP_TX_BUF_SIZE, 0, NULL, 0);
+    if (ret == ESP_OK) {
+        ret = uart_param_config(AUDIO_TAP_UART_NUM, &cfg);
+    }
+    if (ret == ESP_OK) {
+        ret = uart_set_pin(AUDIO_TAP_UART_NUM, AUDIO_TAP_TX_PIN, UART_PIN_NO_CHANGE,
+                           UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set up tap UART: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    s_queue = xQueueCreate(AUDIO_TAP_QUEUE_LEN, sizeof(audio_frame_t *));
+    s_idle_sem = xSemaphoreCreateBinary();
+    if (s_queue == NULL || s_idle_sem == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    s_m.packets = metrics_counter("tap.packets");
+    s_m.dropped = metrics_counter("tap.dropped");
+    s_m.bytes = metrics_counter("tap.bytes");
+
+    if (xTaskCreate(audio_tap_task, "AudioTap", AUDIO_TAP_TASK_STACK, NULL,
+                    AUDIO_TAP_TASK_PRIO, &s_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create tap task");
+        return ESP_ERR_NO_MEM;
+    }
+    metrics_watch_task(s_task, "AudioTap");
+    return ESP_OK;
+}
+
+static void tap_unsubscribe_all(void)
+{
+    for (int i = 0; i < AUDIO_TAP_POINT_COUNT; i++) {
+        if (s_consumer_ids[i] >= 0) {
+            audio_frame_unsubscribe(s_consumer_ids[i]);
+            s_consumer_ids[i] = -1;
+        }
+    }
+}
+
+esp_err_t audio_tap_start(uint8_t point_mask, audio_tap_codec_t codec)
+{
+    point_mask &= AUDIO_TAP_MASK_ALL;
+    if (point_mask == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_active) {
+        ESP_LOGW(TAG, "Tap already running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t ret = tap_setup();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    s_codec_mode = codec;
+    s_adpcm = codec == AUDIO_TAP_CODEC_ADPCM;
+    s_backoff_until_us = 0;
+    s_window_start_us = esp_timer_get_time();
+    s_window_bytes = 0;
+    s_window_pcm_bytes = 0;
+    s_link_load = 0;
+    s_pcm_load = 0;
+    __atomic_store_n(&s_congested, false, __ATOMIC_RELAXED);
+    memset(s_points, 0, sizeof(s_points));
+
+    for (int i = 0; i < AUDIO_TAP_POINT_COUNT; i++) {
+        if ((point_mask & (1 << i)) == 0) {
+            continue;
+        }
+        ret = audio_frame_subscribe(s_point_streams[i], tap_frame_cb, &s_points[i], &s_consumer_ids[i]);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "No frame consumer slot for tap point %s", s_point_names[i]);
+            tap_unsubscribe_all();
+            return ret;
+        }
+    }
+    s_point_mask = point_mask;
+    __atomic_store_n(&s_active, true, __ATOMIC_RELEASE);
+
+    ESP_LOGI(TAG, "🔌 Audio tap on UART%d (GPIO%d, %d baud): %s%s%s, codec %s",
+             AUDIO_TAP_UART_NUM, AUDIO_TAP_TX_PIN, AUDIO_TAP_BAUD,
+             (point_mask & AUDIO_TAP_MASK_RAW) ? "raw " : "",
+             (point_mask & AUDIO_TAP_MASK_RX) ? "rx " : "",
+             (point_mask & AUDIO_TAP_MASK_TX) ? "tx " : "",
+             codec == AUDIO_TAP_CODEC_AUTO ? "auto" : (codec == AUDIO_TAP_CODEC_PCM ? "pcm" : "adpcm"));
+    return ESP_OK;
+}
+
+void audio_tap_stop(void)
+{
+    if (!s_active) {
+        return;
+    }
+    tap_unsubscribe_all();
+    __atomic_store_n(&s_active, false, __ATOMIC_RELEASE);
+
+    // Кадры из очереди возвращаются в пул без кодирования
+    audio_frame_t *frame = NULL;
+    while (xQueueReceive(s_queue, &frame, 0) == pdTRUE) {
+        if (frame != NULL) {
+            audio_frame_unref(frame);
+        }
+    }
+    // Метка за последним кадром: после ответа задача не кодирует и не трогает
+    // состояние точек, и audio_tap_start может его сбросить
+    xSemaphoreTake(s_idle_sem, 0);
+    frame = NULL;
+    if (xQueueSend(s_queue, &frame, pdMS_TO_TICKS(TAP_STOP_TIMEOUT_MS)) != pdTRUE ||
+        xSemaphoreTake(s_idle_sem, pdMS_TO_TICKS(TAP_STOP_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGW(TAG, "Tap task did not drain in %d ms", TAP_STOP_TIMEOUT_MS);
+    }
+    audio_tap_print_stats();
+}
+
+bool audio_tap_active(void)
+{
+    return s_active;
+}
+
+void audio_tap_print_stats(void)
+{
+    ESP_LOGI(TAG, "Tap %s, sending %s, link %" PRIu32 "%% of %d B/s (PCM would need %" PRIu32 "%%)",
+             s_active ? "on" : "off", s_adpcm ? "ADPCM" : "PCM",
+             s_link_load * 100 / TAP_LINK_BYTES_S, TAP_LINK_BYTES_S,
+             s_pcm_load * 100 / TAP_LINK_BYTES_S);
+    for (int i = 0; i < AUDIO_TAP_POINT_COUNT; i++) {
+        if ((s_point_mask & (1 << i)) == 0) {
+            continue;
+        }
+        const tap_point_state_t *pt = &s_points[i];
+        ESP_LOGI(TAG, "  %-3s: %" PRIu32 " packets, %" PRIu32 " bytes, %" PRIu32 " frames dropped",
+                 s_point_names[i], pt->packets, pt->bytes, __atomic_load_n(&pt->dropped, __ATOMIC_RELAXED));
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef AUDIO_TAP_H
+#define AUDIO_TAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_TAP_UART_NUM      1         // UART1: консоль и логи остаются на UART0
+#define AUDIO_TAP_TX_PIN        17
+#define AUDIO_TAP_BAUD          921600
+#define AUDIO_TAP_TX_BUF_SIZE   8192      // Кольцо драйвера UART (~90 мс на полной скорости)
+#define AUDIO_TAP_QUEUE_LEN     4         // Кадров в очереди задачи; столько ссылок отвод держит в пуле
+#define AUDIO_TAP_POOL_RESERVE  4         // Свободных кадров пула, которые отвод не занимает
+#define AUDIO_TAP_BACKOFF_MS    5000      // Минимум ADPCM после переполнения в режиме auto
+#define AUDIO_TAP_TASK_STACK    3072
+#define AUDIO_TAP_TASK_PRIO     2         // Как у записи: ниже BT и аудио
+
+/*
+ * Отвод сырого PCM в UART для анализа на компьютере (tools/audio_tap_rx.py).
+ *
+ * Отвод - потребитель пула кадров: в потоке аудио он только берет ссылку и
+ * кладет кадр в очередь без ожидания, кодирование и вывод идут в своей задаче.
+ * Если канал не успевает, кадры отбрасываются на входе очереди, а в режиме
+ * auto поток переходит с PCM на IMA-ADPCM (4:1). Тракт звука отвод не
+ * тормозит никогда.
+ *
+ * Пакет (little-endian), CRC-16/CCITT-FALSE по заголовку и данным:
+ *   magic u16 "AT", version u8, point u8, codec u8, flags u8 (бит 0 - речь),
+ *   samples u16, sample_rate u16, payload_len u16,
+ *   seq u32 (номер кадра в потоке), dropped u32 (отброшено кадров точки),
+ *   timestamp_us u32, payload, crc u16
+ * ADPCM payload: predictor i16, step_index u8, 0, коды по 4 бита (младший первым).
+ */
+
+#define AUDIO_TAP_MAGIC         0x5441
+#define AUDIO_TAP_VERSION       1
+#define AUDIO_TAP_HEADER_SIZE   24
+
+typedef enum {
+    AUDIO_TAP_POINT_RAW = 0,       // Захват до обработки
+    AUDIO_TAP_POINT_RX,            // Захват после DSP (АРУ и лимитер)
+    AUDIO_TAP_POINT_TX,            // Исходящий поток в гарнитуру
+    AUDIO_TAP_POINT_COUNT
+} audio_tap_point_t;
+
+#define AUDIO_TAP_MASK_RAW  (1 << AUDIO_TAP_POINT_RAW)
+#define AUDIO_TAP_MASK_RX   (1 << AUDIO_TAP_POINT_RX)
+#define AUDIO_TAP_MASK_TX   (1 << AUDIO_TAP_POINT_TX)
+#define AUDIO_TAP_MASK_ALL  (AUDIO_TAP_MASK_RAW | AUDIO_TAP_MASK_RX | AUDIO_TAP_MASK_TX)
+
+typedef enum {
+    AUDIO_TAP_CODEC_AUTO = 0,      // PCM, при нехватке канала ADPCM
+    AUDIO_TAP_CODEC_PCM,
+    AUDIO_TAP_CODEC_ADPCM,
+} audio_tap_codec_t;
+
+/**
+ * @brief Включение отвода; при первом вызове настраивает UART и задачу
+ * @param point_mask Точки тракта (AUDIO_TAP_MASK_*)
+ * @param codec Сжатие: auto, всегда PCM или всегда ADPCM
+ * @return ESP_OK, ESP_ERR_NO_MEM если заняты слоты потребителей пула
+ */
+esp_err_t audio_tap_start(uint8_t point_mask, audio_tap_codec_t codec);
+
+/**
+ * @brief Выключение отвода
+ *
+ * Кадры из очереди возвращаются в пул, функция ждет, пока задача отвода
+ * закончит текущий пакет: следующий audio_tap_start начинает с чистого
+ * состояния, и флаг START получают только кадры новой сессии.
+ */
+void audio_tap_stop(void);
+
+bool audio_tap_active(void);
+
+/**
+ * @brief Пакеты, отброшенные кадры и загрузка канала по точкам
+ */
+void audio_tap_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_TAP_H */
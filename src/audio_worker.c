@@ -0,0 +1,346 @@
+#include "audio_worker.h"
+#include "metrics.h"
+#include "trace.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <string.h>
+#include <inttypes.h>
+
+static const char *TAG = "AUDIO_WORKER";
+
+#define RING_MASK             (AUDIO_WORKER_RING_FRAMES - 1)
+#define WORKER_IDLE_WAIT_MS   50
+
+_Static_assert((AUDIO_WORKER_RING_FRAMES & RING_MASK) == 0, "ring size must be a power of two");
+_Static_assert(AUDIO_WORKER_TX_AHEAD < AUDIO_WORKER_RING_FRAMES, "TX ring must fit stale frames");
+
+typedef struct {
+    uint32_t gen;            // Сессия, для которой готовился кадр
+    uint32_t ready_us;       // Кадр попал в кольцо (младшие 32 бита esp_timer)
+    uint32_t count;
+    int16_t samples[AUDIO_WORKER_FRAME_MAX];
+} worker_frame_t;
+
+// Кольцо с одним производителем и одним потребителем: head пишет только
+// производитель, tail - только потребитель; слот публикуется release-записью индекса
+typedef struct {
+    worker_frame_t slots[AUDIO_WORKER_RING_FRAMES];
+    uint32_t head;
+    uint32_t tail;
+} frame_ring_t;
+
+// Гистограмма пишется одним потоком; сессия сменилась - писатель сам обнуляет ее.
+// Читают ее из других потоков (итог сессии), поэтому поля только атомарные:
+// снимок может разойтись с писателем на кадр, но не рвется
+typedef struct {
+    uint32_t gen;
+    uint32_t frames;
+    uint32_t buckets[AUDIO_WORKER_LAT_BUCKETS];
+} latency_hist_t;
+
+static frame_ring_t s_rx_ring;
+static frame_ring_t s_tx_ring;
+static latency_hist_t s_rx_lat;      // Пишет задача обработки
+static latency_hist_t s_tx_lat;      // Пишет TX callback
+static TaskHandle_t s_task = NULL;
+static audio_worker_rx_fn_t s_rx_fn = NULL;
+static audio_worker_tx_fn_t s_tx_fn = NULL;
+static uint32_t s_gen = 0;
+static uint32_t s_frame_samples = 60;
+static uint32_t s_served_gen = 0;    // Сессия, в которой TX уже выдал готовый кадр
+static audio_worker_job_fn_t s_job_fn = NULL;   // Задание для задачи; публикуется release после s_job_arg
+static void *s_job_arg = NULL;
+static SemaphoreHandle_t s_job_done = NULL;
+
+static struct {
+    metric_t *deadline_miss;
+    metric_t *rx_drops;
+    metric_t *block_us;
+    metric_t *rx_block_us;
+    metric_t *stale;
+} s_m;
+
+static inline worker_frame_t *ring_write_slot(frame_ring_t *r)
+{
+    uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    if (r->head - tail >= AUDIO_WORKER_RING_FRAMES) {
+        return NULL;
+    }
+    return &r->slots[r->head & RING_MASK];
+}
+
+static inline void ring_commit(frame_ring_t *r)
+{
+    __atomic_store_n(&r->head, r->head + 1, __ATOMIC_RELEASE);
+}
+
+static inline worker_frame_t *ring_read_slot(frame_ring_t *r)
+{
+    uint32_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    if (head == r->tail) {
+        return NULL;
+    }
+    return &r->slots[r->tail & RING_MASK];
+}
+
+static inline void ring_release(frame_ring_t *r)
+{
+    __atomic_store_n(&r->tail, r->tail + 1, __ATOMIC_RELEASE);
+}
+
+static void latency_add(latency_hist_t *h, uint32_t gen, uint32_t ready_us)
+{
+    if (__atomic_load_n(&h->gen, __ATOMIC_RELAXED) != gen) {
+        for (int i = 0; i < AUDIO_WORKER_LAT_BUCKETS; i++) {
+            __atomic_store_n(&h->buckets[i], 0, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&h->frames, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&h->gen, gen, __ATOMIC_RELAXED);
+    }
+    uint32_t ms = ((uint32_t)esp_timer_get_time() - ready_us) / 1000;
+    __atomic_fetch_add(&h->buckets[ms < AUDIO_WORKER_LAT_BUCKETS ? ms : AUDIO_WORKER_LAT_BUCKETS - 1], 1,
+                       __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->frames, 1, __ATOMIC_RELAXED);
+}
+
+static uint8_t latency_percentile(const latency_hist_t *h, uint32_t frames, uint32_t pct)
+{
+    uint32_t rank = (frames * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < AUDIO_WORKER_LAT_BUCKETS; i++) {
+        seen += __atomic_load_n(&h->buckets[i], __ATOMIC_RELAXED);
+        if (seen >= rank) {
+            return (uint8_t)i;
+        }
+    }
+    return AUDIO_WORKER_LAT_BUCKETS - 1;
+}
+
+static void latency_summary(const latency_hist_t *h, uint32_t gen, audio_worker_latency_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    uint32_t frames = __atomic_load_n(&h->frames, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&h->gen, __ATOMIC_RELAXED) != gen || frames == 0) {
+        return;
+    }
+    out->frames = frames;
+    out->p50_ms = latency_percentile(h, frames, 50);
+    out->p95_ms = latency_percentile(h, frames, 95);
+    out->p99_ms = latency_percentile(h, frames, 99);
+}
+
+// Готовые кадры текущей сессии в TX кольце (вызывается только производителем)
+static uint32_t tx_fresh_frames(uint32_t gen)
+{
+    uint32_t fresh = 0;
+    uint32_t tail = __atomic_load_n(&s_tx_ring.tail, __ATOMIC_ACQUIRE);
+    for (uint32_t i = tail; i != s_tx_ring.head; i++) {
+        if (s_tx_ring.slots[i & RING_MASK].gen == gen) {
+            fresh++;
+        }
+    }
+    return fresh;
+}
+
+static void audio_worker_task(void *arg)
+{
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WORKER_IDLE_WAIT_MS));
+
+        // Задание - между кадрами: с обработчиками кадров оно не пересекается
+        audio_worker_job_fn_t job = __atomic_exchange_n(&s_job_fn, NULL, __ATOMIC_ACQUIRE);
+        if (job != NULL) {
+            job(s_job_arg);
+            xSemaphoreGive(s_job_done);
+        }
+
+        // Сначала принятые кадры: детекторы и АРУ не отстают от TX
+        worker_frame_t *in;
+        while ((in = ring_read_slot(&s_rx_ring)) != NULL) {
+            latency_add(&s_rx_lat, __atomic_load_n(&s_gen, __ATOMIC_ACQUIRE), in->ready_us);
+            int64_t start = esp_timer_get_time();
+            s_rx_fn(in->samples, in->count);
+            ring_release(&s_rx_ring);
+            metrics_observe(s_m.rx_block_us, (uint32_t)(esp_timer_get_time() - start));
+        }
+
+        uint32_t gen = __atomic_load_n(&s_gen, __ATOMIC_ACQUIRE);
+        uint32_t count = __atomic_load_n(&s_frame_samples, __ATOMIC_RELAXED);
+        while (tx_fresh_frames(gen) < AUDIO_WORKER_TX_AHEAD) {
+            worker_frame_t *out = ring_write_slot(&s_tx_ring);
+            if (out == NULL) {
+                break;
+            }
+            int64_t start = esp_timer_get_time();
+            out->gen = gen;
+            out->count = count;
+            s_tx_fn(out->samples, count);
+            out->ready_us = (uint32_t)esp_timer_get_time();
+            ring_commit(&s_tx_ring);
+            metrics_observe(s_m.block_us, (uint32_t)(esp_timer_get_time() - start));
+        }
+    }
+}
+
+esp_err_t audio_worker_init(audio_worker_rx_fn_t rx, audio_worker_tx_fn_t tx)
+{
+    if (rx == NULL || tx == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_rx_fn = rx;
+    s_tx_fn = tx;
+    memset(&s_rx_ring, 0, sizeof(s_rx_ring));
+    memset(&s_tx_ring, 0, sizeof(s_tx_ring));
+
+    s_m.deadline_miss = metrics_counter("audio.deadline_miss");
+    s_m.rx_drops = metrics_counter("audio.rx_drops");
+    s_m.stale = metrics_counter("audio.stale_frames");
+    s_m.block_us = metrics_histogram("audio.block", "us");
+    s_m.rx_block_us = metrics_histogram("audio.rx_block", "us");
+
+    s_job_done = xSemaphoreCreateBinary();
+    if (s_job_done == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreatePinnedToCore(audio_worker_task, "AudioWorker", AUDIO_WORKER_TASK_STACK, NULL,
+                                AUDIO_WORKER_TASK_PRIO, &s_task, AUDIO_WORKER_TASK_CORE) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create audio worker task");
+        s_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    metrics_watch_task(s_task, "AudioWorker");
+
+    ESP_LOGI(TAG, "Audio worker on core %d, %d frames ahead", AUDIO_WORKER_TASK_CORE, AUDIO_WORKER_TX_AHEAD);
+    return ESP_OK;
+}
+
+bool audio_worker_running(void)
+{
+    return s_task != NULL;
+}
+
+void audio_worker_start_session(uint32_t frame_samples)
+{
+    if (frame_samples > AUDIO_WORKER_FRAME_MAX) {
+        frame_samples = AUDIO_WORKER_FRAME_MAX;
+    }
+    __atomic_store_n(&s_frame_samples, frame_samples, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&s_gen, 1, __ATOMIC_RELEASE);
+    if (s_task != NULL) {
+        xTaskNotifyGive(s_task);
+    }
+}
+
+bool audio_worker_push_rx(const int16_t *samples, uint32_t count)
+{
+    bool pushed = true;
+    // Буфер длиннее кадра кольца занимает несколько слотов, хвост не обрезается
+    for (uint32_t pos = 0; pos < count; pos += AUDIO_WORKER_FRAME_MAX) {
+        worker_frame_t *slot = ring_write_slot(&s_rx_ring);
+        if (slot == NULL) {
+            metrics_inc(s_m.rx_drops);
+            pushed = false;
+            break;
+        }
+        uint32_t n = count - pos < AUDIO_WORKER_FRAME_MAX ? count - pos : AUDIO_WORKER_FRAME_MAX;
+        memcpy(slot->samples, samples + pos, n * sizeof(int16_t));
+        slot->count = n;
+        slot->ready_us = (uint32_t)esp_timer_get_time();
+        ring_commit(&s_rx_ring);
+    }
+    xTaskNotifyGive(s_task);
+    return pushed;
+}
+
+// Один кадр кольца (count <= AUDIO_WORKER_FRAME_MAX) или тишина
+static bool tx_pop_frame(int16_t *samples, uint32_t count, uint32_t gen)
+{
+    worker_frame_t *slot;
+    bool served = false;
+
+    // Кадры прошлой сессии (другой кодек или гарнитура) отбрасываются
+    while ((slot = ring_read_slot(&s_tx_ring)) != NULL && slot->gen != gen) {
+        ring_release(&s_tx_ring);
+        metrics_inc(s_m.stale);
+    }
+
+    if (slot != NULL) {
+        uint32_t n = slot->count < count ? slot->count : count;
+        memcpy(samples, slot->samples, n * sizeof(int16_t));
+        if (n < count) {
+            memset(samples + n, 0, (count - n) * sizeof(int16_t));
+        }
+        latency_add(&s_tx_lat, gen, slot->ready_us);
+        ring_release(&s_tx_ring);
+        s_served_gen = gen;
+        served = true;
+    } else {
+        memset(samples, 0, count * sizeof(int16_t));
+        // Первый кадр сессии может опередить задачу - это не пропуск дедлайна
+        if (s_served_gen == gen) {
+            metrics_inc(s_m.deadline_miss);
+            trace_instant(TRACE_TRACK_AUDIO, "deadline_miss", count);
+        }
+    }
+    return served;
+}
+
+bool audio_worker_pop_tx(int16_t *samples, uint32_t count)
+{
+    uint32_t gen = __atomic_load_n(&s_gen, __ATOMIC_ACQUIRE);
+    bool served = count > 0;
+
+    // Буфер длиннее кадра кольца собирается из нескольких кадров
+    for (uint32_t pos = 0; pos < count; pos += AUDIO_WORKER_FRAME_MAX) {
+        uint32_t n = count - pos < AUDIO_WORKER_FRAME_MAX ? count - pos : AUDIO_WORKER_FRAME_MAX;
+        if (!tx_pop_frame(samples + pos, n, gen)) {
+            served = false;
+        }
+    }
+
+    // Стек задает размер кадра; следующие кадры готовятся под него
+    uint32_t frame = count < AUDIO_WORKER_FRAME_MAX ? count : AUDIO_WORKER_FRAME_MAX;
+    if (frame != __atomic_load_n(&s_frame_samples, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&s_frame_samples, frame, __ATOMIC_RELAXED);
+    }
+    xTaskNotifyGive(s_task);
+    return served;
+}
+
+esp_err_t audio_worker_run(audio_worker_job_fn_t fn, void *arg, uint32_t timeout_ms)
+{
+    if (s_task == NULL) {
+        fn(arg);
+        return ESP_OK;
+    }
+    s_job_arg = arg;
+    __atomic_store_n(&s_job_fn, fn, __ATOMIC_RELEASE);
+    xTaskNotifyGive(s_task);
+    if (xSemaphoreTake(s_job_done, pdMS_TO_TICKS(timeout_ms)) == pdTRUE) {
+        return ESP_OK;
+    }
+
+    // Задача не взяла задание - отзываем его; уже выполняет - дожидаемся
+    audio_worker_job_fn_t expected = fn;
+    if (__atomic_compare_exchange_n(&s_job_fn, &expected, NULL, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        ESP_LOGW(TAG, "Audio worker did not take a job in %" PRIu32 " ms", timeout_ms);
+        return ESP_ERR_TIMEOUT;
+    }
+    xSemaphoreTake(s_job_done, portMAX_DELAY);
+    return ESP_OK;
+}
+
+void audio_worker_get_latency(audio_worker_latency_t *tx, audio_worker_latency_t *rx)
+{
+    uint32_t gen = __atomic_load_n(&s_gen, __ATOMIC_ACQUIRE);
+    if (tx != NULL) {
+        latency_summary(&s_tx_lat, gen, tx);
+    }
+    if (rx != NULL) {
+        latency_summary(&s_rx_lat, gen, rx);
+    }
+}
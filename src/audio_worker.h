@@ -0,0 +1,99 @@
+#ifndef AUDIO_WORKER_H
+#define AUDIO_WORKER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_WORKER_FRAME_MAX     240    // Сэмплов в кадре: 15 мс при 16 кГц с запасом
+#define AUDIO_WORKER_RING_FRAMES   4      // Кадров в каждом кольце (степень двойки)
+#define AUDIO_WORKER_TX_AHEAD      2      // Сколько кадров TX готовится заранее
+#define AUDIO_WORKER_TASK_STACK    4096
+#define AUDIO_WORKER_TASK_PRIO     18     // Выше задач приложения, ниже задач стека BT
+#define AUDIO_WORKER_TASK_CORE     1      // Контроллер BT и Bluedroid - на ядре 0
+#define AUDIO_WORKER_LAT_BUCKETS   64     // Гистограмма времени кадра в кольце: 1 мс на корзину
+
+/*
+ * Обработка звука вынесена из HCI callbacks в отдельную задачу на ядре 1.
+ * Callbacks только копируют кадр в/из кольца (один производитель, один
+ * потребитель, без блокировок) и будят задачу; обработка, микширование
+ * и запись выполняются задачей. TX готовится на AUDIO_WORKER_TX_AHEAD
+ * кадров вперед: это добавляет задержку, но callback никогда не ждет DSP.
+ */
+
+// Время кадра в кольце за сессию: RX - от приема до обработки, TX - от готовности до выдачи стеку
+typedef struct {
+    uint32_t frames;
+    uint8_t p50_ms;                 // Процентили с точностью до корзины (1 мс)
+    uint8_t p95_ms;
+    uint8_t p99_ms;
+} audio_worker_latency_t;
+
+// Обработка принятого кадра (микрофон гарнитуры)
+typedef void (*audio_worker_rx_fn_t)(const int16_t *samples, uint32_t count);
+// Формирование исходящего кадра (динамик гарнитуры)
+typedef void (*audio_worker_tx_fn_t)(int16_t *samples, uint32_t count);
+// Задание в потоке задачи обработки
+typedef void (*audio_worker_job_fn_t)(void *arg);
+
+/**
+ * @brief Создание задачи обработки
+ * @param rx Обработчик принятых кадров
+ * @param tx Формирователь исходящих кадров
+ * @return ESP_OK при успехе
+ */
+esp_err_t audio_worker_init(audio_worker_rx_fn_t rx, audio_worker_tx_fn_t tx);
+
+/**
+ * @brief Новая аудио сессия: старые кадры отбрасываются, TX готовится заново
+ * @param frame_samples Сэмплов в кадре SCO (60 для CVSD, 120 для mSBC)
+ */
+void audio_worker_start_session(uint32_t frame_samples);
+
+/**
+ * @brief Передача принятого кадра задаче (из HCI callback)
+ *
+ * Буфер длиннее AUDIO_WORKER_FRAME_MAX раскладывается на несколько кадров.
+ * @return false если кольцо заполнено и кадр (или его хвост) отброшен
+ */
+bool audio_worker_push_rx(const int16_t *samples, uint32_t count);
+
+/**
+ * @brief Выдача готового исходящего кадра (из HCI callback)
+ *
+ * Если кадр не готов, выдается тишина и считается пропуск дедлайна.
+ * Буфер длиннее AUDIO_WORKER_FRAME_MAX собирается из нескольких кадров.
+ * @return true если выдан готовый кадр
+ */
+bool audio_worker_pop_tx(int16_t *samples, uint32_t count);
+
+/**
+ * @brief Выполнение задания в потоке задачи обработки с ожиданием конца
+ *
+ * Задание выполняется между кадрами, поэтому не пересекается с обработчиками
+ * rx/tx и может менять их состояние без блокировок. Без задачи выполняется
+ * сразу в вызывающем потоке. Вызывается из одного потока (обработчик событий).
+ * @param timeout_ms Сколько ждать, пока задача возьмет задание
+ * @return ESP_OK или ESP_ERR_TIMEOUT, если задача его так и не взяла (задание отозвано)
+ */
+esp_err_t audio_worker_run(audio_worker_job_fn_t fn, void *arg, uint32_t timeout_ms);
+
+/**
+ * @brief Задержка в кольцах с начала текущей сессии (без задачи обработки - нули)
+ */
+void audio_worker_get_latency(audio_worker_latency_t *tx, audio_worker_latency_t *rx);
+
+/**
+ * @brief Запущена ли задача (иначе обработка остается в callbacks)
+ */
+bool audio_worker_running(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_WORKER_H */
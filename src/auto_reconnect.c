@@ -1,6 +1,9 @@
 #include "auto_reconnect.h"
 #include "paired_devices.h"
 #include "gap_handler.h"
+#include "conn_state.h"
+#include "metrics.h"
+#include "trace.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_hf_ag_api.h"
@@ -8,10 +11,12 @@
 
 static const char* TAG = "AUTO_RECONNECT";
 
+_Static_assert(AUTO_RECONNECT_MAX_ATTEMPTS == CONN_MAX_ATTEMPTS, "attempt limits must match");
+
 static esp_timer_handle_t reconnect_timer = NULL;
-static auto_reconnect_state_t current_state = AUTO_RECONNECT_STATE_IDLE;
-static int reconnect_attempts = 0;
 static esp_bd_addr_t last_connected_device = {0};
+static metric_t *s_m_attempts = NULL;
+static metric_t *s_m_failures = NULL;
 
 // Внутренние функции
 static void auto_reconnect_timer_callback(void* arg);
@@ -21,6 +26,9 @@ static void auto_reconnect_stop_timer(void);
 esp_err_t auto_reconnect_init(void) {
     ESP_LOGI(TAG, "Initializing auto-reconnect module");
     
+    s_m_attempts = metrics_counter("reconnect.attempts");
+    s_m_failures = metrics_counter("reconnect.failures");
+
     // Создаем таймер для автоматического переподключения
     const esp_timer_create_args_t timer_args = {
         .callback = auto_reconnect_timer_callback,
@@ -33,22 +41,22 @@ esp_err_t auto_reconnect_init(void) {
         return ret;
     }
     
-    current_state = AUTO_RECONNECT_STATE_IDLE;
-    reconnect_attempts = 0;
+    // Состояние и счетчик попыток живут в общем атомарном слове conn_state
+    conn_state_dispatch(CONN_EVT_STOP, NULL, NULL);
     
     ESP_LOGI(TAG, "Auto-reconnect module initialized successfully");
     return ESP_OK;
 }
 
 void auto_reconnect_start(void) {
-    if (current_state != AUTO_RECONNECT_STATE_IDLE) {
-        ESP_LOGW(TAG, "Auto-reconnect already in progress, state: %d", current_state);
+    uint32_t old_word;
+    if (!conn_state_dispatch(CONN_EVT_START, &old_word, NULL)) {
+        ESP_LOGW(TAG, "Auto-reconnect already in progress, state: %s",
+                 conn_state_name(CONN_WORD_STATE(old_word)));
         return;
     }
     
     ESP_LOGI(TAG, "Starting auto-reconnect process");
-    current_state = AUTO_RECONNECT_STATE_SEARCHING;
-    reconnect_attempts = 0;
     
     // Получаем последнее подключенное устройство
     if (paired_devices_get_last_connected(last_connected_device) == ESP_OK) {
@@ -56,15 +64,14 @@ void auto_reconnect_start(void) {
         auto_reconnect_start_timer();
     } else {
         ESP_LOGI(TAG, "No last connected device found");
-        current_state = AUTO_RECONNECT_STATE_IDLE;
+        conn_state_dispatch(CONN_EVT_STOP, NULL, NULL);
     }
 }
 
 void auto_reconnect_stop(void) {
     ESP_LOGI(TAG, "Stopping auto-reconnect process");
     auto_reconnect_stop_timer();
-    current_state = AUTO_RECONNECT_STATE_IDLE;
-    reconnect_attempts = 0;
+    conn_state_dispatch(CONN_EVT_STOP, NULL, NULL);
 }
 
 void auto_reconnect_notify_connection_state(bool connected) {
@@ -73,11 +80,10 @@ void auto_reconnect_notify_connection_state(bool connected) {
     if (connected) {
         // Подключение установлено
         auto_reconnect_stop_timer();
-        current_state = AUTO_RECONNECT_STATE_CONNECTED;
-        reconnect_attempts = 0;
-    } else {
-        // Подключение потеряно
-        current_state = AUTO_RECONNECT_STATE_IDLE;
+        conn_state_dispatch(CONN_EVT_CONNECTED, NULL, NULL);
+    } else if (!auto_reconnect_notify_connection_failed()) {
+        // Подключение потеряно (разрыв во время page засчитан выше как неудачная попытка)
+        conn_state_dispatch(CONN_EVT_DISCONNECTED, NULL, NULL);
         
         // Запускаем переподключение через некоторое время
         auto_reconnect_start_timer();
@@ -85,38 +91,41 @@ void auto_reconnect_notify_connection_state(bool connected) {
 }
 
 void auto_reconnect_notify_discovery_complete(void) {
-    if (current_state != AUTO_RECONNECT_STATE_SEARCHING) {
+    if (!conn_state_dispatch(CONN_EVT_DISCOVERY_DONE, NULL, NULL)) {
         return;
     }
     
     ESP_LOGI(TAG, "Discovery complete, trying to connect to last device");
-    current_state = AUTO_RECONNECT_STATE_CONNECTING;
+    metrics_inc(s_m_attempts);
     
     // Пытаемся подключиться к последнему устройству
+    trace_begin(TRACE_TRACK_PAGE, "page");
     esp_err_t ret = esp_hf_ag_slc_connect(last_connected_device);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to connect to device: %s", esp_err_to_name(ret));
-        current_state = AUTO_RECONNECT_STATE_FAILED;
-        auto_reconnect_start_timer(); // Попробуем снова
+        auto_reconnect_notify_connection_failed();
     }
 }
 
-void auto_reconnect_notify_connection_failed(void) {
-    if (current_state != AUTO_RECONNECT_STATE_CONNECTING) {
-        return;
+bool auto_reconnect_notify_connection_failed(void) {
+    // Счет попыток и переход в FAILED делает таблица переходов одним CAS
+    uint32_t old_word, new_word;
+    if (!conn_state_dispatch(CONN_EVT_PAGE_FAILED, &old_word, &new_word)) {
+        return false;
     }
     
-    ESP_LOGW(TAG, "Connection failed, attempt %d/%d", reconnect_attempts + 1, AUTO_RECONNECT_MAX_ATTEMPTS);
+    metrics_inc(s_m_failures);
+    trace_end(TRACE_TRACK_PAGE, "page");
+    trace_instant(TRACE_TRACK_RECONNECT, "page_failed", CONN_WORD_ATTEMPTS(new_word));
+    ESP_LOGW(TAG, "Connection failed, attempt %lu/%d",
+             (unsigned long)CONN_WORD_ATTEMPTS(old_word) + 1, AUTO_RECONNECT_MAX_ATTEMPTS);
     
-    reconnect_attempts++;
-    if (reconnect_attempts < AUTO_RECONNECT_MAX_ATTEMPTS) {
-        current_state = AUTO_RECONNECT_STATE_IDLE;
+    if (CONN_WORD_STATE(new_word) == CONN_STATE_IDLE) {
         auto_reconnect_start_timer();
     } else {
         ESP_LOGE(TAG, "Max reconnection attempts reached, giving up");
-        current_state = AUTO_RECONNECT_STATE_FAILED;
-        reconnect_attempts = 0;
     }
+    return true;
 }
 
 void auto_reconnect_notify_device_found(const esp_bd_addr_t bd_addr, const char* name, uint32_t cod) {
@@ -125,23 +134,31 @@ void auto_reconnect_notify_device_found(const esp_bd_addr_t bd_addr, const char*
 }
 
 auto_reconnect_state_t auto_reconnect_get_state(void) {
-    return current_state;
+    // Порядок состояний conn_state совпадает с auto_reconnect_state_t
+    return (auto_reconnect_state_t)conn_state_get();
 }
 
 bool auto_reconnect_is_active(void) {
-    return (current_state != AUTO_RECONNECT_STATE_IDLE && current_state != AUTO_RECONNECT_STATE_CONNECTED);
+    conn_state_t state = conn_state_get();
+    return (state != CONN_STATE_IDLE && state != CONN_STATE_CONNECTED);
 }
 
 static void auto_reconnect_timer_callback(void* arg) {
-    ESP_LOGI(TAG, "Auto-reconnect timer fired, state: %d", current_state);
+    uint32_t old_word, new_word;
+    bool applied = conn_state_dispatch(CONN_EVT_TIMER, &old_word, &new_word);
+    trace_instant(TRACE_TRACK_RECONNECT, "timer", CONN_WORD_STATE(old_word));
+    if (!applied) {
+        ESP_LOGI(TAG, "Auto-reconnect timer fired, state: %s", conn_state_name(CONN_WORD_STATE(old_word)));
+        return;
+    }
+    ESP_LOGI(TAG, "Auto-reconnect timer fired, state: %s -> %s",
+             conn_state_name(CONN_WORD_STATE(old_word)), conn_state_name(CONN_WORD_STATE(new_word)));
     
-    if (current_state == AUTO_RECONNECT_STATE_IDLE) {
+    if (CONN_WORD_STATE(new_word) == CONN_STATE_SEARCHING) {
         // Начинаем поиск устройств
-        current_state = AUTO_RECONNECT_STATE_SEARCHING;
         gap_start_discovery();
-    } else if (current_state == AUTO_RECONNECT_STATE_FAILED) {
-        // Попробуем снова
-        current_state = AUTO_RECONNECT_STATE_IDLE;
+    } else {
+        // FAILED -> IDLE: попробуем снова
         auto_reconnect_start_timer();
     }
 }
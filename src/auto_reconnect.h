@@ -50,9 +50,10 @@ void auto_reconnect_notify_connection_state(bool connected);
 void auto_reconnect_notify_discovery_complete(void);
 
 /**
- * @brief Уведомление о неудачном подключении
+ * @brief Уведомление о неудачном подключении (ошибка slc_connect или разрыв во время page)
+ * @return true если попытка засчитана, false если переподключение не было в CONNECTING
  */
-void auto_reconnect_notify_connection_failed(void);
+bool auto_reconnect_notify_connection_failed(void);
 
 /**
  * @brief Уведомление о найденном устройстве
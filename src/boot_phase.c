@@ -0,0 +1,113 @@
+#include "boot_phase.h"
+#include "trace.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include <string.h>
+
+static const char *TAG = "BOOT";
+
+typedef struct {
+    const char *name;
+    char task[12];           // Копия: задача загрузки к моменту отчета уже удалена
+    int64_t at_us;
+    bool milestone;
+} boot_mark_t;
+
+static boot_mark_t s_marks[BOOT_PHASE_MAX];
+static int s_mark_count = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static EventGroupHandle_t s_ready = NULL;
+
+void boot_phase_init(void)
+{
+    if (s_ready == NULL) {
+        s_ready = xEventGroupCreate();
+    }
+    boot_phase_mark("start");
+}
+
+static bool boot_phase_add(const char *name, bool milestone)
+{
+    int64_t now = esp_timer_get_time();
+    const char *task = pcTaskGetName(NULL);
+    bool added = false;
+
+    portENTER_CRITICAL(&s_lock);
+    if (milestone) {
+        for (int i = 0; i < s_mark_count; i++) {
+            if (s_marks[i].milestone && strcmp(s_marks[i].name, name) == 0) {
+                portEXIT_CRITICAL(&s_lock);
+                return false;
+            }
+        }
+    }
+    if (s_mark_count < BOOT_PHASE_MAX) {
+        s_marks[s_mark_count].name = name;
+        strncpy(s_marks[s_mark_count].task, task ? task : "?", sizeof(s_marks[0].task) - 1);
+        s_marks[s_mark_count].at_us = now;
+        s_marks[s_mark_count].milestone = milestone;
+        s_mark_count++;
+        added = true;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (added) {
+        trace_instant(TRACE_TRACK_APP, name, (uint32_t)(now / 1000));
+        if (milestone) {
+            ESP_LOGI(TAG, "⏱️ %s at %lld ms after boot", name, (long long)(now / 1000));
+        }
+    }
+    return added;
+}
+
+void boot_phase_mark(const char *name)
+{
+    boot_phase_add(name, false);
+}
+
+bool boot_phase_milestone(const char *name)
+{
+    return boot_phase_add(name, true);
+}
+
+void boot_phase_set_ready(uint32_t bits)
+{
+    if (s_ready != NULL) {
+        xEventGroupSetBits(s_ready, bits);
+    }
+}
+
+esp_err_t boot_phase_wait_ready(uint32_t bits, uint32_t timeout_ms)
+{
+    if (s_ready == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    EventBits_t got = xEventGroupWaitBits(s_ready, bits, pdFALSE, pdTRUE, pdMS_TO_TICKS(timeout_ms));
+    return (got & bits) == bits ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+void boot_phase_report(void)
+{
+    ESP_LOGI(TAG, "=== Boot phases (ms since esp_timer start) ===");
+    for (int i = 0; i < s_mark_count; i++) {
+        const boot_mark_t *m = &s_marks[i];
+
+        // Длительность фазы - от предыдущей отметки той же задачи (первой - от "start")
+        int64_t prev_us = s_marks[0].at_us;
+        for (int j = i - 1; j >= 0; j--) {
+            if (!s_marks[j].milestone && strcmp(s_marks[j].task, m->task) == 0) {
+                prev_us = s_marks[j].at_us;
+                break;
+            }
+        }
+        if (m->milestone) {
+            ESP_LOGI(TAG, "  %7lld  * %s", (long long)(m->at_us / 1000), m->name);
+        } else {
+            ESP_LOGI(TAG, "  %7lld  %-12s %-20s +%lld ms", (long long)(m->at_us / 1000),
+                     m->task, m->name, (long long)((m->at_us - prev_us) / 1000));
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef BOOT_PHASE_H
+#define BOOT_PHASE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_PHASE_MAX            20
+#define BOOT_READY_TIMEOUT_MS     3000   // Запас на случай, если событие готовности не пришло
+
+// Биты готовности загрузки
+#define BOOT_READY_DEVICES   0x01   // Таблица сопряженных устройств загружена, аудио тракт собран
+#define BOOT_READY_STACK     0x02   // Контроллер ответил на первую HCI команду (EIR настроен)
+
+/**
+ * @brief Создание группы событий готовности; вызывается первым в bt_app_init
+ */
+void boot_phase_init(void);
+
+/**
+ * @brief Отметка завершения фазы загрузки (время от старта esp_timer, почти от включения)
+ * @param name Имя фазы (строковый литерал)
+ */
+void boot_phase_mark(const char *name);
+
+/**
+ * @brief Отметка ключевого момента, только первый вызов для данного имени
+ * @param name "connectable", "headset_connected"
+ * @return true если отметка сделана сейчас (первый раз)
+ */
+bool boot_phase_milestone(const char *name);
+
+/**
+ * @brief Установка битов готовности BOOT_READY_*
+ */
+void boot_phase_set_ready(uint32_t bits);
+
+/**
+ * @brief Ожидание битов готовности
+ * @param bits Биты BOOT_READY_*
+ * @param timeout_ms Таймаут
+ * @return ESP_OK, ESP_ERR_TIMEOUT если не дождались
+ */
+esp_err_t boot_phase_wait_ready(uint32_t bits, uint32_t timeout_ms);
+
+/**
+ * @brief Отчет о фазах загрузки в лог
+ */
+void boot_phase_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOT_PHASE_H */
@@ -1,9 +1,17 @@
 #include "bt_app.h"
 #include "gap_handler.h"
+#include "disc_cache.h"
+#include "target_policy.h"
+#include "radio_sched.h"
 #include "hf_handler.h"
+#include "hf_conn.h"
 #include "audio_handler.h"
 #include "paired_devices.h"
 #include "auto_reconnect.h"
+#include "conn_state.h"
+#include "metrics.h"
+#include "trace.h"
+#include "boot_phase.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
 #include "esp_bt.h"
@@ -16,9 +24,43 @@
 
 static const char *TAG = "BT_APP";
 
+#define BOOT_LOAD_TASK_STACK  4096
+#define BOOT_LOAD_TASK_PRIO   3
+#define BOOT_LOAD_TASK_CORE   1      // Контроллер и Bluedroid работают на ядре 0
+
+// Работа, не зависящая от стека Bluetooth: идет параллельно с запуском контроллера
+static void boot_load(void)
+{
+    esp_err_t ret = paired_devices_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize paired devices: %s", esp_err_to_name(ret));
+    } else {
+        ESP_LOGI(TAG, "✅ Paired devices module initialized");
+        paired_devices_print_list();
+    }
+    boot_phase_mark("paired_devices");
+
+    audio_handler_init();
+    boot_phase_mark("audio_pipeline");
+
+    boot_phase_set_ready(BOOT_READY_DEVICES);
+}
+
+static void boot_load_task(void *arg)
+{
+    boot_load();
+    vTaskDelete(NULL);
+}
+
 void bt_app_init(void) {
     ESP_LOGI(TAG, "Initializing Bluetooth stack...");
 
+    // Трасса пишется с загрузки: первое подключение видно целиком
+    trace_start();
+    boot_phase_init();
+    // Реестр метрик до модулей: они регистрируют свои счетчики в init
+    metrics_init();
+
     // NVS init - в соответствии с официальным примером
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -26,6 +68,14 @@ void bt_app_init(void) {
         ESP_ERROR_CHECK(nvs_flash_init());
     }
     ESP_LOGI(TAG, "NVS initialized successfully");
+    boot_phase_mark("nvs");
+
+    // Таблица устройств и аудио тракт собираются, пока поднимается контроллер
+    if (xTaskCreatePinnedToCore(boot_load_task, "BootLoad", BOOT_LOAD_TASK_STACK, NULL,
+                                BOOT_LOAD_TASK_PRIO, NULL, BOOT_LOAD_TASK_CORE) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start boot loader task, loading inline");
+        boot_load();
+    }
 
     // Release memory for BLE if not used - как в официальном примере
     ret = esp_bt_controller_mem_release(ESP_BT_MODE_BLE);
@@ -54,6 +104,7 @@ void bt_app_init(void) {
         return;
     }
     ESP_LOGI(TAG, "Bluetooth controller enabled successfully");
+    boot_phase_mark("controller");
 
     // Initialize bluedroid - как в официальном примере
     esp_bluedroid_config_t bluedroid_cfg = BT_BLUEDROID_INIT_CONFIG_DEFAULT();
@@ -66,29 +117,39 @@ void bt_app_init(void) {
         ESP_LOGE(TAG, "%s enable bluedroid failed: %s", __func__, esp_err_to_name(ret));
         return;
     }
+    boot_phase_mark("bluedroid");
 
     // Set device name - как в официальном примере  
     ESP_ERROR_CHECK(esp_bt_gap_set_device_name("ESP32-HF-AG"));
 
+    // Общее слово состояния читают GAP, HF и аудио callbacks - сбрасываем до их регистрации
+    conn_state_init();
+
+    // Кэш результатов поиска заполняется из GAP callback
+    disc_cache_init();
+    target_policy_init();
+
     // Register GAP callback first
     ESP_ERROR_CHECK(esp_bt_gap_register_callback(gap_callback));
 
+    // Таблица HF соединений должна быть готова до первого события HF AG
+    hf_conn_init();
+
     // Register HF AG callback - как в официальном примере
     ESP_ERROR_CHECK(esp_hf_ag_register_callback(hf_ag_event_handler));
 
     // Initialize HF AG - как в официальном примере
     ESP_ERROR_CHECK(esp_hf_ag_init());
+    boot_phase_mark("hf_ag");
 
-    // Initialize audio handler for HCI data path
-    audio_handler_init();
-
-    // Initialize paired devices module
-    ret = paired_devices_init();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize paired devices: %s", esp_err_to_name(ret));
-        return;
+    // До включения page scan таблица устройств и аудио тракт должны быть готовы
+    if (boot_phase_wait_ready(BOOT_READY_DEVICES, BOOT_READY_TIMEOUT_MS) != ESP_OK) {
+        ESP_LOGW(TAG, "Boot loader is late, continuing");
     }
-    ESP_LOGI(TAG, "✅ Paired devices module initialized");
+    boot_phase_mark("loader_joined");
+
+    // HCI data path - после esp_hf_ag_init
+    audio_handler_attach();
 
     // Initialize auto-reconnect module
     ret = auto_reconnect_init();
@@ -98,9 +159,6 @@ void bt_app_init(void) {
     }
     ESP_LOGI(TAG, "✅ Auto-reconnect module initialized");
 
-    // Print list of paired devices
-    paired_devices_print_list();
-
     // Configure security - как в официальном примере
     esp_bt_pin_type_t pin_type = ESP_BT_PIN_TYPE_VARIABLE;
     esp_bt_pin_code_t pin_code;
@@ -110,8 +168,23 @@ void bt_app_init(void) {
     pin_code[3] = '0';
     ESP_ERROR_CHECK(esp_bt_gap_set_pin(pin_type, 4, pin_code));
 
-    // Set discoverable and connectable mode - как в официальном примере
-    ESP_ERROR_CHECK(esp_bt_gap_set_scan_mode(ESP_BT_CONNECTABLE, ESP_BT_GENERAL_DISCOVERABLE));
+    // Режим page/inquiry scan выбирает планировщик: видимость только без bonding
+    ESP_ERROR_CHECK(radio_sched_init());
+
+    // Ответ контроллера на настройку EIR (ESP_BT_GAP_CONFIG_EIR_DATA_EVT) - признак
+    // готовности стека вместо фиксированной паузы перед переподключением
+    esp_bt_eir_data_t eir = {
+        .fec_required = false,
+        .include_txpower = true,
+        .include_uuid = true,
+        .flag = ESP_BT_EIR_FLAG_GEN_DISC,
+    };
+    ret = esp_bt_gap_config_eir_data(&eir);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to configure EIR: %s", esp_err_to_name(ret));
+        boot_phase_set_ready(BOOT_READY_STACK);
+    }
+    boot_phase_mark("bt_app_init");
 
     ESP_LOGI(TAG, "✅ Bluetooth stack initialized successfully");
 }
@@ -11,6 +11,8 @@
 #include "freertos/queue.h"
 #include "esp_log.h"
 #include "bt_app_core.h"
+#include "metrics.h"
+#include "trace.h"
 
 static const char BT_APP_CORE_TAG[] = "BT_APP_CORE";
 
@@ -22,11 +24,13 @@ typedef struct {
 } bt_app_msg_internal_t;
 
 static void bt_app_task_handler(void *arg);
-static bool bt_app_send_msg(bt_app_msg_internal_t *msg);
+static bool bt_app_send_msg(bt_app_msg_internal_t *msg, TickType_t wait);
 static void bt_app_work_dispatched(bt_app_msg_internal_t *msg);
 
 static QueueHandle_t s_bt_app_task_queue = NULL;
 static TaskHandle_t s_bt_app_task_handle = NULL;
+static metric_t *s_m_drops = NULL;
+static metric_t *s_m_depth = NULL;
 
 bool bt_app_work_dispatch(bt_app_cb_t p_cback, uint16_t event, void *p_params, int param_len, bt_app_copy_cb_t p_copy_cback)
 {
@@ -38,9 +42,10 @@ bool bt_app_work_dispatch(bt_app_cb_t p_cback, uint16_t event, void *p_params, i
     msg.sig = BT_APP_SIG_WORK_DISPATCH;
     msg.event = event;
     msg.cb = p_cback;
+    trace_instant(TRACE_TRACK_APP, "dispatch", event);
 
     if (param_len == 0) {
-        return bt_app_send_msg(&msg);
+        return bt_app_send_msg(&msg, 10 / portTICK_PERIOD_MS);
     } else if (p_params && param_len > 0) {
         if ((msg.param = malloc(param_len)) != NULL) {
             memcpy(msg.param, p_params, param_len);
@@ -53,30 +58,55 @@ bool bt_app_work_dispatch(bt_app_cb_t p_cback, uint16_t event, void *p_params, i
                 copy_msg.param = msg.param;
                 p_copy_cback(&copy_msg, p_params, &param_len);
             }
-            return bt_app_send_msg(&msg);
+            return bt_app_send_msg(&msg, 10 / portTICK_PERIOD_MS);
         }
     }
 
+    metrics_inc(s_m_drops);
     return false;
 }
 
-static bool bt_app_send_msg(bt_app_msg_internal_t *msg)
+bool bt_app_work_post(bt_app_cb_t p_cback, uint16_t event)
+{
+    bt_app_msg_internal_t msg = {
+        .sig = BT_APP_SIG_WORK_DISPATCH,
+        .event = event,
+        .cb = p_cback,
+        .param = NULL,
+    };
+    if (xQueueSend(s_bt_app_task_queue, &msg, 0) != pdTRUE) {
+        /* no log here: the caller is a real-time task, the loss shows in dispatch.drops */
+        metrics_inc(s_m_drops);
+        return false;
+    }
+    metrics_set(s_m_depth, (int32_t)uxQueueMessagesWaiting(s_bt_app_task_queue));
+    return true;
+}
+
+static bool bt_app_send_msg(bt_app_msg_internal_t *msg, TickType_t wait)
 {
     if (msg == NULL) {
         return false;
     }
 
-    if (xQueueSend(s_bt_app_task_queue, msg, 10 / portTICK_PERIOD_MS) != pdTRUE) {
+    if (xQueueSend(s_bt_app_task_queue, msg, wait) != pdTRUE) {
         ESP_LOGE(BT_APP_CORE_TAG, "%s xQueue send failed", __func__);
+        metrics_inc(s_m_drops);
+        if (msg->param) {
+            free(msg->param);
+        }
         return false;
     }
+    metrics_set(s_m_depth, (int32_t)uxQueueMessagesWaiting(s_bt_app_task_queue));
     return true;
 }
 
 static void bt_app_work_dispatched(bt_app_msg_internal_t *msg)
 {
     if (msg->cb) {
+        trace_begin(TRACE_TRACK_APP, "work");
         msg->cb(msg->event, msg->param);
+        trace_end(TRACE_TRACK_APP, "work");
     }
 }
 
@@ -106,6 +136,9 @@ void bt_app_task_start_up(void)
 {
     s_bt_app_task_queue = xQueueCreate(10, sizeof(bt_app_msg_internal_t));
     xTaskCreate(bt_app_task_handler, "BtAppTask", 3072, NULL, configMAX_PRIORITIES - 3, &s_bt_app_task_handle);
+    s_m_drops = metrics_counter("dispatch.drops");
+    s_m_depth = metrics_gauge("dispatch.queue_depth", NULL);
+    metrics_watch_task(s_bt_app_task_handle, "BtAppTask");
     return;
 }
 
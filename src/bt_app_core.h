@@ -35,6 +35,14 @@ typedef void (* bt_app_copy_cb_t) (bt_app_msg_t *msg, void *p_dest, void *p_src)
  */
 bool bt_app_work_dispatch(bt_app_cb_t p_cback, uint16_t event, void *p_params, int param_len, bt_app_copy_cb_t p_copy_cback);
 
+/**
+ * @brief     non-blocking work post without parameters for real-time tasks
+ *
+ *            Never waits for queue space and never allocates: when the queue
+ *            is full the post is dropped and counted in dispatch.drops.
+ */
+bool bt_app_work_post(bt_app_cb_t p_cback, uint16_t event);
+
 void bt_app_task_start_up(void);
 
 void bt_app_task_shut_down(void);
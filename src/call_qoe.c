@@ -0,0 +1,378 @@
+#include "call_qoe.h"
+#include "paired_devices.h"
+#include "dsp_kernels.h"
+#include "metrics.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h>
+
+static const char *TAG = "CALL_QOE";
+static const char *NVS_NAMESPACE = "call_qoe";
+static const char *NVS_KEY_LOG = "log";
+
+_Static_assert(sizeof(call_qoe_record_t) == 48, "call_qoe_record_t is stored in NVS");
+
+#define SUMMARY_MAX   CALL_QOE_LOG_SIZE
+
+// Параметры E-модели по кодекам: Ie - искажения кодека, Bpl - устойчивость к потерям
+typedef struct {
+    float ie;
+    float bpl;
+} emodel_codec_t;
+
+static const emodel_codec_t s_emodel[AUDIO_CODEC_COUNT] = {
+    [AUDIO_CODEC_CVSD] = { 10.0f, 4.3f },       // Как ADPCM 32k; битые кадры идут в динамик как есть
+    [AUDIO_CODEC_MSBC] = { 0.0f, 25.1f },       // Маскирование потерь в стеке (как G.711 с PLC)
+};
+
+// Кольцо в NVS одним blob: одна запись во флеш на звонок
+typedef struct {
+    uint8_t version;
+    uint8_t count;
+    uint8_t next;
+    uint8_t reserved;
+    call_qoe_record_t records[CALL_QOE_LOG_SIZE];
+} call_qoe_log_t;
+
+static call_qoe_log_t s_log;
+static nvs_handle_t s_nvs;
+static bool s_nvs_open = false;
+static metric_t *s_m_calls = NULL;
+static metric_t *s_m_mos = NULL;
+
+esp_err_t call_qoe_init(void)
+{
+    memset(&s_log, 0, sizeof(s_log));
+    s_log.version = CALL_QOE_LOG_VERSION;
+    s_m_calls = metrics_counter("qoe.calls");
+    s_m_mos = metrics_histogram("qoe.mos", "x100");
+
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &s_nvs);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open NVS namespace: %s", esp_err_to_name(err));
+        return err;
+    }
+    s_nvs_open = true;
+
+    call_qoe_log_t stored;
+    size_t size = sizeof(stored);
+    err = nvs_get_blob(s_nvs, NVS_KEY_LOG, &stored, &size);
+    if (err == ESP_OK && size == sizeof(stored) && stored.version == CALL_QOE_LOG_VERSION &&
+        stored.count <= CALL_QOE_LOG_SIZE && stored.next < CALL_QOE_LOG_SIZE) {
+        s_log = stored;
+    } else if (err != ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGW(TAG, "Call log in NVS unreadable or old format, starting empty");
+    }
+    ESP_LOGI(TAG, "Call quality log: %u of %d records", s_log.count, CALL_QOE_LOG_SIZE);
+    return ESP_OK;
+}
+
+void call_qoe_begin(call_qoe_session_t *s, const esp_bd_addr_t bda, audio_codec_t codec)
+{
+    memset(s->ref_rms, 0, sizeof(s->ref_rms));
+    s->ref_pos = 0;
+    s->erl_frames = 0;
+    memset(s->erl_hist, 0, sizeof(s->erl_hist));
+    // Callback прошлой сессии может еще дописывать счетчик: без memset поверх него
+    __atomic_store_n(&s->rx_frames, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->tx_frames, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->late_callbacks, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->ring_underruns, 0, __ATOMIC_RELAXED);
+    memcpy(s->bda, bda, sizeof(esp_bd_addr_t));
+    s->codec = codec;
+    s->start_us = esp_timer_get_time();
+    s->start_time = (uint32_t)time(NULL);
+    s->active = true;
+}
+
+void call_qoe_on_tx(call_qoe_session_t *s, const int16_t *x, uint32_t n)
+{
+    if (!s->active) {
+        return;
+    }
+    s->ref_rms[s->ref_pos] = dsp_rms_q15(x, n);
+    s->ref_pos = (uint8_t)((s->ref_pos + 1) % CALL_QOE_ECHO_REF_FRAMES);
+}
+
+void call_qoe_on_rx(call_qoe_session_t *s, const int16_t *x, uint32_t n)
+{
+    if (!s->active) {
+        return;
+    }
+    // Опора - самый громкий кадр окна: задержка эха точно не известна
+    uint32_t ref = 0;
+    for (int i = 0; i < CALL_QOE_ECHO_REF_FRAMES; i++) {
+        ref = s->ref_rms[i] > ref ? s->ref_rms[i] : ref;
+    }
+    if (ref < CALL_QOE_ECHO_MIN_RMS) {
+        return;
+    }
+    // Двойной разговор занижает ERL отдельных кадров; медиана по звонку его отсекает
+    uint32_t rms = dsp_rms_q15(x, n);
+    int erl = (int)(20.0f * log10f((float)ref / (float)(rms > 0 ? rms : 1)));
+    erl = erl < 0 ? 0 : erl;
+    s->erl_hist[erl < CALL_QOE_ERL_BUCKETS ? erl : CALL_QOE_ERL_BUCKETS - 1]++;
+    s->erl_frames++;
+}
+
+uint16_t call_qoe_mos_x100(audio_codec_t codec, uint32_t loss_permille, uint32_t delay_ms)
+{
+    const emodel_codec_t *c = &s_emodel[codec < AUDIO_CODEC_COUNT ? codec : AUDIO_CODEC_CVSD];
+    float ppl = (float)(loss_permille > 1000 ? 1000 : loss_permille) / 10.0f;
+    float ta = (float)delay_ms;
+
+    // R = R0 - Is - Id - Ie,eff + A с параметрами по умолчанию: R0 - Is = 93.2, A = 0, BurstR = 1
+    float id = 0.024f * ta + (ta > 177.3f ? 0.11f * (ta - 177.3f) : 0.0f);
+    float ie_eff = c->ie + (95.0f - c->ie) * ppl / (ppl + c->bpl);
+    float r = 93.2f - id - ie_eff;
+
+    float mos;
+    if (r <= 0.0f) {
+        mos = 1.0f;
+    } else if (r >= 100.0f) {
+        mos = 4.5f;
+    } else {
+        mos = 1.0f + 0.035f * r + 7e-6f * r * (r - 60.0f) * (100.0f - r);
+    }
+    mos = mos < 1.0f ? 1.0f : mos;
+    return (uint16_t)lroundf(mos * 100.0f);
+}
+
+static uint8_t erl_median(const call_qoe_session_t *s)
+{
+    if (s->erl_frames < CALL_QOE_ECHO_MIN_FRAMES) {
+        return CALL_QOE_ERL_UNKNOWN;
+    }
+    uint32_t seen = 0;
+    for (int i = 0; i < CALL_QOE_ERL_BUCKETS; i++) {
+        seen += s->erl_hist[i];
+        if (seen * 2 >= s->erl_frames) {
+            return (uint8_t)i;
+        }
+    }
+    return CALL_QOE_ERL_BUCKETS - 1;
+}
+
+static uint16_t sat16(uint32_t v)
+{
+    return v > UINT16_MAX ? UINT16_MAX : (uint16_t)v;
+}
+
+bool call_qoe_finish(call_qoe_session_t *s, const link_quality_t *link, const audio_worker_latency_t *tx_lat,
+                     const audio_worker_latency_t *rx_lat, call_qoe_record_t *out)
+{
+    if (!s->active) {
+        return false;
+    }
+    s->active = false;
+    uint32_t tx_frames = __atomic_load_n(&s->tx_frames, __ATOMIC_RELAXED);
+    if (tx_frames < CALL_QOE_MIN_FRAMES) {
+        return false;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->start_time = s->start_time;
+    out->duration_s = sat16((uint32_t)((esp_timer_get_time() - s->start_us) / 1000000));
+    out->rx_frames = __atomic_load_n(&s->rx_frames, __ATOMIC_RELAXED);
+    out->tx_frames = tx_frames;
+    out->late_callbacks = sat16(__atomic_load_n(&s->late_callbacks, __ATOMIC_RELAXED));
+    out->ring_underruns = sat16(__atomic_load_n(&s->ring_underruns, __ATOMIC_RELAXED));
+    memcpy(out->bda, s->bda, sizeof(out->bda));
+    out->codec = (uint8_t)s->codec;
+    out->rssi = INT8_MIN;
+    out->tx_lat_ms[0] = tx_lat->p50_ms;
+    out->tx_lat_ms[1] = tx_lat->p95_ms;
+    out->tx_lat_ms[2] = tx_lat->p99_ms;
+    out->rx_lat_ms[0] = rx_lat->p50_ms;
+    out->rx_lat_ms[1] = rx_lat->p95_ms;
+    out->rx_lat_ms[2] = rx_lat->p99_ms;
+    out->erl_db = erl_median(s);
+
+    if (link != NULL) {
+        out->stack_frames = link->sco_total;
+        out->concealed = link->sco_bad < link->sco_total ? link->sco_bad : link->sco_total;
+        out->jitter_peak_us = sat16(link->jitter_peak_us);
+        if (link->rssi_valid) {
+            out->rssi = link->rssi;
+        }
+    }
+    // Без счетчиков стека потери неизвестны - MOS не оцениваем
+    if (out->stack_frames > 0) {
+        uint32_t loss = (uint32_t)((uint64_t)out->concealed * 1000 / out->stack_frames);
+        uint32_t frame_ms = audio_codec_frame_samples(s->codec) * 1000 / audio_codec_sample_rate(s->codec);
+        uint32_t delay_ms = tx_lat->p95_ms + frame_ms + CALL_QOE_HEADSET_DELAY_MS;
+        out->mos_x100 = call_qoe_mos_x100(s->codec, loss, delay_ms);
+    }
+    return true;
+}
+
+static uint32_t record_loss_permille(const call_qoe_record_t *rec)
+{
+    return rec->stack_frames > 0 ? (uint32_t)((uint64_t)rec->concealed * 1000 / rec->stack_frames) : 0;
+}
+
+static const char *record_codec_name(const call_qoe_record_t *rec)
+{
+    return rec->codec < AUDIO_CODEC_COUNT ? audio_codec_name((audio_codec_t)rec->codec) : "?";
+}
+
+static void print_record(const char *prefix, const call_qoe_record_t *rec)
+{
+    uint32_t loss = record_loss_permille(rec);
+    ESP_LOGI(TAG, "%s" ESP_BD_ADDR_STR " %s %um%02us: MOS %u.%02u, loss %" PRIu32 ".%" PRIu32 "%% (%" PRIu32
+             " of %" PRIu32 " concealed), late callbacks %u, ring underruns %u",
+             prefix, ESP_BD_ADDR_HEX(rec->bda), record_codec_name(rec), rec->duration_s / 60, rec->duration_s % 60,
+             rec->mos_x100 / 100, rec->mos_x100 % 100, loss / 10, loss % 10, rec->concealed, rec->stack_frames,
+             rec->late_callbacks, rec->ring_underruns);
+    char erl[8] = "-";
+    if (rec->erl_db != CALL_QOE_ERL_UNKNOWN) {
+        snprintf(erl, sizeof(erl), "%u", rec->erl_db);
+    }
+    ESP_LOGI(TAG, "   frames rx %" PRIu32 " tx %" PRIu32 ", buffer ms p50/p95/p99 tx %u/%u/%u rx %u/%u/%u, "
+             "jitter peak %u us, RSSI delta %d dB, ERL %s dB",
+             rec->rx_frames, rec->tx_frames, rec->tx_lat_ms[0], rec->tx_lat_ms[1], rec->tx_lat_ms[2],
+             rec->rx_lat_ms[0], rec->rx_lat_ms[1], rec->rx_lat_ms[2], rec->jitter_peak_us,
+             rec->rssi != INT8_MIN ? rec->rssi : 0, erl);
+}
+
+esp_err_t call_qoe_store(const call_qoe_record_t *rec)
+{
+    s_log.records[s_log.next] = *rec;
+    s_log.next = (uint8_t)((s_log.next + 1) % CALL_QOE_LOG_SIZE);
+    if (s_log.count < CALL_QOE_LOG_SIZE) {
+        s_log.count++;
+    }
+    metrics_inc(s_m_calls);
+    if (rec->mos_x100 != 0) {
+        metrics_observe(s_m_mos, rec->mos_x100);
+    }
+    print_record("📊 Call ", rec);
+
+    if (!s_nvs_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = nvs_set_blob(s_nvs, NVS_KEY_LOG, &s_log, sizeof(s_log));
+    if (err == ESP_OK) {
+        err = nvs_commit(s_nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save call log: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+// i-я запись с конца: 0 - последний звонок
+static const call_qoe_record_t *log_at(uint32_t i)
+{
+    return &s_log.records[(s_log.next + CALL_QOE_LOG_SIZE - 1 - i) % CALL_QOE_LOG_SIZE];
+}
+
+void call_qoe_print(uint32_t count)
+{
+    ESP_LOGI(TAG, "=== Last calls (%u stored) ===", s_log.count);
+    if (count == 0 || count > s_log.count) {
+        count = s_log.count;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        char prefix[8];
+        snprintf(prefix, sizeof(prefix), "%" PRIu32 ". ", i + 1);
+        print_record(prefix, log_at(i));
+    }
+}
+
+static const char *headset_name(const call_qoe_record_t *rec)
+{
+    paired_device_t *device = paired_devices_find(rec->bda);
+    return device != NULL ? device->device_name : NULL;
+}
+
+// Модель гарнитуры узнаем по имени: у одинаковых гарнитур оно совпадает
+static bool same_headset(const call_qoe_record_t *a, const call_qoe_record_t *b)
+{
+    const char *name_a = headset_name(a);
+    const char *name_b = headset_name(b);
+    if (name_a != NULL && name_b != NULL) {
+        return strcmp(name_a, name_b) == 0;
+    }
+    return name_a == NULL && name_b == NULL && memcmp(a->bda, b->bda, sizeof(a->bda)) == 0;
+}
+
+void call_qoe_print_summary(void)
+{
+    struct {
+        const call_qoe_record_t *first;
+        uint32_t calls;
+        uint32_t rated;
+        uint32_t mos_sum;
+        uint16_t mos_min;
+        uint64_t frames;
+        uint64_t concealed;
+        uint32_t late_callbacks;
+        uint32_t ring_underruns;
+        uint32_t seconds;
+    } groups[SUMMARY_MAX];
+    uint32_t n = 0;
+
+    memset(groups, 0, sizeof(groups));
+    for (uint32_t i = 0; i < s_log.count; i++) {
+        const call_qoe_record_t *rec = log_at(i);
+        uint32_t g = 0;
+        while (g < n && !same_headset(groups[g].first, rec)) {
+            g++;
+        }
+        if (g == n) {
+            groups[n].first = rec;
+            groups[n].mos_min = UINT16_MAX;
+            n++;
+        }
+        groups[g].calls++;
+        groups[g].frames += rec->stack_frames;
+        groups[g].concealed += rec->concealed;
+        groups[g].late_callbacks += rec->late_callbacks;
+        groups[g].ring_underruns += rec->ring_underruns;
+        groups[g].seconds += rec->duration_s;
+        if (rec->mos_x100 != 0) {
+            groups[g].rated++;
+            groups[g].mos_sum += rec->mos_x100;
+            groups[g].mos_min = rec->mos_x100 < groups[g].mos_min ? rec->mos_x100 : groups[g].mos_min;
+        }
+    }
+
+    ESP_LOGI(TAG, "=== Call quality by headset (%u calls) ===", s_log.count);
+    for (uint32_t g = 0; g < n; g++) {
+        const char *name = headset_name(groups[g].first);
+        char label[DEVICE_NAME_MAX_LEN];
+        if (name != NULL) {
+            snprintf(label, sizeof(label), "%s", name);
+        } else {
+            snprintf(label, sizeof(label), ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(groups[g].first->bda));
+        }
+        uint32_t loss = groups[g].frames > 0 ? (uint32_t)(groups[g].concealed * 1000 / groups[g].frames) : 0;
+        uint32_t mos_avg = groups[g].rated > 0 ? groups[g].mos_sum / groups[g].rated : 0;
+        uint32_t mos_min = groups[g].rated > 0 ? groups[g].mos_min : 0;
+        ESP_LOGI(TAG, "%s: %" PRIu32 " calls, %" PRIu32 " min, MOS avg %" PRIu32 ".%02" PRIu32 " min %" PRIu32
+                 ".%02" PRIu32 ", loss %" PRIu32 ".%" PRIu32 "%%, late callbacks %" PRIu32 ", ring underruns %" PRIu32,
+                 label, groups[g].calls, groups[g].seconds / 60, mos_avg / 100, mos_avg % 100, mos_min / 100,
+                 mos_min % 100, loss / 10, loss % 10, groups[g].late_callbacks, groups[g].ring_underruns);
+    }
+}
+
+esp_err_t call_qoe_clear(void)
+{
+    memset(s_log.records, 0, sizeof(s_log.records));
+    s_log.count = 0;
+    s_log.next = 0;
+    if (!s_nvs_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = nvs_erase_key(s_nvs, NVS_KEY_LOG);
+    if (err == ESP_OK || err == ESP_ERR_NVS_NOT_FOUND) {
+        err = nvs_commit(s_nvs);
+    }
+    ESP_LOGI(TAG, "Call quality log cleared");
+    return err;
+}
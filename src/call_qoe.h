@@ -0,0 +1,152 @@
+#ifndef CALL_QOE_H
+#define CALL_QOE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_bt_defs.h"
+#include "audio_codec.h"
+#include "audio_worker.h"
+#include "link_quality.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALL_QOE_LOG_SIZE          16      // Последних звонков в NVS
+#define CALL_QOE_MIN_FRAMES        133     // Короче секунды - не звонок (SCO под смену кодека, обрыв)
+#define CALL_QOE_ECHO_REF_FRAMES   8       // Окно опоры эха: ~60 мс TX с учетом упреждения и задержки гарнитуры
+#define CALL_QOE_ECHO_MIN_RMS      1000    // Дальний абонент говорит (~-30 dBFS)
+#define CALL_QOE_ECHO_MIN_FRAMES   200     // ~1.5 с одиночной речи дальнего абонента до оценки ERL
+#define CALL_QOE_ERL_BUCKETS       64      // Гистограмма ERL: 1 дБ на корзину
+#define CALL_QOE_HEADSET_DELAY_MS  20      // Воспроизведение и кодек в гарнитуре, для E-модели
+
+/*
+ * Итог каждой SCO сессии: длительность, кодек, кадры, потери, задержка в
+ * кольцах задачи обработки, затухание эха и оценка MOS по E-модели.
+ *
+ * Сессией владеет задача обработки: начало и итог выполняются заданием в
+ * ней (audio_worker_run), обработчик событий только просит о них. HCI
+ * callbacks пишут свои счетчики атомарно и только при открытой сессии. Итог
+ * ложится в кольцо из CALL_QOE_LOG_SIZE записей в NVS. Эхоподавителя в тракте нет, поэтому ERL - затухание пути
+ * динамик -> микрофон гарнитуры (со встроенным в нее AEC): медиана
+ * отношения уровня TX к уровню захвата на кадрах, где говорит дальний абонент.
+ */
+
+// Запись журнала: 48 байт, формат NVS - меняется только с CALL_QOE_LOG_VERSION
+typedef struct {
+    uint32_t start_time;            // time() открытия SCO
+    uint32_t rx_frames;             // Кадров принято через HCI
+    uint32_t tx_frames;             // Кадров отдано стеку
+    uint32_t stack_frames;          // Кадров SCO по счетчикам стека
+    uint32_t concealed;             // Из них с ошибками или потеряны (маскировал стек)
+    uint16_t duration_s;
+    uint16_t late_callbacks;        // Стек запросил кадр с опозданием - до этого в эфир ушла тишина
+    uint16_t ring_underruns;        // Кадр не был готов в кольце задачи обработки - отдана тишина
+    uint16_t mos_x100;              // 0 - нет оценки
+    uint16_t jitter_peak_us;        // Худшее окно монитора канала
+    uint8_t bda[6];
+    uint8_t codec;                  // audio_codec_t
+    int8_t rssi;                    // Отклонение RSSI, дБ; INT8_MIN - нет данных
+    uint8_t tx_lat_ms[3];           // Задержка TX кольца: p50, p95, p99
+    uint8_t rx_lat_ms[3];           // Задержка RX кольца: p50, p95, p99
+    uint8_t erl_db;                 // CALL_QOE_ERL_UNKNOWN - мало речи дальнего абонента
+    uint8_t reserved[3];
+} call_qoe_record_t;
+
+#define CALL_QOE_ERL_UNKNOWN   0xFF
+#define CALL_QOE_LOG_VERSION   2       // 2: недобор разделен на late_callbacks и ring_underruns
+
+// Сессия, которую сейчас обслуживает data path
+typedef struct {
+    // Пишет задача обработки (или callbacks без нее)
+    uint32_t ref_rms[CALL_QOE_ECHO_REF_FRAMES];      // RMS последних кадров TX
+    uint8_t ref_pos;
+    uint32_t erl_frames;
+    uint32_t erl_hist[CALL_QOE_ERL_BUCKETS];
+
+    // Пишут HCI callbacks: только атомарно (call_qoe_count), пока сессия открыта
+    uint32_t rx_frames;
+    uint32_t tx_frames;
+    uint32_t late_callbacks;
+    uint32_t ring_underruns;
+
+    // Начало и итог - задание в задаче обработки
+    bool active;
+    int64_t start_us;
+    uint32_t start_time;
+    esp_bd_addr_t bda;
+    audio_codec_t codec;
+} call_qoe_session_t;
+
+/**
+ * @brief Загрузка журнала звонков из NVS
+ * @return ESP_OK при успехе
+ */
+esp_err_t call_qoe_init(void);
+
+/**
+ * @brief Начало сессии (до включения тракта)
+ */
+void call_qoe_begin(call_qoe_session_t *s, const esp_bd_addr_t bda, audio_codec_t codec);
+
+/**
+ * @brief Счетчик HCI callback: атомарно, запоздалый callback не рвет сброс в call_qoe_begin
+ */
+static inline void call_qoe_count(uint32_t *counter)
+{
+    __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Кадр TX сформирован: опора для оценки эха
+ */
+void call_qoe_on_tx(call_qoe_session_t *s, const int16_t *x, uint32_t n);
+
+/**
+ * @brief Кадр захвата до обработки: эхо относительно опоры
+ */
+void call_qoe_on_rx(call_qoe_session_t *s, const int16_t *x, uint32_t n);
+
+/**
+ * @brief Итог сессии (после выключения тракта)
+ * @param link Монитор канала гарнитуры; NULL если SLC уже закрыт
+ * @param tx_lat Задержка в кольцах за сессию
+ * @param rx_lat Задержка в кольцах за сессию
+ * @param out Запись журнала
+ * @return false если сессия слишком короткая для отчета
+ */
+bool call_qoe_finish(call_qoe_session_t *s, const link_quality_t *link, const audio_worker_latency_t *tx_lat,
+                     const audio_worker_latency_t *rx_lat, call_qoe_record_t *out);
+
+/**
+ * @brief Оценка MOS по упрощенной E-модели (ITU-T G.107, узкополосная шкала)
+ * @param loss_permille Потерянные и маскированные кадры, промилле
+ * @param delay_ms Односторонняя задержка рот-ухо
+ * @return MOS x100 (100..441)
+ */
+uint16_t call_qoe_mos_x100(audio_codec_t codec, uint32_t loss_permille, uint32_t delay_ms);
+
+/**
+ * @brief Итог в журнал и NVS (задача bt_app: commit во флеш не блокирует тракт)
+ */
+esp_err_t call_qoe_store(const call_qoe_record_t *rec);
+
+/**
+ * @brief Последние звонки, новые сверху
+ * @param count Сколько показать (0 - все)
+ */
+void call_qoe_print(uint32_t count);
+
+/**
+ * @brief Сводка по моделям гарнитур (имя из списка сопряженных): звонки, MOS, потери
+ */
+void call_qoe_print_summary(void);
+
+esp_err_t call_qoe_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALL_QOE_H */
@@ -0,0 +1,708 @@
+#include "call_recorder.h"
+#include "ima_adpcm.h"
+#include "msbc.h"
+#include "audio_frame.h"
+#include "storage.h"
+#include "metrics.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "CALL_RECORDER";
+
+#define WAV_PCM_HEADER_SIZE     44
+#define WAV_ADPCM_HEADER_SIZE   60
+#define RECORDER_MAX_INDEX      1000
+#define RECORDER_STOP_TIMEOUT_MS 5000
+
+#define NOTIFY_DATA       0x01
+#define NOTIFY_FINALIZE   0x02
+
+// Последний закодированный блок нулей: тот же вход из того же состояния дает те же байты
+typedef struct {
+    bool valid;
+    int16_t msbc_hist[sizeof(((msbc_enc_t *)0)->hist) / sizeof(int16_t)];
+    ima_adpcm_state_t adpcm_pre;
+    ima_adpcm_state_t adpcm_post;
+    uint8_t bytes[IMA_ADPCM_BLOCK_BYTES];
+} silence_cache_t;
+
+typedef struct {
+    int fd;
+    char path[32];
+    uint8_t buf[2][CALL_RECORDER_SECTOR_SIZE];
+    uint32_t buf_len[2];
+    bool pending[2];            // Буфер заполнен и ждет записи: release-запись после заполнения/записи
+    uint8_t fill;               // Буфер, который заполняет производитель
+    uint8_t write;              // Следующий буфер для записи (строго чередуются)
+    uint32_t fill_pos;
+    ima_adpcm_state_t adpcm;
+    msbc_enc_t msbc;
+    int16_t block[IMA_ADPCM_SAMPLES_PER_BLOCK];   // Накопление блока кодера (ADPCM или mSBC)
+    uint32_t block_pos;
+    bool block_silent;          // Текущий блок пока состоит только из пауз
+    silence_cache_t silence;
+    bool failed;
+    int64_t last_submit_us;
+    call_recorder_stream_stats_t stats;
+} rec_stream_t;
+
+static const char *s_stream_names[CALL_RECORDER_STREAM_COUNT] = { "rx", "tx" };
+
+static rec_stream_t *s_streams[CALL_RECORDER_STREAM_COUNT];
+static TaskHandle_t s_task_handle = NULL;
+static SemaphoreHandle_t s_done_sem = NULL;
+static SemaphoreHandle_t s_feed_idle_sem = NULL;   // feed вышел после сброса s_active (будит stop)
+// s_active и s_feed_busy - пара Дейкера между stop и feed на разных ядрах:
+// нужен полный порядок (SEQ_CST), acquire/release не запрещает перестановку store-load
+static bool s_active = false;
+static bool s_feed_busy[CALL_RECORDER_STREAM_COUNT];
+static int s_consumer_ids[CALL_RECORDER_STREAM_COUNT] = { -1, -1 };
+static call_recorder_format_t s_format = CALL_RECORDER_FORMAT_PCM16;
+static uint32_t s_sample_rate = 8000;
+static call_recorder_stats_t s_last_stats;
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    put_le16(p, (uint16_t)v);
+    put_le16(p + 2, (uint16_t)(v >> 16));
+}
+
+_Static_assert(MSBC_SAMPLES_PER_FRAME <= IMA_ADPCM_SAMPLES_PER_BLOCK, "mSBC frame must fit the block buffer");
+
+static const char *format_name(call_recorder_format_t format)
+{
+    switch (format) {
+    case CALL_RECORDER_FORMAT_IMA_ADPCM:
+        return "IMA-ADPCM";
+    case CALL_RECORDER_FORMAT_MSBC:
+        return "mSBC";
+    default:
+        return "PCM16";
+    }
+}
+
+static const char *format_ext(call_recorder_format_t format)
+{
+    return format == CALL_RECORDER_FORMAT_MSBC ? "msbc" : "wav";
+}
+
+// Размер блока кодера в отсчетах и байтах (0 для PCM)
+static uint32_t block_samples(void)
+{
+    switch (s_format) {
+    case CALL_RECORDER_FORMAT_IMA_ADPCM:
+        return IMA_ADPCM_SAMPLES_PER_BLOCK;
+    case CALL_RECORDER_FORMAT_MSBC:
+        return MSBC_SAMPLES_PER_FRAME;
+    default:
+        return 0;
+    }
+}
+
+static uint32_t block_bytes(void)
+{
+    return s_format == CALL_RECORDER_FORMAT_MSBC ? MSBC_PACKET_LEN : IMA_ADPCM_BLOCK_BYTES;
+}
+
+// Файл mSBC - сырой поток пакетов, как в SCO: заголовка нет
+static uint32_t wav_header_size(void)
+{
+    switch (s_format) {
+    case CALL_RECORDER_FORMAT_IMA_ADPCM:
+        return WAV_ADPCM_HEADER_SIZE;
+    case CALL_RECORDER_FORMAT_MSBC:
+        return 0;
+    default:
+        return WAV_PCM_HEADER_SIZE;
+    }
+}
+
+// Стандартный RIFF/WAVE заголовок: PCM (tag 1) или IMA ADPCM (tag 0x11) с чанком fact
+static void wav_build_header(uint8_t *h, uint32_t data_bytes, uint32_t total_samples)
+{
+    uint32_t size = wav_header_size();
+    memcpy(h, "RIFF", 4);
+    put_le32(h + 4, size - 8 + data_bytes);
+    memcpy(h + 8, "WAVEfmt ", 8);
+
+    if (s_format == CALL_RECORDER_FORMAT_IMA_ADPCM) {
+        put_le32(h + 16, 20);
+        put_le16(h + 20, 0x0011);
+        put_le16(h + 22, 1);
+        put_le32(h + 24, s_sample_rate);
+        put_le32(h + 28, s_sample_rate * IMA_ADPCM_BLOCK_BYTES / IMA_ADPCM_SAMPLES_PER_BLOCK);
+        put_le16(h + 32, IMA_ADPCM_BLOCK_BYTES);
+        put_le16(h + 34, 4);
+        put_le16(h + 36, 2);
+        put_le16(h + 38, IMA_ADPCM_SAMPLES_PER_BLOCK);
+        memcpy(h + 40, "fact", 4);
+        put_le32(h + 44, 4);
+        put_le32(h + 48, total_samples);
+        memcpy(h + 52, "data", 4);
+        put_le32(h + 56, data_bytes);
+    } else {
+        put_le32(h + 16, 16);
+        put_le16(h + 20, 0x0001);
+        put_le16(h + 22, 1);
+        put_le32(h + 24, s_sample_rate);
+        put_le32(h + 28, s_sample_rate * sizeof(int16_t));
+        put_le16(h + 32, sizeof(int16_t));
+        put_le16(h + 34, 16);
+        memcpy(h + 36, "data", 4);
+        put_le32(h + 40, data_bytes);
+    }
+}
+
+// Сколько байт даст запись count отсчетов в текущем формате
+static uint32_t stream_bytes_for(const rec_stream_t *st, uint32_t count)
+{
+    if (block_samples() != 0) {
+        return ((st->block_pos + count) / block_samples()) * block_bytes();
+    }
+    return count * sizeof(int16_t);
+}
+
+// Отдать заполненный буфер фоновой задаче и переключиться на второй
+static void stream_submit(rec_stream_t *st)
+{
+    int64_t now = esp_timer_get_time();
+    if (st->last_submit_us != 0) {
+        st->stats.sector_fill_us = (uint32_t)(now - st->last_submit_us);
+    }
+    st->last_submit_us = now;
+
+    st->buf_len[st->fill] = st->fill_pos;
+    __atomic_store_n(&st->pending[st->fill], true, __ATOMIC_RELEASE);
+    st->fill ^= 1;
+    st->fill_pos = 0;
+
+    if (s_task_handle) {
+        xTaskNotify(s_task_handle, NOTIFY_DATA, eSetBits);
+    }
+}
+
+static void stream_put(rec_stream_t *st, const uint8_t *data, uint32_t len)
+{
+    while (len > 0) {
+        uint32_t n = CALL_RECORDER_SECTOR_SIZE - st->fill_pos;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(&st->buf[st->fill][st->fill_pos], data, n);
+        st->fill_pos += n;
+        data += n;
+        len -= n;
+        if (st->fill_pos == CALL_RECORDER_SECTOR_SIZE) {
+            stream_submit(st);
+        }
+    }
+}
+
+static void stream_encode_block(rec_stream_t *st)
+{
+    uint8_t out[IMA_ADPCM_BLOCK_BYTES];
+    if (s_format == CALL_RECORDER_FORMAT_MSBC) {
+        msbc_encode(&st->msbc, st->block, out);
+    } else {
+        ima_adpcm_encode_block(&st->adpcm, st->block, out);
+    }
+    st->block_pos = 0;
+    stream_put(st, out, block_bytes());
+}
+
+static void stream_encode_silent_block(rec_stream_t *st)
+{
+    silence_cache_t *c = &st->silence;
+    if (s_format == CALL_RECORDER_FORMAT_MSBC) {
+        // Состояние кодера - окно анализа; после блока нулей оно нулевое, меняется только номер H2
+        if (c->valid && memcmp(c->msbc_hist, st->msbc.hist, sizeof(c->msbc_hist)) == 0) {
+            msbc_h2_write(c->bytes, st->msbc.seq);
+            st->msbc.seq = (st->msbc.seq + 1) & 3;
+            memset(st->msbc.hist, 0, sizeof(st->msbc.hist));
+        } else {
+            memcpy(c->msbc_hist, st->msbc.hist, sizeof(c->msbc_hist));
+            msbc_encode(&st->msbc, st->block, c->bytes);
+            c->valid = true;
+        }
+    } else {
+        if (c->valid && c->adpcm_pre.predictor == st->adpcm.predictor &&
+            c->adpcm_pre.step_index == st->adpcm.step_index) {
+            st->adpcm = c->adpcm_post;
+        } else {
+            c->adpcm_pre = st->adpcm;
+            ima_adpcm_encode_block(&st->adpcm, st->block, c->bytes);
+            c->adpcm_post = st->adpcm;
+            c->valid = true;
+        }
+    }
+    st->block_pos = 0;
+    stream_put(st, c->bytes, block_bytes());
+}
+
+static void stream_put_zeros(rec_stream_t *st, uint32_t len)
+{
+    while (len > 0) {
+        uint32_t n = CALL_RECORDER_SECTOR_SIZE - st->fill_pos;
+        if (n > len) {
+            n = len;
+        }
+        memset(&st->buf[st->fill][st->fill_pos], 0, n);
+        st->fill_pos += n;
+        len -= n;
+        if (st->fill_pos == CALL_RECORDER_SECTOR_SIZE) {
+            stream_submit(st);
+        }
+    }
+}
+
+static void stream_write_pending(rec_stream_t *st)
+{
+    while (__atomic_load_n(&st->pending[st->write], __ATOMIC_ACQUIRE)) {
+        uint8_t idx = st->write;
+        if (!st->failed) {
+            int64_t start = esp_timer_get_time();
+            ssize_t written = write(st->fd, st->buf[idx], st->buf_len[idx]);
+            uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+
+            if (written != (ssize_t)st->buf_len[idx]) {
+                ESP_LOGE(TAG, "Write to %s failed (flash full?), stream stopped", st->path);
+                st->stats.write_errors++;
+                st->failed = true;
+            } else {
+                st->stats.bytes_written += st->buf_len[idx];
+                st->stats.sectors++;
+                st->stats.total_write_us += elapsed;
+                if (elapsed > st->stats.max_write_us) {
+                    st->stats.max_write_us = elapsed;
+                }
+            }
+        }
+        __atomic_store_n(&st->pending[idx], false, __ATOMIC_RELEASE);
+        st->write ^= 1;
+    }
+}
+
+static void stream_finalize(rec_stream_t *st)
+{
+    // Производитель уже остановлен - дописываем хвост в контексте задачи записи
+    stream_write_pending(st);
+
+    if (block_samples() != 0 && st->block_pos > 0) {
+        memset(&st->block[st->block_pos], 0, (block_samples() - st->block_pos) * sizeof(int16_t));
+        stream_encode_block(st);
+        stream_write_pending(st);
+    }
+    if (st->fill_pos > 0) {
+        st->buf_len[st->fill] = st->fill_pos;
+        __atomic_store_n(&st->pending[st->fill], true, __ATOMIC_RELEASE);
+        st->fill_pos = 0;
+        stream_write_pending(st);
+    }
+
+    if (wav_header_size() > 0) {
+        uint32_t data_bytes = st->stats.bytes_written > wav_header_size() ?
+                              st->stats.bytes_written - wav_header_size() : 0;
+        uint8_t header[WAV_ADPCM_HEADER_SIZE];
+        wav_build_header(header, data_bytes, st->stats.samples);
+        if (lseek(st->fd, 0, SEEK_SET) != 0 || write(st->fd, header, wav_header_size()) != (ssize_t)wav_header_size()) {
+            ESP_LOGE(TAG, "Failed to update WAV header in %s", st->path);
+        }
+    }
+    close(st->fd);
+    st->fd = -1;
+
+    ESP_LOGI(TAG, "Closed %s: %" PRIu32 " samples, %" PRIu32 " bytes", st->path,
+             st->stats.samples, st->stats.bytes_written);
+}
+
+static void call_recorder_task(void *arg)
+{
+    uint32_t bits = 0;
+    for (;;) {
+        xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY);
+
+        for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+            if (s_streams[i]) {
+                stream_write_pending(s_streams[i]);
+            }
+        }
+
+        if (bits & NOTIFY_FINALIZE) {
+            for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+                if (s_streams[i]) {
+                    stream_finalize(s_streams[i]);
+                }
+            }
+            xSemaphoreGive(s_done_sem);
+        }
+    }
+}
+
+static esp_err_t stream_open(call_recorder_stream_t stream, int index)
+{
+    rec_stream_t *st = calloc(1, sizeof(rec_stream_t));
+    if (st == NULL) {
+        ESP_LOGE(TAG, "No memory for %s stream buffers", s_stream_names[stream]);
+        return ESP_ERR_NO_MEM;
+    }
+
+    snprintf(st->path, sizeof(st->path), STORAGE_BASE_PATH "/rec_%03d_%s.%s", index, s_stream_names[stream],
+             format_ext(s_format));
+    st->fd = open(st->path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (st->fd < 0) {
+        ESP_LOGE(TAG, "Failed to create %s", st->path);
+        free(st);
+        return ESP_FAIL;
+    }
+
+    // Заголовок занимает начало первого сектора, поэтому все записи остаются выровненными
+    if (wav_header_size() > 0) {
+        wav_build_header(st->buf[0], 0, 0);
+    }
+    st->fill_pos = wav_header_size();
+    msbc_enc_init(&st->msbc);
+
+    s_streams[stream] = st;
+    ESP_LOGI(TAG, "Recording %s stream to %s", s_stream_names[stream], st->path);
+    return ESP_OK;
+}
+
+static void streams_release(void)
+{
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        if (s_streams[i]) {
+            if (s_streams[i]->fd >= 0) {
+                close(s_streams[i]->fd);
+            }
+            free(s_streams[i]);
+            s_streams[i] = NULL;
+        }
+    }
+}
+
+static bool index_used(int index)
+{
+    static const call_recorder_format_t formats[] = { CALL_RECORDER_FORMAT_PCM16, CALL_RECORDER_FORMAT_MSBC };
+    struct stat st;
+    char path[32];
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        for (int s = 0; s < CALL_RECORDER_STREAM_COUNT; s++) {
+            snprintf(path, sizeof(path), STORAGE_BASE_PATH "/rec_%03d_%s.%s", index, s_stream_names[s],
+                     format_ext(formats[f]));
+            if (stat(path, &st) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static int find_free_index(void)
+{
+    for (int i = 0; i < RECORDER_MAX_INDEX; i++) {
+        if (!index_used(i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+esp_err_t call_recorder_init(void)
+{
+    s_done_sem = xSemaphoreCreateBinary();
+    s_feed_idle_sem = xSemaphoreCreateBinary();
+    if (s_done_sem == NULL || s_feed_idle_sem == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(call_recorder_task, "CallRecorder", CALL_RECORDER_TASK_STACK, NULL,
+                    CALL_RECORDER_TASK_PRIO, &s_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create recorder task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    metrics_watch_task(s_task_handle, "CallRecorder");
+    ESP_LOGI(TAG, "Call recorder initialized");
+    return ESP_OK;
+}
+
+// Потребитель пула кадров: кодер читает общий кадр, промежуточной копии нет
+static void recorder_frame_cb(audio_frame_t *frame, void *ctx)
+{
+    call_recorder_stream_t stream = frame->stream == AUDIO_FRAME_RX ? CALL_RECORDER_STREAM_RX : CALL_RECORDER_STREAM_TX;
+    if (frame->speech) {
+        call_recorder_feed(stream, frame->samples, frame->count);
+    } else {
+        call_recorder_feed_silence(stream, frame->count);
+    }
+}
+
+esp_err_t call_recorder_start(uint8_t stream_mask, call_recorder_format_t format, uint32_t sample_rate)
+{
+    if (s_task_handle == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (__atomic_load_n(&s_active, __ATOMIC_SEQ_CST)) {
+        ESP_LOGW(TAG, "Recording already in progress");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if ((stream_mask & CALL_RECORDER_MASK_ALL) == 0 || sample_rate == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (format == CALL_RECORDER_FORMAT_MSBC && sample_rate != 16000) {
+        ESP_LOGW(TAG, "mSBC recording needs a 16 kHz (wideband) call");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = storage_mount();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    int index = find_free_index();
+    if (index < 0) {
+        ESP_LOGE(TAG, "No free recording slots, delete old recordings");
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_format = format;
+    s_sample_rate = sample_rate;
+
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        if (stream_mask & (1 << i)) {
+            ret = stream_open((call_recorder_stream_t)i, index);
+            if (ret != ESP_OK) {
+                streams_release();
+                return ret;
+            }
+        }
+    }
+
+    // Публикует s_streams и состояние кодеров для feed на другом ядре
+    __atomic_store_n(&s_active, true, __ATOMIC_SEQ_CST);
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        if (s_streams[i] != NULL &&
+            audio_frame_subscribe(i == CALL_RECORDER_STREAM_RX ? AUDIO_FRAME_RX : AUDIO_FRAME_TX,
+                                  recorder_frame_cb, NULL, &s_consumer_ids[i]) != ESP_OK) {
+            ESP_LOGW(TAG, "No frame consumer slot for %s stream", s_stream_names[i]);
+        }
+    }
+    ESP_LOGI(TAG, "🔴 Recording started: %s, %" PRIu32 " Hz", format_name(format), sample_rate);
+    return ESP_OK;
+}
+
+esp_err_t call_recorder_stop(void)
+{
+    if (!__atomic_load_n(&s_active, __ATOMIC_SEQ_CST)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        audio_frame_unsubscribe(s_consumer_ids[i]);
+        s_consumer_ids[i] = -1;
+    }
+    // Сигнал, оставшийся от прошлой записи, не должен разбудить нас раньше времени
+    xSemaphoreTake(s_feed_idle_sem, 0);
+    __atomic_store_n(&s_active, false, __ATOMIC_SEQ_CST);
+    // Дожидаемся выхода из call_recorder_feed, который мог начаться до сброса флага:
+    // feed, увидевший s_active == false на выходе, отдает семафор
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        while (__atomic_load_n(&s_feed_busy[i], __ATOMIC_SEQ_CST)) {
+            if (xSemaphoreTake(s_feed_idle_sem, pdMS_TO_TICKS(RECORDER_STOP_TIMEOUT_MS)) != pdTRUE) {
+                ESP_LOGE(TAG, "Timeout waiting for %s feed to leave", s_stream_names[i]);
+                return ESP_ERR_TIMEOUT;
+            }
+        }
+    }
+
+    xTaskNotify(s_task_handle, NOTIFY_FINALIZE, eSetBits);
+    if (xSemaphoreTake(s_done_sem, pdMS_TO_TICKS(RECORDER_STOP_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGE(TAG, "Timeout while finalizing recording");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    call_recorder_get_stats(&s_last_stats);
+    s_last_stats.active = false;
+    call_recorder_print_stats();
+    streams_release();
+
+    ESP_LOGI(TAG, "⏹️ Recording stopped");
+    return ESP_OK;
+}
+
+// Снять отметку занятости; если stop уже сбросил s_active, он ждет на семафоре
+static void feed_release(call_recorder_stream_t stream)
+{
+    __atomic_store_n(&s_feed_busy[stream], false, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&s_active, __ATOMIC_SEQ_CST)) {
+        xSemaphoreGive(s_feed_idle_sem);
+    }
+}
+
+// Поток для записи count отсчетов или NULL; при успехе поток помечен занятым до feed_end()
+static rec_stream_t *feed_begin(call_recorder_stream_t stream, uint32_t count)
+{
+    if (stream >= CALL_RECORDER_STREAM_COUNT || !__atomic_load_n(&s_active, __ATOMIC_SEQ_CST)) {
+        return NULL;
+    }
+
+    // Сначала отметка, потом повторная проверка: stop либо увидит отметку, либо мы увидим сброс
+    __atomic_store_n(&s_feed_busy[stream], true, __ATOMIC_SEQ_CST);
+    rec_stream_t *st = s_streams[stream];
+    if (!__atomic_load_n(&s_active, __ATOMIC_SEQ_CST) || st == NULL || st->failed) {
+        feed_release(stream);
+        return NULL;
+    }
+
+    // Не ждем фоновую задачу: если второй буфер еще пишется и места не хватит - блок отбрасывается
+    uint32_t space = CALL_RECORDER_SECTOR_SIZE - st->fill_pos;
+    if (!__atomic_load_n(&st->pending[st->fill ^ 1], __ATOMIC_ACQUIRE)) {
+        space += CALL_RECORDER_SECTOR_SIZE;
+    }
+    if (stream_bytes_for(st, count) >= space) {
+        st->stats.overruns++;
+        feed_release(stream);
+        return NULL;
+    }
+    return st;
+}
+
+static void feed_end(call_recorder_stream_t stream, rec_stream_t *st, uint32_t count)
+{
+    st->stats.samples += count;
+    feed_release(stream);
+}
+
+void call_recorder_feed(call_recorder_stream_t stream, const int16_t *samples, uint32_t count)
+{
+    if (samples == NULL) {
+        return;
+    }
+    rec_stream_t *st = feed_begin(stream, count);
+    if (st == NULL) {
+        return;
+    }
+
+    if (block_samples() != 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            st->block[st->block_pos++] = samples[i];
+            if (st->block_pos == block_samples()) {
+                stream_encode_block(st);
+            }
+        }
+        st->block_silent = false;
+    } else {
+        stream_put(st, (const uint8_t *)samples, count * sizeof(int16_t));
+    }
+    feed_end(stream, st, count);
+}
+
+void call_recorder_feed_silence(call_recorder_stream_t stream, uint32_t count)
+{
+    rec_stream_t *st = feed_begin(stream, count);
+    if (st == NULL) {
+        return;
+    }
+
+    if (block_samples() != 0) {
+        uint32_t left = count;
+        while (left > 0) {
+            if (st->block_pos == 0) {
+                st->block_silent = true;
+            }
+            uint32_t n = block_samples() - st->block_pos;
+            if (n > left) {
+                n = left;
+            }
+            memset(&st->block[st->block_pos], 0, n * sizeof(int16_t));
+            st->block_pos += n;
+            left -= n;
+            if (st->block_pos == block_samples()) {
+                if (st->block_silent) {
+                    stream_encode_silent_block(st);
+                } else {
+                    stream_encode_block(st);
+                }
+            }
+        }
+    } else {
+        stream_put_zeros(st, count * sizeof(int16_t));
+    }
+    st->stats.silent_samples += count;
+    feed_end(stream, st, count);
+}
+
+bool call_recorder_is_active(void)
+{
+    return __atomic_load_n(&s_active, __ATOMIC_RELAXED);
+}
+
+void call_recorder_get_stats(call_recorder_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    bool have_streams = false;
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        have_streams |= s_streams[i] != NULL;
+    }
+    if (!have_streams) {
+        *stats = s_last_stats;
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->active = __atomic_load_n(&s_active, __ATOMIC_RELAXED);
+    stats->format = s_format;
+    stats->sample_rate = s_sample_rate;
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        if (s_streams[i]) {
+            stats->stream[i] = s_streams[i]->stats;
+        }
+    }
+}
+
+void call_recorder_print_stats(void)
+{
+    call_recorder_stats_t stats;
+    call_recorder_get_stats(&stats);
+
+    ESP_LOGI(TAG, "=== Recorder: %s, %s, %" PRIu32 " Hz ===", stats.active ? "ACTIVE" : "idle",
+             format_name(stats.format), stats.sample_rate);
+
+    for (int i = 0; i < CALL_RECORDER_STREAM_COUNT; i++) {
+        const call_recorder_stream_stats_t *s = &stats.stream[i];
+        if (s->samples == 0 && s->bytes_written == 0) {
+            continue;
+        }
+
+        uint32_t kbps = s->total_write_us ? (uint32_t)((uint64_t)s->bytes_written * 1000000 / s->total_write_us / 1024) : 0;
+        // Запас: сколько времени остается между концом самой долгой записи и заполнением следующего сектора
+        int32_t headroom_ms = ((int32_t)s->sector_fill_us - (int32_t)s->max_write_us) / 1000;
+        uint32_t headroom_pct = s->sector_fill_us && s->sector_fill_us > s->max_write_us ?
+                                (s->sector_fill_us - s->max_write_us) * 100 / s->sector_fill_us : 0;
+
+        ESP_LOGI(TAG, "%s: %" PRIu32 " samples (%" PRIu32 "%% pauses), %" PRIu32 " bytes in %" PRIu32 " sectors",
+                 s_stream_names[i], s->samples, s->samples ? s->silent_samples * 100 / s->samples : 0, s->bytes_written, s->sectors);
+        ESP_LOGI(TAG, "   flash %" PRIu32 " KB/s, max write %" PRIu32 " ms, sector fill %" PRIu32 " ms",
+                 kbps, s->max_write_us / 1000, s->sector_fill_us / 1000);
+        ESP_LOGI(TAG, "   headroom %" PRId32 " ms (%" PRIu32 "%%), overruns %" PRIu32 ", write errors %" PRIu32,
+                 headroom_ms, headroom_pct, s->overruns, s->write_errors);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef CALL_RECORDER_H
+#define CALL_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALL_RECORDER_SECTOR_SIZE   4096  // Размер записи во флеш, выровнен по сектору
+#define CALL_RECORDER_TASK_STACK    4096
+#define CALL_RECORDER_TASK_PRIO     2
+
+typedef enum {
+    CALL_RECORDER_STREAM_RX = 0,   // Захват: аудио от гарнитуры (audio_data_callback)
+    CALL_RECORDER_STREAM_TX,       // Воспроизведение: то, что уходит в гарнитуру
+    CALL_RECORDER_STREAM_COUNT
+} call_recorder_stream_t;
+
+#define CALL_RECORDER_MASK_RX   (1 << CALL_RECORDER_STREAM_RX)
+#define CALL_RECORDER_MASK_TX   (1 << CALL_RECORDER_STREAM_TX)
+#define CALL_RECORDER_MASK_ALL  (CALL_RECORDER_MASK_RX | CALL_RECORDER_MASK_TX)
+
+typedef enum {
+    CALL_RECORDER_FORMAT_PCM16 = 0,
+    CALL_RECORDER_FORMAT_IMA_ADPCM,
+    CALL_RECORDER_FORMAT_MSBC,      // Пакеты H2 по 60 байт без заголовка файла, только 16 кГц
+} call_recorder_format_t;
+
+typedef struct {
+    uint32_t samples;         // Принято отсчетов
+    uint32_t silent_samples;  // Из них паузы (call_recorder_feed_silence)
+    uint32_t bytes_written;   // Записано во флеш
+    uint32_t sectors;         // Записано секторов
+    uint32_t overruns;        // Блоков, отброшенных из-за занятого буфера
+    uint32_t write_errors;
+    uint32_t max_write_us;    // Самая долгая запись сектора
+    uint64_t total_write_us;
+    uint32_t sector_fill_us;  // За сколько поток заполняет сектор
+} call_recorder_stream_stats_t;
+
+typedef struct {
+    bool active;
+    call_recorder_format_t format;
+    uint32_t sample_rate;
+    call_recorder_stream_stats_t stream[CALL_RECORDER_STREAM_COUNT];
+} call_recorder_stats_t;
+
+/**
+ * @brief Инициализация записи разговоров (создает фоновую задачу записи)
+ * @return ESP_OK при успехе
+ */
+esp_err_t call_recorder_init(void);
+
+/**
+ * @brief Начало записи в файлы WAV (или .msbc) на разделе spiffs
+ * @param stream_mask Какие потоки писать (CALL_RECORDER_MASK_*)
+ * @param format PCM16, IMA-ADPCM (~4:1) или mSBC (~4:1, тот же поток, что идет по SCO)
+ * @param sample_rate Частота дискретизации, Гц
+ * @return ESP_OK при успехе
+ */
+esp_err_t call_recorder_start(uint8_t stream_mask, call_recorder_format_t format, uint32_t sample_rate);
+
+/**
+ * @brief Остановка записи: дописывает остаток буферов и закрывает файлы
+ * @return ESP_OK при успехе
+ */
+esp_err_t call_recorder_stop(void);
+
+/**
+ * @brief Передача отсчетов в запись. Безопасно вызывать из HCI callback - никогда не блокирует
+ * @param stream Поток
+ * @param samples Отсчеты
+ * @param count Количество отсчетов
+ */
+void call_recorder_feed(call_recorder_stream_t stream, const int16_t *samples, uint32_t count);
+
+/**
+ * @brief Запись паузы, которую детектор речи отбросил: в файл идут нули
+ *
+ * Закодированный блок нулей кэшируется по состоянию кодера, поэтому длинные
+ * паузы почти не стоят процессорного времени даже для ADPCM и mSBC.
+ * @param stream Поток
+ * @param count Количество отсчетов
+ */
+void call_recorder_feed_silence(call_recorder_stream_t stream, uint32_t count);
+
+/**
+ * @brief Проверка, идет ли запись
+ * @return true если запись активна
+ */
+bool call_recorder_is_active(void);
+
+/**
+ * @brief Получение статистики записи
+ * @param stats Структура для записи статистики
+ */
+void call_recorder_get_stats(call_recorder_stats_t *stats);
+
+/**
+ * @brief Вывод статистики записи (пропускная способность, запас буфера) в лог
+ */
+void call_recorder_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALL_RECORDER_H */
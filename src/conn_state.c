@@ -0,0 +1,164 @@
+#include "conn_state.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+
+static const char *TAG = "CONN_STATE";
+
+#define NEXT_KEEP     0xFF   // Состояние не меняется, только флаги
+#define NEXT_REJECT   0xFE   // Событие недопустимо в этом состоянии
+
+#define ACT_RESET_ATTEMPTS   0x01
+#define ACT_COUNT_FAILURE    0x02   // +1 попытка; на CONN_MAX_ATTEMPTS - FAILED и сброс счетчика
+
+typedef struct {
+    uint8_t next;
+    uint8_t actions;
+    uint8_t set_flags;
+    uint8_t clear_flags;
+    uint8_t guard_clear;     // Флаги, которые должны быть сброшены, иначе событие отклоняется
+} conn_transition_t;
+
+#define T(next, act, set, clr, guard)  { (next), (act), (set), (clr), (guard) }
+#define X                              T(NEXT_REJECT, 0, 0, 0, 0)
+#define ALL(t)                         { t, t, t, t, t }
+
+#define F_PAGE    CONN_FLAG_PAGE_PENDING
+#define F_FOUND   CONN_FLAG_TARGET_FOUND
+#define F_ARMED   CONN_FLAG_AUDIO_ARMED
+#define F_ACTIVE  CONN_FLAG_AUDIO_ACTIVE
+
+// Строки - события, столбцы - состояния IDLE, SEARCHING, CONNECTING, CONNECTED, FAILED
+static const conn_transition_t s_table[CONN_EVT_COUNT][CONN_STATE_COUNT] = {
+    [CONN_EVT_START]          = { T(CONN_STATE_SEARCHING, ACT_RESET_ATTEMPTS, 0, 0, 0), X, X, X, X },
+    [CONN_EVT_STOP]           = ALL(T(CONN_STATE_IDLE, ACT_RESET_ATTEMPTS, 0, 0, 0)),
+    [CONN_EVT_TIMER]          = { T(CONN_STATE_SEARCHING, 0, 0, 0, 0), X, X, X, T(CONN_STATE_IDLE, 0, 0, 0, 0) },
+    [CONN_EVT_DISCOVERY_DONE] = { X, T(CONN_STATE_CONNECTING, 0, 0, 0, 0), X, X, X },
+    [CONN_EVT_PAGE_FAILED]    = { X, X, T(CONN_STATE_IDLE, ACT_COUNT_FAILURE, 0, F_PAGE | F_FOUND, 0), X, X },
+    [CONN_EVT_CONNECTED]      = ALL(T(CONN_STATE_CONNECTED, ACT_RESET_ATTEMPTS, 0, F_PAGE, 0)),
+    [CONN_EVT_DISCONNECTED]   = ALL(T(CONN_STATE_IDLE, 0, 0, F_PAGE | F_FOUND, 0)),
+    [CONN_EVT_ROUND_START]    = ALL(T(NEXT_KEEP, 0, 0, F_PAGE | F_FOUND, 0)),
+    [CONN_EVT_PAGE_START]     = { T(NEXT_KEEP, 0, F_PAGE | F_FOUND, 0, F_PAGE),
+                                  T(CONN_STATE_CONNECTING, 0, F_PAGE | F_FOUND, 0, F_PAGE),
+                                  T(NEXT_KEEP, 0, F_PAGE | F_FOUND, 0, F_PAGE),
+                                  T(NEXT_KEEP, 0, F_PAGE | F_FOUND, 0, F_PAGE),
+                                  T(NEXT_KEEP, 0, F_PAGE | F_FOUND, 0, F_PAGE) },
+    [CONN_EVT_PAGE_DONE]      = ALL(T(NEXT_KEEP, 0, 0, F_PAGE, 0)),
+    [CONN_EVT_AUDIO_ARM]      = ALL(T(NEXT_KEEP, 0, F_ARMED, 0, 0)),
+    [CONN_EVT_AUDIO_ON]       = ALL(T(NEXT_KEEP, 0, F_ARMED | F_ACTIVE, 0, 0)),
+    [CONN_EVT_AUDIO_OFF]      = ALL(T(NEXT_KEEP, 0, F_ARMED, F_ACTIVE, 0)),
+    [CONN_EVT_AUDIO_DISARM]   = ALL(T(NEXT_KEEP, 0, 0, F_ARMED | F_ACTIVE, 0)),
+};
+
+static const char *const s_state_names[CONN_STATE_COUNT] = {
+    "IDLE", "SEARCHING", "CONNECTING", "CONNECTED", "FAILED",
+};
+
+static _Atomic uint32_t s_word = 0;
+static atomic_uint s_applied = 0;
+static atomic_uint s_rejected = 0;
+static atomic_uint s_cas_retries = 0;
+
+static inline uint32_t make_word(uint32_t state, uint32_t attempts, uint32_t flags, uint32_t seq)
+{
+    return (state & 0xFF) | ((attempts & 0xFF) << 8) | ((flags & 0x0F) << 16) | ((seq & 0xFFF) << 20);
+}
+
+void conn_state_init(void)
+{
+    atomic_store_explicit(&s_word, make_word(CONN_STATE_IDLE, 0, 0, 0), memory_order_release);
+    atomic_store_explicit(&s_applied, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_rejected, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_cas_retries, 0, memory_order_relaxed);
+}
+
+uint32_t conn_state_load(void)
+{
+    return atomic_load_explicit(&s_word, memory_order_acquire);
+}
+
+bool conn_state_dispatch(conn_event_t event, uint32_t *old_word, uint32_t *new_word)
+{
+    if ((unsigned)event >= CONN_EVT_COUNT) {
+        return false;
+    }
+
+    uint32_t cur = atomic_load_explicit(&s_word, memory_order_acquire);
+    for (;;) {
+        uint32_t state = CONN_WORD_STATE(cur);
+        uint32_t attempts = CONN_WORD_ATTEMPTS(cur);
+        uint32_t flags = CONN_WORD_FLAGS(cur);
+        const conn_transition_t *t = &s_table[event][state < CONN_STATE_COUNT ? state : CONN_STATE_IDLE];
+
+        if (t->next == NEXT_REJECT || (flags & t->guard_clear) != 0) {
+            atomic_fetch_add_explicit(&s_rejected, 1, memory_order_relaxed);
+            if (old_word) {
+                *old_word = cur;
+            }
+            if (new_word) {
+                *new_word = cur;
+            }
+            return false;
+        }
+
+        uint32_t next = t->next == NEXT_KEEP ? state : t->next;
+        if (t->actions & ACT_RESET_ATTEMPTS) {
+            attempts = 0;
+        }
+        if (t->actions & ACT_COUNT_FAILURE) {
+            attempts++;
+            if (attempts >= CONN_MAX_ATTEMPTS) {
+                next = CONN_STATE_FAILED;
+                attempts = 0;
+            }
+        }
+        flags = (flags | t->set_flags) & ~(uint32_t)t->clear_flags;
+
+        uint32_t desired = make_word(next, attempts, flags, CONN_WORD_SEQ(cur) + 1);
+        // При неудаче cur обновляется свежим значением и переход пересчитывается
+        if (atomic_compare_exchange_weak_explicit(&s_word, &cur, desired,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            atomic_fetch_add_explicit(&s_applied, 1, memory_order_relaxed);
+            if (old_word) {
+                *old_word = cur;
+            }
+            if (new_word) {
+                *new_word = desired;
+            }
+            return true;
+        }
+        atomic_fetch_add_explicit(&s_cas_retries, 1, memory_order_relaxed);
+    }
+}
+
+conn_state_t conn_state_get(void)
+{
+    return CONN_WORD_STATE(conn_state_load());
+}
+
+bool conn_state_has_flag(uint32_t flag)
+{
+    return (CONN_WORD_FLAGS(conn_state_load()) & flag) != 0;
+}
+
+const char *conn_state_name(conn_state_t state)
+{
+    return (unsigned)state < CONN_STATE_COUNT ? s_state_names[state] : "?";
+}
+
+void conn_state_print(void)
+{
+    uint32_t w = conn_state_load();
+    uint32_t flags = CONN_WORD_FLAGS(w);
+
+    ESP_LOGI(TAG, "State %s, attempts %lu, flags:%s%s%s%s, seq %lu",
+             conn_state_name(CONN_WORD_STATE(w)), (unsigned long)CONN_WORD_ATTEMPTS(w),
+             (flags & CONN_FLAG_PAGE_PENDING) ? " page" : "",
+             (flags & CONN_FLAG_TARGET_FOUND) ? " found" : "",
+             (flags & CONN_FLAG_AUDIO_ARMED) ? " armed" : "",
+             (flags & CONN_FLAG_AUDIO_ACTIVE) ? " audio" : "",
+             (unsigned long)CONN_WORD_SEQ(w));
+    ESP_LOGI(TAG, "Transitions: %u applied, %u rejected, %u CAS retries",
+             atomic_load_explicit(&s_applied, memory_order_relaxed),
+             atomic_load_explicit(&s_rejected, memory_order_relaxed),
+             atomic_load_explicit(&s_cas_retries, memory_order_relaxed));
+}
@@ -0,0 +1,108 @@
+#ifndef CONN_STATE_H
+#define CONN_STATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Общее состояние подключения в одном 32-битном слове:
+ *   биты  0..7   состояние (conn_state_t)
+ *   биты  8..15  число неудачных попыток переподключения
+ *   биты 16..19  флаги CONN_FLAG_*
+ *   биты 20..31  номер перехода (меняется при каждом применённом событии)
+ * Слово публикуется атомарно, переходы - compare-and-swap по таблице,
+ * поэтому читатели из любых задач и callbacks видят согласованный снимок без мьютекса.
+ */
+typedef enum {
+    CONN_STATE_IDLE = 0,
+    CONN_STATE_SEARCHING,
+    CONN_STATE_CONNECTING,
+    CONN_STATE_CONNECTED,
+    CONN_STATE_FAILED,
+    CONN_STATE_COUNT,
+} conn_state_t;
+
+typedef enum {
+    CONN_EVT_START = 0,        // Запуск переподключения (только из IDLE)
+    CONN_EVT_STOP,             // Остановка переподключения
+    CONN_EVT_TIMER,            // Таймер переподключения: IDLE -> поиск, FAILED -> IDLE
+    CONN_EVT_DISCOVERY_DONE,   // Поиск завершен, подключаемся к последнему устройству
+    CONN_EVT_PAGE_FAILED,      // Подключение не запустилось или не состоялось (считается попытка)
+    CONN_EVT_CONNECTED,
+    CONN_EVT_DISCONNECTED,
+    CONN_EVT_ROUND_START,      // Новый раунд поиска цели: сброс флагов GAP
+    CONN_EVT_PAGE_START,       // GAP начинает подключение (отклоняется, если уже идет); из поиска - CONNECTING
+    CONN_EVT_PAGE_DONE,        // GAP подключение завершено или не запустилось
+    CONN_EVT_AUDIO_ARM,        // Аудио тракт подготовлен под SLC
+    CONN_EVT_AUDIO_ON,         // SCO открыт, тракт выдает кадры
+    CONN_EVT_AUDIO_OFF,        // SCO закрыт, тракт остается подготовленным
+    CONN_EVT_AUDIO_DISARM,     // SLC не осталось
+    CONN_EVT_COUNT,
+} conn_event_t;
+
+#define CONN_FLAG_PAGE_PENDING   0x01   // GAP подключение в процессе
+#define CONN_FLAG_TARGET_FOUND   0x02   // Цель найдена в текущем раунде
+#define CONN_FLAG_AUDIO_ARMED    0x04
+#define CONN_FLAG_AUDIO_ACTIVE   0x08
+
+#define CONN_MAX_ATTEMPTS        5
+
+#define CONN_WORD_STATE(w)       ((conn_state_t)((w) & 0xFF))
+#define CONN_WORD_ATTEMPTS(w)    (((w) >> 8) & 0xFF)
+#define CONN_WORD_FLAGS(w)       (((w) >> 16) & 0x0F)
+#define CONN_WORD_SEQ(w)         ((w) >> 20)
+
+/**
+ * @brief Сброс состояния в IDLE
+ */
+void conn_state_init(void);
+
+/**
+ * @brief Атомарный снимок слова состояния (acquire)
+ * @return Слово состояния
+ */
+uint32_t conn_state_load(void);
+
+/**
+ * @brief Применение события по таблице переходов
+ * @param event Событие
+ * @param old_word Слово до перехода (может быть NULL)
+ * @param new_word Слово после перехода (может быть NULL)
+ * @return true если переход применен, false если событие недопустимо в текущем состоянии
+ */
+bool conn_state_dispatch(conn_event_t event, uint32_t *old_word, uint32_t *new_word);
+
+/**
+ * @brief Текущее состояние
+ * @return Состояние
+ */
+conn_state_t conn_state_get(void);
+
+/**
+ * @brief Проверка флага
+ * @param flag CONN_FLAG_*
+ * @return true если флаг установлен
+ */
+bool conn_state_has_flag(uint32_t flag);
+
+/**
+ * @brief Имя состояния для логов
+ * @param state Состояние
+ * @return Строка
+ */
+const char *conn_state_name(conn_state_t state);
+
+/**
+ * @brief Вывод состояния и счетчиков переходов в лог
+ */
+void conn_state_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONN_STATE_H */
@@ -1,17 +1,124 @@
 #include "console_handler.h"
 #include "audio_handler.h"
+#include "call_recorder.h"
+#include "audio_mixer.h"
+#include "prompts.h"
+#include "hf_conn.h"
+#include "hf_handler.h"
+#include "paired_devices.h"
+#include "disc_cache.h"
+#include "target_policy.h"
+#include "gap_handler.h"
+#include "radio_sched.h"
+#include "conn_state.h"
+#include "metrics.h"
+#include "trace.h"
+#include "boot_phase.h"
+#include "dsp_kernels.h"
+#include "msbc.h"
+#include "dtmf.h"
+#include "audio_tap.h"
+#include "call_qoe.h"
+#include "loopback.h"
 #include "esp_log.h"
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "CONSOLE";
 
+#define CONSOLE_UART_NUM      CONFIG_ESP_CONSOLE_UART_NUM
+#define CONSOLE_RX_BUF_SIZE   256
+#define CONSOLE_LINE_LEN      80
+#define CONSOLE_TASK_STACK    4096
+#define CONSOLE_TASK_PRIO     2       // Ниже BT и аудио: команды не мешают разговору
+
+// Построчный ввод с UART консоли: эхо, backspace, выполнение по Enter
+static void console_task(void *arg)
+{
+    char line[CONSOLE_LINE_LEN];
+    size_t len = 0;
+    uint8_t ch;
+
+    for (;;) {
+        if (uart_read_bytes(CONSOLE_UART_NUM, &ch, 1, portMAX_DELAY) != 1) {
+            continue;
+        }
+        if (ch == '\r' || ch == '\n') {
+            if (len == 0) {
+                continue;
+            }
+            uart_write_bytes(CONSOLE_UART_NUM, "\r\n", 2);
+            line[len] = '\0';
+            console_handler_process_command(line);
+            len = 0;
+        } else if (ch == '\b' || ch == 0x7F) {
+            if (len > 0) {
+                len--;
+                uart_write_bytes(CONSOLE_UART_NUM, "\b \b", 3);
+            }
+        } else if (ch >= 0x20 && len < sizeof(line) - 1) {
+            line[len++] = (char)ch;
+            uart_write_bytes(CONSOLE_UART_NUM, &ch, 1);
+        }
+    }
+}
+
+static void console_start_repl(void)
+{
+    // Драйвер UART нужен для чтения; вывод логов идет через тот же порт
+    esp_err_t ret = uart_driver_install(CONSOLE_UART_NUM, CONSOLE_RX_BUF_SIZE, 0, 0, NULL, 0);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to install console UART driver: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    TaskHandle_t task = NULL;
+    if (xTaskCreate(console_task, "Console", CONSOLE_TASK_STACK, NULL, CONSOLE_TASK_PRIO, &task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create console task");
+        return;
+    }
+    metrics_watch_task(task, "Console");
+}
+
 void console_handler_init(void)
 {
     ESP_LOGI(TAG, "Console handler initialized");
     ESP_LOGI(TAG, "Available commands:");
     ESP_LOGI(TAG, "  'test_audio' - Send test audio signal");
     ESP_LOGI(TAG, "  'audio_status' - Check audio connection status");
+    ESP_LOGI(TAG, "  'rec_start [adpcm|msbc] [rx|tx]' - Record call audio to spiffs");
+    ESP_LOGI(TAG, "  'rec_stop' - Stop recording");
+    ESP_LOGI(TAG, "  'rec_status' - Recorder throughput and buffer headroom");
+    ESP_LOGI(TAG, "  'prompts' - List voice prompts in flash");
+    ESP_LOGI(TAG, "  'prompt <name> [loop]' - Play a prompt into the call");
+    ESP_LOGI(TAG, "  'prompt_stop' - Stop all prompts");
+    ESP_LOGI(TAG, "  'links' - Show connected headsets");
+    ESP_LOGI(TAG, "  'audio_open' / 'audio_close' - Open/close SCO to the first headset");
+    ESP_LOGI(TAG, "  'paired' - Show paired devices with cached codecs");
+    ESP_LOGI(TAG, "  'disc' - Show discovery cache");
+    ESP_LOGI(TAG, "  'targets' - Show target patterns and best candidate");
+    ESP_LOGI(TAG, "  'target_add <name|AA:BB:CC>' - Add a target pattern");
+    ESP_LOGI(TAG, "  'radio' - Radio scheduler mode and airtime");
+    ESP_LOGI(TAG, "  'pair' - Become discoverable for 60 s");
+    ESP_LOGI(TAG, "  'state' - Connection state word and transition counters");
+    ESP_LOGI(TAG, "  'stats [reset]' - Dump or reset runtime metrics");
+    ESP_LOGI(TAG, "  'boot' - Boot phase timing report");
+    ESP_LOGI(TAG, "  'dsp [bench]' - Check DSP kernels against reference, cycles per sample");
+    ESP_LOGI(TAG, "  'msbc' - mSBC codec self-test against reference vectors, cycles per frame");
+    ESP_LOGI(TAG, "  'vad [on|off]' - Voice activity detection on capture, noise estimate");
+    ESP_LOGI(TAG, "  'agc [on|off]' - Capture AGC and limiter, headset volume ramps");
+    ESP_LOGI(TAG, "  'dtmf' - DTMF digits received this call");
+    ESP_LOGI(TAG, "  'tap on [raw] [rx] [tx] [pcm|adpcm]|off' - Stream PCM to UART%d for tools/audio_tap_rx.py",
+             AUDIO_TAP_UART_NUM);
+    ESP_LOGI(TAG, "  'loopback [rx]|stop|last' - Latency, THD+N, SNR and response through a looped-back headset");
+    ESP_LOGI(TAG, "  'calls [N|summary|clear]' - Per-call quality log: MOS, loss, buffering, echo loss");
+    ESP_LOGI(TAG, "  'trace on|off|dump|save' - Event trace, Chrome JSON to UART or " TRACE_FILE_PATH);
+
+    console_start_repl();
 }
 
 void console_handler_process_command(const char *command)
@@ -22,6 +129,180 @@ void console_handler_process_command(const char *command)
     } else if (strncmp(command, "audio_status", 12) == 0) {
         bool connected = audio_handler_is_connected();
         ESP_LOGI(TAG, "🎙️ Audio status: %s", connected ? "CONNECTED" : "DISCONNECTED");
+        if (connected) {
+            ESP_LOGI(TAG, "⏱️ First frame served %lu us after SCO open",
+                     (unsigned long)audio_handler_get_first_frame_us());
+        }
+    } else if (strncmp(command, "rec_start", 9) == 0) {
+        call_recorder_format_t format = CALL_RECORDER_FORMAT_PCM16;
+        if (strstr(command, "adpcm")) {
+            format = CALL_RECORDER_FORMAT_IMA_ADPCM;
+        } else if (strstr(command, "msbc")) {
+            format = CALL_RECORDER_FORMAT_MSBC;
+        }
+        uint8_t mask = CALL_RECORDER_MASK_ALL;
+        if (strstr(command, " rx")) {
+            mask = CALL_RECORDER_MASK_RX;
+        } else if (strstr(command, " tx")) {
+            mask = CALL_RECORDER_MASK_TX;
+        }
+        esp_err_t ret = call_recorder_start(mask, format, audio_handler_get_sample_rate());
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to start recording: %s", esp_err_to_name(ret));
+        }
+    } else if (strncmp(command, "rec_stop", 8) == 0) {
+        call_recorder_stop();
+    } else if (strncmp(command, "rec_status", 10) == 0) {
+        call_recorder_print_stats();
+    } else if (strncmp(command, "prompt_stop", 11) == 0) {
+        prompts_stop_all(50);
+    } else if (strncmp(command, "prompts", 7) == 0) {
+        prompts_print_list();
+    } else if (strncmp(command, "prompt ", 7) == 0) {
+        char name[PROMPTS_NAME_LEN] = {0};
+        const char *arg = command + 7;
+        size_t len = strcspn(arg, " \r\n");
+        if (len >= sizeof(name)) {
+            len = sizeof(name) - 1;
+        }
+        memcpy(name, arg, len);
+        const prompt_play_cfg_t cfg = {
+            .priority = 10,
+            .gain = AUDIO_MIXER_GAIN_UNITY,
+            .loop = strstr(arg + len, "loop") != NULL,
+            .fade_ms = 10,
+        };
+        prompts_play(name, &cfg, NULL);
+    } else if (strncmp(command, "links", 5) == 0) {
+        hf_conn_print();
+    } else if (strncmp(command, "audio_open", 10) == 0 || strncmp(command, "audio_close", 11) == 0) {
+        hf_conn_t *conn = NULL;
+        for (int i = 0; i < HF_CONN_MAX && conn == NULL; i++) {
+            conn = hf_conn_at(i);
+        }
+        if (conn == NULL) {
+            ESP_LOGW(TAG, "No headset connected");
+        } else if (command[6] == 'o') {
+            hf_handler_audio_open(conn->bda);
+        } else {
+            hf_handler_audio_close(conn->bda);
+        }
+    } else if (strncmp(command, "paired", 6) == 0) {
+        paired_devices_print_list();
+    } else if (strncmp(command, "disc", 4) == 0) {
+        disc_cache_print();
+    } else if (strncmp(command, "radio", 5) == 0) {
+        radio_sched_print_stats();
+    } else if (strncmp(command, "pair", 4) == 0) {
+        radio_sched_open_pairing_window(RADIO_PAIRING_WINDOW_MS);
+    } else if (strncmp(command, "stats", 5) == 0) {
+        if (strstr(command + 5, "reset")) {
+            metrics_reset();
+        } else {
+            metrics_print();
+        }
+    } else if (strncmp(command, "boot", 4) == 0) {
+        boot_phase_report();
+    } else if (strncmp(command, "vad", 3) == 0) {
+        if (strstr(command, "off")) {
+            audio_handler_set_vad(false);
+        } else if (strstr(command, "on")) {
+            audio_handler_set_vad(true);
+        }
+        audio_handler_print_vad();
+    } else if (strncmp(command, "agc", 3) == 0) {
+        if (strstr(command, "off")) {
+            audio_handler_set_agc(false);
+        } else if (strstr(command, "on")) {
+            audio_handler_set_agc(true);
+        }
+        audio_handler_print_agc();
+    } else if (strncmp(command, "dtmf", 4) == 0) {
+        audio_handler_print_dtmf();
+    } else if (strncmp(command, "msbc", 4) == 0) {
+        msbc_selftest();
+    } else if (strncmp(command, "dsp", 3) == 0) {
+        if (dsp_selftest(strstr(command + 3, "bench") != NULL) != ESP_OK) {
+            ESP_LOGE(TAG, "DSP kernel mismatch, backend %s", dsp_backend_name());
+        }
+    } else if (strncmp(command, "trace", 5) == 0) {
+        const char *arg = command + 5;
+        if (strstr(arg, "on")) {
+            trace_start();
+        } else if (strstr(arg, "off")) {
+            trace_stop();
+        } else if (strstr(arg, "dump")) {
+            trace_export_uart();
+        } else if (strstr(arg, "save")) {
+            esp_err_t ret = trace_export_file(TRACE_FILE_PATH);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to save trace: %s", esp_err_to_name(ret));
+            }
+        } else {
+            trace_print_status();
+        }
+    } else if (strncmp(command, "tap", 3) == 0) {
+        const char *arg = command + 3;
+        if (strstr(arg, "off")) {
+            audio_tap_stop();
+        } else if (strstr(arg, "on")) {
+            uint8_t mask = 0;
+            if (strstr(arg, " raw")) {
+                mask |= AUDIO_TAP_MASK_RAW;
+            }
+            if (strstr(arg, " rx")) {
+                mask |= AUDIO_TAP_MASK_RX;
+            }
+            if (strstr(arg, " tx")) {
+                mask |= AUDIO_TAP_MASK_TX;
+            }
+            audio_tap_codec_t codec = AUDIO_TAP_CODEC_AUTO;
+            if (strstr(arg, "adpcm")) {
+                codec = AUDIO_TAP_CODEC_ADPCM;
+            } else if (strstr(arg, " pcm")) {
+                codec = AUDIO_TAP_CODEC_PCM;
+            }
+            esp_err_t ret = audio_tap_start(mask != 0 ? mask : AUDIO_TAP_MASK_ALL, codec);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to start audio tap: %s", esp_err_to_name(ret));
+            }
+        } else {
+            audio_tap_print_stats();
+        }
+    } else if (strncmp(command, "loopback", 8) == 0) {
+        const char *arg = command + 8;
+        if (strstr(arg, "stop")) {
+            loopback_stop();
+        } else if (strstr(arg, "last")) {
+            loopback_print_result();
+        } else {
+            loopback_start(strstr(arg, "rx") != NULL);
+        }
+    } else if (strncmp(command, "calls", 5) == 0) {
+        const char *arg = command + 5;
+        if (strstr(arg, "summary")) {
+            call_qoe_print_summary();
+        } else if (strstr(arg, "clear")) {
+            call_qoe_clear();
+        } else {
+            call_qoe_print((uint32_t)strtoul(arg, NULL, 10));
+        }
+    } else if (strncmp(command, "state", 5) == 0) {
+        conn_state_print();
+    } else if (strncmp(command, "targets", 7) == 0) {
+        target_policy_print();
+    } else if (strncmp(command, "target_add ", 11) == 0) {
+        char pattern[TARGET_POLICY_PATTERN_LEN] = {0};
+        const char *arg = command + 11;
+        size_t len = strcspn(arg, "\r\n");
+        if (len >= sizeof(pattern)) {
+            len = sizeof(pattern) - 1;
+        }
+        memcpy(pattern, arg, len);
+        esp_err_t ret = gap_add_target(pattern);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to add target: %s", esp_err_to_name(ret));
+        }
     } else {
         ESP_LOGW(TAG, "Unknown command: %s", command);
     }
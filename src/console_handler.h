@@ -2,7 +2,7 @@
 #define CONSOLE_HANDLER_H
 
 /**
- * @brief Инициализация консольного обработчика
+ * @brief Инициализация консольного обработчика и запуск REPL на UART консоли
  */
 void console_handler_init(void);
 
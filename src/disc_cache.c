@@ -0,0 +1,281 @@
+#include "disc_cache.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "DISC_CACHE";
+
+static disc_cache_entry_t s_entries[DISC_CACHE_SIZE];
+static int s_count = 0;
+
+static struct {
+    uint32_t results;     // Всего DISC_RES
+    uint32_t repeats;     // Повторов без изменений (разбор пропущен)
+    uint32_t parsed;      // Разобранных ответов
+    uint32_t evictions;
+} s_stats;
+
+// Базовый UUID Bluetooth в порядке байт EIR (little-endian), без 16-битной части
+static const uint8_t s_base_uuid_lo[12] = {
+    0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00
+};
+
+// FNV-1a: дешевое сравнение повторных ответов без разбора
+static uint32_t fnv1a(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void add_uuid(disc_cache_entry_t *e, uint16_t uuid)
+{
+    for (int i = 0; i < e->uuid_count; i++) {
+        if (e->uuids[i] == uuid) {
+            return;
+        }
+    }
+    if (e->uuid_count < DISC_CACHE_MAX_UUIDS) {
+        e->uuids[e->uuid_count++] = uuid;
+    }
+}
+
+static void set_name(disc_cache_entry_t *e, const uint8_t *name, size_t len, bool complete)
+{
+    // Сокращенное имя не затирает уже известное полное
+    if (!complete && e->name_complete && e->name[0]) {
+        return;
+    }
+    if (len >= sizeof(e->name)) {
+        len = sizeof(e->name) - 1;
+    }
+    memcpy(e->name, name, len);
+    e->name[len] = '\0';
+    e->name_complete = complete;
+}
+
+// Один проход по всем полям EIR вместо поиска каждого типа отдельно
+static void parse_eir(disc_cache_entry_t *e, const uint8_t *eir, int eir_len)
+{
+    int pos = 0;
+    while (pos < eir_len) {
+        uint8_t field_len = eir[pos];
+        if (field_len == 0 || pos + 1 + field_len > eir_len) {
+            break;
+        }
+        uint8_t type = eir[pos + 1];
+        const uint8_t *data = &eir[pos + 2];
+        int data_len = field_len - 1;
+
+        switch (type) {
+            case ESP_BT_EIR_TYPE_CMPL_LOCAL_NAME:
+                set_name(e, data, data_len, true);
+                break;
+            case ESP_BT_EIR_TYPE_SHORT_LOCAL_NAME:
+                set_name(e, data, data_len, false);
+                break;
+            case 0x02:  // Неполный список 16-битных UUID
+            case 0x03:  // Полный список 16-битных UUID
+                for (int i = 0; i + 1 < data_len; i += 2) {
+                    add_uuid(e, (uint16_t)(data[i] | (data[i + 1] << 8)));
+                }
+                break;
+            case 0x06:  // 128-битные UUID: сохраняем только производные от базового
+            case 0x07:
+                for (int i = 0; i + 15 < data_len; i += 16) {
+                    if (memcmp(&data[i], s_base_uuid_lo, sizeof(s_base_uuid_lo)) == 0 &&
+                        data[i + 14] == 0 && data[i + 15] == 0) {
+                        add_uuid(e, (uint16_t)(data[i + 12] | (data[i + 13] << 8)));
+                    }
+                }
+                break;
+            case ESP_BT_EIR_TYPE_TX_POWER_LEVEL:
+                if (data_len >= 1) {
+                    e->tx_power = (int8_t)data[0];
+                }
+                break;
+            default:
+                break;
+        }
+        pos += 1 + field_len;
+    }
+}
+
+static int find_index(const uint8_t *bda)
+{
+    for (int i = 0; i < s_count; i++) {
+        if (memcmp(s_entries[i].bda, bda, ESP_BD_ADDR_LEN) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Свободный слот или давно не виденное устройство
+static disc_cache_entry_t *alloc_entry(void)
+{
+    if (s_count < DISC_CACHE_SIZE) {
+        return &s_entries[s_count++];
+    }
+
+    int oldest = 0;
+    for (int i = 1; i < DISC_CACHE_SIZE; i++) {
+        if (s_entries[i].last_seen_us < s_entries[oldest].last_seen_us) {
+            oldest = i;
+        }
+    }
+    s_stats.evictions++;
+    return &s_entries[oldest];
+}
+
+esp_err_t disc_cache_init(void)
+{
+    disc_cache_clear();
+    ESP_LOGI(TAG, "Discovery cache initialized: %d entries, fresh window %d ms",
+             DISC_CACHE_SIZE, DISC_CACHE_FRESH_MS);
+    return ESP_OK;
+}
+
+disc_cache_entry_t *disc_cache_update(const esp_bt_gap_cb_param_t *param, bool *changed)
+{
+    const uint8_t *bda = param->disc_res.bda;
+    int64_t now = esp_timer_get_time();
+    int8_t rssi = 0;
+    uint32_t hash = 2166136261u;
+
+    s_stats.results++;
+
+    // Хешируем все, кроме RSSI, который меняется в каждом ответе
+    for (int i = 0; i < param->disc_res.num_prop; i++) {
+        const esp_bt_gap_dev_prop_t *prop = &param->disc_res.prop[i];
+        if (prop->type == ESP_BT_GAP_DEV_PROP_RSSI) {
+            rssi = *(int8_t *)prop->val;
+        } else if (prop->val != NULL && prop->len > 0) {
+            hash = fnv1a(hash, &prop->type, sizeof(prop->type));
+            hash = fnv1a(hash, prop->val, prop->len);
+        }
+    }
+
+    disc_cache_entry_t *e = NULL;
+    int idx = find_index(bda);
+    if (idx >= 0) {
+        e = &s_entries[idx];
+        if (e->data_hash == hash) {
+            s_stats.repeats++;
+            e->last_seen_us = now;
+            e->seen_count++;
+            e->skip_used = false;
+            if (rssi != 0) {
+                e->rssi = rssi;
+            }
+            if (changed) {
+                *changed = false;
+            }
+            return e;
+        }
+    } else {
+        e = alloc_entry();
+        memset(e, 0, sizeof(*e));
+        memcpy(e->bda, bda, ESP_BD_ADDR_LEN);
+        e->first_seen_us = now;
+    }
+
+    s_stats.parsed++;
+    e->data_hash = hash;
+    e->last_seen_us = now;
+    e->seen_count++;
+    e->skip_used = false;
+    e->match_gen = 0;  // Данные изменились - проверку цели нужно повторить
+    if (rssi != 0) {
+        e->rssi = rssi;
+    }
+
+    for (int i = 0; i < param->disc_res.num_prop; i++) {
+        const esp_bt_gap_dev_prop_t *prop = &param->disc_res.prop[i];
+        switch (prop->type) {
+            case ESP_BT_GAP_DEV_PROP_EIR:
+                parse_eir(e, (const uint8_t *)prop->val, prop->len);
+                break;
+            case ESP_BT_GAP_DEV_PROP_BDNAME:
+                set_name(e, (const uint8_t *)prop->val, strnlen((const char *)prop->val, prop->len), true);
+                break;
+            case ESP_BT_GAP_DEV_PROP_COD:
+                e->cod = *(uint32_t *)prop->val;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (changed) {
+        *changed = true;
+    }
+    return e;
+}
+
+disc_cache_entry_t *disc_cache_find(const esp_bd_addr_t bda)
+{
+    int idx = find_index(bda);
+    return idx >= 0 ? &s_entries[idx] : NULL;
+}
+
+int disc_cache_count(void)
+{
+    return s_count;
+}
+
+disc_cache_entry_t *disc_cache_at(int index)
+{
+    if (index < 0 || index >= s_count) {
+        return NULL;
+    }
+    return &s_entries[index];
+}
+
+uint32_t disc_cache_age_ms(const disc_cache_entry_t *entry)
+{
+    return (uint32_t)((esp_timer_get_time() - entry->last_seen_us) / 1000);
+}
+
+bool disc_cache_has_uuid(const disc_cache_entry_t *entry, uint16_t uuid16)
+{
+    for (int i = 0; i < entry->uuid_count; i++) {
+        if (entry->uuids[i] == uuid16) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void disc_cache_clear(void)
+{
+    memset(s_entries, 0, sizeof(s_entries));
+    s_count = 0;
+}
+
+void disc_cache_print(void)
+{
+    ESP_LOGI(TAG, "=== Discovery cache (%d/%d) ===", s_count, DISC_CACHE_SIZE);
+    for (int i = 0; i < s_count; i++) {
+        const disc_cache_entry_t *e = &s_entries[i];
+        ESP_LOGI(TAG, "%d. " ESP_BD_ADDR_STR " '%s'%s, COD 0x%06lx, RSSI %d, seen %lu times, %lu ms ago",
+                 i + 1, ESP_BD_ADDR_HEX(e->bda), e->name, e->name_complete ? "" : " (short)",
+                 (unsigned long)e->cod, e->rssi, (unsigned long)e->seen_count,
+                 (unsigned long)disc_cache_age_ms(e));
+        if (e->uuid_count > 0) {
+            char uuids[DISC_CACHE_MAX_UUIDS * 7 + 1] = {0};
+            int pos = 0;
+            for (int u = 0; u < e->uuid_count; u++) {
+                pos += snprintf(uuids + pos, sizeof(uuids) - pos, " %04x", e->uuids[u]);
+            }
+            ESP_LOGI(TAG, "   UUIDs:%s", uuids);
+        }
+    }
+    ESP_LOGI(TAG, "Results %lu, repeats %lu (parse skipped), parsed %lu, evictions %lu",
+             (unsigned long)s_stats.results, (unsigned long)s_stats.repeats,
+             (unsigned long)s_stats.parsed, (unsigned long)s_stats.evictions);
+}
@@ -0,0 +1,99 @@
+#ifndef DISC_CACHE_H
+#define DISC_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_bt_defs.h"
+#include "esp_gap_bt_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DISC_CACHE_SIZE           16     // Устройств в кэше (вытесняется давно не виденное)
+#define DISC_CACHE_NAME_LEN       64
+#define DISC_CACHE_MAX_UUIDS      8      // 16-битных UUID сервисов на устройство
+#define DISC_CACHE_FRESH_MS       30000  // Устройство, виденное недавно, не требует нового поиска
+
+#define DISC_CACHE_UUID_HEADSET   0x1108
+#define DISC_CACHE_UUID_HANDSFREE 0x111E
+
+typedef struct {
+    esp_bd_addr_t bda;
+    char name[DISC_CACHE_NAME_LEN];
+    bool name_complete;           // Полное имя (иначе сокращенное из EIR)
+    uint32_t cod;
+    int8_t rssi;                  // Последний RSSI, дБм (0 - неизвестен)
+    int8_t tx_power;              // Мощность из EIR, дБм (0 - нет)
+    uint8_t uuid_count;
+    uint16_t uuids[DISC_CACHE_MAX_UUIDS];
+    int64_t first_seen_us;
+    int64_t last_seen_us;
+    uint32_t seen_count;
+    uint32_t data_hash;           // Хеш сырого ответа: повтор не разбирается заново
+    uint16_t match_gen;           // Поколение фильтра, для которого посчитан matched
+    bool matched;                 // Закэшированный результат проверки цели вызывающим
+    bool skip_used;               // Запись уже использована вместо поиска
+} disc_cache_entry_t;
+
+/**
+ * @brief Инициализация кэша результатов поиска
+ * @return ESP_OK при успехе
+ */
+esp_err_t disc_cache_init(void);
+
+/**
+ * @brief Учет результата ESP_BT_GAP_DISC_RES_EVT
+ * @param param Параметры события
+ * @param changed true, если устройство новое или его данные изменились
+ * @return Запись кэша (действительна до следующего вызова update/clear)
+ *
+ * Повторный ответ с теми же данными обновляет только RSSI и время.
+ */
+disc_cache_entry_t *disc_cache_update(const esp_bt_gap_cb_param_t *param, bool *changed);
+
+/**
+ * @brief Поиск устройства в кэше
+ * @param bda Адрес устройства
+ * @return Запись кэша или NULL
+ */
+disc_cache_entry_t *disc_cache_find(const esp_bd_addr_t bda);
+
+/**
+ * @brief Количество записей и доступ к ним по индексу
+ * @return Количество записей
+ */
+int disc_cache_count(void);
+disc_cache_entry_t *disc_cache_at(int index);
+
+/**
+ * @brief Возраст записи
+ * @param entry Запись кэша
+ * @return Миллисекунды с последнего ответа устройства
+ */
+uint32_t disc_cache_age_ms(const disc_cache_entry_t *entry);
+
+/**
+ * @brief Проверка наличия сервиса в EIR
+ * @param entry Запись кэша
+ * @param uuid16 16-битный UUID сервиса
+ * @return true если сервис объявлен
+ */
+bool disc_cache_has_uuid(const disc_cache_entry_t *entry, uint16_t uuid16);
+
+/**
+ * @brief Очистка кэша
+ */
+void disc_cache_clear(void);
+
+/**
+ * @brief Вывод кэша и статистики разбора в лог
+ */
+void disc_cache_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISC_CACHE_H */
@@ -0,0 +1,484 @@
+#include "dsp_kernels.h"
+#include "dsp_kernels_impl.h"
+#include "esp_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#if DSP_HAVE_X86
+#include <x86intrin.h>
+#else
+#include "esp_cpu.h"
+#endif
+
+static const char *TAG = "DSP";
+
+#define SELFTEST_MAX_N     256
+#define BENCH_N            240    // Блок mSBC: 15 мс при 16 кГц
+#define BENCH_REPS         200
+#define BENCH_FIR_TAPS     31
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (v < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)v;
+}
+
+// ---- Эталонные ядра ----
+
+void dsp_ref_add_sat16(int16_t *dst, const int16_t *src, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = sat16((int32_t)dst[i] + src[i]);
+    }
+}
+
+void dsp_ref_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = sat16(((int32_t)src[i] * gain + (1 << 14)) >> 15);
+    }
+}
+
+void dsp_ref_mac_q15(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        acc[i] += ((int32_t)src[i] * gain) >> 15;
+    }
+}
+
+uint32_t dsp_ref_sat16(int16_t *dst, const int32_t *src, uint32_t n)
+{
+    uint32_t clipped = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t v = src[i];
+        if (v > INT16_MAX || v < INT16_MIN) {
+            clipped++;
+        }
+        dst[i] = sat16(v);
+    }
+    return clipped;
+}
+
+int64_t dsp_ref_dot_q15(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        sum += (int32_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+const dsp_kernels_t dsp_kernels_ref = {
+    .name = "ref",
+    .add_sat16 = dsp_ref_add_sat16,
+    .scale_q15 = dsp_ref_scale_q15,
+    .mac_q15 = dsp_ref_mac_q15,
+    .sat16 = dsp_ref_sat16,
+    .dot_q15 = dsp_ref_dot_q15,
+};
+
+// ---- Выбор варианта ----
+
+#if defined(__XTENSA__)
+static const dsp_kernels_t *s_k = &dsp_kernels_unrolled;
+#elif DSP_HAVE_X86
+static const dsp_kernels_t *s_k = &dsp_kernels_sse2;
+#else
+static const dsp_kernels_t *s_k = &dsp_kernels_ref;
+#endif
+
+void dsp_init(void)
+{
+#if DSP_HAVE_X86
+    if (dsp_x86_has_avx2()) {
+        s_k = &dsp_kernels_avx2;
+    }
+#endif
+    ESP_LOGI(TAG, "DSP kernels: %s", s_k->name);
+}
+
+const char *dsp_backend_name(void)
+{
+    return s_k->name;
+}
+
+void dsp_add_sat16(int16_t *dst, const int16_t *src, uint32_t n)
+{
+    s_k->add_sat16(dst, src, n);
+}
+
+void dsp_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain)
+{
+    s_k->scale_q15(dst, src, n, gain);
+}
+
+void dsp_mac_q15(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain)
+{
+    s_k->mac_q15(acc, src, n, gain);
+}
+
+uint32_t dsp_sat16(int16_t *dst, const int32_t *src, uint32_t n)
+{
+    return s_k->sat16(dst, src, n);
+}
+
+int64_t dsp_dot_q15(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    return s_k->dot_q15(a, b, n);
+}
+
+static uint32_t isqrt64(uint64_t v)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+uint32_t dsp_rms_q15(const int16_t *x, uint32_t n)
+{
+    if (n == 0) {
+        return 0;
+    }
+    return isqrt64((uint64_t)s_k->dot_q15(x, x, n) / n);
+}
+
+// ---- FIR ----
+
+esp_err_t dsp_fir_init(dsp_fir_t *fir, const int16_t *coeffs_q15, uint16_t taps)
+{
+    if (fir == NULL || coeffs_q15 == NULL || taps == 0 || taps > DSP_FIR_MAX_TAPS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    fir->coeffs = malloc(taps * sizeof(int16_t));
+    fir->buf = calloc(taps - 1 + DSP_FIR_BLOCK, sizeof(int16_t));
+    if (fir->coeffs == NULL || fir->buf == NULL) {
+        dsp_fir_free(fir);
+        return ESP_ERR_NO_MEM;
+    }
+    for (uint16_t k = 0; k < taps; k++) {
+        fir->coeffs[k] = coeffs_q15[taps - 1 - k];
+    }
+    fir->taps = taps;
+    return ESP_OK;
+}
+
+void dsp_fir_free(dsp_fir_t *fir)
+{
+    free(fir->coeffs);
+    free(fir->buf);
+    fir->coeffs = NULL;
+    fir->buf = NULL;
+    fir->taps = 0;
+}
+
+void dsp_fir_reset(dsp_fir_t *fir)
+{
+    memset(fir->buf, 0, (fir->taps - 1) * sizeof(int16_t));
+}
+
+void dsp_fir_process(dsp_fir_t *fir, int16_t *out, const int16_t *in, uint32_t n)
+{
+    uint32_t hist = fir->taps - 1;
+
+    while (n > 0) {
+        uint32_t chunk = n < DSP_FIR_BLOCK ? n : DSP_FIR_BLOCK;
+        // Вход копируется за историей, поэтому out может совпадать с in
+        memcpy(fir->buf + hist, in, chunk * sizeof(int16_t));
+        for (uint32_t i = 0; i < chunk; i++) {
+            int64_t acc = s_k->dot_q15(fir->coeffs, fir->buf + i, fir->taps);
+            int64_t y = (acc + (1 << 14)) >> 15;
+            out[i] = y > INT16_MAX ? INT16_MAX : (y < INT16_MIN ? INT16_MIN : (int16_t)y);
+        }
+        memmove(fir->buf, fir->buf + chunk, hist * sizeof(int16_t));
+        in += chunk;
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+// ---- Биквад ----
+
+void dsp_biquad_init(dsp_biquad_t *bq, const int16_t coeffs_q14[5])
+{
+    memset(bq, 0, sizeof(*bq));
+    bq->b0 = coeffs_q14[0];
+    bq->b1 = coeffs_q14[1];
+    bq->b2 = coeffs_q14[2];
+    bq->a1 = coeffs_q14[3];
+    bq->a2 = coeffs_q14[4];
+}
+
+void dsp_biquad_process(dsp_biquad_t *bq, int16_t *out, const int16_t *in, uint32_t n)
+{
+    int32_t x1 = bq->x1, x2 = bq->x2, y1 = bq->y1, y2 = bq->y2;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x = in[i];
+        // Пять произведений до 2^30 каждое: накопление в 64 битах
+        int64_t acc = (int64_t)bq->b0 * x + (int64_t)bq->b1 * x1 + (int64_t)bq->b2 * x2
+                      - (int64_t)bq->a1 * y1 - (int64_t)bq->a2 * y2;
+        int64_t y = (acc + (1 << 13)) >> 14;
+        int16_t ys = y > INT16_MAX ? INT16_MAX : (y < INT16_MIN ? INT16_MIN : (int16_t)y);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = ys;
+        out[i] = ys;
+    }
+    bq->x1 = (int16_t)x1;
+    bq->x2 = (int16_t)x2;
+    bq->y1 = (int16_t)y1;
+    bq->y2 = (int16_t)y2;
+}
+
+// ---- Самопроверка и замер ----
+
+static int16_t s_a[SELFTEST_MAX_N + 1];
+static int16_t s_b[SELFTEST_MAX_N + 1];
+static int16_t s_o1[SELFTEST_MAX_N + 1];
+static int16_t s_o2[SELFTEST_MAX_N + 1];
+static int32_t s_acc1[SELFTEST_MAX_N + 1];
+static int32_t s_acc2[SELFTEST_MAX_N + 1];
+
+static uint32_t xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+// Случайные отсчеты с частыми граничными значениями
+static int16_t rand_sample(uint32_t *seed)
+{
+    uint32_t r = xorshift32(seed);
+    switch (r & 7) {
+    case 0:
+        return INT16_MIN;
+    case 1:
+        return INT16_MAX;
+    default:
+        return (int16_t)(r >> 16);
+    }
+}
+
+static int32_t rand_acc(uint32_t *seed)
+{
+    uint32_t r = xorshift32(seed);
+    switch (r & 7) {
+    case 0:
+        return INT16_MIN - (int32_t)(r >> 20);
+    case 1:
+        return INT16_MAX + (int32_t)(r >> 20);
+    case 2:
+        return (int32_t)r >> 3;
+    default:
+        return (int16_t)(r >> 16);
+    }
+}
+
+static uint32_t dsp_variants(const dsp_kernels_t **list)
+{
+    uint32_t count = 0;
+    list[count++] = &dsp_kernels_ref;
+#if DSP_HAVE_X86
+    list[count++] = &dsp_kernels_sse2;
+    if (dsp_x86_has_avx2()) {
+        list[count++] = &dsp_kernels_avx2;
+    }
+#endif
+    list[count++] = &dsp_kernels_unrolled;
+    return count;
+}
+
+static const int16_t s_scale_gains[] = { 0, 1, -1, 12345, 16384, -16384, INT16_MAX, INT16_MIN };
+static const int32_t s_mac_gains[] = { 0, 1, -1, 16384, 32767, -32768, 32768, 40000, 65536, -65535 };
+
+// Сверка одного варианта с эталоном; off = 1 проверяет невыровненные указатели
+static bool dsp_check_variant(const dsp_kernels_t *k, uint32_t n, uint32_t off, uint32_t *seed)
+{
+    int16_t *a = s_a + off, *b = s_b + off, *o1 = s_o1 + off, *o2 = s_o2 + off;
+    int32_t *acc1 = s_acc1 + off, *acc2 = s_acc2 + off;
+
+    for (uint32_t i = 0; i < n; i++) {
+        a[i] = rand_sample(seed);
+        b[i] = rand_sample(seed);
+        acc1[i] = rand_acc(seed);
+    }
+
+    memcpy(o1, a, n * sizeof(int16_t));
+    memcpy(o2, a, n * sizeof(int16_t));
+    dsp_ref_add_sat16(o1, b, n);
+    k->add_sat16(o2, b, n);
+    if (memcmp(o1, o2, n * sizeof(int16_t)) != 0) {
+        ESP_LOGE(TAG, "%s: add_sat16 mismatch (n=%" PRIu32 ")", k->name, n);
+        return false;
+    }
+
+    for (size_t g = 0; g < sizeof(s_scale_gains) / sizeof(s_scale_gains[0]); g++) {
+        dsp_ref_scale_q15(o1, a, n, s_scale_gains[g]);
+        k->scale_q15(o2, a, n, s_scale_gains[g]);
+        if (memcmp(o1, o2, n * sizeof(int16_t)) != 0) {
+            ESP_LOGE(TAG, "%s: scale_q15 mismatch (n=%" PRIu32 ", gain %d)", k->name, n, s_scale_gains[g]);
+            return false;
+        }
+    }
+
+    for (size_t g = 0; g < sizeof(s_mac_gains) / sizeof(s_mac_gains[0]); g++) {
+        for (uint32_t i = 0; i < n; i++) {
+            acc2[i] = acc1[i] = (int32_t)(xorshift32(seed) >> 2) - (1 << 29);
+        }
+        dsp_ref_mac_q15(acc1, a, n, s_mac_gains[g]);
+        k->mac_q15(acc2, a, n, s_mac_gains[g]);
+        if (memcmp(acc1, acc2, n * sizeof(int32_t)) != 0) {
+            ESP_LOGE(TAG, "%s: mac_q15 mismatch (n=%" PRIu32 ", gain %" PRId32 ")", k->name, n, s_mac_gains[g]);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        acc1[i] = rand_acc(seed);
+    }
+    uint32_t c1 = dsp_ref_sat16(o1, acc1, n);
+    uint32_t c2 = k->sat16(o2, acc1, n);
+    if (c1 != c2 || memcmp(o1, o2, n * sizeof(int16_t)) != 0) {
+        ESP_LOGE(TAG, "%s: sat16 mismatch (n=%" PRIu32 ")", k->name, n);
+        return false;
+    }
+
+    if (dsp_ref_dot_q15(a, b, n) != k->dot_q15(a, b, n) || dsp_ref_dot_q15(a, a, n) != k->dot_q15(a, a, n)) {
+        ESP_LOGE(TAG, "%s: dot_q15 mismatch (n=%" PRIu32 ")", k->name, n);
+        return false;
+    }
+    return true;
+}
+
+uint32_t dsp_cycle_count(void)
+{
+#if DSP_HAVE_X86
+    return (uint32_t)__rdtsc();
+#else
+    return (uint32_t)esp_cpu_get_cycle_count();
+#endif
+}
+
+// Такты на отсчет * 100
+static uint32_t bench_result(uint32_t start)
+{
+    return (uint32_t)(((uint64_t)(dsp_cycle_count() - start) * 100) / (BENCH_REPS * BENCH_N));
+}
+
+#define BENCH(expr) ({                        \
+    uint32_t _start = dsp_cycle_count();      \
+    for (int _r = 0; _r < BENCH_REPS; _r++) { \
+        expr;                                 \
+    }                                         \
+    bench_result(_start);                     \
+})
+
+static volatile int64_t s_bench_sink;
+
+static void dsp_bench_variant(const dsp_kernels_t *k)
+{
+    uint32_t add = BENCH(k->add_sat16(s_o1, s_b, BENCH_N));
+    uint32_t scale = BENCH(k->scale_q15(s_o1, s_a, BENCH_N, 12345));
+    uint32_t mac = BENCH(k->mac_q15(s_acc1, s_a, BENCH_N, 12345));
+    uint32_t sat = BENCH(s_bench_sink += k->sat16(s_o1, s_acc1, BENCH_N));
+    uint32_t dot = BENCH(s_bench_sink += k->dot_q15(s_a, s_b, BENCH_N));
+
+    ESP_LOGI(TAG, "  %-6s add %3" PRIu32 ".%02" PRIu32 "  scale %3" PRIu32 ".%02" PRIu32
+             "  mac %3" PRIu32 ".%02" PRIu32 "  sat %3" PRIu32 ".%02" PRIu32 "  dot %3" PRIu32 ".%02" PRIu32,
+             k->name, add / 100, add % 100, scale / 100, scale % 100, mac / 100, mac % 100,
+             sat / 100, sat % 100, dot / 100, dot % 100);
+}
+
+static void dsp_bench_filters(void)
+{
+    int16_t h[BENCH_FIR_TAPS];
+    for (int i = 0; i < BENCH_FIR_TAPS; i++) {
+        h[i] = (int16_t)(32767 / BENCH_FIR_TAPS);
+    }
+    dsp_fir_t fir = {0};
+    if (dsp_fir_init(&fir, h, BENCH_FIR_TAPS) != ESP_OK) {
+        return;
+    }
+    uint32_t fir_c = BENCH(dsp_fir_process(&fir, s_o1, s_a, BENCH_N));
+    dsp_fir_free(&fir);
+
+    // Фильтр верхних частот ~100 Гц при 8 кГц
+    static const int16_t hp[5] = { 15734, -31468, 15734, -31418, 15136 };
+    dsp_biquad_t bq;
+    dsp_biquad_init(&bq, hp);
+    uint32_t bq_c = BENCH(dsp_biquad_process(&bq, s_o1, s_a, BENCH_N));
+    uint32_t rms_c = BENCH(s_bench_sink += dsp_rms_q15(s_a, BENCH_N));
+
+    ESP_LOGI(TAG, "  %-6s fir%d %3" PRIu32 ".%02" PRIu32 "  biquad %3" PRIu32 ".%02" PRIu32 "  rms %3" PRIu32 ".%02" PRIu32,
+             s_k->name, BENCH_FIR_TAPS, fir_c / 100, fir_c % 100, bq_c / 100, bq_c % 100, rms_c / 100, rms_c % 100);
+}
+
+// Все длины до 67 захватывают хвосты любых ширин векторов, плюс рабочие блоки
+static bool dsp_check_lengths(const dsp_kernels_t *k, uint32_t *seed)
+{
+    static const uint32_t blocks[] = { 120, BENCH_N, SELFTEST_MAX_N };
+
+    for (uint32_t i = 0; i < 68 + sizeof(blocks) / sizeof(blocks[0]); i++) {
+        uint32_t n = i < 68 ? i : blocks[i - 68];
+        for (uint32_t off = 0; off < 2; off++) {
+            if (!dsp_check_variant(k, n, off, seed)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+esp_err_t dsp_selftest(bool bench)
+{
+    const dsp_kernels_t *variants[4];
+    uint32_t count = dsp_variants(variants);
+    uint32_t seed = 0x2545F491;
+    bool ok = true;
+
+    for (uint32_t v = 1; v < count && ok; v++) {
+        ok = dsp_check_lengths(variants[v], &seed);
+        if (ok) {
+            ESP_LOGI(TAG, "✅ %s matches reference", variants[v]->name);
+        }
+    }
+    if (!ok) {
+        return ESP_FAIL;
+    }
+
+    if (bench) {
+        for (uint32_t i = 0; i < SELFTEST_MAX_N; i++) {
+            s_a[i] = rand_sample(&seed);
+            s_b[i] = rand_sample(&seed);
+            s_acc1[i] = rand_acc(&seed);
+        }
+        ESP_LOGI(TAG, "Cycles per sample (block %d):", BENCH_N);
+        for (uint32_t v = 0; v < count; v++) {
+            dsp_bench_variant(variants[v]);
+        }
+        dsp_bench_filters();
+    }
+    return ESP_OK;
+}
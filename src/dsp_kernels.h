@@ -0,0 +1,121 @@
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DSP_FIR_BLOCK      240    // Отсчетов за один проход FIR (буфер истории + блок)
+#define DSP_FIR_MAX_TAPS   128
+
+/*
+ * Ядра обработки int16/int32 блоков в фиксированной точке. Каждое ядро
+ * имеет эталонную реализацию на C и ускоренные варианты (SSE2/AVX2 на
+ * хосте x86, развернутые циклы на C для Xtensa); все варианты дают результат,
+ * бит в бит совпадающий с эталоном. Сверку выполняют хостовый набор
+ * test/native/test_dsp_kernels и, на устройстве, dsp_selftest().
+ * Округление и насыщение определены явно в описании каждой функции.
+ */
+
+/**
+ * @brief Выбор лучшего варианта ядер для текущего процессора
+ */
+void dsp_init(void);
+
+/**
+ * @brief Имя выбранного варианта ("ref", "sse2", "avx2", "unrolled")
+ */
+const char *dsp_backend_name(void);
+
+/**
+ * @brief dst[i] = sat16(dst[i] + src[i])
+ */
+void dsp_add_sat16(int16_t *dst, const int16_t *src, uint32_t n);
+
+/**
+ * @brief dst[i] = sat16((src[i] * gain + 2^14) >> 15), gain в Q15; dst может совпадать с src
+ */
+void dsp_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain);
+
+/**
+ * @brief acc[i] += (src[i] * gain) >> 15, gain в Q15 в диапазоне (-2.0, 2.0]
+ */
+void dsp_mac_q15(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain);
+
+/**
+ * @brief dst[i] = sat16(src[i])
+ * @return Количество обрезанных отсчетов
+ */
+uint32_t dsp_sat16(int16_t *dst, const int32_t *src, uint32_t n);
+
+/**
+ * @brief Точная сумма a[i] * b[i] (накопление в 64 битах)
+ */
+int64_t dsp_dot_q15(const int16_t *a, const int16_t *b, uint32_t n);
+
+/**
+ * @brief Среднеквадратичное значение блока, округленное вниз (0..32768)
+ */
+uint32_t dsp_rms_q15(const int16_t *x, uint32_t n);
+
+// FIR фильтр с коэффициентами в Q15
+typedef struct {
+    int16_t *coeffs;          // Коэффициенты в обратном порядке: отсчет = скалярное произведение
+    int16_t *buf;             // taps - 1 отсчетов истории + DSP_FIR_BLOCK входных
+    uint16_t taps;
+} dsp_fir_t;
+
+/**
+ * @brief Создание FIR фильтра
+ * @param coeffs_q15 Импульсная характеристика h[0..taps-1] в Q15
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_NO_MEM
+ */
+esp_err_t dsp_fir_init(dsp_fir_t *fir, const int16_t *coeffs_q15, uint16_t taps);
+void dsp_fir_free(dsp_fir_t *fir);
+void dsp_fir_reset(dsp_fir_t *fir);
+
+/**
+ * @brief y[i] = sat16((sum h[k] * x[i-k] + 2^14) >> 15); out может совпадать с in
+ */
+void dsp_fir_process(dsp_fir_t *fir, int16_t *out, const int16_t *in, uint32_t n);
+
+// Биквадратное звено (Direct Form I), коэффициенты в Q14, a0 = 1
+typedef struct {
+    int16_t b0, b1, b2, a1, a2;
+    int16_t x1, x2, y1, y2;
+} dsp_biquad_t;
+
+/**
+ * @brief Инициализация звена
+ * @param coeffs_q14 {b0, b1, b2, a1, a2} в Q14
+ */
+void dsp_biquad_init(dsp_biquad_t *bq, const int16_t coeffs_q14[5]);
+
+/**
+ * @brief y = sat16((b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2 + 2^13) >> 14)
+ *
+ * Рекурсия по времени не векторизуется, поэтому вариант один для всех платформ.
+ */
+void dsp_biquad_process(dsp_biquad_t *bq, int16_t *out, const int16_t *in, uint32_t n);
+
+/**
+ * @brief Счетчик тактов для замеров (CCOUNT на ESP32, TSC на хосте x86)
+ */
+uint32_t dsp_cycle_count(void);
+
+/**
+ * @brief Сверка всех вариантов ядер с эталоном на случайных и граничных данных
+ * @param bench Дополнительно вывести такты на отсчет для каждого ядра
+ * @return ESP_OK если все варианты совпали с эталоном
+ */
+esp_err_t dsp_selftest(bool bench);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_KERNELS_H */
@@ -0,0 +1,52 @@
+#ifndef DSP_KERNELS_IMPL_H
+#define DSP_KERNELS_IMPL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Внутренний интерфейс dsp_kernels: таблицы вариантов ядер
+
+#if defined(__SSE2__)
+#define DSP_HAVE_X86     1
+#endif
+
+typedef struct {
+    const char *name;
+    void (*add_sat16)(int16_t *dst, const int16_t *src, uint32_t n);
+    void (*scale_q15)(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain);
+    void (*mac_q15)(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain);
+    uint32_t (*sat16)(int16_t *dst, const int32_t *src, uint32_t n);
+    int64_t (*dot_q15)(const int16_t *a, const int16_t *b, uint32_t n);
+} dsp_kernels_t;
+
+extern const dsp_kernels_t dsp_kernels_ref;
+
+#if DSP_HAVE_X86
+extern const dsp_kernels_t dsp_kernels_sse2;
+extern const dsp_kernels_t dsp_kernels_avx2;
+
+/**
+ * @brief Поддерживает ли процессор AVX2 (проверка при запуске)
+ */
+bool dsp_x86_has_avx2(void);
+#endif
+
+// Развернутые циклы на C: вариант по умолчанию на Xtensa, собирается на любой цели
+extern const dsp_kernels_t dsp_kernels_unrolled;
+
+// Эталонные ядра доступны вариантам для хвостов блоков и неподдержанных параметров
+void dsp_ref_add_sat16(int16_t *dst, const int16_t *src, uint32_t n);
+void dsp_ref_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain);
+void dsp_ref_mac_q15(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain);
+uint32_t dsp_ref_sat16(int16_t *dst, const int32_t *src, uint32_t n);
+int64_t dsp_ref_dot_q15(const int16_t *a, const int16_t *b, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_KERNELS_IMPL_H */
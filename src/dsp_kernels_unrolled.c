@@ -0,0 +1,101 @@
+#include "dsp_kernels_impl.h"
+
+/*
+ * Переносимый C с развернутыми на 4 отсчета циклами. Выбирается на Xtensa
+ * LX6/LX7: у ядра нет SIMD, а развертка дает компилятору независимые
+ * загрузки и умножения для конвейера и насыщение через MIN/MAX без ветвлений.
+ * Это не целевой backend: MAC16/интринсики Xtensa здесь не используются.
+ * Вариант собирается везде, поэтому dsp_selftest() сверяет его и на хосте.
+ */
+
+static inline int32_t clamp16(int32_t v)
+{
+    v = v < INT16_MAX ? v : INT16_MAX;
+    return v > INT16_MIN ? v : INT16_MIN;
+}
+
+static void unrolled_add_sat16(int16_t *restrict dst, const int16_t *restrict src, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32_t s0 = dst[i] + src[i];
+        int32_t s1 = dst[i + 1] + src[i + 1];
+        int32_t s2 = dst[i + 2] + src[i + 2];
+        int32_t s3 = dst[i + 3] + src[i + 3];
+        dst[i] = (int16_t)clamp16(s0);
+        dst[i + 1] = (int16_t)clamp16(s1);
+        dst[i + 2] = (int16_t)clamp16(s2);
+        dst[i + 3] = (int16_t)clamp16(s3);
+    }
+    dsp_ref_add_sat16(dst + i, src + i, n - i);
+}
+
+static void unrolled_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32_t p0 = (src[i] * gain + (1 << 14)) >> 15;
+        int32_t p1 = (src[i + 1] * gain + (1 << 14)) >> 15;
+        int32_t p2 = (src[i + 2] * gain + (1 << 14)) >> 15;
+        int32_t p3 = (src[i + 3] * gain + (1 << 14)) >> 15;
+        dst[i] = (int16_t)clamp16(p0);
+        dst[i + 1] = (int16_t)clamp16(p1);
+        dst[i + 2] = (int16_t)clamp16(p2);
+        dst[i + 3] = (int16_t)clamp16(p3);
+    }
+    dsp_ref_scale_q15(dst + i, src + i, n - i, gain);
+}
+
+static void unrolled_mac_q15(int32_t *restrict acc, const int16_t *restrict src, uint32_t n, int32_t gain)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc[i] += (src[i] * gain) >> 15;
+        acc[i + 1] += (src[i + 1] * gain) >> 15;
+        acc[i + 2] += (src[i + 2] * gain) >> 15;
+        acc[i + 3] += (src[i + 3] * gain) >> 15;
+    }
+    dsp_ref_mac_q15(acc + i, src + i, n - i, gain);
+}
+
+static uint32_t unrolled_sat16(int16_t *restrict dst, const int32_t *restrict src, uint32_t n)
+{
+    uint32_t clipped = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32_t c0 = clamp16(src[i]);
+        int32_t c1 = clamp16(src[i + 1]);
+        int32_t c2 = clamp16(src[i + 2]);
+        int32_t c3 = clamp16(src[i + 3]);
+        clipped += (c0 != src[i]) + (c1 != src[i + 1]) + (c2 != src[i + 2]) + (c3 != src[i + 3]);
+        dst[i] = (int16_t)c0;
+        dst[i + 1] = (int16_t)c1;
+        dst[i + 2] = (int16_t)c2;
+        dst[i + 3] = (int16_t)c3;
+    }
+    return clipped + dsp_ref_sat16(dst + i, src + i, n - i);
+}
+
+static int64_t unrolled_dot_q15(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    // Пара произведений (-32768)^2 переполняет int32, поэтому каждое сразу идет в int64;
+    // два независимых накопителя прячут задержку 64-битного сложения
+    int64_t s0 = 0, s1 = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s0 += a[i + 2] * b[i + 2];
+        s1 += a[i + 3] * b[i + 3];
+    }
+    return s0 + s1 + dsp_ref_dot_q15(a + i, b + i, n - i);
+}
+
+const dsp_kernels_t dsp_kernels_unrolled = {
+    .name = "unrolled",
+    .add_sat16 = unrolled_add_sat16,
+    .scale_q15 = unrolled_scale_q15,
+    .mac_q15 = unrolled_mac_q15,
+    .sat16 = unrolled_sat16,
+    .dot_q15 = unrolled_dot_q15,
+};
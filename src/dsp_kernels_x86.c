@@ -0,0 +1,233 @@
+#include "dsp_kernels_impl.h"
+
+#if DSP_HAVE_X86
+
+#include <immintrin.h>
+
+/*
+ * Варианты для хостовой сборки на x86. SSE2 есть на любом x86-64, AVX2
+ * собирается атрибутом target и включается после проверки CPUID.
+ * Хвосты короче вектора считаются эталонными ядрами.
+ */
+
+#define AVX2 __attribute__((target("avx2")))
+
+// 32-битные произведения a * b для восьми пар int16 (младшая и старшая половины)
+static inline void mul16x8_32(__m128i a, __m128i b, __m128i *lo, __m128i *hi)
+{
+    __m128i pl = _mm_mullo_epi16(a, b);
+    __m128i ph = _mm_mulhi_epi16(a, b);
+    *lo = _mm_unpacklo_epi16(pl, ph);
+    *hi = _mm_unpackhi_epi16(pl, ph);
+}
+
+// Знаковое расширение int32 -> int64 и сложение с накопителем
+static inline __m128i add_epi32_to_64(__m128i acc, __m128i v)
+{
+    __m128i sign = _mm_srai_epi32(v, 31);
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+}
+
+static inline int64_t hsum_epi64(__m128i v)
+{
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, v);
+    return lanes[0] + lanes[1];
+}
+
+// ---- SSE2 ----
+
+static void sse2_add_sat16(int16_t *dst, const int16_t *src, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_adds_epi16(d, s));
+    }
+    dsp_ref_add_sat16(dst + i, src + i, n - i);
+}
+
+static void sse2_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain)
+{
+    const __m128i g = _mm_set1_epi16(gain);
+    const __m128i round = _mm_set1_epi32(1 << 14);
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo, hi;
+        mul16x8_32(_mm_loadu_si128((const __m128i *)(src + i)), g, &lo, &hi);
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, round), 15);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, round), 15);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(lo, hi));
+    }
+    dsp_ref_scale_q15(dst + i, src + i, n - i, gain);
+}
+
+static void sse2_mac_q15(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain)
+{
+    // Без 32-битного умножения: усиление должно помещаться в int16 (1.0 - особый случай)
+    if (gain < INT16_MIN || gain > INT16_MAX + 1) {
+        dsp_ref_mac_q15(acc, src, n, gain);
+        return;
+    }
+
+    uint32_t i = 0;
+    if (gain == INT16_MAX + 1) {
+        for (; i + 8 <= n; i += 8) {
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+            __m128i *a = (__m128i *)(acc + i);
+            _mm_storeu_si128(a, _mm_add_epi32(_mm_loadu_si128(a), lo));
+            _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), hi));
+        }
+    } else {
+        const __m128i g = _mm_set1_epi16((int16_t)gain);
+        for (; i + 8 <= n; i += 8) {
+            __m128i lo, hi;
+            mul16x8_32(_mm_loadu_si128((const __m128i *)(src + i)), g, &lo, &hi);
+            __m128i *a = (__m128i *)(acc + i);
+            _mm_storeu_si128(a, _mm_add_epi32(_mm_loadu_si128(a), _mm_srai_epi32(lo, 15)));
+            _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), _mm_srai_epi32(hi, 15)));
+        }
+    }
+    dsp_ref_mac_q15(acc + i, src + i, n - i, gain);
+}
+
+static uint32_t sse2_sat16(int16_t *dst, const int32_t *src, uint32_t n)
+{
+    const __m128i max = _mm_set1_epi32(INT16_MAX);
+    const __m128i min = _mm_set1_epi32(INT16_MIN);
+    uint32_t clipped = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i *)(src + i + 4));
+        __m128i over = _mm_or_si128(_mm_cmpgt_epi32(lo, max), _mm_cmplt_epi32(lo, min));
+        __m128i over_hi = _mm_or_si128(_mm_cmpgt_epi32(hi, max), _mm_cmplt_epi32(hi, min));
+        clipped += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(over)) |
+                                      (_mm_movemask_ps(_mm_castsi128_ps(over_hi)) << 4));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(lo, hi));
+    }
+    return clipped + dsp_ref_sat16(dst + i, src + i, n - i);
+}
+
+static int64_t sse2_dot_q15(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    // madd_epi16 переполняется на паре (-32768)^2, поэтому произведения расширяются до 64 бит
+    __m128i acc = _mm_setzero_si128();
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo, hi;
+        mul16x8_32(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)), &lo, &hi);
+        acc = add_epi32_to_64(acc, lo);
+        acc = add_epi32_to_64(acc, hi);
+    }
+    return hsum_epi64(acc) + dsp_ref_dot_q15(a + i, b + i, n - i);
+}
+
+const dsp_kernels_t dsp_kernels_sse2 = {
+    .name = "sse2",
+    .add_sat16 = sse2_add_sat16,
+    .scale_q15 = sse2_scale_q15,
+    .mac_q15 = sse2_mac_q15,
+    .sat16 = sse2_sat16,
+    .dot_q15 = sse2_dot_q15,
+};
+
+// ---- AVX2 ----
+
+AVX2 static void avx2_add_sat16(int16_t *dst, const int16_t *src, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_adds_epi16(d, s));
+    }
+    sse2_add_sat16(dst + i, src + i, n - i);
+}
+
+AVX2 static void avx2_scale_q15(int16_t *dst, const int16_t *src, uint32_t n, int16_t gain)
+{
+    const __m256i g = _mm256_set1_epi16(gain);
+    const __m256i round = _mm256_set1_epi32(1 << 14);
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i pl = _mm256_mullo_epi16(s, g);
+        __m256i ph = _mm256_mulhi_epi16(s, g);
+        // unpack и packs работают внутри 128-битных половин, порядок отсчетов сохраняется
+        __m256i lo = _mm256_srai_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(pl, ph), round), 15);
+        __m256i hi = _mm256_srai_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(pl, ph), round), 15);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packs_epi32(lo, hi));
+    }
+    sse2_scale_q15(dst + i, src + i, n - i, gain);
+}
+
+AVX2 static void avx2_mac_q15(int32_t *acc, const int16_t *src, uint32_t n, int32_t gain)
+{
+    // При gain в (-2.0, 2.0] произведение помещается в int32
+    const __m256i g = _mm256_set1_epi32(gain);
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i s = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+        __m256i p = _mm256_srai_epi32(_mm256_mullo_epi32(s, g), 15);
+        __m256i *a = (__m256i *)(acc + i);
+        _mm256_storeu_si256(a, _mm256_add_epi32(_mm256_loadu_si256(a), p));
+    }
+    dsp_ref_mac_q15(acc + i, src + i, n - i, gain);
+}
+
+AVX2 static uint32_t avx2_sat16(int16_t *dst, const int32_t *src, uint32_t n)
+{
+    const __m256i max = _mm256_set1_epi32(INT16_MAX);
+    const __m256i min = _mm256_set1_epi32(INT16_MIN);
+    uint32_t clipped = 0;
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i lo = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(src + i + 8));
+        __m256i over = _mm256_or_si256(_mm256_cmpgt_epi32(lo, max), _mm256_cmpgt_epi32(min, lo));
+        __m256i over_hi = _mm256_or_si256(_mm256_cmpgt_epi32(hi, max), _mm256_cmpgt_epi32(min, hi));
+        clipped += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(over)) |
+                                      (_mm256_movemask_ps(_mm256_castsi256_ps(over_hi)) << 8));
+        // packs чередует 128-битные половины lo и hi: возвращаем порядок перестановкой
+        __m256i packed = _mm256_packs_epi32(lo, hi);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return clipped + sse2_sat16(dst + i, src + i, n - i);
+}
+
+AVX2 static int64_t avx2_dot_q15(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(a + i)));
+        __m256i vb = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(b + i)));
+        __m256i p = _mm256_mullo_epi32(va, vb);
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p, 1)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dsp_ref_dot_q15(a + i, b + i, n - i);
+}
+
+const dsp_kernels_t dsp_kernels_avx2 = {
+    .name = "avx2",
+    .add_sat16 = avx2_add_sat16,
+    .scale_q15 = avx2_scale_q15,
+    .mac_q15 = avx2_mac_q15,
+    .sat16 = avx2_sat16,
+    .dot_q15 = avx2_dot_q15,
+};
+
+bool dsp_x86_has_avx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif /* DSP_HAVE_X86 */
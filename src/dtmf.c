@@ -0,0 +1,181 @@
+#include "dtmf.h"
+#include <string.h>
+
+#define DTMF_CNG_IDX        8
+#define DTMF_CED_IDX        9
+
+// Минимальная амплитуда тона ~-36 дБ от полной шкалы: |X|^2 = (A * N / 2)^2
+#define DTMF_MIN_AMP        500
+#define DTMF_MIN_MAG2       ((int64_t)(DTMF_MIN_AMP * DTMF_BLOCK / 2) * (DTMF_MIN_AMP * DTMF_BLOCK / 2))
+#define DTMF_TONE_BLOCKS    16    // ~200 мс непрерывного CNG/CED до события
+
+/*
+ * Для чистого тона |X|^2 = E * N / 2, где E - энергия блока: отношение
+ * |X|^2 / (E * N / 2) - доля энергии блока, попавшая в фильтр.
+ * Пороги отношений заданы целыми дробями, чтобы сравнение шло без деления.
+ */
+#define DTMF_TWIST_NORMAL   631   // Нижний тон громче верхнего не больше чем на 8 дБ (x100)
+#define DTMF_TWIST_REVERSE  251   // Верхний громче нижнего не больше чем на 4 дБ (x100)
+#define DTMF_PEAK_RATIO     631   // Остальные тоны группы слабее пика минимум на 8 дБ (x100)
+
+// 2 cos(2 pi f / 8000) в Q14
+static const int16_t s_coef[DTMF_TONES] = {
+    27980, 26956, 25701, 24219,     // 697, 770, 852, 941 Гц
+    19073, 16325, 13085, 9315,      // 1209, 1336, 1477, 1633 Гц
+    21281,                          // 1100 Гц (CNG)
+    -2571,                          // 2100 Гц (CED)
+};
+
+static const char s_keys[4][4] = {
+    { '1', '2', '3', 'A' },
+    { '4', '5', '6', 'B' },
+    { '7', '8', '9', 'C' },
+    { '*', '0', '#', 'D' },
+};
+
+esp_err_t dtmf_init(dtmf_t *dtmf, uint32_t sample_rate)
+{
+    memset(dtmf, 0, sizeof(*dtmf));
+    if (sample_rate != DTMF_RATE && sample_rate != DTMF_RATE * 2) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    dtmf->decimate = sample_rate == DTMF_RATE * 2;
+    return ESP_OK;
+}
+
+const char *dtmf_event_name(dtmf_event_type_t type)
+{
+    switch (type) {
+    case DTMF_EVENT_DIGIT: return "digit";
+    case DTMF_EVENT_CNG: return "CNG";
+    case DTMF_EVENT_CED: return "CED";
+    default: return "?";
+    }
+}
+
+// Уровень синусоиды в дБ от полной шкалы по |X|^2 блока: 10 log10 |X|^2 - 124.4
+static int8_t mag2_to_db(int64_t mag2)
+{
+    if (mag2 <= 0) {
+        return INT8_MIN;
+    }
+    int e = 63 - __builtin_clzll((uint64_t)mag2);
+    int32_t log2_q4 = e * 16 + (int32_t)((e >= 4 ? (uint64_t)mag2 >> (e - 4) : (uint64_t)mag2 << (4 - e)) & 15);
+    int32_t db = ((log2_q4 * 771) >> 12) - 124;   // 3.0103 / 16 ~= 771 / 4096
+    return (int8_t)(db < INT8_MIN ? INT8_MIN : (db > 0 ? 0 : db));
+}
+
+static void emit(dtmf_event_cb_t cb, void *ctx, dtmf_event_type_t type, char digit, int64_t mag2)
+{
+    if (cb != NULL) {
+        dtmf_event_t ev = { .type = type, .digit = digit, .level_db = mag2_to_db(mag2) };
+        cb(&ev, ctx);
+    }
+}
+
+// Индекс максимума в группе из четырех и проверка, что остальные заметно слабее
+static int group_peak(const int64_t *mag2, int64_t *peak)
+{
+    int best = 0;
+    for (int i = 1; i < 4; i++) {
+        if (mag2[i] > mag2[best]) {
+            best = i;
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        if (i != best && mag2[i] * DTMF_PEAK_RATIO > mag2[best] * 100) {
+            return -1;
+        }
+    }
+    *peak = mag2[best];
+    return best;
+}
+
+static void block_decide(dtmf_t *dtmf, dtmf_event_cb_t cb, void *ctx)
+{
+    int64_t mag2[DTMF_TONES];
+    for (int k = 0; k < DTMF_TONES; k++) {
+        int64_t s1 = dtmf->s1[k];
+        int64_t s2 = dtmf->s2[k];
+        mag2[k] = s1 * s1 + s2 * s2 - ((s_coef[k] * s1) >> 14) * s2;
+        dtmf->s1[k] = 0;
+        dtmf->s2[k] = 0;
+    }
+    // E * N / 2 - знаменатель доли энергии
+    int64_t ref = dtmf->energy * (DTMF_BLOCK / 2);
+    dtmf->energy = 0;
+    dtmf->blocks++;
+
+    char digit = 0;
+    int64_t row_mag = 0;
+    int64_t col_mag = 0;
+    int row = group_peak(mag2, &row_mag);
+    int col = group_peak(mag2 + 4, &col_mag);
+    if (row >= 0 && col >= 0 &&
+        row_mag >= DTMF_MIN_MAG2 && col_mag >= DTMF_MIN_MAG2 &&
+        row_mag * 100 <= col_mag * DTMF_TWIST_NORMAL &&
+        col_mag * 100 <= row_mag * DTMF_TWIST_REVERSE &&
+        (row_mag + col_mag) * 2 >= ref) {       // Оба тона - не меньше половины энергии блока
+        digit = s_keys[row][col];
+    }
+
+    // Нажатие: та же цифра в двух блоках подряд (>= 26 мс), событие одно на нажатие.
+    // Блок без цифры завершает нажатие
+    if (digit != 0 && digit == dtmf->candidate && digit != dtmf->reported) {
+        dtmf->reported = digit;
+        dtmf->digits++;
+        emit(cb, ctx, DTMF_EVENT_DIGIT, digit, row_mag);
+    } else if (digit == 0) {
+        dtmf->reported = 0;
+    }
+    dtmf->candidate = digit;
+
+    // Тоны факса: чистая синусоида (>= 70% энергии блока), держится DTMF_TONE_BLOCKS блоков
+    for (int t = 0; t < 2; t++) {
+        int k = DTMF_CNG_IDX + t;
+        bool on = digit == 0 && mag2[k] >= DTMF_MIN_MAG2 && mag2[k] * 10 >= ref * 7;
+        if (!on) {
+            dtmf->tone_blocks[t] = 0;
+        } else if (dtmf->tone_blocks[t] < DTMF_TONE_BLOCKS && ++dtmf->tone_blocks[t] == DTMF_TONE_BLOCKS) {
+            emit(cb, ctx, t == 0 ? DTMF_EVENT_CNG : DTMF_EVENT_CED, 0, mag2[k]);
+        }
+    }
+}
+
+static inline void goertzel_sample(dtmf_t *dtmf, int32_t x, dtmf_event_cb_t cb, void *ctx)
+{
+    for (int k = 0; k < DTMF_TONES; k++) {
+        // Резонанс на 697 Гц дает |s| до ~100 * 32767: произведение с Q14 не помещается в int32
+        int32_t s0 = x + (int32_t)(((int64_t)s_coef[k] * dtmf->s1[k]) >> 14) - dtmf->s2[k];
+        dtmf->s2[k] = dtmf->s1[k];
+        dtmf->s1[k] = s0;
+    }
+    dtmf->energy += x * x;
+    if (++dtmf->count == DTMF_BLOCK) {
+        dtmf->count = 0;
+        block_decide(dtmf, cb, ctx);
+    }
+}
+
+void dtmf_process(dtmf_t *dtmf, const int16_t *x, uint32_t n, dtmf_event_cb_t cb, void *ctx)
+{
+    if (!dtmf->decimate) {
+        for (uint32_t i = 0; i < n; i++) {
+            goertzel_sample(dtmf, x[i], cb, ctx);
+        }
+        return;
+    }
+
+    // Фильтр (1 2 1) / 4 с нулем на 8 кГц подавляет то, что после прореживания
+    // наложилось бы на полосу DTMF; y[m] = (x[2m-1] + 2 x[2m] + x[2m+1]) / 4
+    for (uint32_t i = 0; i < n; i++) {
+        if (!dtmf->dec_odd) {
+            dtmf->dec_mid = x[i];
+        } else {
+            int32_t y = (dtmf->dec_prev + 2 * dtmf->dec_mid + x[i]) >> 2;
+            dtmf->dec_prev = x[i];
+            goertzel_sample(dtmf, y, cb, ctx);
+        }
+        dtmf->dec_odd = !dtmf->dec_odd;
+    }
+}
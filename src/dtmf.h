@@ -0,0 +1,78 @@
+#ifndef DTMF_H
+#define DTMF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DTMF_RATE         8000   // Частота банка фильтров: поток 16 кГц прореживается вдвое
+#define DTMF_BLOCK        102    // Отсчетов на блок Гёрцеля (12.75 мс, полоса 78 Гц - уход частоты 1.5%)
+#define DTMF_TONES        10     // 4 строки + 4 столбца DTMF, CNG 1100 Гц, CED 2100 Гц
+
+/*
+ * Потоковый детектор DTMF и сигнальных тонов факса в фиксированной точке.
+ * Кадры любой длины: отсчеты копятся в состоянии фильтров Гёрцеля, решение
+ * принимается на границе блока DTMF_BLOCK. Стоимость постоянна - десять
+ * умножений с накоплением на отсчет 8 кГц плюс прореживающий фильтр для 16 кГц.
+ */
+
+typedef enum {
+    DTMF_EVENT_DIGIT = 0,          // Нажатие клавиши (одно событие на нажатие)
+    DTMF_EVENT_CNG,                // Вызывной тон факса 1100 Гц
+    DTMF_EVENT_CED,                // Ответный тон факса/модема 2100 Гц
+} dtmf_event_type_t;
+
+typedef struct {
+    dtmf_event_type_t type;
+    char digit;                    // '0'..'9', '*', '#', 'A'..'D' для DTMF_EVENT_DIGIT
+    int8_t level_db;               // Уровень тона (нижнего для DTMF), дБ относительно полной шкалы
+} dtmf_event_t;
+
+typedef void (*dtmf_event_cb_t)(const dtmf_event_t *event, void *ctx);
+
+typedef struct {
+    int32_t s1[DTMF_TONES];        // Состояние фильтров Гёрцеля
+    int32_t s2[DTMF_TONES];
+    int64_t energy;                // Энергия входа текущего блока
+    uint16_t count;                // Отсчетов 8 кГц в текущем блоке
+
+    // Прореживание 16 -> 8 кГц фильтром (1 2 1) / 4
+    bool decimate;
+    bool dec_odd;
+    int16_t dec_prev;
+    int16_t dec_mid;
+
+    char candidate;                // Цифра прошлого блока (0 - нет)
+    char reported;                 // Цифра, о которой уже сообщили в текущем нажатии
+    uint8_t tone_blocks[2];        // Блоков подряд с CNG/CED
+    uint32_t digits;
+    uint32_t blocks;
+} dtmf_t;
+
+/**
+ * @brief Инициализация детектора
+ * @param sample_rate 8000 или 16000
+ * @return ESP_OK, ESP_ERR_INVALID_ARG для другой частоты
+ */
+esp_err_t dtmf_init(dtmf_t *dtmf, uint32_t sample_rate);
+
+/**
+ * @brief Обработка кадра произвольной длины
+ * @param cb Вызывается из этого же потока для каждого обнаруженного события (может быть NULL)
+ */
+void dtmf_process(dtmf_t *dtmf, const int16_t *x, uint32_t n, dtmf_event_cb_t cb, void *ctx);
+
+/**
+ * @brief Имя события для журнала
+ */
+const char *dtmf_event_name(dtmf_event_type_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTMF_H */
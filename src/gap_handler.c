@@ -1,40 +1,138 @@
 #include "gap_handler.h"
 #include "auto_reconnect.h"
 #include "paired_devices.h"
+#include "disc_cache.h"
+#include "target_policy.h"
+#include "radio_sched.h"
+#include "conn_state.h"
+#include "trace.h"
+#include "boot_phase.h"
+#include "hf_conn.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_gap_bt_api.h"
 #include "esp_hf_ag_api.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include <ctype.h>
 #include <string.h>
 
 static const char* TAG = "GAP_HANDLER";
 
-static char target_name[ESP_BT_GAP_MAX_BDNAME_LEN + 1] = {0};
 static esp_bd_addr_t target_addr = {0};
-static bool found = false;
-static bool connection_in_progress = false;
+static bool discovery_active = false;
+static esp_timer_handle_t window_timer = NULL;
 
 void gap_set_target_name(const char *name) {
-    if (name && strlen(name) < sizeof(target_name)) {
-        strncpy(target_name, name, sizeof(target_name) - 1);
-        target_name[sizeof(target_name) - 1] = '\0';
-        ESP_LOGI(TAG, "Target device name set to: %s", target_name);
+    if (name && name[0]) {
+        target_policy_clear();
+        if (target_policy_add_name(name) == ESP_OK) {
+            ESP_LOGI(TAG, "Target device name set to: %s", name);
+        }
     }
 }
 
+esp_err_t gap_add_target(const char *pattern) {
+    if (pattern == NULL || pattern[0] == '\0') {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // "AA:BB:CC..." - шаблон адреса, иначе подстрока имени
+    if (strlen(pattern) >= 3 && pattern[2] == ':' && isxdigit((unsigned char)pattern[0])) {
+        return target_policy_add_addr(pattern);
+    }
+    return target_policy_add_name(pattern);
+}
+
 void gap_reset_connection_state() {
-    connection_in_progress = false;
-    found = false;
+    conn_state_dispatch(CONN_EVT_ROUND_START, NULL, NULL);
 }
 
 void gap_set_connection_status(bool connected) {
-    connection_in_progress = connected;
+    conn_state_dispatch(connected ? CONN_EVT_PAGE_START : CONN_EVT_PAGE_DONE, NULL, NULL);
+}
+
+// Окно сбора кандидатов истекло - берем лучшего из найденных
+static void gap_window_timer_cb(void *arg) {
+    if (discovery_active) {
+        ESP_LOGI(TAG, "Candidate window elapsed, stopping discovery");
+        esp_bt_gap_cancel_discovery();
+    }
+}
+
+static bool gap_connect_target(const target_candidate_t *target) {
+    memcpy(target_addr, target->bda, ESP_BD_ADDR_LEN);
+
+    // Добавляем в список сопряженных устройств
+    const disc_cache_entry_t *entry = disc_cache_find(target->bda);
+    bool is_hf_device = ((target->cod & 0x1F00) >> 8) == 0x04 ||
+                        (entry != NULL && disc_cache_has_uuid(entry, DISC_CACHE_UUID_HANDSFREE));
+    paired_devices_add(target->bda, target->name, target->cod, is_hf_device);
+
+    // PAGE_START отклоняется, если подключение уже идет: проверка и захват одним CAS.
+    // Из поиска переподключения переводит в CONNECTING, и неудача считается попыткой
+    if (!conn_state_dispatch(CONN_EVT_PAGE_START, NULL, NULL)) {
+        return true;
+    }
+
+    // Поиск уже остановлен (вызывается по DISCOVERY_STOPPED), ждать в callback не нужно
+    ESP_LOGI(TAG, "🎯 Connecting to " ESP_BD_ADDR_STR " '%s' (RSSI %d, score %d)",
+             ESP_BD_ADDR_HEX(target->bda), target->name, target->rssi, target->score);
+    trace_begin(TRACE_TRACK_PAGE, "page");
+    esp_err_t ret = esp_hf_ag_slc_connect(target_addr);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to connect HF AG: %s", esp_err_to_name(ret));
+        // Засчитанная попытка повторится по таймеру переподключения, запасной путь не нужен
+        bool counted = auto_reconnect_notify_connection_failed();
+        if (!counted) {
+            trace_end(TRACE_TRACK_PAGE, "page");
+        }
+        conn_state_dispatch(CONN_EVT_PAGE_DONE, NULL, NULL);
+        return counted;
+    }
+    return true;
 }
 
 void gap_start_discovery() {
-    ESP_LOGI(TAG, "Starting device discovery");
-    esp_err_t ret = esp_bt_gap_start_discovery(ESP_BT_INQ_MODE_GENERAL_INQUIRY, 10, 0);
+    // Новая попытка: предыдущая либо завершилась, либо не удалась
+    conn_state_dispatch(CONN_EVT_ROUND_START, NULL, NULL);
+    target_policy_begin_round();
+
+    // Цели отвечали недавно - выбираем лучшую без нового поиска (один раз на ответ)
+    for (int i = 0; i < disc_cache_count(); i++) {
+        disc_cache_entry_t *entry = disc_cache_at(i);
+        if (!entry->skip_used && disc_cache_age_ms(entry) < DISC_CACHE_FRESH_MS) {
+            target_policy_offer(entry);
+        }
+    }
+    target_candidate_t best;
+    if (target_policy_get_best(&best)) {
+        disc_cache_entry_t *entry = disc_cache_find(best.bda);
+        ESP_LOGI(TAG, "🎯 Target seen %lu ms ago, skipping inquiry", (unsigned long)disc_cache_age_ms(entry));
+        entry->skip_used = true;
+        if (gap_connect_target(&best)) {
+            return;
+        }
+        target_policy_begin_round();
+    }
+
+    if (window_timer == NULL) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = gap_window_timer_cb,
+            .name = "gap_window",
+        };
+        esp_timer_create(&timer_args, &window_timer);
+    }
+
+    // Inquiry во время разговора отбирает эфир у SCO - только прямой page последнего устройства
+    if (!radio_sched_inquiry_allowed()) {
+        ESP_LOGW(TAG, "Call in progress, inquiry deferred");
+        auto_reconnect_notify_discovery_complete();
+        return;
+    }
+
+    uint8_t inq_len = radio_sched_inquiry_len();
+    ESP_LOGI(TAG, "Starting device discovery (%u x 1.28 s)", inq_len);
+    esp_err_t ret = esp_bt_gap_start_discovery(ESP_BT_INQ_MODE_GENERAL_INQUIRY, inq_len, 0);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to start discovery: %s", esp_err_to_name(ret));
     }
@@ -53,68 +151,68 @@ void gap_callback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t *param) {
 
     switch (event) {
         case ESP_BT_GAP_DISC_RES_EVT: {
-            uint8_t *bd_addr = param->disc_res.bda;
-            ESP_LOGI(TAG, "Device found: " ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(bd_addr));
-            
-            char device_name[ESP_BT_GAP_MAX_BDNAME_LEN + 1] = {0};
-            uint32_t cod = 0;
-            bool is_hf_device = false;
-            
-            // Парсим свойства устройства
-            for (int i = 0; i < param->disc_res.num_prop; i++) {
-                if (param->disc_res.prop[i].type == ESP_BT_GAP_DEV_PROP_EIR) {
-                    uint8_t *eir = param->disc_res.prop[i].val;
-                    uint8_t len = 0;
-                    uint8_t *name_ptr = esp_bt_gap_resolve_eir_data(eir, ESP_BT_EIR_TYPE_CMPL_LOCAL_NAME, &len);
-                    
-                    if (name_ptr && len < sizeof(device_name)) {
-                        memcpy(device_name, name_ptr, len);
-                        device_name[len] = '\0';
-                        ESP_LOGI(TAG, "Device name: %s", device_name);
-                    }
-                } else if (param->disc_res.prop[i].type == ESP_BT_GAP_DEV_PROP_COD) {
-                    cod = *(uint32_t*)(param->disc_res.prop[i].val);
-                    uint32_t major_class = (cod & 0x1F00) >> 8;
-                    if (major_class == 0x04) { // Audio/Video major class
-                        is_hf_device = true;
-                    }
-                }
+            bool changed = false;
+            disc_cache_entry_t *entry = disc_cache_update(param, &changed);
+
+            // Повторные ответы с теми же данными не разбираются и не засоряют лог
+            if (changed) {
+                trace_instant(TRACE_TRACK_GAP, "device_found", (uint32_t)entry->cod);
+                ESP_LOGI(TAG, "Device found: " ESP_BD_ADDR_STR ", name: %s, COD: 0x%06lx, RSSI: %d",
+                         ESP_BD_ADDR_HEX(entry->bda), entry->name[0] ? entry->name : "?",
+                         (unsigned long)entry->cod, entry->rssi);
+            } else {
+                ESP_LOGD(TAG, "Device seen again: " ESP_BD_ADDR_STR ", RSSI: %d",
+                         ESP_BD_ADDR_HEX(entry->bda), entry->rssi);
+            }
+
+            if (!discovery_active) {
+                break;
             }
 
-            // Проверяем целевое устройство
-            if (target_name[0] && strlen(device_name) > 0 && strstr(device_name, target_name)) {
-                ESP_LOGI(TAG, "🎯 Target device found: %s", device_name);
-                memcpy(target_addr, bd_addr, ESP_BD_ADDR_LEN);
-                found = true;
-                
-                // Добавляем в список сопряженных устройств
-                paired_devices_add(bd_addr, device_name, cod, is_hf_device);
-                
-                // Останавливаем поиск
+            // Кандидаты ранжируются; поиск заканчивается на хорошем кандидате или по окну
+            bool had_candidate = target_policy_get_best(NULL);
+            target_policy_verdict_t verdict = target_policy_offer(entry);
+            if (verdict != TARGET_POLICY_IGNORE) {
+                trace_instant(TRACE_TRACK_GAP, "candidate", (uint32_t)(entry->rssi + 128));
+                radio_sched_on_target_seen();
+            }
+            if (verdict == TARGET_POLICY_STOP) {
+                ESP_LOGI(TAG, "🎯 Good enough target found: %s", entry->name);
+                entry->skip_used = true;
+                esp_timer_stop(window_timer);
                 esp_bt_gap_cancel_discovery();
-                
-                if (!connection_in_progress) {
-                    connection_in_progress = true;
-                    
-                    // Небольшая задержка перед подключением
-                    vTaskDelay(pdMS_TO_TICKS(1000));
-                    
-                    // Инициируем HF AG соединение
-                    esp_err_t ret = esp_hf_ag_slc_connect(target_addr);
-                    if (ret != ESP_OK) {
-                        ESP_LOGE(TAG, "Failed to connect HF AG: %s", esp_err_to_name(ret));
-                        connection_in_progress = false;
-                        auto_reconnect_notify_connection_failed();
-                    }
-                }
+            } else if (verdict == TARGET_POLICY_CANDIDATE && !had_candidate && window_timer != NULL) {
+                esp_timer_start_once(window_timer, TARGET_POLICY_WINDOW_MS * 1000);
             }
             break;
         }
         
         case ESP_BT_GAP_DISC_STATE_CHANGED_EVT: {
             ESP_LOGI(TAG, "Discovery state changed: %d", param->disc_st_chg.state);
-            if (param->disc_st_chg.state == ESP_BT_GAP_DISCOVERY_STOPPED) {
+            if (param->disc_st_chg.state == ESP_BT_GAP_DISCOVERY_STARTED) {
+                discovery_active = true;
+                trace_begin(TRACE_TRACK_GAP, "inquiry");
+                radio_sched_on_inquiry_started();
+            } else if (param->disc_st_chg.state == ESP_BT_GAP_DISCOVERY_STOPPED) {
                 ESP_LOGI(TAG, "Discovery stopped");
+                discovery_active = false;
+                trace_end(TRACE_TRACK_GAP, "inquiry");
+                radio_sched_on_inquiry_stopped();
+                if (window_timer != NULL) {
+                    esp_timer_stop(window_timer);
+                }
+
+                // Лучшая цель раунда; без нее - переподключение к последнему устройству
+                target_candidate_t best;
+                if (target_policy_get_best(&best)) {
+                    disc_cache_entry_t *entry = disc_cache_find(best.bda);
+                    if (entry != NULL) {
+                        entry->skip_used = true;
+                    }
+                    if (gap_connect_target(&best)) {
+                        break;
+                    }
+                }
                 auto_reconnect_notify_discovery_complete();
             }
             break;
@@ -140,15 +238,34 @@ void gap_callback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t *param) {
         }
         
         case ESP_BT_GAP_AUTH_CMPL_EVT: {
+            trace_instant(TRACE_TRACK_GAP, "auth", param->auth_cmpl.stat);
             ESP_LOGI(TAG, "Authentication complete for device " ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(param->auth_cmpl.bda));
             if (param->auth_cmpl.stat == ESP_BT_STATUS_SUCCESS) {
                 ESP_LOGI(TAG, "Authentication successful");
+                // Появился bonding - видимость больше не нужна
+                radio_sched_refresh();
             } else {
                 ESP_LOGE(TAG, "Authentication failed: %d", param->auth_cmpl.stat);
             }
             break;
         }
         
+        case ESP_BT_GAP_READ_RSSI_DELTA_EVT: {
+            // Запрос шлет монитор качества SCO раз в окно
+            hf_conn_t *conn = hf_conn_get(param->read_rssi_delta.bda);
+            if (conn != NULL && param->read_rssi_delta.stat == ESP_BT_STATUS_SUCCESS) {
+                link_quality_set_rssi(&conn->link, param->read_rssi_delta.rssi_delta);
+            }
+            break;
+        }
+
+        case ESP_BT_GAP_CONFIG_EIR_DATA_EVT:
+            // Первый ответ контроллера на команду GAP: стек готов к page/inquiry
+            ESP_LOGI(TAG, "EIR configured, status %d", param->config_eir_data.stat);
+            boot_phase_mark("stack_ready");
+            boot_phase_set_ready(BOOT_READY_STACK);
+            break;
+
         default:
             ESP_LOGD(TAG, "Unhandled GAP event: %d", event);
             break;
@@ -4,6 +4,7 @@
 #include "esp_gap_bt_api.h"
 
 void gap_set_target_name(const char *name);
+esp_err_t gap_add_target(const char *pattern);
 void gap_reset_connection_state();
 void gap_set_connection_status(bool connected);
 void gap_start_discovery();
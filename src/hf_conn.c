@@ -0,0 +1,301 @@
+#include "hf_conn.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <string.h>
+
+static const char *TAG = "HF_CONN";
+
+// Индексы открытой адресации: размер - степень двойки больше HF_CONN_MAX,
+// поэтому цепочка пробирования ограничена и поиск из callbacks - O(1)
+#define HF_CONN_INDEX_SIZE  8
+#define HF_CONN_INDEX_MASK  (HF_CONN_INDEX_SIZE - 1)
+
+static hf_conn_t s_conns[HF_CONN_MAX];
+static int8_t s_addr_index[HF_CONN_INDEX_SIZE];
+static int8_t s_handle_index[HF_CONN_INDEX_SIZE];
+static volatile int s_audio_active = -1;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Младшие байты адреса (LAP) распределены равномерно
+static inline uint32_t addr_hash(const uint8_t *bda)
+{
+    return (uint32_t)(bda[3] ^ bda[4] ^ bda[5]) & HF_CONN_INDEX_MASK;
+}
+
+static inline uint32_t handle_hash(uint16_t handle)
+{
+    return (uint32_t)(handle ^ (handle >> 3)) & HF_CONN_INDEX_MASK;
+}
+
+// Пересборка индексов после вставки/удаления; вызывается под s_lock
+static void rebuild_indexes(void)
+{
+    memset(s_addr_index, -1, sizeof(s_addr_index));
+    memset(s_handle_index, -1, sizeof(s_handle_index));
+
+    for (int i = 0; i < HF_CONN_MAX; i++) {
+        if (!s_conns[i].in_use) {
+            continue;
+        }
+        uint32_t slot = addr_hash(s_conns[i].bda);
+        while (s_addr_index[slot] >= 0) {
+            slot = (slot + 1) & HF_CONN_INDEX_MASK;
+        }
+        s_addr_index[slot] = (int8_t)i;
+
+        if (s_conns[i].sync_conn_handle != HF_CONN_HANDLE_NONE) {
+            slot = handle_hash(s_conns[i].sync_conn_handle);
+            while (s_handle_index[slot] >= 0) {
+                slot = (slot + 1) & HF_CONN_INDEX_MASK;
+            }
+            s_handle_index[slot] = (int8_t)i;
+        }
+    }
+}
+
+static int find_by_addr_locked(const uint8_t *bda)
+{
+    uint32_t slot = addr_hash(bda);
+    for (int probe = 0; probe < HF_CONN_INDEX_SIZE; probe++) {
+        int idx = s_addr_index[slot];
+        if (idx < 0) {
+            return -1;
+        }
+        if (memcmp(s_conns[idx].bda, bda, sizeof(esp_bd_addr_t)) == 0) {
+            return idx;
+        }
+        slot = (slot + 1) & HF_CONN_INDEX_MASK;
+    }
+    return -1;
+}
+
+esp_err_t hf_conn_init(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    memset(s_conns, 0, sizeof(s_conns));
+    for (int i = 0; i < HF_CONN_MAX; i++) {
+        s_conns[i].sync_conn_handle = HF_CONN_HANDLE_NONE;
+    }
+    s_audio_active = -1;
+    rebuild_indexes();
+    portEXIT_CRITICAL(&s_lock);
+
+    ESP_LOGI(TAG, "Connection table initialized: %d links", HF_CONN_MAX);
+    return ESP_OK;
+}
+
+hf_conn_t *hf_conn_get(const esp_bd_addr_t bda)
+{
+    if (bda == NULL) {
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    int idx = find_by_addr_locked(bda);
+    portEXIT_CRITICAL(&s_lock);
+
+    return idx >= 0 ? &s_conns[idx] : NULL;
+}
+
+hf_conn_t *hf_conn_acquire(const esp_bd_addr_t bda)
+{
+    if (bda == NULL) {
+        return NULL;
+    }
+
+    bool found = true;
+    portENTER_CRITICAL(&s_lock);
+    int idx = find_by_addr_locked(bda);
+    if (idx < 0) {
+        found = false;
+        for (int i = 0; i < HF_CONN_MAX; i++) {
+            if (!s_conns[i].in_use) {
+                idx = i;
+                break;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (idx < 0) {
+        ESP_LOGW(TAG, "Connection table full, rejecting " ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(bda));
+        return NULL;
+    }
+    hf_conn_t *c = &s_conns[idx];
+    if (found) {
+        return c;
+    }
+
+    // Свободный слот не виден ни индексам, ни callbacks, а занимает слоты только
+    // обработчик HF AG - контекст заполняется без блокировки
+    memset(c, 0, sizeof(*c));
+    memcpy(c->bda, bda, sizeof(esp_bd_addr_t));
+    c->sync_conn_handle = HF_CONN_HANDLE_NONE;
+    c->spk_volume = -1;
+    c->mic_volume = -1;
+    link_quality_init(&c->link);
+
+    portENTER_CRITICAL(&s_lock);
+    c->in_use = true;
+    rebuild_indexes();
+    portEXIT_CRITICAL(&s_lock);
+    return c;
+}
+
+void hf_conn_release(hf_conn_t *conn)
+{
+    if (conn == NULL || !conn->in_use) {
+        return;
+    }
+
+    int idx = (int)(conn - s_conns);
+    portENTER_CRITICAL(&s_lock);
+    if (s_audio_active == idx) {
+        s_audio_active = -1;
+    }
+    conn->in_use = false;
+    conn->sync_conn_handle = HF_CONN_HANDLE_NONE;
+    conn->slc_state = ESP_HF_CONNECTION_STATE_DISCONNECTED;
+    conn->audio_state = ESP_HF_AUDIO_STATE_DISCONNECTED;
+    rebuild_indexes();
+    portEXIT_CRITICAL(&s_lock);
+}
+
+hf_conn_t *hf_conn_get_by_handle(uint16_t sync_conn_handle)
+{
+    if (sync_conn_handle == HF_CONN_HANDLE_NONE) {
+        return NULL;
+    }
+
+    hf_conn_t *conn = NULL;
+    portENTER_CRITICAL(&s_lock);
+    uint32_t slot = handle_hash(sync_conn_handle);
+    for (int probe = 0; probe < HF_CONN_INDEX_SIZE; probe++) {
+        int idx = s_handle_index[slot];
+        if (idx < 0) {
+            break;
+        }
+        if (s_conns[idx].sync_conn_handle == sync_conn_handle) {
+            conn = &s_conns[idx];
+            break;
+        }
+        slot = (slot + 1) & HF_CONN_INDEX_MASK;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return conn;
+}
+
+void hf_conn_set_audio_state(hf_conn_t *conn, esp_hf_audio_state_t state, uint16_t sync_conn_handle)
+{
+    if (conn == NULL || !conn->in_use) {
+        return;
+    }
+
+    int idx = (int)(conn - s_conns);
+    bool open = state == ESP_HF_AUDIO_STATE_CONNECTED || state == ESP_HF_AUDIO_STATE_CONNECTED_MSBC;
+    if (open) {
+        // Соединение еще не активно - джиттер и счетчики SCO сбрасываются до публикации
+        link_quality_sco_open(&conn->link);
+        // Детекторы и АРУ переинициализирует поток приема перед первым кадром
+        __atomic_store_n(&conn->dsp_reset, audio_codec_sample_rate(audio_codec_from_audio_state(state)),
+                         __ATOMIC_RELEASE);
+    }
+
+    // Под блокировкой - только дескрипторы и индексы
+    portENTER_CRITICAL(&s_lock);
+    conn->audio_state = state;
+    if (open) {
+        conn->sync_conn_handle = sync_conn_handle;
+        conn->codec = audio_codec_from_audio_state(state);
+        // HCI data path обслуживает последний открытый SCO, остальные остаются без звука
+        s_audio_active = idx;
+    } else if (state == ESP_HF_AUDIO_STATE_DISCONNECTED) {
+        conn->sync_conn_handle = HF_CONN_HANDLE_NONE;
+        if (s_audio_active == idx) {
+            s_audio_active = -1;
+            for (int i = 0; i < HF_CONN_MAX; i++) {
+                if (s_conns[i].in_use && s_conns[i].sync_conn_handle != HF_CONN_HANDLE_NONE) {
+                    s_audio_active = i;
+                    break;
+                }
+            }
+        }
+    }
+    rebuild_indexes();
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void hf_conn_rx_sync(hf_conn_t *conn)
+{
+    uint32_t rate = __atomic_exchange_n(&conn->dsp_reset, 0, __ATOMIC_ACQUIRE);
+    if (rate == 0) {
+        return;
+    }
+    vad_init(&conn->vad, rate);
+    // Частоту, которую детектор не поддерживает, dtmf_init отклоняет - детектор остается выключенным
+    conn->dtmf_enabled = dtmf_init(&conn->dtmf, rate) == ESP_OK;
+    agc_init(&conn->agc, rate);
+    agc_set_volume(&conn->agc, agc_volume_gain(conn->mic_volume));
+}
+
+hf_conn_t *hf_conn_get_audio_active(void)
+{
+    int idx = s_audio_active;
+    return idx >= 0 ? &s_conns[idx] : NULL;
+}
+
+int hf_conn_count(void)
+{
+    int count = 0;
+    for (int i = 0; i < HF_CONN_MAX; i++) {
+        if (s_conns[i].in_use) {
+            count++;
+        }
+    }
+    return count;
+}
+
+hf_conn_t *hf_conn_at(int index)
+{
+    if (index < 0 || index >= HF_CONN_MAX || !s_conns[index].in_use) {
+        return NULL;
+    }
+    return &s_conns[index];
+}
+
+void hf_conn_print(void)
+{
+    int64_t now = esp_timer_get_time();
+    hf_conn_t *active = hf_conn_get_audio_active();
+
+    ESP_LOGI(TAG, "=== HF links (%d/%d) ===", hf_conn_count(), HF_CONN_MAX);
+    for (int i = 0; i < HF_CONN_MAX; i++) {
+        const hf_conn_t *c = &s_conns[i];
+        if (!c->in_use) {
+            continue;
+        }
+        ESP_LOGI(TAG, "%d. " ESP_BD_ADDR_STR " slc=%d audio=%d%s", i, ESP_BD_ADDR_HEX(c->bda),
+                 c->slc_state, c->audio_state, c == active ? " (active)" : "");
+        if (c->sync_conn_handle != HF_CONN_HANDLE_NONE) {
+            ESP_LOGI(TAG, "   SCO handle 0x%04x, codec %s", c->sync_conn_handle, audio_codec_name(c->codec));
+            const link_quality_t *lq = &c->link;
+            ESP_LOGI(TAG, "   link %s: loss %u.%u%% (avg %u.%u%%), jitter %lu us, RSSI delta %d dB%s",
+                     link_quality_level_name(lq->level), lq->loss / 10, lq->loss % 10,
+                     lq->loss_avg / 10, lq->loss_avg % 10, (unsigned long)lq->jitter_us,
+                     lq->rssi_valid ? lq->rssi : 0, lq->blocked ? ", codec policy off" : "");
+        }
+        if (c->link.downgrades + c->link.upgrades > 0) {
+            ESP_LOGI(TAG, "   codec policy: %lu downgrades, %lu upgrades suggested%s", (unsigned long)c->link.downgrades,
+                     (unsigned long)c->link.upgrades, c->link.fallback ? " (fallback to CVSD)" : "");
+        }
+        if (c->slc_to_audio_ms > 0) {
+            ESP_LOGI(TAG, "   SLC->audio %lu ms%s", (unsigned long)c->slc_to_audio_ms,
+                     c->fast_audio ? " (cached codec)" : "");
+        }
+        ESP_LOGI(TAG, "   volume spk=%d mic=%d, features 0x%08lx, up %lld s",
+                 c->spk_volume, c->mic_volume, (unsigned long)c->peer_feat,
+                 (long long)((now - c->connected_at_us) / 1000000));
+    }
+}
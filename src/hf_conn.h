@@ -0,0 +1,138 @@
+#ifndef HF_CONN_H
+#define HF_CONN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_bt_defs.h"
+#include "esp_hf_defs.h"
+#include "audio_codec.h"
+#include "vad.h"
+#include "dtmf.h"
+#include "agc.h"
+#include "link_quality.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HF_CONN_MAX               3     // Одновременных гарнитур (не больше BR/EDR ACL контроллера)
+#define HF_CONN_HANDLE_NONE       0xFFFF
+
+/*
+ * Контекст одного HF соединения. Поля соединения меняются только из
+ * обработчика событий HF AG; HCI callbacks их только читают. Детекторы и
+ * АРУ принадлежат потоку приема: при открытии SCO обработчик лишь
+ * выставляет dsp_reset, а переинициализацию выполняет hf_conn_rx_sync().
+ *
+ * SCO может быть открыто у нескольких гарнитур, но звук идет только через
+ * одно: legacy HCI data path (esp_hf_ag_register_data_callback) не передает
+ * дескриптор SCO, поэтому принятые и исходящие кадры относятся к соединению
+ * hf_conn_get_audio_active(). Сведения гарнитур между собой нет: остальные
+ * SCO остаются открытыми, но звук через них не идет.
+ */
+typedef struct {
+    bool in_use;
+    esp_bd_addr_t bda;
+    esp_hf_connection_state_t slc_state;
+    esp_hf_audio_state_t audio_state;
+    uint16_t sync_conn_handle;      // HF_CONN_HANDLE_NONE пока нет SCO
+    audio_codec_t codec;            // Кодек текущего (или ожидаемого) SCO
+    int spk_volume;                 // Громкость динамика гарнитуры, 0..15
+    int mic_volume;                 // Усиление микрофона гарнитуры, 0..15
+    uint32_t peer_feat;             // Биты возможностей HF (AT+BRSF)
+    uint32_t chld_feat;             // Возможности AT+CHLD
+    int64_t connected_at_us;
+    int64_t slc_up_us;              // Момент SLC_CONNECTED
+    int64_t audio_req_us;           // Момент запроса/начала открытия SCO (0 - не открывается)
+    uint32_t slc_to_audio_ms;       // Время от SLC до первого открытого аудио
+    bool fast_audio;                // SCO открыт сразу по кэшу paired_devices
+
+    uint32_t dsp_reset;             // Частота нового SCO для потока приема, 0 - нет запроса
+    vad_t vad;                      // Детектор речи микрофона (обновляет поток приема)
+    dtmf_t dtmf;                    // Детектор DTMF и тонов факса (обновляет поток приема)
+    bool dtmf_enabled;              // Частота SCO поддерживается детектором
+    agc_t agc;                      // АРУ, лимитер и громкость микрофона (AT+VGM)
+    link_quality_t link;            // Качество SCO и политика кодека (джиттер - поток приема)
+} hf_conn_t;
+
+/**
+ * @brief Инициализация таблицы соединений
+ * @return ESP_OK при успехе
+ */
+esp_err_t hf_conn_init(void);
+
+/**
+ * @brief Поиск соединения по адресу гарнитуры
+ * @param bda Адрес гарнитуры
+ * @return Контекст соединения или NULL
+ */
+hf_conn_t *hf_conn_get(const esp_bd_addr_t bda);
+
+/**
+ * @brief Поиск соединения по адресу с созданием нового контекста
+ * @param bda Адрес гарнитуры
+ * @return Контекст соединения или NULL, если таблица заполнена
+ */
+hf_conn_t *hf_conn_acquire(const esp_bd_addr_t bda);
+
+/**
+ * @brief Освобождение контекста при разрыве SLC
+ * @param conn Контекст соединения
+ */
+void hf_conn_release(hf_conn_t *conn);
+
+/**
+ * @brief Поиск соединения по дескриптору SCO
+ * @param sync_conn_handle Дескриптор SCO соединения
+ * @return Контекст соединения или NULL
+ */
+hf_conn_t *hf_conn_get_by_handle(uint16_t sync_conn_handle);
+
+/**
+ * @brief Обновление состояния аудио канала соединения
+ * @param conn Контекст соединения
+ * @param state Новое состояние аудио
+ * @param sync_conn_handle Дескриптор SCO (при открытии канала)
+ */
+void hf_conn_set_audio_state(hf_conn_t *conn, esp_hf_audio_state_t state, uint16_t sync_conn_handle);
+
+/**
+ * @brief Соединение, чей SCO сейчас обслуживает HCI data path
+ * @return Контекст соединения или NULL
+ *
+ * Вызывается из HCI callbacks, без блокировок.
+ */
+hf_conn_t *hf_conn_get_audio_active(void);
+
+/**
+ * @brief Переинициализация детекторов и АРУ, запрошенная открытием SCO
+ * @param conn Контекст соединения
+ *
+ * Вызывается потоком приема перед обработкой кадра.
+ */
+void hf_conn_rx_sync(hf_conn_t *conn);
+
+/**
+ * @brief Количество соединений в таблице
+ * @return Количество соединений
+ */
+int hf_conn_count(void);
+
+/**
+ * @brief Доступ к соединению по индексу таблицы
+ * @param index Индекс 0..HF_CONN_MAX-1
+ * @return Контекст соединения или NULL, если слот свободен
+ */
+hf_conn_t *hf_conn_at(int index);
+
+/**
+ * @brief Вывод таблицы соединений в лог
+ */
+void hf_conn_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HF_CONN_H */
@@ -1,12 +1,241 @@
 #include "hf_handler.h"
+#include "hf_conn.h"
 #include "auto_reconnect.h"
 #include "paired_devices.h"
+#include "audio_handler.h"
+#include "radio_sched.h"
+#include "trace.h"
+#include "boot_phase.h"
+#include "link_quality.h"
+#include "metrics.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_gap_bt_api.h"
 #include <string.h>
 
 static const char* TAG = "HF_HANDLER";
 
-esp_bd_addr_t hf_peer_addr = {0};
+static esp_timer_handle_t s_link_timer = NULL;
+static bool s_link_polling = false;
+static struct {
+    metric_t *downgrades;
+    metric_t *upgrades;
+} s_link_m;
+
+static int32_t sample_link_loss(void)
+{
+    hf_conn_t *active = hf_conn_get_audio_active();
+    return active != NULL ? active->link.loss : 0;
+}
+
+// Опрос раз в окно; ответы приходят событиями HF и GAP
+static void hf_link_poll_cb(void *arg)
+{
+    hf_conn_t *active = hf_conn_get_audio_active();
+    if (active == NULL) {
+        return;
+    }
+    // Событие статистики не несет дескриптор SCO, поэтому опрашивается только SCO на data path
+    esp_hf_ag_pkt_stat_nums_get(active->sync_conn_handle);
+    esp_bt_gap_read_rssi_delta(active->bda);
+}
+
+// Опрос идет, пока открыт хотя бы один SCO
+static void hf_link_monitor_refresh(void)
+{
+    if (s_link_timer == NULL) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = hf_link_poll_cb,
+            .name = "link_poll",
+        };
+        if (esp_timer_create(&timer_args, &s_link_timer) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create link monitor timer");
+            return;
+        }
+        s_link_m.downgrades = metrics_counter("link.codec_downgrades");
+        s_link_m.upgrades = metrics_counter("link.codec_upgrades");
+        metrics_gauge("link.loss_permille", sample_link_loss);
+    }
+
+    bool audio = hf_conn_get_audio_active() != NULL;
+    if (audio && !s_link_polling) {
+        s_link_polling = esp_timer_start_periodic(s_link_timer, LINK_QUALITY_POLL_MS * 1000) == ESP_OK;
+    } else if (!audio && s_link_polling) {
+        esp_timer_stop(s_link_timer);
+        s_link_polling = false;
+    }
+}
+
+// Решение политики - только совет: кодек согласует Bluedroid при открытии SCO
+// (AT+BCS), и переоткрытие на гарнитуре с WBS снова дает mSBC. Закрывать SCO
+// ради этого - разрыв звука как раз во время помех, поэтому SCO не трогаем,
+// пока у стека нет способа навязать кодек
+static void hf_link_advise_codec(hf_conn_t *conn, link_quality_action_t action)
+{
+    link_quality_t *lq = &conn->link;
+    bool down = action == LINK_QUALITY_ACTION_DOWNGRADE;
+    ESP_LOGW(TAG, "🔀 Link " ESP_BD_ADDR_STR ": policy suggests %s %s -> %s (loss %u.%u%%, avg %u.%u%%, jitter %lu us, RSSI delta %d dB), codec left to the stack",
+             ESP_BD_ADDR_HEX(conn->bda), down ? "downgrade" : "upgrade", audio_codec_name(conn->codec),
+             audio_codec_name(lq->switch_target), lq->loss / 10, lq->loss % 10, lq->loss_avg / 10,
+             lq->loss_avg % 10, (unsigned long)lq->jitter_us, lq->rssi_valid ? lq->rssi : 0);
+    metrics_inc(down ? s_link_m.downgrades : s_link_m.upgrades);
+    trace_instant(TRACE_TRACK_AUDIO, down ? "codec_down" : "codec_up", lq->loss);
+
+    // Смена не выполняется: следующий совет - не раньше LINK_QUALITY_DWELL_MS
+    link_quality_switch_failed(lq);
+}
+
+static void hf_on_pkt_stats(const esp_hf_cb_param_t *param)
+{
+    hf_conn_t *conn = hf_conn_get_audio_active();
+    if (conn == NULL) {
+        return;
+    }
+    const link_quality_sample_t sample = {
+        .rx_total = param->pkt_nums.rx_total,
+        .rx_bad = param->pkt_nums.rx_err + param->pkt_nums.rx_none + param->pkt_nums.rx_lost,
+    };
+    link_quality_t *lq = &conn->link;
+    link_quality_level_t prev = lq->level;
+    link_quality_action_t action = link_quality_update(lq, conn->codec, &sample, esp_timer_get_time() / 1000);
+
+    // Журнал - только смены оценки и решения, не каждое окно
+    if (lq->level != prev && lq->level != LINK_QUALITY_UNKNOWN) {
+        ESP_LOGI(TAG, "📶 Link " ESP_BD_ADDR_STR " %s: loss %u.%u%% (avg %u.%u%%), jitter %lu us, RSSI delta %d dB",
+                 ESP_BD_ADDR_HEX(conn->bda), link_quality_level_name(lq->level), lq->loss / 10, lq->loss % 10,
+                 lq->loss_avg / 10, lq->loss_avg % 10, (unsigned long)lq->jitter_us, lq->rssi_valid ? lq->rssi : 0);
+    }
+    if (action != LINK_QUALITY_ACTION_NONE) {
+        hf_link_advise_codec(conn, action);
+    }
+}
+
+// SLC поднят: сохраняем возможности гарнитуры и, если для нее уже есть
+// проверенный кодек, сразу открываем SCO без ожидания команды
+static void hf_on_slc_connected(hf_conn_t *conn, const esp_hf_cb_param_t *param)
+{
+    conn->peer_feat = param->conn_stat.peer_feat;
+    conn->chld_feat = param->conn_stat.chld_feat;
+    conn->slc_up_us = esp_timer_get_time();
+    conn->slc_to_audio_ms = 0;
+    conn->fast_audio = false;
+
+    paired_device_t *device = paired_devices_find(conn->bda);
+    uint8_t cached_codec = 0;
+    if (device != NULL) {
+        paired_link_caps_t link = device->link;
+        link.peer_feat = conn->peer_feat;
+        link.chld_feat = conn->chld_feat;
+        paired_devices_update_link(conn->bda, &link);
+        cached_codec = link.last_codec;
+    }
+
+    // Без кэша ожидаем лучший кодек, доступный гарнитуре через согласование
+    conn->codec = audio_codec_select(conn->peer_feat, cached_codec);
+    bool cached = cached_codec != 0 && audio_codec_to_paired(conn->codec) == cached_codec;
+
+    // Буферы и частоты готовятся заранее, открытие SCO только включает тракт
+    audio_handler_prepare(conn->codec);
+
+    if (cached && conn->audio_state == ESP_HF_AUDIO_STATE_DISCONNECTED) {
+        ESP_LOGI(TAG, "⚡ Known-good codec %s, opening audio right away", audio_codec_name(conn->codec));
+        conn->fast_audio = true;
+        if (hf_handler_audio_open(conn->bda) != ESP_OK) {
+            conn->fast_audio = false;
+        }
+    }
+}
+
+static void hf_on_audio_state(hf_conn_t *conn, const esp_hf_cb_param_t *param)
+{
+    int64_t now = esp_timer_get_time();
+    esp_hf_audio_state_t prev = conn->audio_state;
+    esp_hf_audio_state_t state = param->audio_stat.state;
+
+    hf_conn_set_audio_state(conn, state, param->audio_stat.sync_conn_handle);
+
+    // Data path переключается на SCO, выбранный таблицей соединений
+    if (state != ESP_HF_AUDIO_STATE_CONNECTING) {
+        trace_end(TRACE_TRACK_AUDIO, "sco_setup");
+        hf_conn_t *active = hf_conn_get_audio_active();
+        if (active != NULL) {
+            audio_handler_set_connection_state(true, active->sync_conn_handle, active->codec);
+        } else {
+            audio_handler_set_connection_state(false, HF_CONN_HANDLE_NONE, conn->codec);
+        }
+    }
+
+    if (state == ESP_HF_AUDIO_STATE_CONNECTING) {
+        if (conn->audio_req_us == 0) {
+            conn->audio_req_us = now;  // SCO инициирован гарнитурой
+            trace_begin(TRACE_TRACK_AUDIO, "sco_setup");
+        }
+        return;
+    }
+
+    paired_device_t *device = paired_devices_find(conn->bda);
+
+    if (state == ESP_HF_AUDIO_STATE_CONNECTED || state == ESP_HF_AUDIO_STATE_CONNECTED_MSBC) {
+        uint32_t setup_ms = conn->audio_req_us ? (uint32_t)((now - conn->audio_req_us) / 1000) : 0;
+        if (conn->slc_to_audio_ms == 0 && conn->slc_up_us != 0) {
+            conn->slc_to_audio_ms = (uint32_t)((now - conn->slc_up_us) / 1000);
+        }
+        conn->audio_req_us = 0;
+        ESP_LOGI(TAG, "⏱️ Audio up: SLC->audio %lu ms, SCO setup %lu ms, codec %s%s",
+                 (unsigned long)conn->slc_to_audio_ms, (unsigned long)setup_ms,
+                 audio_codec_name(conn->codec), conn->fast_audio ? " (cached)" : "");
+
+        if (device != NULL) {
+            paired_link_caps_t link = device->link;
+            uint8_t codec = audio_codec_to_paired(conn->codec);
+            link.codecs |= codec;
+            link.last_codec = codec;
+            link.last_frame_size = param->audio_stat.preferred_frame_size;
+            link.slc_to_audio_ms = conn->slc_to_audio_ms > UINT16_MAX ? UINT16_MAX : (uint16_t)conn->slc_to_audio_ms;
+            if (link.audio_ok_count < UINT16_MAX) {
+                link.audio_ok_count++;
+            }
+            paired_devices_update_link(conn->bda, &link);
+        }
+    } else if (state == ESP_HF_AUDIO_STATE_DISCONNECTED) {
+        // SCO не открылся с кэшированным кодеком - в следующий раз согласуем заново
+        if (prev == ESP_HF_AUDIO_STATE_CONNECTING && conn->fast_audio && device != NULL) {
+            ESP_LOGW(TAG, "Cached codec failed, dropping it");
+            paired_link_caps_t link = device->link;
+            link.last_codec = 0;
+            paired_devices_update_link(conn->bda, &link);
+        }
+        conn->audio_req_us = 0;
+        conn->fast_audio = false;
+    }
+}
+
+esp_err_t hf_handler_audio_open(const esp_bd_addr_t bda)
+{
+    hf_conn_t *conn = hf_conn_get(bda);
+    if (conn == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    conn->audio_req_us = esp_timer_get_time();
+    trace_begin(TRACE_TRACK_AUDIO, "sco_setup");
+    esp_err_t ret = esp_hf_ag_audio_connect((uint8_t *)conn->bda);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open audio: %s", esp_err_to_name(ret));
+        trace_end(TRACE_TRACK_AUDIO, "sco_setup");
+        conn->audio_req_us = 0;
+    }
+    return ret;
+}
+
+esp_err_t hf_handler_audio_close(const esp_bd_addr_t bda)
+{
+    hf_conn_t *conn = hf_conn_get(bda);
+    if (conn == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return esp_hf_ag_audio_disconnect((uint8_t *)conn->bda);
+}
 
 void hf_ag_event_handler(esp_hf_cb_event_t event, esp_hf_cb_param_t *param) {
     if (param == NULL) {
@@ -14,33 +243,99 @@ void hf_ag_event_handler(esp_hf_cb_event_t event, esp_hf_cb_param_t *param) {
         return;
     }
 
+    trace_instant(TRACE_TRACK_HF, "hf_evt", event);
+
     switch (event) {
-        case ESP_HF_CONNECTION_STATE_EVT:
+        case ESP_HF_CONNECTION_STATE_EVT: {
             ESP_LOGI(TAG, "HF connection state: %d", param->conn_stat.state);
+            hf_conn_t *conn = hf_conn_get(param->conn_stat.remote_bda);
             if (param->conn_stat.state == ESP_HF_CONNECTION_STATE_CONNECTED) {
                 ESP_LOGI(TAG, "HF connected to " ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(param->conn_stat.remote_bda));
-                memcpy(hf_peer_addr, param->conn_stat.remote_bda, sizeof(esp_bd_addr_t));
+                conn = hf_conn_acquire(param->conn_stat.remote_bda);
+                if (conn == NULL) {
+                    // Свободного контекста нет - не держим SLC, который не сможем обслужить
+                    esp_hf_ag_slc_disconnect(param->conn_stat.remote_bda);
+                    break;
+                }
+                conn->connected_at_us = esp_timer_get_time();
+                // Page завершен, дальше - согласование SLC по RFCOMM
+                trace_end(TRACE_TRACK_PAGE, "page");
+                trace_begin(TRACE_TRACK_HF, "slc");
                 
-                // Добавляем устройство в список сопряженных
-                paired_devices_add(param->conn_stat.remote_bda, "HF Device", 0x200408, true);
+                // Имя и COD известны из поиска; заглушка - только для неизвестных устройств
+                if (paired_devices_find(param->conn_stat.remote_bda) != NULL) {
+                    paired_devices_update_connection_time(param->conn_stat.remote_bda);
+                } else {
+                    paired_devices_add(param->conn_stat.remote_bda, "HF Device", 0x200408, true);
+                }
                 
                 // Уведомляем модуль автоматического переподключения
                 auto_reconnect_notify_connection_state(true);
             } else if (param->conn_stat.state == ESP_HF_CONNECTION_STATE_DISCONNECTED) {
-                ESP_LOGI(TAG, "HF disconnected");
-                memset(hf_peer_addr, 0, sizeof(esp_bd_addr_t));
+                ESP_LOGI(TAG, "HF disconnected " ESP_BD_ADDR_STR, ESP_BD_ADDR_HEX(param->conn_stat.remote_bda));
+                trace_end(TRACE_TRACK_PAGE, "page");
+                trace_end(TRACE_TRACK_HF, "slc");
+                hf_conn_release(conn);
+                conn = NULL;
                 
-                // Уведомляем модуль автоматического переподключения
-                auto_reconnect_notify_connection_state(false);
+                // Переподключение нужно только когда не осталось ни одной гарнитуры
+                hf_link_monitor_refresh();
+                if (hf_conn_count() == 0) {
+                    audio_handler_disarm();
+                    auto_reconnect_notify_connection_state(false);
+                } else if (hf_conn_get_audio_active() == NULL && audio_handler_is_connected()) {
+                    audio_handler_set_connection_state(false, HF_CONN_HANDLE_NONE, AUDIO_CODEC_CVSD);
+                }
+            }
+            radio_sched_refresh();
+            if (conn != NULL) {
+                conn->slc_state = param->conn_stat.state;
+                if (param->conn_stat.state == ESP_HF_CONNECTION_STATE_SLC_CONNECTED) {
+                    trace_end(TRACE_TRACK_HF, "slc");
+                    if (boot_phase_milestone("headset_connected")) {
+                        boot_phase_report();
+                    }
+                    hf_on_slc_connected(conn, param);
+                }
             }
             break;
+        }
 
-        case ESP_HF_AUDIO_STATE_EVT:
-            ESP_LOGI(TAG, "HF audio state: %d", param->audio_stat.state);
+        case ESP_HF_AUDIO_STATE_EVT: {
+            ESP_LOGI(TAG, "HF audio state: %d, " ESP_BD_ADDR_STR ", sync_conn_handle: 0x%04x",
+                     param->audio_stat.state, ESP_BD_ADDR_HEX(param->audio_stat.remote_addr),
+                     param->audio_stat.sync_conn_handle);
+            hf_conn_t *conn = hf_conn_get(param->audio_stat.remote_addr);
+            if (conn == NULL) {
+                ESP_LOGW(TAG, "Audio state for unknown link");
+                break;
+            }
+            hf_on_audio_state(conn, param);
+            hf_link_monitor_refresh();
+            radio_sched_refresh();
             break;
+        }
 
-        case ESP_HF_VOLUME_CONTROL_EVT:
+        case ESP_HF_VOLUME_CONTROL_EVT: {
             ESP_LOGI(TAG, "Volume control: type=%d, volume=%d", param->volume_control.type, param->volume_control.volume);
+            hf_conn_t *conn = hf_conn_get(param->volume_control.remote_addr);
+            if (conn != NULL) {
+                if (param->volume_control.type == ESP_HF_VOLUME_CONTROL_TARGET_SPK) {
+                    conn->spk_volume = param->volume_control.volume;
+                } else {
+                    conn->mic_volume = param->volume_control.volume;
+                }
+                audio_handler_apply_volume(conn);
+            }
+            break;
+        }
+
+        case ESP_HF_PKT_STAT_NUMS_GET_EVT:
+            hf_on_pkt_stats(param);
+            break;
+
+        case ESP_HF_BCS_RESPONSE_EVT:
+            ESP_LOGI(TAG, "Codec selected by HF: %s", param->bcs_rep.mode == ESP_HF_WBS_YES ? "mSBC" : "CVSD");
             break;
 
         default:
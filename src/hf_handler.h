@@ -4,10 +4,21 @@
 #include "esp_hf_ag_api.h"
 #include "esp_bt_defs.h"
 
-// Экспортированные переменные
-extern esp_bd_addr_t hf_peer_addr;
-
 // Функции
 void hf_ag_event_handler(esp_hf_cb_event_t event, esp_hf_cb_param_t *param);
 
+/**
+ * @brief Открытие SCO к гарнитуре с замером времени установления
+ * @param bda Адрес гарнитуры
+ * @return ESP_OK при успехе, ESP_ERR_NOT_FOUND если гарнитура не подключена
+ */
+esp_err_t hf_handler_audio_open(const esp_bd_addr_t bda);
+
+/**
+ * @brief Закрытие SCO к гарнитуре
+ * @param bda Адрес гарнитуры
+ * @return ESP_OK при успехе
+ */
+esp_err_t hf_handler_audio_close(const esp_bd_addr_t bda);
+
 #endif // HF_HANDLER_H
@@ -0,0 +1,113 @@
+#include "ima_adpcm.h"
+
+static const int16_t s_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t s_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static inline int32_t clamp_index(int32_t index)
+{
+    return index < 0 ? 0 : (index > 88 ? 88 : index);
+}
+
+static inline int32_t clamp_sample(int32_t value)
+{
+    return value < INT16_MIN ? INT16_MIN : (value > INT16_MAX ? INT16_MAX : value);
+}
+
+uint8_t ima_adpcm_encode_sample(ima_adpcm_state_t *state, int16_t sample)
+{
+    int32_t step = s_step_table[state->step_index];
+    int32_t diff = sample - state->predictor;
+    uint8_t code = 0;
+
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+
+    // Тот же расчет разности, что и в декодере, чтобы предсказатели не расходились
+    int32_t vpdiff = step >> 3;
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+        vpdiff += step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+        vpdiff += step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+        vpdiff += step;
+    }
+
+    state->predictor = clamp_sample((code & 8) ? state->predictor - vpdiff : state->predictor + vpdiff);
+    state->step_index = clamp_index(state->step_index + s_index_table[code]);
+    return code;
+}
+
+int16_t ima_adpcm_decode_sample(ima_adpcm_state_t *state, uint8_t code)
+{
+    int32_t step = s_step_table[state->step_index];
+    int32_t vpdiff = step >> 3;
+
+    if (code & 4) {
+        vpdiff += step;
+    }
+    if (code & 2) {
+        vpdiff += step >> 1;
+    }
+    if (code & 1) {
+        vpdiff += step >> 2;
+    }
+
+    state->predictor = clamp_sample((code & 8) ? state->predictor - vpdiff : state->predictor + vpdiff);
+    state->step_index = clamp_index(state->step_index + s_index_table[code & 0x0F]);
+    return (int16_t)state->predictor;
+}
+
+void ima_adpcm_encode_block(ima_adpcm_state_t *state, const int16_t *pcm, uint8_t *out)
+{
+    // Заголовок блока: первый отсчет как опорный + индекс шага
+    state->predictor = pcm[0];
+    out[0] = (uint8_t)(pcm[0] & 0xFF);
+    out[1] = (uint8_t)((uint16_t)pcm[0] >> 8);
+    out[2] = (uint8_t)state->step_index;
+    out[3] = 0;
+
+    uint8_t *p = out + 4;
+    for (int i = 1; i < IMA_ADPCM_SAMPLES_PER_BLOCK; i += 2) {
+        uint8_t lo = ima_adpcm_encode_sample(state, pcm[i]);
+        uint8_t hi = ima_adpcm_encode_sample(state, pcm[i + 1]);
+        *p++ = (uint8_t)(lo | (hi << 4));
+    }
+}
+
+void ima_adpcm_decode_block(const uint8_t *in, int16_t *pcm)
+{
+    ima_adpcm_state_t state = {
+        .predictor = (int16_t)(in[0] | (in[1] << 8)),
+        .step_index = clamp_index(in[2]),
+    };
+
+    pcm[0] = (int16_t)state.predictor;
+    const uint8_t *p = in + 4;
+    for (int i = 1; i < IMA_ADPCM_SAMPLES_PER_BLOCK; i += 2) {
+        pcm[i] = ima_adpcm_decode_sample(&state, *p & 0x0F);
+        pcm[i + 1] = ima_adpcm_decode_sample(&state, *p >> 4);
+        p++;
+    }
+}
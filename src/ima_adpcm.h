@@ -0,0 +1,55 @@
+#ifndef IMA_ADPCM_H
+#define IMA_ADPCM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Блочный формат IMA-ADPCM как в WAV (WAVE_FORMAT_IMA_ADPCM), моно
+#define IMA_ADPCM_BLOCK_BYTES        256
+#define IMA_ADPCM_SAMPLES_PER_BLOCK  ((IMA_ADPCM_BLOCK_BYTES - 4) * 2 + 1)
+
+typedef struct {
+    int32_t predictor;
+    int32_t step_index;
+} ima_adpcm_state_t;
+
+/**
+ * @brief Кодирование одного отсчета в 4-битный код
+ * @param state Состояние кодера
+ * @param sample Входной отсчет
+ * @return Код 0..15
+ */
+uint8_t ima_adpcm_encode_sample(ima_adpcm_state_t *state, int16_t sample);
+
+/**
+ * @brief Декодирование одного 4-битного кода
+ * @param state Состояние декодера
+ * @param code Код 0..15
+ * @return Восстановленный отсчет
+ */
+int16_t ima_adpcm_decode_sample(ima_adpcm_state_t *state, uint8_t code);
+
+/**
+ * @brief Кодирование блока IMA_ADPCM_SAMPLES_PER_BLOCK отсчетов в IMA_ADPCM_BLOCK_BYTES байт
+ * @param state Состояние кодера (индекс шага переносится между блоками)
+ * @param pcm Входные отсчеты
+ * @param out Выходной блок
+ */
+void ima_adpcm_encode_block(ima_adpcm_state_t *state, const int16_t *pcm, uint8_t *out);
+
+/**
+ * @brief Декодирование блока IMA_ADPCM_BLOCK_BYTES байт в IMA_ADPCM_SAMPLES_PER_BLOCK отсчетов
+ * @param in Входной блок
+ * @param pcm Выходные отсчеты
+ */
+void ima_adpcm_decode_block(const uint8_t *in, int16_t *pcm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMA_ADPCM_H */
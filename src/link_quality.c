@@ -0,0 +1,185 @@
+#include "link_quality.h"
+#include <string.h>
+
+#define LOSS_AVG_SHIFT   2          // Сглаживание потерь: 1/4 нового окна
+
+void link_quality_init(link_quality_t *lq)
+{
+    memset(lq, 0, sizeof(*lq));
+    lq->switch_target = AUDIO_CODEC_COUNT;
+    lq->wide_codec = AUDIO_CODEC_MSBC;
+    lq->hold_ms = LINK_QUALITY_HOLD_MS;
+}
+
+void link_quality_sco_open(link_quality_t *lq)
+{
+    lq->jitter_q4 = 0;
+    lq->last_frame_us = 0;
+    lq->have_base = false;
+    lq->level = LINK_QUALITY_UNKNOWN;
+    lq->loss = 0;
+    lq->loss_avg = 0;
+    lq->jitter_us = 0;
+    lq->jitter_peak_us = 0;
+    lq->sco_total = 0;
+    lq->sco_bad = 0;
+    lq->bad_windows = 0;
+    lq->good_windows = 0;
+}
+
+void link_quality_on_frame(link_quality_t *lq, int64_t now_us, uint32_t frame_us)
+{
+    if (lq->last_frame_us != 0) {
+        int32_t d = (int32_t)(now_us - lq->last_frame_us) - (int32_t)frame_us;
+        uint32_t a = (uint32_t)(d < 0 ? -d : d);
+        // RFC 3550: J += (|D| - J) / 16, J хранится в Q4
+        uint32_t j = lq->jitter_q4;
+        lq->jitter_q4 = j + a - ((j + 8) >> 4);
+    }
+    lq->last_frame_us = now_us;
+}
+
+void link_quality_set_rssi(link_quality_t *lq, int8_t rssi)
+{
+    lq->rssi = rssi;
+    lq->rssi_valid = true;
+}
+
+static link_quality_level_t classify(const link_quality_t *lq)
+{
+    bool weak = lq->rssi_valid && lq->rssi <= LINK_QUALITY_WEAK_RSSI;
+    bool strong = !lq->rssi_valid || lq->rssi > LINK_QUALITY_WEAK_RSSI + LINK_QUALITY_RSSI_MARGIN;
+
+    // Слабый сигнал сам по себе не плох, но вместе с заметными потерями предвещает обрывы
+    if (lq->loss >= LINK_QUALITY_BAD_LOSS || lq->jitter_us >= LINK_QUALITY_BAD_JITTER_US ||
+        (weak && lq->loss > LINK_QUALITY_GOOD_LOSS)) {
+        return LINK_QUALITY_BAD;
+    }
+    if (lq->loss <= LINK_QUALITY_GOOD_LOSS && lq->loss_avg <= LINK_QUALITY_GOOD_LOSS &&
+        lq->jitter_us <= LINK_QUALITY_GOOD_JITTER_US && strong) {
+        return LINK_QUALITY_GOOD;
+    }
+    return LINK_QUALITY_FAIR;
+}
+
+static void begin_switch(link_quality_t *lq, audio_codec_t target, int64_t now_ms)
+{
+    lq->switch_target = target;
+    lq->last_switch_ms = now_ms;
+    lq->bad_windows = 0;
+    lq->good_windows = 0;
+}
+
+link_quality_action_t link_quality_update(link_quality_t *lq, audio_codec_t codec,
+                                          const link_quality_sample_t *sample, int64_t now_ms)
+{
+    lq->jitter_us = lq->jitter_q4 >> 4;
+    if (lq->jitter_us > lq->jitter_peak_us) {
+        lq->jitter_peak_us = lq->jitter_us;
+    }
+    lq->sco_total = sample->rx_total;
+    lq->sco_bad = sample->rx_bad;
+
+    // Первое окно SCO или стек сбросил счетчики - только точка отсчета
+    if (!lq->have_base || sample->rx_total < lq->base_total || sample->rx_bad < lq->base_bad) {
+        lq->base_total = sample->rx_total;
+        lq->base_bad = sample->rx_bad;
+        lq->have_base = true;
+        lq->level = LINK_QUALITY_UNKNOWN;
+        return LINK_QUALITY_ACTION_NONE;
+    }
+    uint32_t total = sample->rx_total - lq->base_total;
+    uint32_t bad = sample->rx_bad - lq->base_bad;
+    lq->base_total = sample->rx_total;
+    lq->base_bad = sample->rx_bad;
+    if (total == 0) {
+        lq->level = LINK_QUALITY_UNKNOWN;
+        return LINK_QUALITY_ACTION_NONE;
+    }
+
+    bad = bad < total ? bad : total;
+    lq->loss = (uint16_t)(bad * 1000 / total);
+    lq->loss_avg = (uint16_t)(lq->loss_avg + (((int32_t)lq->loss - lq->loss_avg) >> LOSS_AVG_SHIFT));
+    lq->level = classify(lq);
+
+    // Среднее окно - зона гистерезиса: обе серии начинаются заново
+    switch (lq->level) {
+    case LINK_QUALITY_BAD:
+        lq->bad_windows += lq->bad_windows < UINT8_MAX;
+        lq->good_windows = 0;
+        break;
+    case LINK_QUALITY_GOOD:
+        lq->good_windows += lq->good_windows < UINT8_MAX;
+        lq->bad_windows = 0;
+        break;
+    default:
+        lq->bad_windows = 0;
+        lq->good_windows = 0;
+        break;
+    }
+
+    if (lq->switch_target != AUDIO_CODEC_COUNT || lq->blocked) {
+        return LINK_QUALITY_ACTION_NONE;
+    }
+    int64_t since = now_ms - lq->last_switch_ms;
+    bool switched = lq->downgrades + lq->upgrades > 0;
+
+    if (codec != AUDIO_CODEC_CVSD && lq->bad_windows >= LINK_QUALITY_BAD_WINDOWS &&
+        (!switched || since >= LINK_QUALITY_DWELL_MS)) {
+        // Повышение не прижилось: следующая попытка вдвое позже
+        if (lq->upgrades > 0 && now_ms - lq->last_upgrade_ms < LINK_QUALITY_FLAP_MS) {
+            lq->hold_ms = lq->hold_ms * 2 < LINK_QUALITY_HOLD_MAX_MS ? lq->hold_ms * 2 : LINK_QUALITY_HOLD_MAX_MS;
+        }
+        lq->fallback = true;
+        lq->wide_codec = codec;
+        lq->downgrades++;
+        begin_switch(lq, AUDIO_CODEC_CVSD, now_ms);
+        return LINK_QUALITY_ACTION_DOWNGRADE;
+    }
+    if (codec == AUDIO_CODEC_CVSD && lq->fallback && lq->good_windows >= LINK_QUALITY_GOOD_WINDOWS &&
+        since >= (int64_t)lq->hold_ms) {
+        lq->upgrades++;
+        lq->last_upgrade_ms = now_ms;
+        begin_switch(lq, lq->wide_codec, now_ms);
+        return LINK_QUALITY_ACTION_UPGRADE;
+    }
+    return LINK_QUALITY_ACTION_NONE;
+}
+
+bool link_quality_switch_done(link_quality_t *lq, audio_codec_t codec)
+{
+    audio_codec_t target = lq->switch_target;
+    lq->switch_target = AUDIO_CODEC_COUNT;
+    if (target == AUDIO_CODEC_COUNT || codec == target) {
+        return true;
+    }
+    // Стек согласовал свой кодек: повторные попытки дали бы только разрывы звука
+    lq->blocked = true;
+    if (target == AUDIO_CODEC_CVSD) {
+        lq->fallback = false;
+    }
+    return false;
+}
+
+void link_quality_switch_failed(link_quality_t *lq)
+{
+    // Кодек не понижен - возвращаться не с чего
+    if (lq->switch_target == AUDIO_CODEC_CVSD) {
+        lq->fallback = false;
+    }
+    lq->switch_target = AUDIO_CODEC_COUNT;
+}
+
+const char *link_quality_level_name(link_quality_level_t level)
+{
+    switch (level) {
+    case LINK_QUALITY_GOOD:
+        return "good";
+    case LINK_QUALITY_FAIR:
+        return "fair";
+    case LINK_QUALITY_BAD:
+        return "bad";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef LINK_QUALITY_H
+#define LINK_QUALITY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "audio_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LINK_QUALITY_POLL_MS          1000    // Окно: опрос статистики SCO и RSSI
+#define LINK_QUALITY_BAD_LOSS         50      // Потери, промилле: с 5% речь mSBC рвется
+#define LINK_QUALITY_GOOD_LOSS        10
+#define LINK_QUALITY_BAD_JITTER_US    20000   // Кадры идут пачками по три и больше: повторы в эфире
+#define LINK_QUALITY_GOOD_JITTER_US   10000   // Пары кадров по HCI дают ~один кадр (7.5 мс) - это норма
+#define LINK_QUALITY_WEAK_RSSI        (-6)    // Отклонение от "золотого" диапазона контроллера, дБ
+#define LINK_QUALITY_RSSI_MARGIN      3       // Гистерезис RSSI, дБ
+#define LINK_QUALITY_BAD_WINDOWS      3       // Подряд плохих окон до понижения кодека
+#define LINK_QUALITY_GOOD_WINDOWS     20      // Подряд хороших окон до повышения
+#define LINK_QUALITY_DWELL_MS         10000   // Минимум между сменами кодека
+#define LINK_QUALITY_HOLD_MS          30000   // Начальная выдержка перед повышением
+#define LINK_QUALITY_HOLD_MAX_MS      300000  // Выдержка удваивается после каждого отката
+#define LINK_QUALITY_FLAP_MS          60000   // Понижение быстрее этого после повышения - откат
+
+/*
+ * Монитор качества SCO и политика смены кодека.
+ *
+ * Раз в окно обработчик HF передает накопительные счетчики кадров стека и
+ * RSSI; джиттер прихода кадров считает поток приема (RFC 3550). Окно
+ * оценивается как хорошее, среднее или плохое. Несколько плохих окон подряд
+ * на широкополосном кодеке - понижение до CVSD, длинная серия хороших после
+ * нашего понижения - возврат. Между ними зона гистерезиса, минимальный
+ * интервал между сменами и выдержка, которая растет после каждого отката.
+ *
+ * Модуль не зависит от стека. Bluedroid не дает выбрать кодек SCO, поэтому
+ * hf_handler решения только журналирует и сразу отменяет через
+ * link_quality_switch_failed(); link_quality_switch_done() - для пути,
+ * который сможет кодек навязать.
+ */
+
+typedef enum {
+    LINK_QUALITY_UNKNOWN = 0,       // Нет данных за окно
+    LINK_QUALITY_GOOD,
+    LINK_QUALITY_FAIR,
+    LINK_QUALITY_BAD,
+} link_quality_level_t;
+
+typedef enum {
+    LINK_QUALITY_ACTION_NONE = 0,
+    LINK_QUALITY_ACTION_DOWNGRADE,  // Широкополосный кодек -> CVSD
+    LINK_QUALITY_ACTION_UPGRADE,    // Обратно после нашего понижения
+} link_quality_action_t;
+
+// Накопительные счетчики стека за SCO (ESP_HF_PKT_STAT_NUMS_GET_EVT)
+typedef struct {
+    uint32_t rx_total;
+    uint32_t rx_bad;                // С ошибками + не принятые + частично потерянные
+} link_quality_sample_t;
+
+typedef struct {
+    // Пишет поток приема
+    volatile uint32_t jitter_q4;    // Джиттер прихода кадров, мкс в Q4
+    int64_t last_frame_us;
+
+    // Остальное - только обработчик событий HF
+    uint32_t base_total;            // Счетчики стека в начале окна
+    uint32_t base_bad;
+    bool have_base;
+    int8_t rssi;                    // Последнее отклонение RSSI, дБ
+    bool rssi_valid;
+
+    link_quality_level_t level;
+    uint16_t loss;                  // Потери последнего окна, промилле
+    uint16_t loss_avg;              // Сглаженные потери, промилле
+    uint32_t jitter_us;
+    uint32_t jitter_peak_us;        // Худшее окно за SCO
+    uint32_t sco_total;             // Счетчики стека за SCO на последнем опросе (итог звонка)
+    uint32_t sco_bad;
+    uint8_t bad_windows;
+    uint8_t good_windows;
+
+    bool fallback;                  // Кодек понижен политикой, возврат разрешен
+    audio_codec_t wide_codec;       // Кодек до понижения
+    bool blocked;                   // Стек не выполнил смену - больше не пробуем на этом SLC
+    audio_codec_t switch_target;    // Идущая смена кодека (AUDIO_CODEC_COUNT - нет)
+    int64_t last_switch_ms;
+    int64_t last_upgrade_ms;
+    uint32_t hold_ms;               // Текущая выдержка перед повышением
+    uint32_t downgrades;
+    uint32_t upgrades;
+} link_quality_t;
+
+/**
+ * @brief Сброс на новом SLC: политика с чистого листа
+ */
+void link_quality_init(link_quality_t *lq);
+
+/**
+ * @brief Новый SCO: счетчики стека и джиттер заново, состояние политики сохраняется
+ */
+void link_quality_sco_open(link_quality_t *lq);
+
+/**
+ * @brief Кадр принят (поток приема)
+ * @param frame_us Длительность кадра: ожидаемый интервал между кадрами
+ */
+void link_quality_on_frame(link_quality_t *lq, int64_t now_us, uint32_t frame_us);
+
+void link_quality_set_rssi(link_quality_t *lq, int8_t rssi);
+
+/**
+ * @brief Итог окна: оценка и решение политики
+ * @param codec Кодек открытого SCO
+ * @param now_ms Монотонное время
+ * @return Действие; при DOWNGRADE/UPGRADE switch_target уже выставлен
+ */
+link_quality_action_t link_quality_update(link_quality_t *lq, audio_codec_t codec,
+                                          const link_quality_sample_t *sample, int64_t now_ms);
+
+/**
+ * @brief SCO открыт после смены кодека
+ * @param codec Кодек, который согласовал стек
+ * @return true если стек выбрал запрошенный кодек
+ */
+bool link_quality_switch_done(link_quality_t *lq, audio_codec_t codec);
+
+/**
+ * @brief Смена не выполнена: решение отменяется, понижение не засчитывается в fallback
+ */
+void link_quality_switch_failed(link_quality_t *lq);
+
+const char *link_quality_level_name(link_quality_level_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINK_QUALITY_H */
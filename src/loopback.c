@@ -0,0 +1,612 @@
+#include "loopback.h"
+#include "audio_handler.h"
+#include "audio_mixer.h"
+#include "audio_frame.h"
+#include "dsp_kernels.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+
+static const char *TAG = "LOOPBACK";
+
+#define MLS_LEN          ((1u << LOOPBACK_MLS_ORDER) - 1)
+#define CHIRP_BLOCKS     (LOOPBACK_CHIRP_MS / LOOPBACK_CHIRP_BLOCK_MS)
+#define TONES_PLAYED     4        // Периодов мультитона: установление, два под анализ, хвост
+#define BAND_EDGE_PCT    45       // Верх стимулов: 0.45 fs, ниже среза фильтров кодека
+#define TWO_PI           6.28318531f
+
+typedef enum {
+    STAGE_IDLE = 0,               // Генератор молчит, захват выключен
+    STAGE_NOISE,
+    STAGE_MLS,
+    STAGE_CHIRP,
+    STAGE_TONES,
+} stage_t;
+
+// Флаги и задачу читают консоль, задача измерения и захват: доступ только атомарный
+static TaskHandle_t s_task = NULL;
+static bool s_running = false;
+static bool s_abort = false;
+static bool s_processed = false;
+static uint32_t s_rate = 0;
+static loopback_result_t s_result;
+
+// Буферы на время измерения
+static int16_t *s_mls = NULL;
+static int16_t *s_tones = NULL;
+static int16_t *s_capture = NULL;
+static uint16_t s_tone_bins[LOOPBACK_TONES_MAX];
+static uint8_t s_tone_count = 0;
+static uint32_t s_latency = 0;    // Задержка круга в отсчетах после этапа MLS
+static float s_noise_power = 0.0f;
+
+// Этап пишет задача (release), читает генератор
+static int s_stage = STAGE_IDLE;
+
+// Генератор - поток TX
+static int s_gen_stage = STAGE_IDLE;
+static uint32_t s_gen_pos = 0;
+static float s_chirp_phase = 0.0f;
+static float s_chirp_inc = 0.0f;
+static float s_chirp_mul = 1.0f;
+
+// Окно захвата: генератор открывает его с первым отсчетом стимула
+static uint32_t s_cap_start = 0;  // Номер отсчета захвата
+static uint32_t s_cap_len = 0;
+static int s_cap_stage = STAGE_IDLE;
+
+// Захват - поток RX
+static int s_cap_seen = STAGE_IDLE;
+static uint32_t s_cap_fill = 0;
+static uint32_t s_rx_pos = 0;
+static int s_consumer_id = -1;
+static int s_source_id = -1;
+
+static uint32_t max_lag(void)
+{
+    return LOOPBACK_MAX_LATENCY_MS * s_rate / 1000;
+}
+
+static uint32_t chirp_len(void)
+{
+    return LOOPBACK_CHIRP_MS * s_rate / 1000;
+}
+
+static float chirp_end_hz(void)
+{
+    return (float)(s_rate * BAND_EDGE_PCT / 100);
+}
+
+// Со сдвигом на задержку окно захвата ложится ровно на ответ
+static uint32_t stage_capture_offset(int stage)
+{
+    switch (stage) {
+    case STAGE_CHIRP:
+        return s_latency;
+    case STAGE_TONES:
+        return s_latency + LOOPBACK_TONES_PERIOD;
+    default:
+        return 0;
+    }
+}
+
+static uint32_t stage_capture_len(int stage)
+{
+    switch (stage) {
+    case STAGE_NOISE:
+        return LOOPBACK_NOISE_MS * s_rate / 1000;
+    case STAGE_MLS:
+        return MLS_LEN + max_lag();
+    case STAGE_CHIRP:
+        return chirp_len();
+    case STAGE_TONES:
+        return 2 * LOOPBACK_TONES_PERIOD;
+    default:
+        return 0;
+    }
+}
+
+static uint32_t capture_size(void)
+{
+    uint32_t size = 0;
+    for (int stage = STAGE_NOISE; stage <= STAGE_TONES; stage++) {
+        uint32_t len = stage_capture_len(stage);
+        size = len > size ? len : size;
+    }
+    return size;
+}
+
+static int16_t stage_sample(int stage, uint32_t pos)
+{
+    switch (stage) {
+    case STAGE_MLS:
+        return pos < MLS_LEN ? s_mls[pos] : 0;
+    case STAGE_CHIRP: {
+        if (pos >= chirp_len()) {
+            return 0;
+        }
+        int16_t v = (int16_t)(LOOPBACK_LEVEL * sinf(s_chirp_phase));
+        s_chirp_phase += s_chirp_inc;
+        s_chirp_phase = s_chirp_phase >= TWO_PI ? s_chirp_phase - TWO_PI : s_chirp_phase;
+        s_chirp_inc *= s_chirp_mul;
+        return v;
+    }
+    case STAGE_TONES:
+        return pos < TONES_PLAYED * LOOPBACK_TONES_PERIOD ? s_tones[pos % LOOPBACK_TONES_PERIOD] : 0;
+    default:
+        return 0;
+    }
+}
+
+// Источник микшера (поток TX): между этапами - тишина, но источник активен и держит приглушение
+static uint32_t loopback_source_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    int stage = __atomic_load_n(&s_stage, __ATOMIC_ACQUIRE);
+    if (stage != s_gen_stage) {
+        s_gen_stage = stage;
+        s_gen_pos = 0;
+        s_chirp_phase = 0.0f;
+        s_chirp_inc = TWO_PI * LOOPBACK_CHIRP_START_HZ / s_rate;
+        s_chirp_mul = powf(chirp_end_hz() / LOOPBACK_CHIRP_START_HZ, 1.0f / chirp_len());
+        if (stage != STAGE_IDLE) {
+            s_cap_start = __atomic_load_n(&s_rx_pos, __ATOMIC_RELAXED) + stage_capture_offset(stage);
+            s_cap_len = stage_capture_len(stage);
+        }
+        __atomic_store_n(&s_cap_stage, stage, __ATOMIC_RELEASE);
+    }
+    for (uint32_t i = 0; i < samples; i++) {
+        buf[i] = stage_sample(stage, s_gen_pos++);
+    }
+    return samples;
+}
+
+// Потребитель пула (поток RX): копия отсчетов, попавших в окно этапа
+static void loopback_frame_cb(audio_frame_t *frame, void *ctx)
+{
+    uint32_t pos = s_rx_pos;
+    int stage = __atomic_load_n(&s_cap_stage, __ATOMIC_ACQUIRE);
+    if (stage != s_cap_seen) {
+        s_cap_seen = stage;
+        __atomic_store_n(&s_cap_fill, 0, __ATOMIC_RELAXED);
+    }
+    uint32_t fill = s_cap_fill;
+    if (stage != STAGE_IDLE && fill < s_cap_len) {
+        int32_t skip = (int32_t)(s_cap_start + fill - pos);
+        if (skip < frame->count) {
+            skip = skip > 0 ? skip : 0;
+            uint32_t n = frame->count - (uint32_t)skip;
+            n = n < s_cap_len - fill ? n : s_cap_len - fill;
+            memcpy(s_capture + fill, frame->samples + skip, n * sizeof(int16_t));
+            __atomic_store_n(&s_cap_fill, fill + n, __ATOMIC_RELEASE);
+            if (fill + n == s_cap_len) {
+                xTaskNotifyGive(s_task);
+            }
+        }
+    }
+    __atomic_store_n(&s_rx_pos, pos + frame->count, __ATOMIC_RELAXED);
+}
+
+static void mls_prepare(void)
+{
+    uint32_t lfsr = 1;
+    for (uint32_t i = 0; i < MLS_LEN; i++) {
+        s_mls[i] = (lfsr & 1) ? LOOPBACK_LEVEL : -LOOPBACK_LEVEL;
+        lfsr = (lfsr >> 1) ^ ((lfsr & 1) ? LOOPBACK_MLS_POLY : 0);
+    }
+}
+
+static bool is_prime(uint32_t n)
+{
+    if (n < 2) {
+        return false;
+    }
+    for (uint32_t d = 2; d * d <= n; d++) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Тоны на простых бинах: гармоники и разностные продукты второго порядка не попадают на тоны
+static void tones_prepare(void)
+{
+    static const uint16_t targets[] = { 200, 315, 500, 800, 1250, 2000, 3150, 5000, 8000, 12500 };
+    _Static_assert(sizeof(targets) / sizeof(targets[0]) == LOOPBACK_TONES_MAX, "tone table");
+
+    s_tone_count = 0;
+    for (int i = 0; i < LOOPBACK_TONES_MAX; i++) {
+        if (targets[i] >= s_rate * BAND_EDGE_PCT / 100) {
+            break;
+        }
+        uint32_t bin = (targets[i] * LOOPBACK_TONES_PERIOD + s_rate / 2) / s_rate;
+        for (uint32_t d = 0;; d++) {
+            if (is_prime(bin + d)) {
+                bin += d;
+                break;
+            }
+            if (is_prime(bin - d)) {
+                bin -= d;
+                break;
+            }
+        }
+        s_tone_bins[s_tone_count++] = (uint16_t)bin;
+    }
+
+    // Фазы Ньюмана: пик-фактор суммы ~4 дБ вместо 10 lg(2K) при равных фазах
+    float peak = 0.0f;
+    for (int pass = 0; pass < 2; pass++) {
+        float scale = pass == 0 ? 1.0f : LOOPBACK_LEVEL / peak;
+        for (uint32_t n = 0; n < LOOPBACK_TONES_PERIOD; n++) {
+            float v = 0.0f;
+            for (int k = 0; k < s_tone_count; k++) {
+                float phase = (float)M_PI * k * k / s_tone_count;
+                uint32_t turn = (s_tone_bins[k] * n) % LOOPBACK_TONES_PERIOD;
+                v += cosf(TWO_PI * turn / LOOPBACK_TONES_PERIOD + phase);
+            }
+            if (pass == 0) {
+                peak = fabsf(v) > peak ? fabsf(v) : peak;
+            } else {
+                s_tones[n] = (int16_t)lroundf(v * scale);
+            }
+        }
+    }
+}
+
+static float db10(float ratio)
+{
+    return ratio > 1e-12f ? 10.0f * log10f(ratio) : -120.0f;
+}
+
+static int16_t clamp_db(float db)
+{
+    return (int16_t)lroundf(db < -120.0f ? -120.0f : (db > 120.0f ? 120.0f : db));
+}
+
+static const char *analyze_noise(loopback_result_t *res, uint32_t len)
+{
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < len; i++) {
+        sum += (float)s_capture[i] * s_capture[i];
+    }
+    s_noise_power = sum / len;
+    res->noise_dbfs = clamp_db(db10(s_noise_power / (32768.0f * 32768.0f)));
+    return NULL;
+}
+
+// Линейная корреляция с MLS по всем задержкам окна: пик - задержка круга
+static const char *analyze_mls(loopback_result_t *res)
+{
+    int64_t peak = 0;
+    uint32_t peak_lag = 0;
+    float sum_sq = 0.0f;
+    uint32_t lags = max_lag() + 1;
+    for (uint32_t lag = 0; lag < lags; lag++) {
+        int64_t c = dsp_dot_q15(s_capture + lag, s_mls, MLS_LEN);
+        float cf = (float)c;
+        sum_sq += cf * cf;
+        if (llabs(c) > llabs(peak)) {
+            peak = c;
+            peak_lag = lag;
+        }
+    }
+    float peak_f = (float)peak;
+    res->pnr_db = (int8_t)clamp_db(db10(peak_f * peak_f * lags / sum_sq));
+    if (peak == 0 || res->pnr_db < LOOPBACK_MIN_PNR_DB) {
+        return "no loopback: stimulus not found in capture";
+    }
+    s_latency = peak_lag;
+    res->latency_us = (uint32_t)((uint64_t)peak_lag * 1000000 / s_rate);
+    res->inverted = peak < 0;
+    float gain = fabsf(peak_f) / ((float)MLS_LEN * LOOPBACK_LEVEL * LOOPBACK_LEVEL);
+    res->loop_gain_db = (int8_t)clamp_db(2.0f * db10(gain));
+    return NULL;
+}
+
+static float chirp_block_hz(uint32_t block)
+{
+    uint32_t block_len = LOOPBACK_CHIRP_BLOCK_MS * s_rate / 1000;
+    float t = (block + 0.5f) * block_len / chirp_len();
+    return LOOPBACK_CHIRP_START_HZ * powf(chirp_end_hz() / LOOPBACK_CHIRP_START_HZ, t);
+}
+
+// АЧХ по свипу: уровень блока против уровня синуса стимула на мгновенной частоте
+static const char *analyze_chirp(loopback_result_t *res)
+{
+    static const uint16_t points[] = { 125, 250, 500, 1000, 2000, 3000, 4000, 6000, 8000, 12000 };
+    _Static_assert(sizeof(points) / sizeof(points[0]) == LOOPBACK_RESPONSE_POINTS, "response points");
+
+    uint32_t block_len = LOOPBACK_CHIRP_BLOCK_MS * s_rate / 1000;
+    float raw[CHIRP_BLOCKS];
+    float gain[CHIRP_BLOCKS];
+    float tx_rms = LOOPBACK_LEVEL / sqrtf(2.0f);
+    for (uint32_t b = 0; b < CHIRP_BLOCKS; b++) {
+        uint32_t rms = dsp_rms_q15(s_capture + b * block_len, block_len);
+        raw[b] = 2.0f * db10((float)(rms > 0 ? rms : 1) / tx_rms);
+    }
+    // Крайние блоки не оцениваются: щелчок на обрыве свипа. Медиана трех блоков
+    // убирает провалы от потерянных кадров SCO
+    uint32_t first = 1;
+    uint32_t last = CHIRP_BLOCKS - 2;
+    uint32_t ref = first;
+    for (uint32_t b = first; b <= last; b++) {
+        float lo = fminf(raw[b - 1], raw[b + 1]);
+        float hi = fmaxf(raw[b - 1], raw[b + 1]);
+        gain[b] = fmaxf(lo, fminf(raw[b], hi));
+        if (fabsf(log2f(chirp_block_hz(b) / 1000.0f)) < fabsf(log2f(chirp_block_hz(ref) / 1000.0f))) {
+            ref = b;
+        }
+    }
+
+    res->points = 0;
+    for (int i = 0; i < LOOPBACK_RESPONSE_POINTS; i++) {
+        if (points[i] < chirp_block_hz(first) || points[i] > chirp_block_hz(last)) {
+            continue;
+        }
+        uint32_t best = first;
+        for (uint32_t b = first; b <= last; b++) {
+            if (fabsf(log2f(chirp_block_hz(b) / points[i])) < fabsf(log2f(chirp_block_hz(best) / points[i]))) {
+                best = b;
+            }
+        }
+        res->freq_hz[res->points] = points[i];
+        res->gain_db[res->points] = (int8_t)clamp_db(gain[best] - gain[ref]);
+        res->points++;
+    }
+
+    uint32_t lo = ref;
+    while (lo > first && gain[lo - 1] >= gain[ref] - 3.0f) {
+        lo--;
+    }
+    uint32_t hi = ref;
+    while (hi < last && gain[hi + 1] >= gain[ref] - 3.0f) {
+        hi++;
+    }
+    res->band_low_hz = (uint16_t)chirp_block_hz(lo);
+    res->band_high_hz = (uint16_t)chirp_block_hz(hi);
+    return NULL;
+}
+
+// Мощность тона на бине окна (Гёрцель)
+static float goertzel_power(const int16_t *x, uint32_t n, uint32_t bin, float mean)
+{
+    float coeff = 2.0f * cosf(TWO_PI * bin / n);
+    float s1 = 0.0f;
+    float s2 = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        float s0 = (x[i] - mean) + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    float mag_sq = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+    return 2.0f * mag_sq / ((float)n * n);
+}
+
+// THD+N: все, что в окне не приходится на тоны стимула (гармоники, шум, квантование кодека)
+static const char *analyze_tones(loopback_result_t *res)
+{
+    uint32_t n = 2 * LOOPBACK_TONES_PERIOD;
+    float mean = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        mean += s_capture[i];
+    }
+    mean /= n;
+    float total = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        float v = s_capture[i] - mean;
+        total += v * v;
+    }
+    total /= n;
+
+    float signal = 0.0f;
+    for (int k = 0; k < s_tone_count; k++) {
+        signal += goertzel_power(s_capture, n, 2 * s_tone_bins[k], mean);
+    }
+    if (signal <= 0.0f) {
+        return "multitone not received";
+    }
+    // Остаток не ниже -90 дБ: оценки мощности тонов и окна округляются по-разному
+    float residual = total - signal > signal * 1e-9f ? total - signal : signal * 1e-9f;
+    res->thdn_db = clamp_db(db10(residual / signal));
+    res->thdn_permille = (uint16_t)lroundf(1000.0f * sqrtf(residual / signal));
+    res->snr_db = s_noise_power > 0.0f ? clamp_db(db10(signal / s_noise_power)) : 120;
+    return NULL;
+}
+
+// Этап целиком: стимул, ожидание полного окна захвата
+static const char *run_stage(int stage)
+{
+    ulTaskNotifyTake(pdTRUE, 0);
+    __atomic_store_n(&s_stage, stage, __ATOMIC_RELEASE);
+    for (;;) {
+        bool woke = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOOPBACK_STAGE_TIMEOUT_MS)) != 0;
+        if (__atomic_load_n(&s_abort, __ATOMIC_RELAXED)) {
+            return "stopped";
+        }
+        if (__atomic_load_n(&s_cap_seen, __ATOMIC_RELAXED) == stage &&
+            __atomic_load_n(&s_cap_fill, __ATOMIC_ACQUIRE) == stage_capture_len(stage)) {
+            break;
+        }
+        if (!woke) {
+            return "capture timed out (SCO closed?)";
+        }
+    }
+    __atomic_store_n(&s_stage, STAGE_IDLE, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static const char *loopback_run(loopback_result_t *res)
+{
+    s_mls = malloc(MLS_LEN * sizeof(int16_t));
+    s_tones = malloc(LOOPBACK_TONES_PERIOD * sizeof(int16_t));
+    s_capture = malloc(capture_size() * sizeof(int16_t));
+    if (s_mls == NULL || s_tones == NULL || s_capture == NULL) {
+        return "out of memory";
+    }
+    mls_prepare();
+    tones_prepare();
+
+    const audio_mixer_source_cfg_t cfg = {
+        .cb = loopback_source_cb,
+        .priority = UINT8_MAX,
+        .gain = AUDIO_MIXER_GAIN_UNITY,
+        .duck_gain = 0,
+    };
+    if (audio_mixer_add_source(&cfg, &s_source_id) != ESP_OK) {
+        return "no free mixer slot";
+    }
+    audio_frame_stream_t stream = s_processed ? AUDIO_FRAME_RX : AUDIO_FRAME_RX_RAW;
+    if (audio_frame_subscribe(stream, loopback_frame_cb, NULL, &s_consumer_id) != ESP_OK) {
+        return "no free frame consumer slot";
+    }
+    vTaskDelay(pdMS_TO_TICKS(LOOPBACK_SETTLE_MS));
+
+    const char *err = run_stage(STAGE_NOISE);
+    if (err == NULL) {
+        err = analyze_noise(res, stage_capture_len(STAGE_NOISE));
+    }
+    if (err == NULL) {
+        err = run_stage(STAGE_MLS);
+    }
+    if (err == NULL) {
+        err = analyze_mls(res);
+    }
+    if (err == NULL) {
+        err = run_stage(STAGE_CHIRP);
+    }
+    if (err == NULL) {
+        err = analyze_chirp(res);
+    }
+    if (err == NULL) {
+        err = run_stage(STAGE_TONES);
+    }
+    if (err == NULL) {
+        err = analyze_tones(res);
+    }
+    if (err == NULL && audio_handler_get_sample_rate() != s_rate) {
+        err = "codec changed during measurement";
+    }
+    return err;
+}
+
+static void loopback_cleanup(void)
+{
+    __atomic_store_n(&s_stage, STAGE_IDLE, __ATOMIC_RELEASE);
+    // Обе отписки возвращаются, когда тракт вышел из callbacks генератора и захвата
+    if (s_source_id >= 0) {
+        audio_mixer_remove_source_sync(s_source_id);
+        s_source_id = -1;
+    }
+    if (s_consumer_id >= 0) {
+        audio_frame_unsubscribe(s_consumer_id);
+        s_consumer_id = -1;
+    }
+    free(s_mls);
+    free(s_tones);
+    free(s_capture);
+    s_mls = NULL;
+    s_tones = NULL;
+    s_capture = NULL;
+}
+
+static void loopback_task(void *arg)
+{
+    loopback_result_t *res = &s_result;
+    const char *err = loopback_run(res);
+    loopback_cleanup();
+    res->error = err;
+    res->valid = err == NULL;
+    loopback_print_result();
+    // Задача сбрасывается до флага: следующий loopback_start пишет в s_task уже свою
+    __atomic_store_n(&s_task, NULL, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_running, false, __ATOMIC_RELEASE);
+    vTaskDelete(NULL);
+}
+
+esp_err_t loopback_start(bool processed)
+{
+    if (__atomic_load_n(&s_running, __ATOMIC_ACQUIRE)) {
+        ESP_LOGW(TAG, "Measurement already running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!audio_handler_is_connected()) {
+        ESP_LOGW(TAG, "Audio not connected, open SCO to a looped-back headset first");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_rate = audio_handler_get_sample_rate();
+    s_processed = processed;
+    __atomic_store_n(&s_abort, false, __ATOMIC_RELAXED);
+    s_latency = 0;
+    s_noise_power = 0.0f;
+    s_gen_stage = STAGE_IDLE;
+    s_cap_stage = STAGE_IDLE;
+    s_cap_seen = STAGE_IDLE;
+    s_cap_fill = 0;
+    s_rx_pos = 0;
+    memset(&s_result, 0, sizeof(s_result));
+    s_result.sample_rate = s_rate;
+    s_result.processed = processed;
+
+    __atomic_store_n(&s_running, true, __ATOMIC_RELAXED);
+    if (xTaskCreate(loopback_task, "Loopback", LOOPBACK_TASK_STACK, NULL, LOOPBACK_TASK_PRIO, &s_task) != pdPASS) {
+        __atomic_store_n(&s_running, false, __ATOMIC_RELAXED);
+        ESP_LOGE(TAG, "Failed to create loopback task");
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "🔁 Loopback measurement at %" PRIu32 " kHz, %s capture, ~2 s",
+             s_rate / 1000, processed ? "processed" : "raw");
+    return ESP_OK;
+}
+
+void loopback_stop(void)
+{
+    if (!__atomic_load_n(&s_running, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+    __atomic_store_n(&s_abort, true, __ATOMIC_RELAXED);
+    // Задача могла как раз завершиться: тогда будить некого
+    TaskHandle_t task = __atomic_load_n(&s_task, __ATOMIC_RELAXED);
+    if (task != NULL) {
+        xTaskNotifyGive(task);
+    }
+}
+
+bool loopback_running(void)
+{
+    return __atomic_load_n(&s_running, __ATOMIC_ACQUIRE);
+}
+
+void loopback_print_result(void)
+{
+    const loopback_result_t *res = &s_result;
+    if (res->sample_rate == 0) {
+        ESP_LOGI(TAG, "No loopback measurement yet");
+        return;
+    }
+    ESP_LOGI(TAG, "=== Loopback: %" PRIu32 " kHz, %s capture ===", res->sample_rate / 1000,
+             res->processed ? "processed" : "raw");
+    if (!res->valid) {
+        ESP_LOGW(TAG, "Measurement failed: %s", res->error != NULL ? res->error : "running");
+        if (res->pnr_db != 0) {
+            ESP_LOGW(TAG, "MLS correlation peak %d dB over average (need %d dB)", res->pnr_db, LOOPBACK_MIN_PNR_DB);
+        }
+        return;
+    }
+    ESP_LOGI(TAG, "Round trip %" PRIu32 ".%" PRIu32 " ms (peak %d dB over average), loop gain %d dB%s",
+             res->latency_us / 1000, res->latency_us % 1000 / 100, res->pnr_db, res->loop_gain_db,
+             res->inverted ? ", polarity inverted" : "");
+    ESP_LOGI(TAG, "Noise floor %d dBFS, SNR %d dB, THD+N %d dB (%u.%u%%)",
+             res->noise_dbfs, res->snr_db, res->thdn_db, res->thdn_permille / 10, res->thdn_permille % 10);
+    char line[128];
+    int len = 0;
+    for (int i = 0; i < res->points && len < (int)sizeof(line); i++) {
+        len += snprintf(line + len, sizeof(line) - len, " %u:%+d", res->freq_hz[i], res->gain_db[i]);
+    }
+    ESP_LOGI(TAG, "Response re 1 kHz, Hz:dB%s", line);
+    ESP_LOGI(TAG, "Band -3 dB: %u..%u Hz", res->band_low_hz, res->band_high_hz);
+}
@@ -0,0 +1,92 @@
+#ifndef LOOPBACK_H
+#define LOOPBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOOPBACK_LEVEL             8192    // Амплитуда стимулов: -12 dBFS, запас на усиление громкости
+#define LOOPBACK_MLS_ORDER         12      // MLS 4095 отсчетов
+#define LOOPBACK_MLS_POLY          0x829   // x^12 + x^6 + x^4 + x + 1 (LFSR Галуа)
+#define LOOPBACK_MAX_LATENCY_MS    300     // Окно поиска задержки
+#define LOOPBACK_MIN_PNR_DB        15      // Пик корреляции над ее средним уровнем: петля есть
+#define LOOPBACK_NOISE_MS          250     // Тишина перед стимулами: шумовой порог
+#define LOOPBACK_CHIRP_MS          500     // Логарифмический свип 100 Гц .. 0.45 fs
+#define LOOPBACK_CHIRP_START_HZ    100
+#define LOOPBACK_CHIRP_BLOCK_MS    10      // Блок оценки АЧХ по свипу
+#define LOOPBACK_TONES_PERIOD      2048    // Период мультитона; тоны на простых бинах fs/2048
+#define LOOPBACK_TONES_MAX         10
+#define LOOPBACK_SETTLE_MS         100     // Приглушение других источников микшера
+#define LOOPBACK_STAGE_TIMEOUT_MS  3000    // Захват не набрался (нет петли или SCO закрыт)
+#define LOOPBACK_RESPONSE_POINTS   10
+#define LOOPBACK_TASK_STACK        4096
+#define LOOPBACK_TASK_PRIO         2       // Анализ ниже BT и аудио: тракт не ждет его
+
+/*
+ * Измерение тракта через петлю в гарнитуре (тестовый режим гарнитуры или
+ * кабель динамик -> микрофон).
+ *
+ * Стимулы идут источником микшера с наивысшим приоритетом (остальные
+ * источники приглушены), ответ снимается потребителем пула кадров: по
+ * умолчанию захват до обработки, по запросу - после АРУ и лимитера.
+ * Этапы по порядку:
+ *   тишина    - шумовой порог захвата;
+ *   MLS       - задержка круга по пику взаимной корреляции и усиление петли;
+ *   свип      - АЧХ блоками по мгновенной частоте, полоса по уровню -3 дБ;
+ *   мультитон - THD+N (все, что вне тонов) и SNR относительно тишины.
+ * Задержка считается от формирования кадра TX до приема кадра, т.е.
+ * включает упреждение задачи обработки. Мерится SCO, которое обслуживает
+ * HCI data path (hf_conn_get_audio_active).
+ *
+ * Те же стимулы и анализ повторяет tools/loopback_analyze.py: по записям
+ * отвода (tap) или на модели канала без устройства.
+ */
+
+typedef struct {
+    bool valid;
+    const char *error;              // Почему измерение не состоялось
+    uint32_t sample_rate;
+    bool processed;                 // Захват после АРУ
+    uint32_t latency_us;
+    int8_t pnr_db;                  // Пик корреляции MLS над средним
+    int8_t loop_gain_db;
+    bool inverted;                  // Петля переворачивает полярность
+    int16_t noise_dbfs;
+    int16_t snr_db;
+    int16_t thdn_db;
+    uint16_t thdn_permille;         // THD+N в процентах x10
+    uint16_t band_low_hz;           // Полоса по -3 дБ от уровня на 1 кГц
+    uint16_t band_high_hz;
+    uint8_t points;
+    uint16_t freq_hz[LOOPBACK_RESPONSE_POINTS];
+    int8_t gain_db[LOOPBACK_RESPONSE_POINTS];     // Относительно 1 кГц
+} loopback_result_t;
+
+/**
+ * @brief Запуск измерения в открытом SCO; итог печатается по окончании
+ * @param processed Снимать ответ после АРУ и лимитера, а не сырой захват
+ * @return ESP_ERR_INVALID_STATE если нет SCO или измерение уже идет
+ */
+esp_err_t loopback_start(bool processed);
+
+/**
+ * @brief Прерывание измерения
+ */
+void loopback_stop(void);
+
+bool loopback_running(void);
+
+/**
+ * @brief Печать последнего результата
+ */
+void loopback_print_result(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOOPBACK_H */
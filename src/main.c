@@ -3,6 +3,7 @@
 #include "gap_handler.h"
 #include "hf_handler.h"
 #include "console_handler.h"
+#include "boot_phase.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
@@ -38,8 +39,11 @@ static void bt_hf_hdl_stack_evt(uint16_t event, void *p_param)
             // Устанавливаем имя цели и запускаем обнаружение
             gap_set_target_name(TARGET_NAME);
             
-            // Даем время системе Bluetooth полностью инициализироваться
-            vTaskDelay(pdMS_TO_TICKS(1000));
+            // Ждем ответа контроллера вместо фиксированной паузы
+            if (boot_phase_wait_ready(BOOT_READY_STACK | BOOT_READY_DEVICES, BOOT_READY_TIMEOUT_MS) != ESP_OK) {
+                ESP_LOGW(BT_HF_AG_TAG, "Stack readiness not confirmed, reconnecting anyway");
+            }
+            boot_phase_mark("reconnect_start");
             
             // Сначала пробуем переподключиться к последнему устройству
             gap_try_reconnect_to_last_device();
@@ -0,0 +1,222 @@
+#include "metrics.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include <string.h>
+
+static const char *TAG = "METRICS";
+
+static metric_t s_metrics[METRICS_MAX];
+static int s_metric_count = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static struct {
+    TaskHandle_t task;
+    const char *name;
+} s_tasks[METRICS_MAX_TASKS];
+static int s_task_count = 0;
+
+static int32_t sample_heap_free(void)
+{
+    return (int32_t)esp_get_free_heap_size();
+}
+
+static int32_t sample_heap_min(void)
+{
+    return (int32_t)esp_get_minimum_free_heap_size();
+}
+
+static int32_t sample_heap_largest(void)
+{
+    return (int32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+}
+
+void metrics_init(void)
+{
+    metrics_gauge("heap.free", sample_heap_free);
+    metrics_gauge("heap.min_free", sample_heap_min);
+    metrics_gauge("heap.largest", sample_heap_largest);
+    ESP_LOGI(TAG, "Metrics registry ready (%d slots, %d shards)", METRICS_MAX, METRICS_SHARDS);
+}
+
+static metric_t *metrics_register(const char *name, metric_type_t type)
+{
+    metric_t *m = NULL;
+
+    portENTER_CRITICAL(&s_lock);
+    for (int i = 0; i < s_metric_count; i++) {
+        if (strncmp(s_metrics[i].name, name, METRICS_NAME_LEN - 1) == 0) {
+            m = &s_metrics[i];
+            break;
+        }
+    }
+    if (m == NULL && s_metric_count < METRICS_MAX) {
+        m = &s_metrics[s_metric_count++];
+        memset(m, 0, sizeof(*m));
+        strncpy(m->name, name, METRICS_NAME_LEN - 1);
+        m->type = type;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (m == NULL) {
+        ESP_LOGW(TAG, "Registry full, metric '%s' dropped", name);
+    }
+    return m;
+}
+
+metric_t *metrics_counter(const char *name)
+{
+    return metrics_register(name, METRIC_COUNTER);
+}
+
+metric_t *metrics_gauge(const char *name, int32_t (*sample)(void))
+{
+    metric_t *m = metrics_register(name, METRIC_GAUGE);
+    if (m != NULL && sample != NULL) {
+        m->sample = sample;
+    }
+    return m;
+}
+
+metric_t *metrics_histogram(const char *name, const char *unit)
+{
+    metric_t *m = metrics_register(name, METRIC_HISTOGRAM);
+    if (m != NULL) {
+        m->unit = unit;
+    }
+    return m;
+}
+
+void metrics_watch_task(TaskHandle_t task, const char *name)
+{
+    if (task == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&s_lock);
+    if (s_task_count < METRICS_MAX_TASKS) {
+        s_tasks[s_task_count].task = task;
+        s_tasks[s_task_count].name = name;
+        s_task_count++;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+static void update_peak(metric_t *m, int32_t value)
+{
+    int32_t peak = __atomic_load_n(&m->peak, __ATOMIC_RELAXED);
+    while (value > peak &&
+           !__atomic_compare_exchange_n(&m->peak, &peak, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void metrics_set(metric_t *m, int32_t value)
+{
+    if (m == NULL) {
+        return;
+    }
+    __atomic_store_n(&m->value, value, __ATOMIC_RELAXED);
+    update_peak(m, value);
+}
+
+void metrics_observe(metric_t *m, uint32_t value)
+{
+    if (m == NULL) {
+        return;
+    }
+    // Корзина по старшему биту: 0 -> 0, [2^(i-1), 2^i) -> i
+    int bucket = value == 0 ? 0 : 32 - __builtin_clz(value);
+    if (bucket >= METRICS_HIST_BUCKETS) {
+        bucket = METRICS_HIST_BUCKETS - 1;
+    }
+    int core = xPortGetCoreID();
+    __atomic_fetch_add(&m->shard[core], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&m->sum[core], (uint64_t)value, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&m->buckets[bucket], 1, __ATOMIC_RELAXED);
+    update_peak(m, value > INT32_MAX ? INT32_MAX : (int32_t)value);
+}
+
+uint32_t metrics_read(const metric_t *m)
+{
+    if (m == NULL) {
+        return 0;
+    }
+    uint32_t total = 0;
+    for (int i = 0; i < METRICS_SHARDS; i++) {
+        total += __atomic_load_n(&m->shard[i], __ATOMIC_RELAXED);
+    }
+    return total;
+}
+
+// Верхняя граница корзины, в которую попадает заданная доля наблюдений
+static uint32_t hist_percentile(const metric_t *m, uint32_t count, uint32_t percent)
+{
+    uint32_t rank = (count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < METRICS_HIST_BUCKETS; i++) {
+        seen += __atomic_load_n(&m->buckets[i], __ATOMIC_RELAXED);
+        if (seen >= rank) {
+            uint32_t bound = i == 0 ? 0 : (1u << i) - 1;
+            return bound < (uint32_t)m->peak ? bound : (uint32_t)m->peak;
+        }
+    }
+    return (uint32_t)m->peak;
+}
+
+void metrics_print(void)
+{
+    ESP_LOGI(TAG, "=== Metrics ===");
+    for (int i = 0; i < s_metric_count; i++) {
+        metric_t *m = &s_metrics[i];
+        switch (m->type) {
+            case METRIC_COUNTER:
+                ESP_LOGI(TAG, "  %-22s %lu", m->name, (unsigned long)metrics_read(m));
+                break;
+            case METRIC_GAUGE:
+                if (m->sample != NULL) {
+                    metrics_set(m, m->sample());
+                }
+                ESP_LOGI(TAG, "  %-22s %ld (peak %ld)", m->name, (long)m->value, (long)m->peak);
+                break;
+            case METRIC_HISTOGRAM: {
+                uint32_t count = metrics_read(m);
+                uint64_t sum = 0;
+                for (int s = 0; s < METRICS_SHARDS; s++) {
+                    sum += __atomic_load_n(&m->sum[s], __ATOMIC_RELAXED);
+                }
+                if (count == 0) {
+                    ESP_LOGI(TAG, "  %-22s -", m->name);
+                    break;
+                }
+                ESP_LOGI(TAG, "  %-22s n=%lu avg=%lu p50<=%lu p90<=%lu p99<=%lu max=%ld %s",
+                         m->name, (unsigned long)count, (unsigned long)(sum / count),
+                         (unsigned long)hist_percentile(m, count, 50),
+                         (unsigned long)hist_percentile(m, count, 90),
+                         (unsigned long)hist_percentile(m, count, 99),
+                         (long)m->peak, m->unit ? m->unit : "");
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < s_task_count; i++) {
+        // На ESP-IDF водяной знак стека - в байтах
+        ESP_LOGI(TAG, "  stack.%-16s %lu bytes never used", s_tasks[i].name,
+                 (unsigned long)uxTaskGetStackHighWaterMark(s_tasks[i].task));
+    }
+}
+
+void metrics_reset(void)
+{
+    for (int i = 0; i < s_metric_count; i++) {
+        metric_t *m = &s_metrics[i];
+        for (int s = 0; s < METRICS_SHARDS; s++) {
+            __atomic_store_n(&m->shard[s], 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&m->sum[s], 0, __ATOMIC_RELAXED);
+        }
+        for (int b = 0; b < METRICS_HIST_BUCKETS; b++) {
+            __atomic_store_n(&m->buckets[b], 0, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&m->peak, m->type == METRIC_GAUGE ? m->value : 0, __ATOMIC_RELAXED);
+    }
+    ESP_LOGI(TAG, "Metrics reset");
+}
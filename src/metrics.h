@@ -0,0 +1,108 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define METRICS_MAX             40     // Метрик в реестре
+#define METRICS_MAX_TASKS       6      // Задач под контролем стека
+#define METRICS_NAME_LEN        24
+#define METRICS_HIST_BUCKETS    16     // Степени двойки: [0], [1], [2..3], ... [16384..]
+#define METRICS_SHARDS          CONFIG_FREERTOS_NUMBER_OF_CORES
+
+typedef enum {
+    METRIC_COUNTER = 0,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM,
+} metric_type_t;
+
+/*
+ * Счетчики и гистограммы разнесены по ядрам: инкремент трогает только слот
+ * своего ядра (relaxed atomic - защита от вытеснения на том же ядре),
+ * суммирование по слотам - только при выводе.
+ */
+typedef struct {
+    char name[METRICS_NAME_LEN];
+    metric_type_t type;
+    const char *unit;
+    int32_t (*sample)(void);               // Для gauge: опрос значения при выводе
+    uint32_t shard[METRICS_SHARDS];        // Счетчик / число наблюдений
+    uint64_t sum[METRICS_SHARDS];          // Гистограмма: сумма значений
+    uint32_t buckets[METRICS_HIST_BUCKETS];
+    int32_t value;                         // Gauge: последнее значение
+    int32_t peak;                          // Gauge и гистограмма: максимум с последнего сброса
+} metric_t;
+
+/**
+ * @brief Инициализация реестра и системных метрик (heap)
+ */
+void metrics_init(void);
+
+/**
+ * @brief Регистрация метрик. Повторная регистрация имени возвращает ту же метрику.
+ * @param name Имя в формате "подсистема.метрика"
+ * @return Метрика или NULL, если реестр заполнен (операции над NULL игнорируются)
+ */
+metric_t *metrics_counter(const char *name);
+metric_t *metrics_gauge(const char *name, int32_t (*sample)(void));
+metric_t *metrics_histogram(const char *name, const char *unit);
+
+/**
+ * @brief Контроль минимального запаса стека задачи
+ * @param task Задача
+ * @param name Имя для вывода
+ */
+void metrics_watch_task(TaskHandle_t task, const char *name);
+
+/**
+ * @brief Увеличение счетчика (горячий путь, можно из ISR)
+ */
+static inline void metrics_add(metric_t *m, uint32_t n)
+{
+    if (m != NULL) {
+        __atomic_fetch_add(&m->shard[xPortGetCoreID()], n, __ATOMIC_RELAXED);
+    }
+}
+
+static inline void metrics_inc(metric_t *m)
+{
+    metrics_add(m, 1);
+}
+
+/**
+ * @brief Установка значения gauge с учетом максимума
+ */
+void metrics_set(metric_t *m, int32_t value);
+
+/**
+ * @brief Наблюдение значения гистограммы (горячий путь)
+ */
+void metrics_observe(metric_t *m, uint32_t value);
+
+/**
+ * @brief Суммарное значение счетчика / число наблюдений гистограммы
+ */
+uint32_t metrics_read(const metric_t *m);
+
+/**
+ * @brief Вывод всех метрик в лог
+ */
+void metrics_print(void);
+
+/**
+ * @brief Сброс счетчиков, гистограмм и максимумов
+ */
+void metrics_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* METRICS_H */
@@ -0,0 +1,93 @@
+#ifndef MSBC_H
+#define MSBC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// mSBC (HFP 1.6+ wideband): 16 кГц, моно, 8 поддиапазонов, 15 блоков, bitpool 26, loudness
+#define MSBC_SUBBANDS            8
+#define MSBC_BLOCKS              15
+#define MSBC_BITPOOL             26
+#define MSBC_SAMPLES_PER_FRAME   (MSBC_SUBBANDS * MSBC_BLOCKS)   // 120 отсчетов = 7.5 мс
+#define MSBC_FRAME_LEN           57                              // Кадр SBC от синхрослова 0xAD
+#define MSBC_PACKET_LEN          60                              // Заголовок H2 + кадр + байт выравнивания
+
+/*
+ * Кодек в фиксированной точке, детерминированный: одинаковый вход дает
+ * бит в бит одинаковый выход на ESP32 и на хосте, и этот выход совпадает
+ * с BlueZ libsbc (кадры кодера и PCM декодера, test/native/test_msbc).
+ * Банки фильтров используют симметрию матриц косинусов (8x8 вместо 8x16
+ * умножений на блок), окно анализа считается в 32 битах.
+ */
+
+typedef struct {
+    int16_t hist[80 - MSBC_SUBBANDS];   // Хвост входа прошлого кадра для окна анализа
+    uint8_t seq;                        // Номер пакета для заголовка H2 (0..3)
+} msbc_enc_t;
+
+typedef struct {
+    int32_t v[160];                     // Буфер синтеза (спецификация A2DP, V[0..159])
+    uint8_t seq;                        // Ожидаемый номер следующего пакета
+    uint32_t frames;
+    uint32_t crc_errors;
+    uint32_t sync_errors;
+    uint32_t seq_gaps;                  // Пропуски в нумерации H2 (потерянные пакеты)
+} msbc_dec_t;
+
+void msbc_enc_init(msbc_enc_t *enc);
+void msbc_dec_init(msbc_dec_t *dec);
+
+/**
+ * @brief Кодирование MSBC_SAMPLES_PER_FRAME отсчетов в пакет H2
+ * @param pcm 120 отсчетов 16 кГц
+ * @param packet Буфер MSBC_PACKET_LEN байт
+ */
+void msbc_encode(msbc_enc_t *enc, const int16_t *pcm, uint8_t *packet);
+
+/**
+ * @brief Декодирование пакета H2 в MSBC_SAMPLES_PER_FRAME отсчетов
+ *
+ * При ошибке на выходе затухание фильтра синтеза (нулевые поддиапазоны),
+ * состояние декодера остается согласованным.
+ * @param packet MSBC_PACKET_LEN байт, начиная с заголовка H2
+ * @return ESP_OK, ESP_ERR_INVALID_RESPONSE (нет H2/синхрослова), ESP_ERR_INVALID_CRC
+ */
+esp_err_t msbc_decode(msbc_dec_t *dec, const uint8_t *packet, int16_t *pcm);
+
+/**
+ * @brief Запись заголовка H2
+ * @param hdr 2 байта
+ * @param seq Номер пакета 0..3
+ */
+void msbc_h2_write(uint8_t *hdr, uint8_t seq);
+
+/**
+ * @brief Разбор заголовка H2
+ * @param seq Номер пакета 0..3
+ * @return false если это не заголовок H2
+ */
+bool msbc_h2_parse(const uint8_t *hdr, uint8_t *seq);
+
+/**
+ * @brief Поиск начала пакета (H2 + синхрослово) в захваченном потоке байт
+ * @return Смещение пакета или -1, если в буфере полного пакета нет
+ */
+int msbc_find_packet(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Проверка кодека: эталонный кадр тишины, контрольные суммы, качество, такты на кадр
+ * @return ESP_OK если все проверки прошли
+ */
+esp_err_t msbc_selftest(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSBC_H */
@@ -3,6 +3,8 @@
 #include "esp_err.h"
 #include "nvs_flash.h"
 #include "nvs.h"
+#include "metrics.h"
+#include "esp_timer.h"
 #include <string.h>
 #include <time.h>
 
@@ -11,9 +13,14 @@ static const char *NVS_NAMESPACE = "paired_dev";
 static const char *NVS_KEY_COUNT = "count";
 static const char *NVS_KEY_DEVICE_PREFIX = "dev_";
 
+// Статистика открытий SCO без изменения кэша пишется во флеш раз в столько открытий
+#define PAIRED_LINK_STATS_SAVE_EVERY 16
+
 static paired_device_t paired_devices[MAX_PAIRED_DEVICES];
 static int paired_device_count = 0;
 static nvs_handle_t nvs_handle_storage;
+static metric_t *s_m_nvs_writes = NULL;
+static metric_t *s_m_nvs_commit = NULL;
 
 // Вспомогательная функция для получения строкового представления MAC адреса
 static void bd_addr_to_string(const esp_bd_addr_t bd_addr, char *str) {
@@ -46,6 +53,8 @@ static esp_err_t load_devices_from_nvs(void) {
         char key[32];
         snprintf(key, sizeof(key), "%s%d", NVS_KEY_DEVICE_PREFIX, i);
         
+        // Записи старого формата короче: недостающий хвост (кэш возможностей) остается нулевым
+        memset(&paired_devices[i], 0, sizeof(paired_device_t));
         size_t device_size = sizeof(paired_device_t);
         err = nvs_get_blob(nvs_handle_storage, key, &paired_devices[i], &device_size);
         if (err != ESP_OK) {
@@ -62,12 +71,34 @@ static esp_err_t load_devices_from_nvs(void) {
     return ESP_OK;
 }
 
+// Commit с учетом числа и длительности записей во флеш
+static esp_err_t nvs_commit_timed(void) {
+    int64_t start = esp_timer_get_time();
+    esp_err_t err = nvs_commit(nvs_handle_storage);
+    metrics_observe(s_m_nvs_commit, (uint32_t)(esp_timer_get_time() - start));
+    return err;
+}
+
+// Сохранение одной записи в NVS (без commit)
+static esp_err_t save_device_to_nvs(int index) {
+    char key[32];
+    snprintf(key, sizeof(key), "%s%d", NVS_KEY_DEVICE_PREFIX, index);
+
+    esp_err_t err = nvs_set_blob(nvs_handle_storage, key, &paired_devices[index], sizeof(paired_device_t));
+    metrics_inc(s_m_nvs_writes);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save device %d to NVS: %s", index, esp_err_to_name(err));
+    }
+    return err;
+}
+
 // Сохранение устройств в NVS
 static esp_err_t save_devices_to_nvs(void) {
     esp_err_t err;
     
     // Сохраняем количество устройств
     err = nvs_set_blob(nvs_handle_storage, NVS_KEY_COUNT, &paired_device_count, sizeof(paired_device_count));
+    metrics_inc(s_m_nvs_writes);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to save device count to NVS: %s", esp_err_to_name(err));
         return err;
@@ -75,18 +106,14 @@ static esp_err_t save_devices_to_nvs(void) {
 
     // Сохраняем каждое устройство
     for (int i = 0; i < paired_device_count; i++) {
-        char key[32];
-        snprintf(key, sizeof(key), "%s%d", NVS_KEY_DEVICE_PREFIX, i);
-        
-        err = nvs_set_blob(nvs_handle_storage, key, &paired_devices[i], sizeof(paired_device_t));
+        err = save_device_to_nvs(i);
         if (err != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to save device %d to NVS: %s", i, esp_err_to_name(err));
             return err;
         }
     }
 
     // Коммитим изменения
-    err = nvs_commit(nvs_handle_storage);
+    err = nvs_commit_timed();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to commit NVS changes: %s", esp_err_to_name(err));
         return err;
@@ -97,6 +124,9 @@ static esp_err_t save_devices_to_nvs(void) {
 }
 
 esp_err_t paired_devices_init(void) {
+    s_m_nvs_writes = metrics_counter("nvs.writes");
+    s_m_nvs_commit = metrics_histogram("nvs.commit", "us");
+
     esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs_handle_storage);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to open NVS namespace: %s", esp_err_to_name(err));
@@ -115,11 +145,6 @@ esp_err_t paired_devices_init(void) {
 }
 
 esp_err_t paired_devices_add(const esp_bd_addr_t bd_addr, const char *device_name, uint32_t cod, bool is_hf_device) {
-    if (paired_device_count >= MAX_PAIRED_DEVICES) {
-        ESP_LOGW(TAG, "Maximum number of paired devices reached (%d)", MAX_PAIRED_DEVICES);
-        return ESP_ERR_NO_MEM;
-    }
-
     // Проверяем, не существует ли уже такое устройство
     for (int i = 0; i < paired_device_count; i++) {
         if (bd_addr_equal(paired_devices[i].bd_addr, bd_addr)) {
@@ -139,8 +164,14 @@ esp_err_t paired_devices_add(const esp_bd_addr_t bd_addr, const char *device_nam
         }
     }
 
+    if (paired_device_count >= MAX_PAIRED_DEVICES) {
+        ESP_LOGW(TAG, "Maximum number of paired devices reached (%d)", MAX_PAIRED_DEVICES);
+        return ESP_ERR_NO_MEM;
+    }
+
     // Добавляем новое устройство
     paired_device_t *new_device = &paired_devices[paired_device_count];
+    memset(new_device, 0, sizeof(*new_device));
     memcpy(new_device->bd_addr, bd_addr, ESP_BD_ADDR_LEN);
     strncpy(new_device->device_name, device_name ? device_name : "", DEVICE_NAME_MAX_LEN - 1);
     new_device->device_name[DEVICE_NAME_MAX_LEN - 1] = '\0';
@@ -212,6 +243,42 @@ esp_err_t paired_devices_update_connection_time(const esp_bd_addr_t bd_addr) {
     return ESP_ERR_NOT_FOUND;
 }
 
+// Поля, от которых зависит быстрое открытие аудио; счетчики открытий сюда не входят
+static bool link_caps_changed(const paired_link_caps_t *a, const paired_link_caps_t *b) {
+    return a->peer_feat != b->peer_feat || a->chld_feat != b->chld_feat || a->codecs != b->codecs ||
+           a->last_codec != b->last_codec || a->last_frame_size != b->last_frame_size;
+}
+
+esp_err_t paired_devices_update_link(const esp_bd_addr_t bd_addr, const paired_link_caps_t *link) {
+    if (link == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < paired_device_count; i++) {
+        if (bd_addr_equal(paired_devices[i].bd_addr, bd_addr)) {
+            paired_link_caps_t *cur = &paired_devices[i].link;
+            bool caps_changed = link_caps_changed(cur, link);
+            bool count_changed = cur->audio_ok_count != link->audio_ok_count;
+            *cur = *link;
+
+            // Одинаковый кэш при каждом подключении не должен изнашивать флеш: счетчики
+            // открытий живут в RAM и попадают в NVS вместе с любым сохранением записи
+            // или раз в PAIRED_LINK_STATS_SAVE_EVERY открытий
+            if (!caps_changed &&
+                !(count_changed && link->audio_ok_count % PAIRED_LINK_STATS_SAVE_EVERY == 0)) {
+                return ESP_OK;
+            }
+
+            esp_err_t err = save_device_to_nvs(i);
+            if (err != ESP_OK) {
+                return err;
+            }
+            return nvs_commit_timed();
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
 paired_device_t* paired_devices_get_reconnect_candidate(void) {
     paired_device_t *candidate = NULL;
     uint32_t latest_time = 0;
@@ -238,7 +305,7 @@ esp_err_t paired_devices_clear_all(void) {
         return err;
     }
 
-    return nvs_commit(nvs_handle_storage);
+    return nvs_commit_timed();
 }
 
 void paired_devices_print_list(void) {
@@ -258,6 +325,20 @@ void paired_devices_print_list(void) {
                  paired_devices[i].is_hf_device ? "Yes" : "No",
                  (unsigned long)paired_devices[i].cod,
                  (unsigned long)paired_devices[i].connection_count);
+        const paired_link_caps_t *link = &paired_devices[i].link;
+        if (link->audio_ok_count > 0) {
+            const char *last = "-";
+            if (link->last_codec == PAIRED_CODEC_CVSD) {
+                last = "CVSD";
+            } else if (link->last_codec == PAIRED_CODEC_MSBC) {
+                last = "mSBC";
+            }
+            ESP_LOGI(TAG, "   Codec: %s%s, last SCO %s (%u bytes), SLC->audio %u ms, features 0x%08lx",
+                     (link->codecs & PAIRED_CODEC_CVSD) ? "CVSD " : "",
+                     (link->codecs & PAIRED_CODEC_MSBC) ? "mSBC" : "",
+                     last,
+                     link->last_frame_size, link->slc_to_audio_ms, (unsigned long)link->peer_feat);
+        }
     }
     
     ESP_LOGI(TAG, "=== End of Paired Devices List ===");
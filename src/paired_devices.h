@@ -12,6 +12,20 @@ extern "C" {
 #define MAX_PAIRED_DEVICES 10
 #define DEVICE_NAME_MAX_LEN 64
 
+#define PAIRED_CODEC_CVSD   0x01
+#define PAIRED_CODEC_MSBC   0x02
+
+// Кэш возможностей гарнитуры: при переподключении аудио открывается сразу известным кодеком
+typedef struct {
+    uint32_t peer_feat;          // Биты возможностей HF (AT+BRSF)
+    uint32_t chld_feat;          // Возможности AT+CHLD
+    uint8_t codecs;              // PAIRED_CODEC_* - кодеки, на которых SCO уже открывался
+    uint8_t last_codec;          // Кодек последнего успешного SCO (0 - неизвестен)
+    uint16_t last_frame_size;    // Размер кадра последнего SCO
+    uint16_t slc_to_audio_ms;    // Время от SLC до аудио при последнем подключении
+    uint16_t audio_ok_count;     // Успешных открытий SCO
+} paired_link_caps_t;
+
 typedef struct {
     esp_bd_addr_t bd_addr;
     char device_name[DEVICE_NAME_MAX_LEN];
@@ -19,6 +33,7 @@ typedef struct {
     bool is_hf_device;
     uint32_t last_connected_time;
     uint32_t connection_count;
+    paired_link_caps_t link;  // Добавлено в конец: старые записи NVS читаются с нулевым кэшем
 } paired_device_t;
 
 /**
@@ -72,6 +87,18 @@ int paired_devices_get_all(paired_device_t *devices, int max_count);
  */
 esp_err_t paired_devices_update_connection_time(const esp_bd_addr_t bd_addr);
 
+/**
+ * @brief Обновление кэша возможностей гарнитуры
+ *
+ * В NVS пишется только изменение кодеков, возможностей или размера кадра;
+ * счетчики открытий SCO (audio_ok_count, slc_to_audio_ms) обновляются в RAM
+ * и сохраняются вместе с записью или раз в 16 открытий.
+ * @param bd_addr MAC адрес устройства
+ * @param link Новые данные кэша
+ * @return ESP_OK при успехе, ESP_ERR_NOT_FOUND если устройства нет в списке
+ */
+esp_err_t paired_devices_update_link(const esp_bd_addr_t bd_addr, const paired_link_caps_t *link);
+
 /**
  * @brief Получение устройства для автоматического переподключения
  * @return Указатель на устройство или NULL если нет кандидатов
@@ -0,0 +1,334 @@
+#include "prompts.h"
+#include "audio_mixer.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <string.h>
+
+static const char *TAG = "PROMPTS";
+
+#define PLAYER_FREE       (-1)
+#define PLAYER_RESERVED   (-2)
+#define STEP_ONE          (1u << 16)   // Шаг ресэмплинга 1.0 в Q16
+#define STOP_GUARD_US     20000        // Запас после затухания, прежде чем слот можно переиспользовать
+
+typedef struct {
+    const prompt_pack_entry_t *entry;
+    const int16_t *data;           // Указывает прямо во флеш через mmap, в RAM ничего не копируется
+    uint32_t length;
+    uint32_t idx;                  // Позиция в отсчетах исходного клипа
+    uint32_t frac;                 // Дробная часть позиции, Q16
+    uint32_t step;                 // Q16: src_rate / out_rate
+    volatile bool loop;
+    volatile bool seek_pending;
+    volatile uint32_t seek_idx;
+    volatile bool finished;
+    int64_t release_at_us;         // Когда слот освободится после prompts_stop
+    int mixer_id;
+} prompt_player_t;
+
+static const void *s_map = NULL;
+static esp_partition_mmap_handle_t s_map_handle;
+static const prompt_pack_header_t *s_header = NULL;
+static const prompt_pack_entry_t *s_entries = NULL;
+static prompt_player_t s_players[PROMPTS_MAX_PLAYERS];
+static portMUX_TYPE s_players_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_output_rate = 8000;
+
+static inline uint32_t calc_step(uint32_t src_rate)
+{
+    return (uint32_t)(((uint64_t)src_rate << 16) / s_output_rate);
+}
+
+static bool player_is_free(const prompt_player_t *p)
+{
+    if (p->mixer_id == PLAYER_FREE) {
+        return true;
+    }
+    if (p->mixer_id == PLAYER_RESERVED) {
+        return false;
+    }
+    if (p->release_at_us != 0) {
+        return esp_timer_get_time() >= p->release_at_us;
+    }
+    return p->finished;
+}
+
+// Конец клипа: либо в начало (loop), либо завершение
+static inline bool player_wrap(prompt_player_t *p)
+{
+    if (p->idx < p->length) {
+        return true;
+    }
+    if (p->loop) {
+        p->idx -= p->length;
+        return true;
+    }
+    p->finished = true;
+    return false;
+}
+
+static uint32_t prompt_source_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    prompt_player_t *p = (prompt_player_t *)ctx;
+    const int16_t *d = p->data;
+    uint32_t n = 0;
+
+    if (p->seek_pending) {
+        p->idx = p->seek_idx;
+        p->frac = 0;
+        p->seek_pending = false;
+    }
+    if (p->finished) {
+        return 0;
+    }
+
+    if (p->step == STEP_ONE) {
+        // Частоты совпадают: прямое копирование из отображенного флеша
+        while (n < samples && player_wrap(p)) {
+            uint32_t chunk = p->length - p->idx;
+            if (chunk > samples - n) {
+                chunk = samples - n;
+            }
+            memcpy(&buf[n], &d[p->idx], chunk * sizeof(int16_t));
+            n += chunk;
+            p->idx += chunk;
+        }
+    } else if (p->step == 2 * STEP_ONE) {
+        // 16 -> 8 кГц: децимация 2:1 с фильтром [1 2 1]/4 против наложения спектра
+        while (n < samples && player_wrap(p)) {
+            int32_t c = d[p->idx];
+            int32_t l = p->idx > 0 ? d[p->idx - 1] : c;
+            int32_t r = p->idx + 1 < p->length ? d[p->idx + 1] : c;
+            buf[n++] = (int16_t)((l + 2 * c + r) >> 2);
+            p->idx += 2;
+        }
+    } else {
+        // Остальные соотношения (8 -> 16 кГц и т.п.): линейная интерполяция
+        while (n < samples && player_wrap(p)) {
+            int32_t a = d[p->idx];
+            int32_t b = p->idx + 1 < p->length ? d[p->idx + 1] : (p->loop ? d[0] : a);
+            buf[n++] = (int16_t)(a + (((b - a) * (int32_t)p->frac) >> 16));
+            p->frac += p->step;
+            p->idx += p->frac >> 16;
+            p->frac &= 0xFFFF;
+        }
+    }
+
+    return n;
+}
+
+static prompt_player_t *player_get(int handle)
+{
+    if (handle < 0 || handle >= PROMPTS_MAX_PLAYERS || s_players[handle].mixer_id < 0) {
+        return NULL;
+    }
+    return &s_players[handle];
+}
+
+esp_err_t prompts_init(void)
+{
+    for (int i = 0; i < PROMPTS_MAX_PLAYERS; i++) {
+        s_players[i].mixer_id = PLAYER_FREE;
+    }
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                           PROMPTS_PARTITION_LABEL);
+    if (part == NULL) {
+        ESP_LOGW(TAG, "Partition '%s' not found, prompts disabled", PROMPTS_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Отображается весь раздел: страницы MMU, а не RAM, поэтому расход памяти не зависит от числа подсказок
+    esp_err_t ret = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &s_map, &s_map_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to mmap prompts partition: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    const prompt_pack_header_t *hdr = (const prompt_pack_header_t *)s_map;
+    uint32_t table_end = sizeof(prompt_pack_header_t) + (uint32_t)hdr->count * sizeof(prompt_pack_entry_t);
+    if (hdr->magic != PROMPTS_MAGIC || hdr->version != PROMPTS_VERSION ||
+        hdr->total_size > part->size || table_end > hdr->total_size) {
+        ESP_LOGW(TAG, "No valid prompt pack in '%s' (flash one with tools/prompt_pack.py)", PROMPTS_PARTITION_LABEL);
+        esp_partition_munmap(s_map_handle);
+        s_map = NULL;
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const prompt_pack_entry_t *entries = (const prompt_pack_entry_t *)(hdr + 1);
+    for (int i = 0; i < hdr->count; i++) {
+        const prompt_pack_entry_t *e = &entries[i];
+        // Сравнение через остаток: offset + samples * 2 из поврежденного образа может переполнить uint32_t
+        if ((e->offset & 1) || e->sample_rate == 0 || e->samples == 0 ||
+            e->offset < table_end || e->offset > hdr->total_size ||
+            e->samples > (hdr->total_size - e->offset) / sizeof(int16_t)) {
+            ESP_LOGE(TAG, "Prompt %d has invalid bounds, pack rejected", i);
+            esp_partition_munmap(s_map_handle);
+            s_map = NULL;
+            return ESP_ERR_INVALID_SIZE;
+        }
+    }
+
+    s_header = hdr;
+    s_entries = entries;
+    ESP_LOGI(TAG, "✅ Prompt pack mapped: %d prompts, %" PRIu32 " KB", hdr->count, hdr->total_size / 1024);
+    return ESP_OK;
+}
+
+int prompts_count(void)
+{
+    return s_header ? s_header->count : 0;
+}
+
+const prompt_pack_entry_t *prompts_get_entry(int index)
+{
+    if (s_header == NULL || index < 0 || index >= s_header->count) {
+        return NULL;
+    }
+    return &s_entries[index];
+}
+
+static const prompt_pack_entry_t *prompts_find(const char *name)
+{
+    for (int i = 0; i < prompts_count(); i++) {
+        if (strncmp(s_entries[i].name, name, PROMPTS_NAME_LEN) == 0) {
+            return &s_entries[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t prompts_play(const char *name, const prompt_play_cfg_t *cfg, int *out_handle)
+{
+    if (name == NULL || cfg == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const prompt_pack_entry_t *entry = prompts_find(name);
+    if (entry == NULL) {
+        ESP_LOGW(TAG, "Prompt '%s' not found", name);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    int handle = -1;
+    portENTER_CRITICAL(&s_players_lock);
+    for (int i = 0; i < PROMPTS_MAX_PLAYERS; i++) {
+        if (player_is_free(&s_players[i])) {
+            s_players[i].mixer_id = PLAYER_RESERVED;
+            handle = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_players_lock);
+
+    if (handle < 0) {
+        ESP_LOGW(TAG, "All %d prompt players busy", PROMPTS_MAX_PLAYERS);
+        return ESP_ERR_NO_MEM;
+    }
+
+    prompt_player_t *p = &s_players[handle];
+    p->entry = entry;
+    p->data = (const int16_t *)((const uint8_t *)s_map + entry->offset);
+    p->length = entry->samples;
+    p->idx = 0;
+    p->frac = 0;
+    p->step = calc_step(entry->sample_rate);
+    p->loop = cfg->loop;
+    p->seek_pending = false;
+    p->finished = false;
+    p->release_at_us = 0;
+
+    const audio_mixer_source_cfg_t src = {
+        .cb = prompt_source_cb,
+        .ctx = p,
+        .priority = cfg->priority,
+        .flags = AUDIO_MIXER_FLAG_ONESHOT,
+        .gain = cfg->gain,
+        .duck_gain = AUDIO_MIXER_GAIN_UNITY,
+        .fade_in_ms = cfg->fade_ms,
+    };
+    int mixer_id = PLAYER_FREE;
+    esp_err_t ret = audio_mixer_add_source(&src, &mixer_id);
+    p->mixer_id = ret == ESP_OK ? mixer_id : PLAYER_FREE;
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    if (out_handle) {
+        *out_handle = handle;
+    }
+    ESP_LOGI(TAG, "▶️ Playing '%.*s' (%" PRIu32 " ms, %u Hz%s)", PROMPTS_NAME_LEN, entry->name,
+             entry->samples * 1000 / entry->sample_rate, entry->sample_rate, cfg->loop ? ", loop" : "");
+    return ESP_OK;
+}
+
+esp_err_t prompts_stop(int handle, uint32_t fade_ms)
+{
+    prompt_player_t *p = player_get(handle);
+    if (p == NULL || player_is_free(p)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    p->loop = false;
+    p->release_at_us = esp_timer_get_time() + (int64_t)fade_ms * 1000 + STOP_GUARD_US;
+    return audio_mixer_remove_source(p->mixer_id, fade_ms);
+}
+
+void prompts_stop_all(uint32_t fade_ms)
+{
+    for (int i = 0; i < PROMPTS_MAX_PLAYERS; i++) {
+        prompts_stop(i, fade_ms);
+    }
+}
+
+esp_err_t prompts_seek(int handle, uint32_t position_ms)
+{
+    prompt_player_t *p = player_get(handle);
+    if (p == NULL || player_is_free(p)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint32_t idx = (uint32_t)((uint64_t)position_ms * p->entry->sample_rate / 1000);
+    if (idx >= p->length) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Применяется в callback источника на границе блока
+    p->seek_idx = idx;
+    p->seek_pending = true;
+    return ESP_OK;
+}
+
+esp_err_t prompts_set_loop(int handle, bool loop)
+{
+    prompt_player_t *p = player_get(handle);
+    if (p == NULL || player_is_free(p)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    p->loop = loop;
+    return ESP_OK;
+}
+
+void prompts_set_output_rate(uint32_t sample_rate)
+{
+    if (sample_rate == 0) {
+        return;
+    }
+    s_output_rate = sample_rate;
+    for (int i = 0; i < PROMPTS_MAX_PLAYERS; i++) {
+        if (s_players[i].entry) {
+            s_players[i].step = calc_step(s_players[i].entry->sample_rate);
+        }
+    }
+}
+
+void prompts_print_list(void)
+{
+    ESP_LOGI(TAG, "=== Prompts (%d) ===", prompts_count());
+    for (int i = 0; i < prompts_count(); i++) {
+        const prompt_pack_entry_t *e = &s_entries[i];
+        ESP_LOGI(TAG, "%d. %.*s: %" PRIu32 " ms @ %u Hz", i + 1, PROMPTS_NAME_LEN, e->name,
+                 e->samples * 1000 / e->sample_rate, e->sample_rate);
+    }
+}
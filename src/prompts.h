@@ -0,0 +1,120 @@
+#ifndef PROMPTS_H
+#define PROMPTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Контейнер подсказок в разделе "prompts" (little-endian), собирается tools/prompt_pack.py:
+ *   заголовок  prompt_pack_header_t (16 байт)
+ *   оглавление prompt_pack_entry_t  (32 байта на запись)
+ *   данные     PCM16 моно, каждый клип выровнен на 4 байта
+ */
+#define PROMPTS_PARTITION_LABEL  "prompts"
+#define PROMPTS_MAGIC            0x544D5250  // "PRMT"
+#define PROMPTS_VERSION          1
+#define PROMPTS_NAME_LEN         20
+#define PROMPTS_MAX_PLAYERS      4
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t total_size;
+    uint32_t reserved;
+} prompt_pack_header_t;
+
+typedef struct {
+    char name[PROMPTS_NAME_LEN];
+    uint32_t offset;        // Смещение данных от начала раздела
+    uint32_t samples;
+    uint16_t sample_rate;
+    uint16_t flags;
+} prompt_pack_entry_t;
+
+typedef struct {
+    uint8_t priority;       // Приоритет в микшере (подсказки обычно приглушают тон/поток)
+    int32_t gain;           // Q15
+    bool loop;
+    uint32_t fade_ms;
+} prompt_play_cfg_t;
+
+/**
+ * @brief Отображение раздела подсказок в адресное пространство и проверка оглавления
+ * @return ESP_OK при успехе, ESP_ERR_NOT_FOUND если раздела или контейнера нет
+ */
+esp_err_t prompts_init(void);
+
+/**
+ * @brief Количество подсказок в контейнере
+ * @return Количество подсказок
+ */
+int prompts_count(void);
+
+/**
+ * @brief Получение записи оглавления по индексу
+ * @param index Индекс подсказки
+ * @return Указатель на запись (во флеше) или NULL
+ */
+const prompt_pack_entry_t *prompts_get_entry(int index);
+
+/**
+ * @brief Запуск воспроизведения подсказки в исходящий поток
+ * @param name Имя подсказки
+ * @param cfg Параметры воспроизведения
+ * @param out_handle Дескриптор проигрывателя
+ * @return ESP_OK при успехе
+ */
+esp_err_t prompts_play(const char *name, const prompt_play_cfg_t *cfg, int *out_handle);
+
+/**
+ * @brief Остановка воспроизведения с затуханием
+ * @param handle Дескриптор проигрывателя
+ * @param fade_ms Длительность затухания
+ * @return ESP_OK при успехе
+ */
+esp_err_t prompts_stop(int handle, uint32_t fade_ms);
+
+/**
+ * @brief Остановка всех проигрывателей
+ * @param fade_ms Длительность затухания
+ */
+void prompts_stop_all(uint32_t fade_ms);
+
+/**
+ * @brief Перемотка на позицию
+ * @param handle Дескриптор проигрывателя
+ * @param position_ms Позиция от начала подсказки, мс
+ * @return ESP_OK при успехе
+ */
+esp_err_t prompts_seek(int handle, uint32_t position_ms);
+
+/**
+ * @brief Включение/выключение зацикливания
+ * @param handle Дескриптор проигрывателя
+ * @param loop true - играть по кругу
+ * @return ESP_OK при успехе
+ */
+esp_err_t prompts_set_loop(int handle, bool loop);
+
+/**
+ * @brief Смена частоты выходного потока (8 кГц CVSD / 16 кГц mSBC)
+ * @param sample_rate Частота, Гц
+ */
+void prompts_set_output_rate(uint32_t sample_rate);
+
+/**
+ * @brief Вывод оглавления в лог
+ */
+void prompts_print_list(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROMPTS_H */
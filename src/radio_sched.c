@@ -0,0 +1,245 @@
+#include "radio_sched.h"
+#include "hf_conn.h"
+#include "boot_phase.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_gap_bt_api.h"
+#include <string.h>
+
+static const char *TAG = "RADIO_SCHED";
+
+typedef enum {
+    RADIO_MODE_OPEN = 0,     // Нет bonding: видим и доступен для подключения
+    RADIO_MODE_BONDED,       // Есть bonding: только page scan, inquiry scan выключен
+    RADIO_MODE_PAIRING,      // Временное окно видимости по команде
+    RADIO_MODE_FULL,         // Все слоты HF заняты: новые подключения не нужны
+    RADIO_MODE_CALL,         // Открыт SCO: сканирование выключено, эфир - разговору
+    RADIO_MODE_COUNT,
+} radio_mode_t;
+
+static const char *const s_mode_names[RADIO_MODE_COUNT] = {
+    "open", "bonded", "pairing", "full", "call",
+};
+
+static radio_mode_t s_mode = RADIO_MODE_OPEN;
+static bool s_mode_applied = false;
+static int64_t s_mode_since_us = 0;
+static int64_t s_pairing_until_us = 0;
+static esp_timer_handle_t s_pairing_timer = NULL;
+
+// Время до первого кандидата в последних раундах, мс (0 - промах)
+static uint32_t s_hit_ms[RADIO_INQ_HISTORY];
+static int s_hit_pos = 0;
+static int s_hit_filled = 0;
+static int64_t s_inq_start_us = 0;
+static uint32_t s_inq_hit_ms = 0;
+static uint8_t s_last_len = RADIO_INQ_MAX_UNITS;
+
+static struct {
+    uint64_t mode_us[RADIO_MODE_COUNT];   // Время в каждом режиме
+    uint64_t inquiry_us;                  // Суммарная длительность inquiry
+    uint64_t inquiry_budget_us;           // Сколько заняли бы те же inquiry по 12.8 с
+    uint32_t inquiries;
+    uint32_t hits;
+    uint32_t deferred;                    // Inquiry, отложенные из-за разговора
+    uint32_t mode_changes;
+} s_stats;
+
+static void account_mode_time(int64_t now)
+{
+    if (s_mode_applied) {
+        s_stats.mode_us[s_mode] += (uint64_t)(now - s_mode_since_us);
+    }
+    s_mode_since_us = now;
+}
+
+static void apply_mode(radio_mode_t mode)
+{
+    if (s_mode_applied && mode == s_mode) {
+        return;
+    }
+
+    esp_bt_connection_mode_t conn = ESP_BT_CONNECTABLE;
+    esp_bt_discovery_mode_t disc = ESP_BT_NON_DISCOVERABLE;
+    switch (mode) {
+        case RADIO_MODE_OPEN:
+        case RADIO_MODE_PAIRING:
+            disc = ESP_BT_GENERAL_DISCOVERABLE;
+            break;
+        case RADIO_MODE_BONDED:
+            break;
+        case RADIO_MODE_FULL:
+        case RADIO_MODE_CALL:
+            conn = ESP_BT_NON_CONNECTABLE;
+            break;
+        default:
+            break;
+    }
+
+    esp_err_t ret = esp_bt_gap_set_scan_mode(conn, disc);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set scan mode: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    account_mode_time(esp_timer_get_time());
+    ESP_LOGI(TAG, "📻 Radio mode: %s -> %s (page scan %s, inquiry scan %s)",
+             s_mode_applied ? s_mode_names[s_mode] : "-", s_mode_names[mode],
+             conn == ESP_BT_CONNECTABLE ? "on" : "off", disc == ESP_BT_NON_DISCOVERABLE ? "off" : "on");
+    s_mode = mode;
+    s_mode_applied = true;
+    s_stats.mode_changes++;
+    if (conn == ESP_BT_CONNECTABLE) {
+        boot_phase_milestone("connectable");
+    }
+}
+
+static void pairing_timer_cb(void *arg)
+{
+    ESP_LOGI(TAG, "Pairing window closed");
+    s_pairing_until_us = 0;
+    radio_sched_refresh();
+}
+
+esp_err_t radio_sched_init(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(s_hit_ms, 0, sizeof(s_hit_ms));
+    s_hit_pos = 0;
+    s_hit_filled = 0;
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = pairing_timer_cb,
+        .name = "radio_pairing",
+    };
+    esp_err_t ret = esp_timer_create(&timer_args, &s_pairing_timer);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create pairing timer: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    radio_sched_refresh();
+    return ESP_OK;
+}
+
+void radio_sched_refresh(void)
+{
+    radio_mode_t mode;
+
+    if (hf_conn_get_audio_active() != NULL) {
+        mode = RADIO_MODE_CALL;
+    } else if (hf_conn_count() >= HF_CONN_MAX) {
+        mode = RADIO_MODE_FULL;
+    } else if (s_pairing_until_us > esp_timer_get_time()) {
+        mode = RADIO_MODE_PAIRING;
+    } else if (esp_bt_gap_get_bond_device_num() > 0) {
+        mode = RADIO_MODE_BONDED;
+    } else {
+        mode = RADIO_MODE_OPEN;
+    }
+
+    apply_mode(mode);
+}
+
+uint8_t radio_sched_inquiry_len(void)
+{
+    // Последний раунд промахнулся или истории нет - полная длительность
+    int last = (s_hit_pos + RADIO_INQ_HISTORY - 1) % RADIO_INQ_HISTORY;
+    if (s_hit_filled == 0 || s_hit_ms[last] == 0) {
+        s_last_len = RADIO_INQ_MAX_UNITS;
+        return s_last_len;
+    }
+
+    // Окно по самому медленному попаданию в истории плюс единица запаса
+    uint32_t worst_ms = 0;
+    for (int i = 0; i < s_hit_filled; i++) {
+        if (s_hit_ms[i] > worst_ms) {
+            worst_ms = s_hit_ms[i];
+        }
+    }
+    uint32_t units = (worst_ms + RADIO_INQ_UNIT_MS - 1) / RADIO_INQ_UNIT_MS + 1;
+    if (units < RADIO_INQ_MIN_UNITS) {
+        units = RADIO_INQ_MIN_UNITS;
+    } else if (units > RADIO_INQ_MAX_UNITS) {
+        units = RADIO_INQ_MAX_UNITS;
+    }
+    s_last_len = (uint8_t)units;
+    return s_last_len;
+}
+
+bool radio_sched_inquiry_allowed(void)
+{
+    if (hf_conn_get_audio_active() != NULL) {
+        s_stats.deferred++;
+        return false;
+    }
+    return true;
+}
+
+void radio_sched_on_inquiry_started(void)
+{
+    s_inq_start_us = esp_timer_get_time();
+    s_inq_hit_ms = 0;
+    s_stats.inquiries++;
+    s_stats.inquiry_budget_us += (uint64_t)RADIO_INQ_MAX_UNITS * RADIO_INQ_UNIT_MS * 1000;
+}
+
+void radio_sched_on_target_seen(void)
+{
+    if (s_inq_start_us != 0 && s_inq_hit_ms == 0) {
+        s_inq_hit_ms = (uint32_t)((esp_timer_get_time() - s_inq_start_us) / 1000);
+        if (s_inq_hit_ms == 0) {
+            s_inq_hit_ms = 1;
+        }
+    }
+}
+
+void radio_sched_on_inquiry_stopped(void)
+{
+    if (s_inq_start_us == 0) {
+        return;
+    }
+
+    int64_t elapsed = esp_timer_get_time() - s_inq_start_us;
+    s_stats.inquiry_us += (uint64_t)elapsed;
+    if (s_inq_hit_ms != 0) {
+        s_stats.hits++;
+    }
+
+    s_hit_ms[s_hit_pos] = s_inq_hit_ms;
+    s_hit_pos = (s_hit_pos + 1) % RADIO_INQ_HISTORY;
+    if (s_hit_filled < RADIO_INQ_HISTORY) {
+        s_hit_filled++;
+    }
+
+    ESP_LOGI(TAG, "Inquiry took %lld ms (len %u), first candidate %s",
+             (long long)(elapsed / 1000), s_last_len, s_inq_hit_ms ? "seen" : "not seen");
+    s_inq_start_us = 0;
+}
+
+void radio_sched_open_pairing_window(uint32_t duration_ms)
+{
+    s_pairing_until_us = esp_timer_get_time() + (int64_t)duration_ms * 1000;
+    if (s_pairing_timer != NULL) {
+        esp_timer_stop(s_pairing_timer);
+        esp_timer_start_once(s_pairing_timer, (uint64_t)duration_ms * 1000);
+    }
+    ESP_LOGI(TAG, "Pairing window open for %lu ms", (unsigned long)duration_ms);
+    radio_sched_refresh();
+}
+
+void radio_sched_print_stats(void)
+{
+    account_mode_time(esp_timer_get_time());
+
+    ESP_LOGI(TAG, "=== Radio scheduler ===");
+    ESP_LOGI(TAG, "Mode: %s, next inquiry %u units", s_mode_names[s_mode], radio_sched_inquiry_len());
+    for (int i = 0; i < RADIO_MODE_COUNT; i++) {
+        ESP_LOGI(TAG, "  %-8s %llu s", s_mode_names[i], (unsigned long long)(s_stats.mode_us[i] / 1000000));
+    }
+    ESP_LOGI(TAG, "Inquiries: %lu (hits %lu, deferred in call %lu)",
+             (unsigned long)s_stats.inquiries, (unsigned long)s_stats.hits, (unsigned long)s_stats.deferred);
+    ESP_LOGI(TAG, "Inquiry airtime: %llu ms of %llu ms with fixed 12.8 s inquiries",
+             (unsigned long long)(s_stats.inquiry_us / 1000), (unsigned long long)(s_stats.inquiry_budget_us / 1000));
+    ESP_LOGI(TAG, "Scan mode changes: %lu", (unsigned long)s_stats.mode_changes);
+}
@@ -0,0 +1,65 @@
+#ifndef RADIO_SCHED_H
+#define RADIO_SCHED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RADIO_INQ_UNIT_MS          1280   // Единица длительности inquiry
+#define RADIO_INQ_MIN_UNITS        3
+#define RADIO_INQ_MAX_UNITS        10     // Прежняя фиксированная длительность (12.8 с)
+#define RADIO_INQ_HISTORY          8      // Раундов поиска в истории
+#define RADIO_PAIRING_WINDOW_MS    60000  // Окно видимости по команде pair
+
+/**
+ * @brief Инициализация планировщика радио и установка начального режима сканирования
+ * @return ESP_OK при успехе
+ */
+esp_err_t radio_sched_init(void);
+
+/**
+ * @brief Пересчет режима page/inquiry scan по состоянию соединений и bonding
+ *
+ * Вызывается при изменении SLC, SCO и после успешной аутентификации.
+ */
+void radio_sched_refresh(void);
+
+/**
+ * @brief Длительность следующего inquiry по истории попаданий
+ * @return Длительность в единицах 1.28 с
+ */
+uint8_t radio_sched_inquiry_len(void);
+
+/**
+ * @brief Можно ли сейчас запускать inquiry (нельзя во время разговора)
+ * @return true если можно
+ */
+bool radio_sched_inquiry_allowed(void);
+
+/**
+ * @brief Учет событий inquiry для статистики и подбора длительности
+ */
+void radio_sched_on_inquiry_started(void);
+void radio_sched_on_target_seen(void);
+void radio_sched_on_inquiry_stopped(void);
+
+/**
+ * @brief Временное включение видимости для сопряжения нового устройства
+ * @param duration_ms Длительность окна
+ */
+void radio_sched_open_pairing_window(uint32_t duration_ms);
+
+/**
+ * @brief Вывод статистики эфирного времени в лог
+ */
+void radio_sched_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RADIO_SCHED_H */
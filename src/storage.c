@@ -0,0 +1,48 @@
+#include "storage.h"
+#include "esp_log.h"
+#include "esp_spiffs.h"
+
+static const char *TAG = "STORAGE";
+
+static bool s_mounted = false;
+
+esp_err_t storage_mount(void) {
+    if (s_mounted) {
+        return ESP_OK;
+    }
+
+    const esp_vfs_spiffs_conf_t conf = {
+        .base_path = STORAGE_BASE_PATH,
+        .partition_label = STORAGE_PARTITION_LABEL,
+        .max_files = STORAGE_MAX_FILES,
+        .format_if_mount_failed = true,
+    };
+
+    esp_err_t ret = esp_vfs_spiffs_register(&conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to mount %s: %s", STORAGE_PARTITION_LABEL, esp_err_to_name(ret));
+        return ret;
+    }
+    s_mounted = true;
+
+    size_t total = 0, used = 0;
+    if (storage_get_info(&total, &used) == ESP_OK) {
+        ESP_LOGI(TAG, "Mounted %s at %s: %u KB total, %u KB used", STORAGE_PARTITION_LABEL,
+                 STORAGE_BASE_PATH, (unsigned)(total / 1024), (unsigned)(used / 1024));
+    }
+    return ESP_OK;
+}
+
+bool storage_is_mounted(void) {
+    return s_mounted;
+}
+
+esp_err_t storage_get_info(size_t *total, size_t *used) {
+    if (total == NULL || used == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_mounted) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return esp_spiffs_info(STORAGE_PARTITION_LABEL, total, used);
+}
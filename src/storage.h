@@ -0,0 +1,40 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STORAGE_BASE_PATH        "/spiffs"
+#define STORAGE_PARTITION_LABEL  "spiffs"
+#define STORAGE_MAX_FILES        6
+
+/**
+ * @brief Монтирование раздела spiffs в STORAGE_BASE_PATH (повторный вызов безопасен)
+ * @return ESP_OK при успехе
+ */
+esp_err_t storage_mount(void);
+
+/**
+ * @brief Проверка, смонтирован ли раздел
+ * @return true если смонтирован
+ */
+bool storage_is_mounted(void);
+
+/**
+ * @brief Получение размера раздела и занятого места
+ * @param total Общий размер, байт
+ * @param used Занято, байт
+ * @return ESP_OK при успехе
+ */
+esp_err_t storage_get_info(size_t *total, size_t *used);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STORAGE_H */
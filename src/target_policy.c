@@ -0,0 +1,240 @@
+#include "target_policy.h"
+#include "paired_devices.h"
+#include "esp_log.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "TARGET_POLICY";
+
+typedef enum {
+    PATTERN_NAME,
+    PATTERN_ADDR,
+} pattern_type_t;
+
+// Шаблоны разбираются один раз при добавлении, а не на каждый результат поиска
+typedef struct {
+    pattern_type_t type;
+    char text[TARGET_POLICY_PATTERN_LEN];   // Исходный текст для вывода
+    char lower[TARGET_POLICY_PATTERN_LEN];  // Имя в нижнем регистре
+    uint8_t addr[ESP_BD_ADDR_LEN];
+    uint8_t mask[ESP_BD_ADDR_LEN];
+} pattern_t;
+
+static pattern_t s_patterns[TARGET_POLICY_MAX_PATTERNS];
+static int s_pattern_count = 0;
+static uint16_t s_generation = 1;
+
+static target_candidate_t s_best;
+static bool s_have_best = false;
+static uint32_t s_round_candidates = 0;
+
+static void bump_generation(void)
+{
+    s_generation++;
+    if (s_generation == 0) {
+        s_generation = 1;
+    }
+}
+
+static void to_lower(char *dst, const char *src, size_t size)
+{
+    size_t i = 0;
+    for (; src[i] && i < size - 1; i++) {
+        dst[i] = (char)tolower((unsigned char)src[i]);
+    }
+    dst[i] = '\0';
+}
+
+esp_err_t target_policy_init(void)
+{
+    target_policy_clear();
+    target_policy_begin_round();
+    return ESP_OK;
+}
+
+void target_policy_clear(void)
+{
+    memset(s_patterns, 0, sizeof(s_patterns));
+    s_pattern_count = 0;
+    bump_generation();
+}
+
+esp_err_t target_policy_add_name(const char *substr)
+{
+    if (substr == NULL || substr[0] == '\0' || strlen(substr) >= TARGET_POLICY_PATTERN_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_pattern_count >= TARGET_POLICY_MAX_PATTERNS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    pattern_t *p = &s_patterns[s_pattern_count++];
+    memset(p, 0, sizeof(*p));
+    p->type = PATTERN_NAME;
+    strncpy(p->text, substr, sizeof(p->text) - 1);
+    to_lower(p->lower, substr, sizeof(p->lower));
+    bump_generation();
+
+    ESP_LOGI(TAG, "Target name pattern: '%s'", p->text);
+    return ESP_OK;
+}
+
+esp_err_t target_policy_add_addr(const char *pattern)
+{
+    if (pattern == NULL || strlen(pattern) >= TARGET_POLICY_PATTERN_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_pattern_count >= TARGET_POLICY_MAX_PATTERNS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    pattern_t p = { .type = PATTERN_ADDR };
+    strncpy(p.text, pattern, sizeof(p.text) - 1);
+
+    // Недостающие байты в конце - любые (шаблон-префикс)
+    const char *s = pattern;
+    for (int i = 0; i < ESP_BD_ADDR_LEN && *s; i++) {
+        if (*s == '*') {
+            s++;
+        } else {
+            char *end = NULL;
+            long v = strtol(s, &end, 16);
+            if (end == s || v < 0 || v > 0xFF) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            p.addr[i] = (uint8_t)v;
+            p.mask[i] = 0xFF;
+            s = end;
+        }
+        if (*s == ':') {
+            s++;
+        } else if (*s != '\0') {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    s_patterns[s_pattern_count++] = p;
+    bump_generation();
+
+    ESP_LOGI(TAG, "Target address pattern: '%s'", p.text);
+    return ESP_OK;
+}
+
+uint16_t target_policy_generation(void)
+{
+    return s_generation;
+}
+
+static bool match_patterns(const disc_cache_entry_t *entry)
+{
+    char lower_name[DISC_CACHE_NAME_LEN];
+    bool have_lower = false;
+
+    for (int i = 0; i < s_pattern_count; i++) {
+        const pattern_t *p = &s_patterns[i];
+        if (p->type == PATTERN_ADDR) {
+            bool ok = true;
+            for (int b = 0; b < ESP_BD_ADDR_LEN && ok; b++) {
+                ok = (entry->bda[b] & p->mask[b]) == p->addr[b];
+            }
+            if (ok) {
+                return true;
+            }
+        } else if (entry->name[0]) {
+            if (!have_lower) {
+                to_lower(lower_name, entry->name, sizeof(lower_name));
+                have_lower = true;
+            }
+            if (strstr(lower_name, p->lower) != NULL) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool target_policy_match(disc_cache_entry_t *entry)
+{
+    if (entry->match_gen != s_generation) {
+        entry->matched = match_patterns(entry);
+        entry->match_gen = s_generation;
+    }
+    return entry->matched;
+}
+
+int target_policy_score(const disc_cache_entry_t *entry)
+{
+    // RSSI -90..-30 дБм дает 10..70 очков: ближняя гарнитура важнее всего
+    int rssi = entry->rssi != 0 ? entry->rssi : TARGET_POLICY_NO_RSSI;
+    int score = rssi + 100;
+
+    bool audio_major = ((entry->cod & 0x1F00) >> 8) == 0x04;
+    if (audio_major || disc_cache_has_uuid(entry, DISC_CACHE_UUID_HANDSFREE)) {
+        score += 20;
+    }
+
+    const paired_device_t *device = paired_devices_find(entry->bda);
+    if (device != NULL) {
+        score += 15;
+        score += device->connection_count > 5 ? 10 : (int)device->connection_count * 2;
+    }
+    return score;
+}
+
+void target_policy_begin_round(void)
+{
+    memset(&s_best, 0, sizeof(s_best));
+    s_have_best = false;
+    s_round_candidates = 0;
+}
+
+target_policy_verdict_t target_policy_offer(disc_cache_entry_t *entry)
+{
+    if (!target_policy_match(entry)) {
+        return TARGET_POLICY_IGNORE;
+    }
+
+    int score = target_policy_score(entry);
+    bool same = s_have_best && memcmp(s_best.bda, entry->bda, ESP_BD_ADDR_LEN) == 0;
+    if (!same) {
+        s_round_candidates++;
+    }
+    if (!s_have_best || same || score > s_best.score) {
+        memcpy(s_best.bda, entry->bda, ESP_BD_ADDR_LEN);
+        strncpy(s_best.name, entry->name, sizeof(s_best.name) - 1);
+        s_best.cod = entry->cod;
+        s_best.rssi = entry->rssi;
+        s_best.score = score;
+        s_have_best = true;
+    }
+
+    ESP_LOGI(TAG, "Candidate " ESP_BD_ADDR_STR " '%s' RSSI %d score %d", ESP_BD_ADDR_HEX(entry->bda),
+             entry->name, entry->rssi, score);
+    return score >= TARGET_POLICY_GOOD_SCORE ? TARGET_POLICY_STOP : TARGET_POLICY_CANDIDATE;
+}
+
+bool target_policy_get_best(target_candidate_t *out)
+{
+    if (!s_have_best) {
+        return false;
+    }
+    if (out) {
+        *out = s_best;
+    }
+    return true;
+}
+
+void target_policy_print(void)
+{
+    ESP_LOGI(TAG, "=== Target patterns (%d) ===", s_pattern_count);
+    for (int i = 0; i < s_pattern_count; i++) {
+        ESP_LOGI(TAG, "%d. %s '%s'", i + 1, s_patterns[i].type == PATTERN_NAME ? "name" : "addr",
+                 s_patterns[i].text);
+    }
+    if (s_have_best) {
+        ESP_LOGI(TAG, "Best of %lu candidates: " ESP_BD_ADDR_STR " '%s' RSSI %d score %d",
+                 (unsigned long)s_round_candidates, ESP_BD_ADDR_HEX(s_best.bda), s_best.name,
+                 s_best.rssi, s_best.score);
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef TARGET_POLICY_H
+#define TARGET_POLICY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_bt_defs.h"
+#include "disc_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TARGET_POLICY_MAX_PATTERNS   8
+#define TARGET_POLICY_PATTERN_LEN    32
+#define TARGET_POLICY_WINDOW_MS      3000   // Окно сбора кандидатов после первого совпадения
+#define TARGET_POLICY_GOOD_SCORE     60     // Кандидат, достаточный для немедленной остановки поиска
+#define TARGET_POLICY_NO_RSSI        -90    // RSSI, принимаемый для ответов без RSSI
+
+typedef enum {
+    TARGET_POLICY_IGNORE = 0,   // Не цель
+    TARGET_POLICY_CANDIDATE,    // Цель, продолжаем искать лучшую
+    TARGET_POLICY_STOP,         // Цель достаточно хороша - поиск можно прекращать
+} target_policy_verdict_t;
+
+typedef struct {
+    esp_bd_addr_t bda;
+    char name[DISC_CACHE_NAME_LEN];
+    uint32_t cod;
+    int8_t rssi;
+    int score;
+} target_candidate_t;
+
+/**
+ * @brief Инициализация политики выбора цели
+ * @return ESP_OK при успехе
+ */
+esp_err_t target_policy_init(void);
+
+/**
+ * @brief Удаление всех шаблонов
+ */
+void target_policy_clear(void);
+
+/**
+ * @brief Добавление шаблона имени (подстрока без учета регистра)
+ * @param substr Подстрока имени
+ * @return ESP_OK при успехе, ESP_ERR_NO_MEM если шаблонов слишком много
+ */
+esp_err_t target_policy_add_name(const char *substr);
+
+/**
+ * @brief Добавление шаблона адреса: "AA:BB:CC" (префикс) или "AA:*:CC:*:*:01"
+ * @param pattern Шаблон адреса
+ * @return ESP_OK при успехе, ESP_ERR_INVALID_ARG при ошибке разбора
+ */
+esp_err_t target_policy_add_addr(const char *pattern);
+
+/**
+ * @brief Поколение набора шаблонов (меняется при каждом изменении)
+ * @return Поколение, никогда не 0
+ */
+uint16_t target_policy_generation(void);
+
+/**
+ * @brief Проверка совпадения устройства с шаблонами (результат кэшируется в записи)
+ * @param entry Запись кэша поиска
+ * @return true если устройство подходит
+ */
+bool target_policy_match(disc_cache_entry_t *entry);
+
+/**
+ * @brief Оценка кандидата: RSSI, класс HF и история подключений
+ * @param entry Запись кэша поиска
+ * @return Оценка (больше - лучше)
+ */
+int target_policy_score(const disc_cache_entry_t *entry);
+
+/**
+ * @brief Начало нового раунда поиска (сброс лучшего кандидата)
+ */
+void target_policy_begin_round(void);
+
+/**
+ * @brief Учет результата поиска в текущем раунде
+ * @param entry Запись кэша поиска
+ * @return Решение по результату
+ */
+target_policy_verdict_t target_policy_offer(disc_cache_entry_t *entry);
+
+/**
+ * @brief Лучший кандидат текущего раунда
+ * @param out Структура для записи кандидата
+ * @return true если кандидат есть
+ */
+bool target_policy_get_best(target_candidate_t *out);
+
+/**
+ * @brief Вывод шаблонов и кандидата в лог
+ */
+void target_policy_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TARGET_POLICY_H */
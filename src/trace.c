@@ -0,0 +1,174 @@
+#include "trace.h"
+#include "storage.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "TRACE";
+
+#define TRACE_MASK  (TRACE_RING_SIZE - 1)
+
+_Static_assert((TRACE_RING_SIZE & TRACE_MASK) == 0, "TRACE_RING_SIZE must be a power of two");
+
+typedef struct {
+    uint32_t ts_us;          // От trace_start, хватает на 71 минуту
+    const char *name;
+    uint32_t arg;
+    uint8_t track;
+    char phase;              // 'B', 'E', 'i'; 0 - слот еще не дописан
+} trace_event_t;
+
+static trace_event_t s_ring[TRACE_RING_SIZE];
+static uint32_t s_head = 0;              // Число захваченных слотов за сессию
+static volatile bool s_enabled = false;
+static int64_t s_base_us = 0;
+static uint8_t s_depth[TRACE_TRACK_COUNT];  // Открытые интервалы: конец без начала не пишется
+
+static const char *const s_track_names[TRACE_TRACK_COUNT] = {
+    "app", "gap", "page", "hf", "audio", "reconnect",
+};
+
+static void trace_record(trace_track_t track, char phase, const char *name, uint32_t arg)
+{
+    if (!s_enabled) {
+        return;
+    }
+    uint32_t idx = __atomic_fetch_add(&s_head, 1, __ATOMIC_RELAXED);
+    trace_event_t *ev = &s_ring[idx & TRACE_MASK];
+
+    __atomic_store_n(&ev->phase, 0, __ATOMIC_RELAXED);
+    ev->ts_us = (uint32_t)(esp_timer_get_time() - s_base_us);
+    ev->name = name;
+    ev->arg = arg;
+    ev->track = (uint8_t)track;
+    // Фаза пишется последней: экспорт пропускает недописанные слоты
+    __atomic_store_n(&ev->phase, phase, __ATOMIC_RELEASE);
+}
+
+void trace_start(void)
+{
+    s_enabled = false;
+    memset(s_ring, 0, sizeof(s_ring));
+    memset(s_depth, 0, sizeof(s_depth));
+    __atomic_store_n(&s_head, 0, __ATOMIC_RELAXED);
+    s_base_us = esp_timer_get_time();
+    s_enabled = true;
+    ESP_LOGI(TAG, "Tracing started (%d events ring)", TRACE_RING_SIZE);
+}
+
+void trace_stop(void)
+{
+    s_enabled = false;
+    ESP_LOGI(TAG, "Tracing stopped, %lu events recorded", (unsigned long)__atomic_load_n(&s_head, __ATOMIC_RELAXED));
+}
+
+bool trace_is_enabled(void)
+{
+    return s_enabled;
+}
+
+void trace_begin(trace_track_t track, const char *name)
+{
+    if (s_enabled) {
+        __atomic_fetch_add(&s_depth[track], 1, __ATOMIC_RELAXED);
+        trace_record(track, 'B', name, 0);
+    }
+}
+
+void trace_end(trace_track_t track, const char *name)
+{
+    uint8_t depth = __atomic_load_n(&s_depth[track], __ATOMIC_RELAXED);
+    do {
+        if (depth == 0) {
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&s_depth[track], &depth, depth - 1, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    trace_record(track, 'E', name, 0);
+}
+
+void trace_instant(trace_track_t track, const char *name, uint32_t arg)
+{
+    trace_record(track, 'i', name, arg);
+}
+
+static void trace_emit(FILE *out)
+{
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t first = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+    bool comma = false;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", out);
+    for (int t = 0; t < TRACE_TRACK_COUNT; t++) {
+        fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                comma ? ",\n" : "", t + 1, s_track_names[t]);
+        comma = true;
+    }
+
+    for (uint32_t i = first; i < head; i++) {
+        const trace_event_t *ev = &s_ring[i & TRACE_MASK];
+        char phase = __atomic_load_n(&ev->phase, __ATOMIC_ACQUIRE);
+        if (phase == 0 || ev->name == NULL) {
+            continue;
+        }
+        fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%d",
+                ev->name, phase, (unsigned long)ev->ts_us, ev->track + 1);
+        if (phase == 'i') {
+            fprintf(out, ",\"s\":\"t\",\"args\":{\"v\":%lu}", (unsigned long)ev->arg);
+        }
+        fputc('}', out);
+    }
+    fputs("\n]}\n", out);
+}
+
+esp_err_t trace_export_uart(void)
+{
+    bool was_enabled = s_enabled;
+    s_enabled = false;
+
+    // Маркеры позволяют вырезать JSON из общего вывода консоли
+    printf("\n=== TRACE JSON BEGIN ===\n");
+    trace_emit(stdout);
+    printf("=== TRACE JSON END ===\n");
+    fflush(stdout);
+
+    s_enabled = was_enabled;
+    return ESP_OK;
+}
+
+esp_err_t trace_export_file(const char *path)
+{
+    esp_err_t ret = storage_mount();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        return ESP_FAIL;
+    }
+
+    bool was_enabled = s_enabled;
+    s_enabled = false;
+    trace_emit(f);
+    s_enabled = was_enabled;
+
+    bool failed = ferror(f) != 0;
+    fclose(f);
+    if (failed) {
+        ESP_LOGE(TAG, "Write to %s failed", path);
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Trace written to %s", path);
+    return ESP_OK;
+}
+
+void trace_print_status(void)
+{
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_RELAXED);
+    ESP_LOGI(TAG, "Tracing %s, %lu events recorded, %lu in ring",
+             s_enabled ? "on" : "off", (unsigned long)head,
+             (unsigned long)(head > TRACE_RING_SIZE ? TRACE_RING_SIZE : head));
+}
@@ -0,0 +1,75 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_RING_SIZE    1024                       // Событий в кольце (степень двойки)
+#define TRACE_FILE_PATH    "/spiffs/trace.json"
+
+// Дорожки на временной шкале (tid в Chrome trace)
+typedef enum {
+    TRACE_TRACK_APP = 0,     // Диспетчер bt_app_core
+    TRACE_TRACK_GAP,         // Inquiry и события GAP
+    TRACE_TRACK_PAGE,        // Подключение от page до SLC
+    TRACE_TRACK_HF,          // События HF AG
+    TRACE_TRACK_AUDIO,       // SCO и аудио тракт
+    TRACE_TRACK_RECONNECT,   // Таймер переподключения
+    TRACE_TRACK_COUNT,
+} trace_track_t;
+
+/*
+ * Запись - один атомарный захват слота в кольце, без блокировок и аллокаций,
+ * допустима из callbacks стека и esp_timer. Имя события должно быть строковым
+ * литералом: в кольце хранится только указатель.
+ */
+
+/**
+ * @brief Начало записи (кольцо очищается, отсчет времени с нуля)
+ */
+void trace_start(void);
+
+/**
+ * @brief Остановка записи, содержимое кольца сохраняется для экспорта
+ */
+void trace_stop(void);
+
+/**
+ * @brief Идет ли запись
+ */
+bool trace_is_enabled(void);
+
+/**
+ * @brief Начало/конец интервала на дорожке и мгновенное событие с аргументом
+ *
+ * Конец без открытого интервала на дорожке отбрасывается, поэтому его можно
+ * вызывать из обработчиков, которые срабатывают и без соответствующего начала.
+ */
+void trace_begin(trace_track_t track, const char *name);
+void trace_end(trace_track_t track, const char *name);
+void trace_instant(trace_track_t track, const char *name, uint32_t arg);
+
+/**
+ * @brief Экспорт в формате Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+ *
+ * На время экспорта запись приостанавливается.
+ * @return ESP_OK при успехе
+ */
+esp_err_t trace_export_uart(void);
+esp_err_t trace_export_file(const char *path);
+
+/**
+ * @brief Вывод состояния кольца в лог
+ */
+void trace_print_status(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H */
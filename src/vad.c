@@ -0,0 +1,143 @@
+#include "vad.h"
+#include <string.h>
+
+#define VAD_MIN_ENERGY     64         // Ниже (~-72 dBFS) кадр - пауза при любом шуме
+#define VAD_SNR_HIGH       384        // Среднее превышение над шумом по полосам, log2 Q8 (1.5 ~ 4.5 дБ)
+#define VAD_SNR_LOW        256        // ~3 дБ: достаточно, если спектр заметно менее плоский, чем у шума
+#define VAD_SNR_MAX        (8 << 8)   // Ограничение вклада одной полосы
+#define VAD_FLAT_MARGIN    128        // ~1.5 дБ
+
+// log2(v) в Q8; log2(1 + f) ~= f + 0.343 f (1 - f) дает ошибку меньше 0.01
+static int32_t log2_q8(uint64_t v)
+{
+    if (v == 0) {
+        return 0;
+    }
+    int e = 63 - __builtin_clzll(v);
+    uint32_t f = (uint32_t)(e >= 16 ? v >> (e - 16) : v << (16 - e)) & 0xFFFF;
+    uint32_t corr = (uint32_t)(((uint64_t)f * (65536 - f) * 22487) >> 32);
+    return (e << 8) + (int32_t)((f + corr) >> 8);
+}
+
+static uint32_t isqrt32(uint32_t v)
+{
+    uint32_t r = 0;
+    for (uint32_t bit = 1u << 30; bit != 0; bit >>= 2) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+    }
+    return r;
+}
+
+void vad_init(vad_t *vad, uint32_t sample_rate)
+{
+    memset(vad, 0, sizeof(*vad));
+    vad->hang_samples = sample_rate * VAD_HANGOVER_MS / 1000;
+    vad->warmup_left = sample_rate * VAD_WARMUP_MS / 1000;
+}
+
+bool vad_process(vad_t *vad, const int16_t *x, uint32_t n)
+{
+    // Двухуровневое разложение Хаара: четыре полосы по fs/8 без умножений
+    uint64_t band[VAD_BANDS] = { 0 };
+    for (uint32_t i = 0; i + 4 <= n; i += 4) {
+        int32_t l0 = x[i] + x[i + 1];
+        int32_t h0 = x[i] - x[i + 1];
+        int32_t l1 = x[i + 2] + x[i + 3];
+        int32_t h1 = x[i + 2] - x[i + 3];
+        int32_t b0 = l0 + l1;
+        int32_t b1 = l0 - l1;
+        int32_t b2 = h0 - h1;
+        int32_t b3 = h0 + h1;
+        band[0] += (uint64_t)((int64_t)b0 * b0);
+        band[1] += (uint64_t)((int64_t)b1 * b1);
+        band[2] += (uint64_t)((int64_t)b2 * b2);
+        band[3] += (uint64_t)((int64_t)b3 * b3);
+    }
+    if (n < 4) {
+        return vad->speech;
+    }
+
+    // Преобразование сохраняет энергию с множителем 4: приводим к LSB^2 на отсчет.
+    // Вместо 64-битного деления (вызов libgcc на Xtensa) - умножение на 2^16 / n
+    uint32_t recip = 65536 / n;
+    uint64_t total = 0;
+    int32_t log_sum = 0;
+    for (int k = 0; k < VAD_BANDS; k++) {
+        band[k] = ((band[k] >> 2) * recip) >> 16;
+        total += band[k];
+        log_sum += log2_q8(band[k] + 1);
+    }
+    int32_t flat = log_sum / VAD_BANDS - log2_q8(total / VAD_BANDS + 1);
+    vad->frames++;
+
+    if (vad->warmup_left > 0) {
+        // Начальная оценка шума - минимум по первым кадрам
+        for (int k = 0; k < VAD_BANDS; k++) {
+            if (vad->frames == 1 || band[k] < vad->noise[k]) {
+                vad->noise[k] = band[k];
+            }
+        }
+        vad->noise_flat = flat;
+        vad->warmup_left = vad->warmup_left > n ? vad->warmup_left - n : 0;
+        vad->speech = true;
+        vad->speech_frames++;
+        return true;
+    }
+
+    int32_t snr = 0;
+    for (int k = 0; k < VAD_BANDS; k++) {
+        int32_t d = log2_q8(band[k] + 1) - log2_q8(vad->noise[k] + 1);
+        snr += d < 0 ? 0 : (d > VAD_SNR_MAX ? VAD_SNR_MAX : d);
+    }
+    snr /= VAD_BANDS;
+
+    bool active = total >= VAD_MIN_ENERGY &&
+                  (snr >= VAD_SNR_HIGH || (snr >= VAD_SNR_LOW && flat < vad->noise_flat - VAD_FLAT_MARGIN));
+
+    // Шум: быстро вниз, медленно вверх в паузах (не больше ~3% за кадр, чтобы
+    // нарастание речи не утаскивало оценку за собой), еле заметно вверх во
+    // время речи и hangover (иначе резко выросший шум навсегда считался бы речью)
+    for (int k = 0; k < VAD_BANDS; k++) {
+        uint64_t nk = vad->noise[k];
+        if (band[k] < nk) {
+            nk -= (nk - band[k]) >> 3;
+        } else if (!active && vad->hang_left == 0) {
+            uint64_t up = (band[k] - nk) >> 4;
+            uint64_t cap = (nk >> 5) + 1;
+            nk += up < cap ? up : cap;
+        } else {
+            nk += (nk >> 9) + 1;
+        }
+        vad->noise[k] = nk;
+    }
+
+    if (!active) {
+        vad->noise_flat += (flat - vad->noise_flat) >> 3;
+    }
+
+    if (active) {
+        vad->hang_left = vad->hang_samples;
+        vad->speech = true;
+    } else {
+        vad->speech = vad->hang_left > 0;
+        vad->hang_left = vad->hang_left > n ? vad->hang_left - n : 0;
+    }
+    if (vad->speech) {
+        vad->speech_frames++;
+    }
+    return vad->speech;
+}
+
+uint32_t vad_noise_rms(const vad_t *vad)
+{
+    uint64_t total = 0;
+    for (int k = 0; k < VAD_BANDS; k++) {
+        total += vad->noise[k];
+    }
+    return isqrt32(total > UINT32_MAX ? UINT32_MAX : (uint32_t)total);
+}
@@ -0,0 +1,57 @@
+#ifndef VAD_H
+#define VAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VAD_BANDS          4      // Полосы двухуровневого разложения Хаара
+#define VAD_HANGOVER_MS    200    // Речь держится после последнего речевого кадра
+#define VAD_WARMUP_MS      100    // Начальная оценка шума: кадры считаются речью
+
+/*
+ * Детектор речи в фиксированной точке для кадров SCO (60..240 отсчетов,
+ * кратно 4). Признаки: превышение энергии над оценкой шума по четырем
+ * полосам и спектральная плоскостность (отношение геометрического и
+ * арифметического среднего энергий полос) - шум плоский, речь нет.
+ * Логарифмы считаются в log2 с 8 дробными битами.
+ */
+
+typedef struct {
+    uint64_t noise[VAD_BANDS];      // Оценка энергии шума по полосам, LSB^2 на отсчет
+    int32_t noise_flat;             // Плоскостность шума, log2 Q8 (<= 0)
+    uint32_t hang_samples;
+    uint32_t hang_left;             // Отсчетов до окончания hangover
+    uint32_t warmup_left;           // Отсчетов до конца начальной оценки шума
+    bool speech;                    // Решение по последнему кадру
+    uint32_t frames;
+    uint32_t speech_frames;
+} vad_t;
+
+/**
+ * @brief Инициализация детектора
+ * @param sample_rate Частота потока (задает длительность hangover)
+ */
+void vad_init(vad_t *vad, uint32_t sample_rate);
+
+/**
+ * @brief Классификация кадра
+ * @param x Отсчеты кадра
+ * @param n Количество отсчетов (кратно 4)
+ * @return true - речь (включая hangover), false - пауза
+ */
+bool vad_process(vad_t *vad, const int16_t *x, uint32_t n);
+
+/**
+ * @brief Уровень шума (среднеквадратичное значение, LSB)
+ */
+uint32_t vad_noise_rms(const vad_t *vad);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VAD_H */
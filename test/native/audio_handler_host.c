@@ -0,0 +1,14 @@
+#include "audio_handler.h"
+
+// Хостовая замена состояния audio_handler для модулей, которые его спрашивают
+// (loopback): SCO открыт, CVSD 8 кГц. Кадры тракта подает сам тест через audio_worker
+
+bool audio_handler_is_connected(void)
+{
+    return true;
+}
+
+uint32_t audio_handler_get_sample_rate(void)
+{
+    return 8000;
+}
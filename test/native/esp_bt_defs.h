@@ -0,0 +1,23 @@
+#ifndef ESP_BT_DEFS_H
+#define ESP_BT_DEFS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Хостовая замена esp_bt_defs.h: адрес устройства и его формат в логах
+
+#define ESP_BD_ADDR_LEN     6
+
+typedef uint8_t esp_bd_addr_t[ESP_BD_ADDR_LEN];
+
+#define ESP_BD_ADDR_STR         "%02x:%02x:%02x:%02x:%02x:%02x"
+#define ESP_BD_ADDR_HEX(addr)   addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_BT_DEFS_H */
@@ -0,0 +1,18 @@
+#ifndef ESP_CPU_H
+#define ESP_CPU_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Хостовая замена esp_cpu.h для процессоров без TSC: "такт" - наносекунда
+
+uint32_t esp_cpu_get_cycle_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_CPU_H */
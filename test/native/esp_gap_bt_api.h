@@ -0,0 +1,9 @@
+#ifndef ESP_GAP_BT_API_H
+#define ESP_GAP_BT_API_H
+
+#include "esp_err.h"
+#include "esp_bt_defs.h"
+
+// Хостовая замена esp_gap_bt_api.h: модулям без стека нужен только esp_bt_defs.h
+
+#endif /* ESP_GAP_BT_API_H */
@@ -0,0 +1,26 @@
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MALLOC_CAP_8BIT      (1 << 2)
+#define MALLOC_CAP_INTERNAL  (1 << 11)
+#define MALLOC_CAP_SPIRAM    (1 << 10)
+
+#define heap_caps_malloc(size, caps)         malloc(size)
+#define heap_caps_calloc(n, size, caps)      calloc((n), (size))
+#define heap_caps_free(ptr)                  free(ptr)
+
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_HEAP_CAPS_H */
@@ -0,0 +1,10 @@
+#ifndef ESP_HF_AG_API_H
+#define ESP_HF_AG_API_H
+
+#include "esp_err.h"
+#include "esp_bt_defs.h"
+#include "esp_hf_defs.h"
+
+// Хостовая замена esp_hf_ag_api.h: заголовки модулей включают ее, API стека на хосте нет
+
+#endif /* ESP_HF_AG_API_H */
@@ -0,0 +1,31 @@
+#ifndef ESP_HF_DEFS_H
+#define ESP_HF_DEFS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Хостовая замена esp_hf_defs.h: только состояния, которые нужны модулям без стека
+
+typedef enum {
+    ESP_HF_CONNECTION_STATE_DISCONNECTED = 0,
+    ESP_HF_CONNECTION_STATE_CONNECTING,
+    ESP_HF_CONNECTION_STATE_CONNECTED,
+    ESP_HF_CONNECTION_STATE_SLC_CONNECTED,
+    ESP_HF_CONNECTION_STATE_DISCONNECTING,
+} esp_hf_connection_state_t;
+
+typedef enum {
+    ESP_HF_AUDIO_STATE_DISCONNECTED = 0,
+    ESP_HF_AUDIO_STATE_CONNECTING,
+    ESP_HF_AUDIO_STATE_CONNECTED,
+    ESP_HF_AUDIO_STATE_CONNECTED_MSBC,
+} esp_hf_audio_state_t;
+
+#define ESP_HF_PEER_FEAT_CODEC      0x200   // Согласование кодека (AT+BRSF)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_HF_DEFS_H */
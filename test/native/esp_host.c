@@ -0,0 +1,263 @@
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_spiffs.h"
+#include "driver/uart.h"
+#include "nvs.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+// Хостовые реализации служб ESP-IDF, которые используют модули под тестом
+
+static int64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return monotonic_ns() / 1000;
+}
+
+uint32_t esp_log_timestamp(void)
+{
+    return (uint32_t)(monotonic_ns() / 1000000);
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+    return (uint32_t)monotonic_ns();
+}
+
+uint32_t esp_get_free_heap_size(void)
+{
+    return 200 * 1024;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    return 200 * 1024;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return 100 * 1024;
+}
+
+esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t *conf)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_spiffs_info(const char *partition_label, size_t *total, size_t *used)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static uart_host_writer_t s_uart_writer = NULL;
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags)
+{
+    return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config)
+{
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num)
+{
+    return ESP_OK;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size)
+{
+    uart_host_writer_t writer = __atomic_load_n(&s_uart_writer, __ATOMIC_ACQUIRE);
+    if (writer != NULL) {
+        writer(uart_num, src, size);
+    }
+    return (int)size;
+}
+
+void uart_host_set_writer(uart_host_writer_t writer)
+{
+    __atomic_store_n(&s_uart_writer, writer, __ATOMIC_RELEASE);
+}
+
+// NVS: пространство имен - номер дескриптора, ключ - строка, значение - копия blob
+#define NVS_HOST_NAMESPACES   8
+#define NVS_HOST_ENTRIES      64
+#define NVS_HOST_NAME_LEN     16    // Как у NVS: 15 символов и ноль
+
+typedef struct {
+    nvs_handle_t handle;            // 0 - свободно
+    char key[NVS_HOST_NAME_LEN];
+    void *value;
+    size_t length;
+} nvs_host_entry_t;
+
+static pthread_mutex_t s_nvs_lock = PTHREAD_MUTEX_INITIALIZER;
+static char s_nvs_namespaces[NVS_HOST_NAMESPACES][NVS_HOST_NAME_LEN];
+static nvs_host_entry_t s_nvs_entries[NVS_HOST_ENTRIES];
+
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    if (strlen(namespace_name) >= NVS_HOST_NAME_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    pthread_mutex_lock(&s_nvs_lock);
+    for (int i = 0; i < NVS_HOST_NAMESPACES; i++) {
+        if (s_nvs_namespaces[i][0] == '\0') {
+            strcpy(s_nvs_namespaces[i], namespace_name);
+        }
+        if (strcmp(s_nvs_namespaces[i], namespace_name) == 0) {
+            *out_handle = (nvs_handle_t)(i + 1);
+            err = ESP_OK;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_nvs_lock);
+    return err;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+}
+
+// Вызывается под s_nvs_lock
+static nvs_host_entry_t *nvs_host_find(nvs_handle_t handle, const char *key)
+{
+    for (int i = 0; i < NVS_HOST_ENTRIES; i++) {
+        if (s_nvs_entries[i].handle == handle && strcmp(s_nvs_entries[i].key, key) == 0) {
+            return &s_nvs_entries[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    esp_err_t err = ESP_OK;
+    pthread_mutex_lock(&s_nvs_lock);
+    nvs_host_entry_t *e = nvs_host_find(handle, key);
+    if (e == NULL) {
+        err = ESP_ERR_NVS_NOT_FOUND;
+    } else if (out_value == NULL) {
+        *length = e->length;
+    } else if (*length < e->length) {
+        err = ESP_ERR_NVS_INVALID_LENGTH;
+    } else {
+        memcpy(out_value, e->value, e->length);
+        *length = e->length;
+    }
+    pthread_mutex_unlock(&s_nvs_lock);
+    return err;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    if (strlen(key) >= NVS_HOST_NAME_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    void *copy = malloc(length > 0 ? length : 1);
+    if (copy == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(copy, value, length);
+    esp_err_t err = ESP_OK;
+    pthread_mutex_lock(&s_nvs_lock);
+    nvs_host_entry_t *e = nvs_host_find(handle, key);
+    if (e == NULL) {
+        e = nvs_host_find(0, "");
+    }
+    if (e == NULL) {
+        err = ESP_ERR_NO_MEM;
+        free(copy);
+    } else {
+        free(e->value);
+        e->handle = handle;
+        strcpy(e->key, key);
+        e->value = copy;
+        e->length = length;
+    }
+    pthread_mutex_unlock(&s_nvs_lock);
+    return err;
+}
+
+// Вызывается под s_nvs_lock
+static void nvs_host_erase(nvs_host_entry_t *e)
+{
+    free(e->value);
+    memset(e, 0, sizeof(*e));
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    pthread_mutex_lock(&s_nvs_lock);
+    nvs_host_entry_t *e = nvs_host_find(handle, key);
+    if (e != NULL) {
+        nvs_host_erase(e);
+    }
+    pthread_mutex_unlock(&s_nvs_lock);
+    return e != NULL ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle)
+{
+    pthread_mutex_lock(&s_nvs_lock);
+    for (int i = 0; i < NVS_HOST_ENTRIES; i++) {
+        if (s_nvs_entries[i].handle == handle) {
+            nvs_host_erase(&s_nvs_entries[i]);
+        }
+    }
+    pthread_mutex_unlock(&s_nvs_lock);
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    return ESP_OK;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+        return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE:
+        return "ESP_ERR_INVALID_RESPONSE";
+    case ESP_ERR_INVALID_CRC:
+        return "ESP_ERR_INVALID_CRC";
+    case ESP_ERR_NVS_NOT_FOUND:
+        return "ESP_ERR_NVS_NOT_FOUND";
+    case ESP_ERR_NVS_INVALID_LENGTH:
+        return "ESP_ERR_NVS_INVALID_LENGTH";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Хостовая замена esp_log.h: формат строки как у ESP-IDF, DEBUG и VERBOSE
+// проверяются компилятором, но не печатаются (HOST_LOG_DEBUG=1 включает)
+
+#ifndef HOST_LOG_DEBUG
+#define HOST_LOG_DEBUG 0
+#endif
+
+uint32_t esp_log_timestamp(void);
+
+#define HOST_LOG(letter, tag, format, ...) \
+    printf(letter " (%" PRIu32 ") %s: " format "\n", esp_log_timestamp(), tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, format, ...) HOST_LOG("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) HOST_LOG("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) HOST_LOG("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) do { if (HOST_LOG_DEBUG) HOST_LOG("D", tag, format, ##__VA_ARGS__); } while (0)
+#define ESP_LOGV(tag, format, ...) do { if (HOST_LOG_DEBUG) HOST_LOG("V", tag, format, ##__VA_ARGS__); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_LOG_H */
@@ -0,0 +1,59 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Хостовое зеркало FreeRTOS из ESP-IDF (SMP, два ядра) на pthreads.
+ * Критическая секция - мьютекс своего portMUX со счетчиком вложенности, как
+ * спинлок ядра: она исключает другие потоки с тем же portMUX, но не все остальные.
+ */
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFF)
+#define configTICK_RATE_HZ      CONFIG_FREERTOS_HZ      // Тик цели: 10 мс
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define portNUM_PROCESSORS      CONFIG_FREERTOS_NUMBER_OF_CORES
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_t owner;
+    uint32_t count;             // Вложенность у владельца
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED  { PTHREAD_MUTEX_INITIALIZER, 0, 0 }
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+
+#define portENTER_CRITICAL(mux)       vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)        vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)   portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux)    portEXIT_CRITICAL(mux)
+#define taskENTER_CRITICAL(mux)       portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux)        portEXIT_CRITICAL(mux)
+
+// Ядро, к которому привязана текущая задача (поток вне задач - ядро 0)
+BaseType_t xPortGetCoreID(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREERTOS_H */
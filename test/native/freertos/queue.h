@@ -0,0 +1,29 @@
+#ifndef FREERTOS_QUEUE_H
+#define FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Очередь - кольцо копий элементов под мьютексом pthread с условной переменной
+
+typedef struct QueueDefinition *QueueHandle_t;
+
+#define errQUEUE_FULL   ((BaseType_t)0)
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#define xQueueSendToBack(queue, item, ticks)    xQueueSend((queue), (item), (ticks))
+#define xQueueSendFromISR(queue, item, woken)   ((void)(woken), xQueueSend((queue), (item), 0))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREERTOS_QUEUE_H */
@@ -0,0 +1,53 @@
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+#include <sched.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Задачи - потоки pthread, уведомления - значение и флаг под мьютексом
+ * задачи, как в FreeRTOS. Приоритеты и размер стека не моделируются;
+ * привязка к ядру задает только номер ядра, который видит xPortGetCoreID().
+ */
+
+typedef struct tskTaskControlBlock *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+#define tskNO_AFFINITY  ((BaseType_t)0x7FFFFFFF)
+#define taskYIELD()     ((void)sched_yield())
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *handle, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+
+#define xTaskNotifyGive(task)                   xTaskNotify((task), 0, eIncrement)
+#define vTaskNotifyGiveFromISR(task, woken)     ((void)(woken), (void)xTaskNotifyGive(task))
+#define xTaskNotifyFromISR(task, v, a, woken)   ((void)(woken), xTaskNotify((task), (v), (a)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREERTOS_TASK_H */
@@ -0,0 +1,411 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Хостовое зеркало FreeRTOS на pthreads (см. freertos/FreeRTOS.h и freertos/task.h)
+
+struct tskTaskControlBlock {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify_value;
+    bool notify_pending;
+    BaseType_t core;
+    TaskFunction_t fn;
+    void *arg;
+};
+
+// Семафор - очередь без элементов: count - 0 или 1
+struct QueueDefinition {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t length;
+    uint32_t item_size;
+    uint32_t head;              // Индекс самого старого элемента
+    uint8_t *items;
+};
+
+static __thread struct tskTaskControlBlock *s_current = NULL;
+
+void vPortEnterCritical(portMUX_TYPE *mux)
+{
+    // owner сравнивается только с собой: свое значение поток видит всегда.
+    // Чужой поток читает count и owner без мьютекса, поэтому оба поля атомарные
+    if (__atomic_load_n(&mux->count, __ATOMIC_RELAXED) > 0 &&
+        pthread_equal(__atomic_load_n(&mux->owner, __ATOMIC_RELAXED), pthread_self())) {
+        __atomic_add_fetch(&mux->count, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    pthread_mutex_lock(&mux->mutex);
+    __atomic_store_n(&mux->owner, pthread_self(), __ATOMIC_RELAXED);
+    __atomic_store_n(&mux->count, 1, __ATOMIC_RELAXED);
+}
+
+void vPortExitCritical(portMUX_TYPE *mux)
+{
+    if (__atomic_sub_fetch(&mux->count, 1, __ATOMIC_RELAXED) == 0) {
+        pthread_mutex_unlock(&mux->mutex);
+    }
+}
+
+static void cond_init_monotonic(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static struct tskTaskControlBlock *tcb_new(TaskFunction_t fn, void *arg, BaseType_t core)
+{
+    struct tskTaskControlBlock *t = calloc(1, sizeof(*t));
+    if (t == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&t->lock, NULL);
+    cond_init_monotonic(&t->cond);
+    t->core = core == tskNO_AFFINITY ? 0 : core;
+    t->fn = fn;
+    t->arg = arg;
+    return t;
+}
+
+static void *task_entry(void *arg)
+{
+    s_current = arg;
+    s_current->fn(s_current->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *handle, BaseType_t core)
+{
+    struct tskTaskControlBlock *t = tcb_new(fn, arg, core);
+    if (t == NULL) {
+        return pdFAIL;
+    }
+    // Как во FreeRTOS, дескриптор записан до первого шага задачи: она может сразу им пользоваться
+    if (handle != NULL) {
+        *handle = t;
+    }
+    if (pthread_create(&t->thread, NULL, task_entry, t) != 0) {
+        if (handle != NULL) {
+            *handle = NULL;
+        }
+        free(t);
+        return pdFAIL;
+    }
+    pthread_detach(t->thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // Поток завершает только себя; TCB остается: на него могут ссылаться чужие уведомления
+    if (task == NULL || task == s_current) {
+        pthread_exit(NULL);
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    usleep((useconds_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(((uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000) / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    // Поток теста становится задачей при первом обращении: ему тоже можно слать уведомления
+    if (s_current == NULL) {
+        s_current = tcb_new(NULL, NULL, 0);
+        s_current->thread = pthread_self();
+    }
+    return s_current;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    return 0;
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+    return s_current != NULL ? s_current->core : 0;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    BaseType_t ret = pdPASS;
+    pthread_mutex_lock(&task->lock);
+    switch (action) {
+    case eSetBits:
+        task->notify_value |= value;
+        break;
+    case eIncrement:
+        task->notify_value++;
+        break;
+    case eSetValueWithOverwrite:
+        task->notify_value = value;
+        break;
+    case eSetValueWithoutOverwrite:
+        if (task->notify_pending) {
+            ret = pdFAIL;
+        } else {
+            task->notify_value = value;
+        }
+        break;
+    default:
+        break;
+    }
+    task->notify_pending = true;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return ret;
+}
+
+static struct timespec deadline_after(TickType_t ticks)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000;
+    deadline.tv_sec += (time_t)(ns / 1000000000);
+    deadline.tv_nsec += (long)(ns % 1000000000);
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    return deadline;
+}
+
+// Ожидание под мьютексом задачи, пока ready() не истинно; false - таймаут
+static bool notify_wait(struct tskTaskControlBlock *t, bool (*ready)(const struct tskTaskControlBlock *),
+                        TickType_t ticks)
+{
+    struct timespec deadline = deadline_after(ticks);
+
+    while (!ready(t)) {
+        if (ticks == 0) {
+            return false;
+        }
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(&t->cond, &t->lock);
+        } else if (pthread_cond_timedwait(&t->cond, &t->lock, &deadline) == ETIMEDOUT) {
+            return ready(t);
+        }
+    }
+    return true;
+}
+
+static bool notify_is_pending(const struct tskTaskControlBlock *t)
+{
+    return t->notify_pending;
+}
+
+static bool notify_is_nonzero(const struct tskTaskControlBlock *t)
+{
+    return t->notify_value != 0;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t ticks)
+{
+    struct tskTaskControlBlock *t = xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&t->lock);
+    if (!t->notify_pending) {
+        t->notify_value &= ~clear_on_entry;
+    }
+    bool got = notify_wait(t, notify_is_pending, ticks);
+    if (value != NULL) {
+        *value = t->notify_value;
+    }
+    if (got) {
+        t->notify_value &= ~clear_on_exit;
+    }
+    t->notify_pending = false;
+    pthread_mutex_unlock(&t->lock);
+    return got ? pdTRUE : pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct tskTaskControlBlock *t = xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&t->lock);
+    notify_wait(t, notify_is_nonzero, ticks);
+    uint32_t value = t->notify_value;
+    if (value != 0) {
+        t->notify_value = clear_on_exit ? 0 : value - 1;
+    }
+    t->notify_pending = false;
+    pthread_mutex_unlock(&t->lock);
+    return value;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    struct QueueDefinition *sem = calloc(1, sizeof(*sem));
+    if (sem == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&sem->lock, NULL);
+    cond_init_monotonic(&sem->cond);
+    return sem;
+}
+
+// Без наследования приоритета: приоритеты зеркало не моделирует
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    if (sem != NULL) {
+        sem->count = 1;
+    }
+    return sem;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->lock);
+    free(sem);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    BaseType_t ret = pdFAIL;
+    pthread_mutex_lock(&sem->lock);
+    if (sem->count == 0) {
+        sem->count = 1;
+        pthread_cond_signal(&sem->cond);
+        ret = pdPASS;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ret;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    struct timespec deadline = deadline_after(ticks);
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0 && ticks != 0) {
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(&sem->cond, &sem->lock);
+        } else if (pthread_cond_timedwait(&sem->cond, &sem->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    BaseType_t ret = pdFAIL;
+    if (sem->count != 0) {
+        sem->count = 0;
+        ret = pdPASS;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ret;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct QueueDefinition *queue = calloc(1, sizeof(*queue));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->items = calloc(length, item_size);
+    if (queue->items == NULL) {
+        free(queue);
+        return NULL;
+    }
+    queue->length = length;
+    queue->item_size = item_size;
+    pthread_mutex_init(&queue->lock, NULL);
+    cond_init_monotonic(&queue->cond);
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    free(queue->items);
+    vSemaphoreDelete(queue);
+}
+
+static bool queue_has_space(const struct QueueDefinition *queue)
+{
+    return queue->count < queue->length;
+}
+
+static bool queue_has_items(const struct QueueDefinition *queue)
+{
+    return queue->count > 0;
+}
+
+// Ожидание под мьютексом очереди, пока ready() не истинно; false - таймаут.
+// Отправители и получатели ждут на одной условной переменной: будятся все
+static bool queue_wait(struct QueueDefinition *queue, bool (*ready)(const struct QueueDefinition *),
+                       TickType_t ticks)
+{
+    struct timespec deadline = deadline_after(ticks);
+
+    while (!ready(queue)) {
+        if (ticks == 0) {
+            return false;
+        }
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(&queue->cond, &queue->lock);
+        } else if (pthread_cond_timedwait(&queue->cond, &queue->lock, &deadline) == ETIMEDOUT) {
+            return ready(queue);
+        }
+    }
+    return true;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    pthread_mutex_lock(&queue->lock);
+    bool ok = queue_wait(queue, queue_has_space, ticks);
+    if (ok) {
+        uint32_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(queue->items + (size_t)tail * queue->item_size, item, queue->item_size);
+        queue->count++;
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ok ? pdTRUE : errQUEUE_FULL;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    pthread_mutex_lock(&queue->lock);
+    bool ok = queue_wait(queue, queue_has_items, ticks);
+    if (ok) {
+        memcpy(item, queue->items + (size_t)queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
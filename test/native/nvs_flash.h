@@ -0,0 +1,8 @@
+#ifndef NVS_FLASH_H
+#define NVS_FLASH_H
+
+#include "nvs.h"
+
+// Хостовая замена nvs_flash.h: раздел не монтируется, хранилище - память процесса (nvs.h)
+
+#endif /* NVS_FLASH_H */
@@ -0,0 +1,8 @@
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+// Значения из sdkconfig.defaults, которые читают модули под тестом
+#define CONFIG_FREERTOS_HZ                  100
+#define CONFIG_FREERTOS_NUMBER_OF_CORES     2
+
+#endif /* SDKCONFIG_H */
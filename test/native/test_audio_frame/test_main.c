@@ -0,0 +1,114 @@
+#include <unity.h>
+#include <string.h>
+#include <unistd.h>
+#include "audio_frame.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/*
+ * Отписка потребителя против производителя на другом ядре: callback
+ * медленный, после возврата audio_frame_unsubscribe контекст считается
+ * освобожденным, и ни один кадр не должен дойти до него.
+ */
+
+typedef struct {
+    uint32_t freed;
+    uint32_t frames;
+    uint32_t after_free;
+} guarded_consumer_t;
+
+static uint32_t s_publishing;
+
+static void guarded_cb(audio_frame_t *frame, void *ctx)
+{
+    guarded_consumer_t *c = (guarded_consumer_t *)ctx;
+    __atomic_add_fetch(&c->frames, 1, __ATOMIC_RELAXED);
+    usleep(200);
+    if (__atomic_load_n(&c->freed, __ATOMIC_ACQUIRE)) {
+        __atomic_add_fetch(&c->after_free, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void count_cb(audio_frame_t *frame, void *ctx)
+{
+    __atomic_add_fetch((uint32_t *)ctx, 1, __ATOMIC_RELAXED);
+}
+
+static void publisher_task(void *arg)
+{
+    TaskHandle_t waiter = (TaskHandle_t)arg;
+    while (__atomic_load_n(&s_publishing, __ATOMIC_ACQUIRE)) {
+        audio_frame_t *frame = audio_frame_alloc(AUDIO_FRAME_RX);
+        if (frame != NULL) {
+            frame->count = 60;
+            audio_frame_publish(frame);
+        }
+    }
+    xTaskNotifyGive(waiter);
+    vTaskDelete(NULL);
+}
+
+void setUp(void)
+{
+    audio_frame_init();
+}
+
+void tearDown(void)
+{
+}
+
+static void test_publish_reaches_only_its_stream(void)
+{
+    uint32_t rx = 0;
+    uint32_t tx = 0;
+    int rx_id = -1;
+    int tx_id = -1;
+    TEST_ASSERT_EQUAL(ESP_OK, audio_frame_subscribe(AUDIO_FRAME_RX, count_cb, &rx, &rx_id));
+    TEST_ASSERT_EQUAL(ESP_OK, audio_frame_subscribe(AUDIO_FRAME_TX, count_cb, &tx, &tx_id));
+    for (int i = 0; i < 10; i++) {
+        audio_frame_publish(audio_frame_alloc(AUDIO_FRAME_RX));
+    }
+    audio_frame_unsubscribe(rx_id);
+    audio_frame_publish(audio_frame_alloc(AUDIO_FRAME_RX));
+    audio_frame_unsubscribe(tx_id);
+
+    TEST_ASSERT_EQUAL_UINT32(10, rx);
+    TEST_ASSERT_EQUAL_UINT32(0, tx);
+    uint32_t in_use = 0;
+    audio_frame_usage(&in_use, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, in_use);
+}
+
+static void test_unsubscribe_waits_for_running_callback(void)
+{
+    guarded_consumer_t consumer;
+    __atomic_store_n(&s_publishing, 1, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(publisher_task, "Pub", 4096, xTaskGetCurrentTaskHandle(),
+                                                      18, NULL, 1));
+    uint32_t frames = 0;
+    uint32_t after_free = 0;
+    for (int i = 0; i < 200; i++) {
+        memset(&consumer, 0, sizeof(consumer));
+        int id = -1;
+        TEST_ASSERT_EQUAL(ESP_OK, audio_frame_subscribe(AUDIO_FRAME_RX, guarded_cb, &consumer, &id));
+        usleep(100 + (i % 7) * 50);
+        audio_frame_unsubscribe(id);
+        __atomic_store_n(&consumer.freed, 1, __ATOMIC_RELEASE);
+        usleep(300);
+        after_free += __atomic_load_n(&consumer.after_free, __ATOMIC_RELAXED);
+        frames += __atomic_load_n(&consumer.frames, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&s_publishing, 0, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL_UINT32(1, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(2000)));
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, frames);
+    TEST_ASSERT_EQUAL_UINT32(0, after_free);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_publish_reaches_only_its_stream);
+    RUN_TEST(test_unsubscribe_waits_for_running_callback);
+    return UNITY_END();
+}
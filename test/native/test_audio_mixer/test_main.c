@@ -0,0 +1,347 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "audio_mixer.h"
+#include "dsp_kernels.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <unistd.h>
+
+#define RATE            16000
+#define FRAME           120     // Кадр mSBC: 7.5 мс при 16 кГц
+#define FRAME_US        7500
+#define NOISE_LEN       4096
+#define BENCH_FRAMES    4000    // 30 с звука на каждую конфигурацию
+#define BENCH_WARMUP    50
+
+// Источник-константа: проверки сумм без зависимости от фазы
+typedef struct {
+    int16_t value;
+    uint32_t limit;             // Сколько отсчетов выдать всего (0 - без конца)
+    uint32_t given;
+    uint32_t calls;
+} const_source_t;
+
+static uint32_t const_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    const_source_t *s = (const_source_t *)ctx;
+    s->calls++;
+    if (s->limit != 0) {
+        uint32_t left = s->limit - s->given;
+        samples = samples < left ? samples : left;
+    }
+    for (uint32_t i = 0; i < samples; i++) {
+        buf[i] = s->value;
+    }
+    s->given += samples;
+    return samples;
+}
+
+static int add_const(const_source_t *s, int16_t value, uint8_t priority, int32_t gain, int32_t duck_gain,
+                     uint32_t fade_in_ms, uint8_t flags)
+{
+    memset(s, 0, sizeof(*s));
+    s->value = value;
+    const audio_mixer_source_cfg_t cfg = {
+        .cb = const_cb,
+        .ctx = s,
+        .priority = priority,
+        .flags = flags,
+        .gain = gain,
+        .duck_gain = duck_gain,
+        .fade_in_ms = fade_in_ms,
+    };
+    int id = -1;
+    TEST_ASSERT_EQUAL(ESP_OK, audio_mixer_add_source(&cfg, &id));
+    return id;
+}
+
+static int16_t s_out[FRAME];
+
+void setUp(void)
+{
+    audio_mixer_init(RATE);
+}
+
+void tearDown(void)
+{
+}
+
+static void test_sum_and_saturation(void)
+{
+    const_source_t a, b, c;
+    add_const(&a, 1000, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0, 0);
+    add_const(&b, -300, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, audio_mixer_mix(s_out, FRAME));
+    for (int i = 0; i < FRAME; i++) {
+        TEST_ASSERT_EQUAL_INT16(700, s_out[i]);
+    }
+
+    // Три источника по 24000: сумма 72700 уходит в насыщение без переполнения
+    a.value = 24000;
+    b.value = 24000;
+    add_const(&c, 24000, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0, 0);
+    audio_mixer_mix(s_out, FRAME);
+    for (int i = 0; i < FRAME; i++) {
+        TEST_ASSERT_EQUAL_INT16(INT16_MAX, s_out[i]);
+    }
+    audio_mixer_stats_t stats;
+    audio_mixer_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(FRAME, stats.clipped);
+    TEST_ASSERT_EQUAL_UINT8(3, stats.active_sources);
+}
+
+static void test_fade_in_reaches_gain(void)
+{
+    const_source_t a;
+    add_const(&a, 16384, 0, AUDIO_MIXER_GAIN_UNITY / 2, AUDIO_MIXER_GAIN_UNITY, 10, 0);
+
+    // Рампа 10 мс = 160 отсчетов: растет монотонно и выходит точно на 8192
+    int16_t prev = 0;
+    for (int f = 0; f < 3; f++) {
+        audio_mixer_mix(s_out, FRAME);
+        for (int i = 0; i < FRAME; i++) {
+            TEST_ASSERT_TRUE(s_out[i] >= prev);
+            prev = s_out[i];
+        }
+    }
+    TEST_ASSERT_EQUAL_INT16(8192, s_out[FRAME - 1]);
+}
+
+static void test_ducking_by_priority(void)
+{
+    const_source_t bed, prompt;
+    add_const(&bed, 8000, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY / 4, 0, 0);
+    audio_mixer_mix(s_out, FRAME);
+    TEST_ASSERT_EQUAL_INT16(8000, s_out[0]);
+
+    // Приоритетный источник приглушает фон за AUDIO_MIXER_DUCK_RAMP_MS со следующего блока
+    add_const(&prompt, 1000, 5, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0, 0);
+    for (int f = 0; f < 6; f++) {
+        audio_mixer_mix(s_out, FRAME);
+    }
+    TEST_ASSERT_INT_WITHIN(2, 2000 + 1000, s_out[FRAME - 1]);
+}
+
+static void test_oneshot_and_fade_out_remove(void)
+{
+    const_source_t shot, tone;
+    int shot_id = add_const(&shot, 500, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0,
+                            AUDIO_MIXER_FLAG_ONESHOT);
+    shot.limit = FRAME + FRAME / 2;
+    int tone_id = add_const(&tone, 500, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0, 0);
+
+    audio_mixer_mix(s_out, FRAME);
+    TEST_ASSERT_TRUE(audio_mixer_is_active(shot_id));
+    audio_mixer_mix(s_out, FRAME);
+    TEST_ASSERT_FALSE(audio_mixer_is_active(shot_id));
+    TEST_ASSERT_EQUAL_INT16(1000, s_out[FRAME / 2 - 1]);
+    TEST_ASSERT_EQUAL_INT16(500, s_out[FRAME / 2]);
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_mixer_remove_source(tone_id, 15));
+    for (int f = 0; f < 3 && audio_mixer_is_active(tone_id); f++) {
+        audio_mixer_mix(s_out, FRAME);
+    }
+    TEST_ASSERT_FALSE(audio_mixer_is_active(tone_id));
+    TEST_ASSERT_EQUAL_INT16(0, s_out[FRAME - 1]);
+}
+
+// Подсказка, которая в своем callback удаляется и запускает следующую в тот же слот:
+// итог старой (выдала 0 при ONESHOT) не должен снять новую
+static const_source_t s_next;
+static int s_self_id = -1;
+static int s_next_id = -1;
+
+static uint32_t handover_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    (void)ctx;
+    audio_mixer_remove_source(s_self_id, 0);
+    s_next_id = add_const(&s_next, 321, 0, AUDIO_MIXER_GAIN_UNITY, AUDIO_MIXER_GAIN_UNITY, 0,
+                          AUDIO_MIXER_FLAG_ONESHOT);
+    return 0;
+}
+
+static void test_slot_reused_during_block(void)
+{
+    const audio_mixer_source_cfg_t cfg = {
+        .cb = handover_cb,
+        .ctx = NULL,
+        .flags = AUDIO_MIXER_FLAG_ONESHOT,
+        .gain = AUDIO_MIXER_GAIN_UNITY,
+        .duck_gain = AUDIO_MIXER_GAIN_UNITY,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, audio_mixer_add_source(&cfg, &s_self_id));
+    audio_mixer_mix(s_out, FRAME);
+
+    TEST_ASSERT_EQUAL(s_self_id, s_next_id);
+    TEST_ASSERT_TRUE(audio_mixer_is_active(s_next_id));
+    TEST_ASSERT_EQUAL_UINT32(0, s_next.calls);
+    audio_mixer_mix(s_out, FRAME);
+    TEST_ASSERT_EQUAL_UINT32(1, s_next.calls);
+    TEST_ASSERT_EQUAL_INT16(321, s_out[0]);
+}
+
+// Удаление с подтверждением: поток микширования на другом ядре, источник
+// медленный, после возврата audio_mixer_remove_source_sync его контекст "освобожден"
+typedef struct {
+    uint32_t freed;
+    uint32_t calls;
+    uint32_t after_free;
+} guarded_source_t;
+
+static uint32_t s_mixing;
+
+static uint32_t guarded_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    guarded_source_t *s = (guarded_source_t *)ctx;
+    __atomic_add_fetch(&s->calls, 1, __ATOMIC_RELAXED);
+    usleep(200);
+    if (__atomic_load_n(&s->freed, __ATOMIC_ACQUIRE)) {
+        __atomic_add_fetch(&s->after_free, 1, __ATOMIC_RELAXED);
+    }
+    memset(buf, 0, samples * sizeof(int16_t));
+    return samples;
+}
+
+static void mixing_task(void *arg)
+{
+    int16_t out[FRAME];
+    TaskHandle_t waiter = (TaskHandle_t)arg;
+    while (__atomic_load_n(&s_mixing, __ATOMIC_ACQUIRE)) {
+        audio_mixer_mix(out, FRAME);
+    }
+    xTaskNotifyGive(waiter);
+    vTaskDelete(NULL);
+}
+
+static void test_remove_sync_waits_for_mixing_thread(void)
+{
+    guarded_source_t src;
+    const audio_mixer_source_cfg_t cfg = {
+        .cb = guarded_cb,
+        .ctx = &src,
+        .gain = AUDIO_MIXER_GAIN_UNITY,
+        .duck_gain = AUDIO_MIXER_GAIN_UNITY,
+    };
+    __atomic_store_n(&s_mixing, 1, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(mixing_task, "Mix", 4096, xTaskGetCurrentTaskHandle(),
+                                                      18, NULL, 1));
+    uint32_t calls = 0;
+    uint32_t after_free = 0;
+    for (int i = 0; i < 200; i++) {
+        memset(&src, 0, sizeof(src));
+        int id = -1;
+        TEST_ASSERT_EQUAL(ESP_OK, audio_mixer_add_source(&cfg, &id));
+        usleep(100 + (i % 7) * 50);
+        TEST_ASSERT_EQUAL(ESP_OK, audio_mixer_remove_source_sync(id));
+        __atomic_store_n(&src.freed, 1, __ATOMIC_RELEASE);
+        usleep(300);
+        // Гонка с возвратом: один кадр поверх уже удаленного источника - и есть use-after-free
+        after_free += __atomic_load_n(&src.after_free, __ATOMIC_RELAXED);
+        calls += __atomic_load_n(&src.calls, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&s_mixing, 0, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL_UINT32(1, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(2000)));
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, calls);
+    TEST_ASSERT_EQUAL_UINT32(0, after_free);
+}
+
+// Источник шума для замера: своя фаза в общей таблице
+typedef struct {
+    const int16_t *table;
+    uint32_t pos;
+} noise_source_t;
+
+static int16_t s_noise[NOISE_LEN];
+
+static uint32_t noise_cb(void *ctx, int16_t *buf, uint32_t samples)
+{
+    noise_source_t *s = (noise_source_t *)ctx;
+    for (uint32_t done = 0; done < samples;) {
+        uint32_t n = NOISE_LEN - s->pos;
+        n = n < samples - done ? n : samples - done;
+        memcpy(buf + done, s->table + s->pos, n * sizeof(int16_t));
+        s->pos = (s->pos + n) % NOISE_LEN;
+        done += n;
+    }
+    return samples;
+}
+
+// Замер как у 'dsp bench': такты на отсчет x100 и доля реального времени кадра SCO.
+// Половина источников постоянно в рампе усиления - худший случай для внутреннего цикла
+static void test_bench_16k_up_to_8_sources(void)
+{
+    uint32_t seed = 0x2545F491;
+    for (int i = 0; i < NOISE_LEN; i++) {
+        seed = seed * 1664525 + 1013904223;
+        s_noise[i] = (int16_t)(seed >> 16) / 2;
+    }
+
+    char line[128];
+    snprintf(line, sizeof(line), "mixer bench: %d Hz, %d-sample frames, dsp backend %s",
+             RATE, FRAME, dsp_backend_name());
+    TEST_MESSAGE(line);
+
+    noise_source_t sources[AUDIO_MIXER_MAX_SOURCES];
+    int ids[AUDIO_MIXER_MAX_SOURCES];
+    for (int count = 1; count <= AUDIO_MIXER_MAX_SOURCES; count++) {
+        audio_mixer_init(RATE);
+        for (int k = 0; k < count; k++) {
+            sources[k].table = s_noise;
+            sources[k].pos = (uint32_t)(k * 509) % NOISE_LEN;
+            const audio_mixer_source_cfg_t cfg = {
+                .cb = noise_cb,
+                .ctx = &sources[k],
+                .priority = (uint8_t)k,
+                .gain = AUDIO_MIXER_GAIN_UNITY,
+                .duck_gain = AUDIO_MIXER_GAIN_UNITY / 2,
+                .fade_in_ms = 20,
+            };
+            TEST_ASSERT_EQUAL(ESP_OK, audio_mixer_add_source(&cfg, &ids[k]));
+        }
+        for (int f = 0; f < BENCH_WARMUP; f++) {
+            audio_mixer_mix(s_out, FRAME);
+        }
+
+        int64_t start_us = esp_timer_get_time();
+        uint32_t start_cc = dsp_cycle_count();
+        for (int f = 0; f < BENCH_FRAMES; f++) {
+            if (f % 64 == 0) {
+                for (int k = 0; k < count; k += 2) {
+                    audio_mixer_set_gain(ids[k], (f / 64) % 2 ? AUDIO_MIXER_GAIN_UNITY / 2 : AUDIO_MIXER_GAIN_UNITY, 30);
+                }
+            }
+            audio_mixer_mix(s_out, FRAME);
+        }
+        uint32_t cycles = dsp_cycle_count() - start_cc;
+        int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+        uint32_t per_sample = (uint32_t)(((uint64_t)cycles * 100) / ((uint64_t)BENCH_FRAMES * FRAME));
+        uint32_t ns_frame = (uint32_t)(elapsed_us * 1000 / BENCH_FRAMES);
+        audio_mixer_stats_t stats;
+        audio_mixer_get_stats(&stats);
+        snprintf(line, sizeof(line), "  %d sources: %3" PRIu32 ".%02" PRIu32 " cycles/sample, %5" PRIu32
+                 " ns/frame (%" PRIu32 ".%03" PRIu32 "%% of %d us), clipped %" PRIu32,
+                 count, per_sample / 100, per_sample % 100, ns_frame,
+                 ns_frame / 75 / 1000, ns_frame / 75 % 1000, FRAME_US, stats.clipped);
+        TEST_MESSAGE(line);
+        TEST_ASSERT_EQUAL_UINT8(count, stats.active_sources);
+    }
+}
+
+int main(void)
+{
+    dsp_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_sum_and_saturation);
+    RUN_TEST(test_fade_in_reaches_gain);
+    RUN_TEST(test_ducking_by_priority);
+    RUN_TEST(test_oneshot_and_fade_out_remove);
+    RUN_TEST(test_slot_reused_during_block);
+    RUN_TEST(test_remove_sync_waits_for_mixing_thread);
+    RUN_TEST(test_bench_16k_up_to_8_sources);
+    return UNITY_END();
+}
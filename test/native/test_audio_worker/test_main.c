@@ -0,0 +1,774 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "audio_worker.h"
+#include "audio_frame.h"
+#include "audio_mixer.h"
+#include "audio_tap.h"
+#include "call_qoe.h"
+#include "loopback.h"
+#include "metrics.h"
+#include "esp_timer.h"
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+/*
+ * Модель потоков задачи обработки на pthreads: тест играет роль HCI
+ * callbacks (ядро 0), задача AudioWorker работает в своем потоке. Кадр TX
+ * помечается номером сессии и порядковым номером, кадр RX - непрерывной
+ * пилой, поэтому потеря, повтор или перестановка видны по содержимому.
+ */
+
+#define WAIT_MS         2000
+#define STRESS_FRAMES   20000
+
+// Прием: пила должна продолжаться без разрывов через все кадры
+static uint32_t s_rx_next;
+static uint32_t s_rx_frames;
+static uint32_t s_rx_samples;
+static uint32_t s_rx_bad;
+static uint32_t s_rx_last_count;
+static bool s_rx_publish;           // Кадр RX уходит в пул на AUDIO_FRAME_RX_RAW, как в audio_handler
+static uint32_t s_rx_published;     // Опубликовано кадров: номер следующего кадра потока
+
+// Передача: samples[0] - номер кадра, samples[1] - сессия, остальное - номер кадра
+static uint32_t s_tx_seq;
+static uint32_t s_tx_calls;
+static int16_t s_session;
+static uint32_t s_tx_delay_us;
+static bool s_tx_mix;               // Кадр TX сводит микшер, как в audio_handler
+
+// Сессия качества, как в audio_handler: обработчики кормят ее кадрами, HCI - счетчиками
+static call_qoe_session_t s_qoe;
+static bool s_qoe_path;
+
+static void worker_rx(const int16_t *samples, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        if (samples[i] != (int16_t)s_rx_next) {
+            s_rx_bad++;
+        }
+        s_rx_next++;
+    }
+    s_rx_last_count = count;
+    s_rx_frames++;
+    if (__atomic_load_n(&s_qoe_path, __ATOMIC_RELAXED)) {
+        call_qoe_on_rx(&s_qoe, samples, count);
+    }
+    if (__atomic_load_n(&s_rx_publish, __ATOMIC_RELAXED)) {
+        audio_frame_t *frame = audio_frame_alloc(AUDIO_FRAME_RX_RAW);
+        if (frame != NULL) {
+            memcpy(frame->samples, samples, count * sizeof(int16_t));
+            frame->count = (uint16_t)count;
+            frame->sample_rate = 8000;
+            audio_frame_publish(frame);
+            __atomic_add_fetch(&s_rx_published, 1, __ATOMIC_RELEASE);
+        }
+    }
+    // Публикация последней: после acquire-чтения s_rx_samples тест видит остальные поля
+    __atomic_add_fetch(&s_rx_samples, count, __ATOMIC_RELEASE);
+}
+
+static void worker_tx(int16_t *samples, uint32_t count)
+{
+    uint32_t delay = __atomic_load_n(&s_tx_delay_us, __ATOMIC_RELAXED);
+    if (delay != 0) {
+        usleep(delay);
+    }
+    int16_t seq = (int16_t)s_tx_seq++;
+    for (uint32_t i = 0; i < count; i++) {
+        samples[i] = seq;
+    }
+    if (count > 1) {
+        samples[1] = __atomic_load_n(&s_session, __ATOMIC_RELAXED);
+    }
+    if (__atomic_load_n(&s_tx_mix, __ATOMIC_RELAXED)) {
+        audio_mixer_mix(samples, count);
+    }
+    // Для оценки эха - меандр постоянного уровня вместо номеров кадров
+    if (__atomic_load_n(&s_qoe_path, __ATOMIC_RELAXED)) {
+        for (uint32_t i = 0; i < count; i++) {
+            samples[i] = (i & 1) ? 8000 : -8000;
+        }
+        call_qoe_on_tx(&s_qoe, samples, count);
+    }
+    __atomic_add_fetch(&s_tx_calls, 1, __ATOMIC_RELEASE);
+}
+
+static bool wait_u32(const uint32_t *value, uint32_t target)
+{
+    for (int ms = 0; ms < WAIT_MS; ms++) {
+        if (__atomic_load_n(value, __ATOMIC_ACQUIRE) >= target) {
+            return true;
+        }
+        usleep(1000);
+    }
+    return false;
+}
+
+// Новая сессия: кадры старой сессии, подготовленные заранее, должны отброситься
+static void new_session(int16_t session, uint32_t frame_samples)
+{
+    __atomic_store_n(&s_session, session, __ATOMIC_RELAXED);
+    uint32_t calls = __atomic_load_n(&s_tx_calls, __ATOMIC_ACQUIRE);
+    audio_worker_start_session(frame_samples);
+    TEST_ASSERT_TRUE(wait_u32(&s_tx_calls, calls + AUDIO_WORKER_TX_AHEAD));
+}
+
+// Первый готовый кадр сессии (первый pop может опередить задачу)
+static void pop_first(int16_t *buf, uint32_t count)
+{
+    for (int i = 0; i < WAIT_MS; i++) {
+        if (audio_worker_pop_tx(buf, count)) {
+            return;
+        }
+        usleep(1000);
+    }
+    TEST_FAIL_MESSAGE("worker never produced a frame");
+}
+
+static void push_ramp(uint32_t *next, uint32_t count)
+{
+    int16_t buf[AUDIO_WORKER_FRAME_MAX * 2];
+    for (uint32_t i = 0; i < count; i++) {
+        buf[i] = (int16_t)(*next + i);
+    }
+    // Кольцо на 4 кадра: ждем задачу, а не теряем кадр
+    while (!audio_worker_push_rx(buf, count)) {
+        usleep(100);
+    }
+    *next += count;
+}
+
+// Вызывается, когда все отправленные кадры уже обработаны
+static void rx_reset(void)
+{
+    s_rx_next = 0;
+    s_rx_bad = 0;
+    s_rx_frames = 0;
+    __atomic_store_n(&s_rx_samples, 0, __ATOMIC_RELEASE);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    __atomic_store_n(&s_tx_delay_us, 0, __ATOMIC_RELAXED);
+}
+
+static void test_rx_frames_in_order(void)
+{
+    rx_reset();
+    uint32_t next = 0;
+    for (int i = 0; i < 500; i++) {
+        push_ramp(&next, 60);
+    }
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, next));
+    TEST_ASSERT_EQUAL_UINT32(500, s_rx_frames);
+    TEST_ASSERT_EQUAL_UINT32(0, s_rx_bad);
+}
+
+static void test_rx_oversized_buffer_is_split(void)
+{
+    rx_reset();
+    uint32_t next = 0;
+    push_ramp(&next, AUDIO_WORKER_FRAME_MAX + 60);
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, next));
+    // Ни один отсчет не обрезан: два кадра, 240 + 60
+    TEST_ASSERT_EQUAL_UINT32(2, s_rx_frames);
+    TEST_ASSERT_EQUAL_UINT32(60, s_rx_last_count);
+    TEST_ASSERT_EQUAL_UINT32(0, s_rx_bad);
+}
+
+static void test_tx_prepared_ahead_in_order(void)
+{
+    int16_t buf[120];
+    new_session(1, 120);
+    pop_first(buf, 120);
+    int16_t prev = buf[0];
+    for (int i = 0; i < 50; i++) {
+        usleep(2000);
+        TEST_ASSERT_TRUE(audio_worker_pop_tx(buf, 120));
+        TEST_ASSERT_EQUAL_INT16(1, buf[1]);
+        TEST_ASSERT_EQUAL_INT16((int16_t)(prev + 1), buf[0]);
+        TEST_ASSERT_EQUAL_INT16(buf[0], buf[119]);
+        prev = buf[0];
+    }
+
+    audio_worker_latency_t tx, rx;
+    audio_worker_get_latency(&tx, &rx);
+    TEST_ASSERT_EQUAL_UINT32(51, tx.frames);
+}
+
+static void test_new_session_drops_stale_frames(void)
+{
+    int16_t buf[120];
+    new_session(2, 120);
+    pop_first(buf, 120);
+
+    metric_t *stale = metrics_counter("audio.stale_frames");
+    uint32_t before = metrics_read(stale);
+    new_session(3, 60);
+    pop_first(buf, 60);
+    TEST_ASSERT_EQUAL_INT16(3, buf[1]);
+    TEST_ASSERT_GREATER_THAN_UINT32(before, metrics_read(stale));
+}
+
+static void test_tx_oversized_buffer_is_assembled(void)
+{
+    int16_t buf[AUDIO_WORKER_FRAME_MAX + 60];
+    new_session(4, AUDIO_WORKER_FRAME_MAX);
+    pop_first(buf, AUDIO_WORKER_FRAME_MAX);
+    usleep(5000);
+
+    // Два кадра кольца подряд, без тишины в хвосте
+    TEST_ASSERT_TRUE(audio_worker_pop_tx(buf, AUDIO_WORKER_FRAME_MAX + 60));
+    TEST_ASSERT_EQUAL_INT16(4, buf[1]);
+    TEST_ASSERT_EQUAL_INT16(4, buf[AUDIO_WORKER_FRAME_MAX + 1]);
+    TEST_ASSERT_EQUAL_INT16((int16_t)(buf[0] + 1), buf[AUDIO_WORKER_FRAME_MAX]);
+    TEST_ASSERT_EQUAL_INT16(buf[AUDIO_WORKER_FRAME_MAX], buf[AUDIO_WORKER_FRAME_MAX + 59]);
+}
+
+static void test_deadline_miss_when_worker_is_late(void)
+{
+    int16_t buf[120];
+    new_session(5, 120);
+    pop_first(buf, 120);
+
+    metric_t *miss = metrics_counter("audio.deadline_miss");
+    uint32_t before = metrics_read(miss);
+    __atomic_store_n(&s_tx_delay_us, 20000, __ATOMIC_RELAXED);
+    int served = 0;
+    for (int i = 0; i < 10; i++) {
+        served += audio_worker_pop_tx(buf, 120);
+        usleep(1000);
+    }
+    // Запас TX_AHEAD кадров съеден, дальше - тишина и пропуски
+    TEST_ASSERT_LESS_OR_EQUAL(AUDIO_WORKER_TX_AHEAD + 1, served);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(before + 10 - served, metrics_read(miss));
+    __atomic_store_n(&s_tx_delay_us, 0, __ATOMIC_RELAXED);
+    usleep(50000);
+}
+
+// Задание выполняется задачей обработки, а вызывающий ждет его конца
+typedef struct {
+    uint32_t runs;
+    BaseType_t core;
+    uint32_t tx_calls_before;
+    uint32_t tx_calls_after;
+} job_probe_t;
+
+static void probe_job(void *arg)
+{
+    job_probe_t *probe = (job_probe_t *)arg;
+    probe->tx_calls_before = __atomic_load_n(&s_tx_calls, __ATOMIC_ACQUIRE);
+    usleep(5000);
+    probe->runs++;
+    probe->core = xPortGetCoreID();
+    probe->tx_calls_after = __atomic_load_n(&s_tx_calls, __ATOMIC_ACQUIRE);
+}
+
+static void test_job_runs_on_worker_between_frames(void)
+{
+    int16_t buf[120];
+    job_probe_t probe = { 0 };
+    new_session(7, 120);
+    pop_first(buf, 120);
+    TEST_ASSERT_EQUAL(ESP_OK, audio_worker_run(probe_job, &probe, 1000));
+    TEST_ASSERT_EQUAL_UINT32(1, probe.runs);
+    TEST_ASSERT_EQUAL(AUDIO_WORKER_TASK_CORE, probe.core);
+    // Пока шло задание, кадры не формировались
+    TEST_ASSERT_EQUAL_UINT32(probe.tx_calls_before, probe.tx_calls_after);
+}
+
+// Задача обработки занята кадром дольше таймаута: задание отзывается и не выполняется позже,
+// когда его структура на стеке вызывающего уже не существует
+static void test_job_not_taken_is_withdrawn(void)
+{
+    int16_t buf[120];
+    job_probe_t probe = { 0 };
+    new_session(9, 120);
+    pop_first(buf, 120);
+
+    __atomic_store_n(&s_tx_delay_us, 100000, __ATOMIC_RELAXED);
+    uint32_t calls = __atomic_load_n(&s_tx_calls, __ATOMIC_ACQUIRE);
+    audio_worker_pop_tx(buf, 120);
+    usleep(10000);
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, audio_worker_run(probe_job, &probe, 20));
+    __atomic_store_n(&s_tx_delay_us, 0, __ATOMIC_RELAXED);
+    TEST_ASSERT_TRUE(wait_u32(&s_tx_calls, calls + 1));
+    usleep(50000);
+    TEST_ASSERT_EQUAL_UINT32(0, probe.runs);
+
+    // Следующее задание идет как обычно
+    TEST_ASSERT_EQUAL(ESP_OK, audio_worker_run(probe_job, &probe, 1000));
+    TEST_ASSERT_EQUAL_UINT32(1, probe.runs);
+}
+
+// Итог сессии и начало следующей - одно задание, как audio_qoe_job в audio_handler
+typedef struct {
+    bool begin;
+    esp_bd_addr_t bda;
+    bool have_rec;
+    call_qoe_record_t rec;
+} qoe_job_t;
+
+static void qoe_job(void *arg)
+{
+    qoe_job_t *job = (qoe_job_t *)arg;
+    audio_worker_latency_t tx_lat;
+    audio_worker_latency_t rx_lat;
+    audio_worker_get_latency(&tx_lat, &rx_lat);
+    job->have_rec = call_qoe_finish(&s_qoe, NULL, &tx_lat, &rx_lat, &job->rec);
+    if (job->begin) {
+        call_qoe_begin(&s_qoe, job->bda, AUDIO_CODEC_CVSD);
+    }
+}
+
+static void qoe_switch(qoe_job_t *job, bool begin, uint8_t id)
+{
+    memset(job, 0, sizeof(*job));
+    job->begin = begin;
+    job->bda[0] = 0x10;
+    job->bda[5] = id;
+    TEST_ASSERT_EQUAL(ESP_OK, audio_worker_run(qoe_job, job, 1000));
+}
+
+// Гарнитура в режиме петли: каждый выданный кадр возвращается на прием с затуханием 24 дБ
+static struct {
+    TaskHandle_t waiter;
+    bool stop;
+    uint32_t pushed;                // Отсчетов отдано на прием
+    uint32_t popped;                // Кадров снято с выдачи
+    uint32_t loud;                  // Из них не тишина
+} s_echo;
+
+static void echo_task(void *arg)
+{
+    int16_t buf[60];
+    while (!__atomic_load_n(&s_echo.stop, __ATOMIC_ACQUIRE)) {
+        call_qoe_count(&s_qoe.tx_frames);
+        if (audio_worker_pop_tx(buf, 60)) {
+            bool loud = false;
+            for (int i = 0; i < 60; i++) {
+                loud |= buf[i] != 0;
+                buf[i] >>= 4;
+            }
+            if (loud) {
+                __atomic_add_fetch(&s_echo.loud, 1, __ATOMIC_RELAXED);
+            }
+            __atomic_add_fetch(&s_echo.popped, 1, __ATOMIC_RELEASE);
+            if (audio_worker_push_rx(buf, 60)) {
+                call_qoe_count(&s_qoe.rx_frames);
+                __atomic_add_fetch(&s_echo.pushed, 60, __ATOMIC_RELAXED);
+            }
+        }
+        usleep(300);
+    }
+    xTaskNotifyGive(s_echo.waiter);
+    vTaskDelete(NULL);
+}
+
+// Сессию пишет только задача обработки: смена сессии на ходу не рвет ни счетчики,
+// ни оценку эха, каждый итог относится к своей гарнитуре
+static void test_qoe_session_switches_on_worker(void)
+{
+    qoe_job_t job;
+    rx_reset();
+    new_session(10, 60);
+    __atomic_store_n(&s_qoe_path, true, __ATOMIC_RELAXED);
+    qoe_switch(&job, true, 1);
+    TEST_ASSERT_FALSE(job.have_rec);
+
+    memset(&s_echo, 0, sizeof(s_echo));
+    s_echo.waiter = xTaskGetCurrentTaskHandle();
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(echo_task, "HciCb", 4096, NULL, 19, NULL, 0));
+
+    char msg[32];
+    for (uint8_t id = 1; id <= 4; id++) {
+        snprintf(msg, sizeof(msg), "session %u", id);
+        TEST_ASSERT_TRUE_MESSAGE(wait_u32(&s_qoe.tx_frames, 300), msg);
+        qoe_switch(&job, id < 4, (uint8_t)(id + 1));
+        TEST_ASSERT_TRUE_MESSAGE(job.have_rec, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(id, job.rec.bda[5], msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(AUDIO_CODEC_CVSD, job.rec.codec, msg);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(300, job.rec.tx_frames, msg);
+        TEST_ASSERT_GREATER_THAN_UINT32_MESSAGE(0, job.rec.rx_frames, msg);
+        // Прием считается после выдачи; сброс между ними переносит в новую сессию один кадр
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(job.rec.rx_frames, job.rec.tx_frames + 1, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(24, job.rec.erl_db, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, job.rec.mos_x100, msg);
+    }
+
+    __atomic_store_n(&s_echo.stop, true, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL_UINT32(1, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WAIT_MS)));
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, __atomic_load_n(&s_echo.pushed, __ATOMIC_RELAXED)));
+
+    // После итога сессия закрыта: кадры оценку эха не трогают, повторного итога нет
+    TEST_ASSERT_FALSE(s_qoe.active);
+    uint32_t erl_frames = s_qoe.erl_frames;
+    uint32_t next = 0;
+    rx_reset();
+    for (int i = 0; i < 10; i++) {
+        push_ramp(&next, 60);
+    }
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, next));
+    qoe_switch(&job, false, 0);
+    TEST_ASSERT_FALSE(job.have_rec);
+    TEST_ASSERT_EQUAL_UINT32(erl_frames, s_qoe.erl_frames);
+    __atomic_store_n(&s_qoe_path, false, __ATOMIC_RELAXED);
+}
+
+static bool wait_loopback_idle(uint32_t timeout_ms)
+{
+    for (uint32_t ms = 0; ms < timeout_ms; ms++) {
+        if (!loopback_running()) {
+            return true;
+        }
+        usleep(1000);
+    }
+    return false;
+}
+
+static void echo_skip(uint32_t frames)
+{
+    uint32_t popped = __atomic_load_n(&s_echo.popped, __ATOMIC_ACQUIRE);
+    TEST_ASSERT_TRUE(wait_u32(&s_echo.popped, popped + frames));
+}
+
+// Задача петли вышла: захват отписан, генератор удален из микшера
+static void assert_loopback_quiet(const char *msg)
+{
+    TEST_ASSERT_FALSE_MESSAGE(audio_frame_has_consumers(AUDIO_FRAME_RX_RAW), msg);
+    // Кадры, сведенные до удаления источника, еще лежат в кольце TX
+    echo_skip(AUDIO_WORKER_TX_AHEAD + 2);
+    uint32_t loud = __atomic_load_n(&s_echo.loud, __ATOMIC_RELAXED);
+    echo_skip(50);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(loud, __atomic_load_n(&s_echo.loud, __ATOMIC_RELAXED), msg);
+}
+
+// Измерение через петлю гарнитуры при живом трафике: остановка на любом этапе
+// возвращает буферы только после того, как микшер и захват вышли из callbacks
+static void test_loopback_stop_quiesces_path(void)
+{
+    rx_reset();
+    __atomic_store_n(&s_tx_mix, true, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_rx_publish, true, __ATOMIC_RELAXED);
+    new_session(11, 60);
+
+    memset(&s_echo, 0, sizeof(s_echo));
+    s_echo.waiter = xTaskGetCurrentTaskHandle();
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(echo_task, "HciCb", 4096, NULL, 19, NULL, 0));
+
+    // Первый громкий кадр - начало MLS; дальше остановки все глубже в измерение
+    char msg[32];
+    for (int i = 0; i < 4; i++) {
+        snprintf(msg, sizeof(msg), "stop %d", i);
+        uint32_t loud = __atomic_load_n(&s_echo.loud, __ATOMIC_RELAXED);
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, loopback_start(false), msg);
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_ERR_INVALID_STATE, loopback_start(false), msg);
+        TEST_ASSERT_TRUE_MESSAGE(wait_u32(&s_echo.loud, loud + 1), msg);
+        usleep(i * 5000);
+        TEST_ASSERT_TRUE_MESSAGE(loopback_running(), msg);
+        loopback_stop();
+        TEST_ASSERT_TRUE_MESSAGE(wait_loopback_idle(WAIT_MS), msg);
+        assert_loopback_quiet(msg);
+    }
+
+    // Измерение до конца: задача выходит сама и оставляет тракт таким же
+    TEST_ASSERT_EQUAL(ESP_OK, loopback_start(false));
+    TEST_ASSERT_TRUE(wait_loopback_idle(5 * WAIT_MS));
+    assert_loopback_quiet("complete");
+
+    __atomic_store_n(&s_echo.stop, true, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL_UINT32(1, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WAIT_MS)));
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, __atomic_load_n(&s_echo.pushed, __ATOMIC_RELAXED)));
+    __atomic_store_n(&s_rx_publish, false, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_tx_mix, false, __ATOMIC_RELAXED);
+}
+
+// Пакеты отвода, которые дошли до UART: точка, флаги и номер кадра из заголовка
+#define TAP_LOG_MAX     256
+
+typedef struct {
+    uint8_t point;
+    uint8_t flags;
+    uint32_t seq;
+} tap_packet_t;
+
+static tap_packet_t s_tap_log[TAP_LOG_MAX];
+static uint32_t s_tap_packets;
+static uint32_t s_uart_delay_us;
+
+// Перехватчик UART в задаче отвода: медленный канал держит очередь отвода полной
+static void tap_writer(uart_port_t uart_num, const void *src, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)src;
+    uint32_t delay = __atomic_load_n(&s_uart_delay_us, __ATOMIC_RELAXED);
+    if (delay != 0) {
+        usleep(delay);
+    }
+    uint32_t n = __atomic_load_n(&s_tap_packets, __ATOMIC_RELAXED);
+    if (size >= AUDIO_TAP_HEADER_SIZE && n < TAP_LOG_MAX) {
+        s_tap_log[n].point = p[3];
+        s_tap_log[n].flags = p[5];
+        s_tap_log[n].seq = p[12] | (uint32_t)p[13] << 8 | (uint32_t)p[14] << 16 | (uint32_t)p[15] << 24;
+    }
+    __atomic_store_n(&s_tap_packets, n + 1, __ATOMIC_RELEASE);
+}
+
+static uint32_t frames_in_use(void)
+{
+    uint32_t in_use = 0;
+    audio_frame_usage(&in_use, NULL, NULL);
+    return in_use;
+}
+
+// Остановка возвращает кадры очереди в пул и ждет задачу отвода: после нее в UART
+// ничего не уходит, и старые кадры не получают флаг START следующей сессии
+static void test_tap_stop_drains_queue_before_restart(void)
+{
+    uint32_t next = 0;
+    rx_reset();
+    __atomic_store_n(&s_tap_packets, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_uart_delay_us, 5000, __ATOMIC_RELAXED);
+    uart_host_set_writer(tap_writer);
+    __atomic_store_n(&s_rx_publish, true, __ATOMIC_RELAXED);
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_tap_start(AUDIO_TAP_MASK_RAW, AUDIO_TAP_CODEC_PCM));
+    for (int i = 0; i < 40; i++) {
+        push_ramp(&next, 60);
+    }
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, next));
+    // Канал на 5 мс пакет против кадров без пауз: очередь отвода держит кадры пула
+    TEST_ASSERT_GREATER_THAN_UINT32(0, frames_in_use());
+
+    audio_tap_stop();
+    TEST_ASSERT_EQUAL_UINT32(0, frames_in_use());
+    uint32_t written = __atomic_load_n(&s_tap_packets, __ATOMIC_ACQUIRE);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, written);
+    TEST_ASSERT_LESS_THAN_UINT32(40, written);
+    usleep(30000);
+    TEST_ASSERT_EQUAL_UINT32(written, __atomic_load_n(&s_tap_packets, __ATOMIC_ACQUIRE));
+
+    // Вторая сессия: в UART только ее кадры, START - у первого пакета
+    uint32_t first_seq = __atomic_load_n(&s_rx_published, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&s_tap_packets, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_uart_delay_us, 1000, __ATOMIC_RELAXED);
+    TEST_ASSERT_EQUAL(ESP_OK, audio_tap_start(AUDIO_TAP_MASK_RAW, AUDIO_TAP_CODEC_PCM));
+    for (int i = 0; i < 20; i++) {
+        push_ramp(&next, 60);
+    }
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, next));
+    audio_tap_stop();
+    __atomic_store_n(&s_rx_publish, false, __ATOMIC_RELAXED);
+    uart_host_set_writer(NULL);
+
+    written = __atomic_load_n(&s_tap_packets, __ATOMIC_ACQUIRE);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, written);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TAP_LOG_MAX, written);
+    char msg[48];
+    for (uint32_t i = 0; i < written; i++) {
+        snprintf(msg, sizeof(msg), "packet %" PRIu32, i);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(AUDIO_TAP_POINT_RAW, s_tap_log[i].point, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(i == 0 ? 0x02 : 0, s_tap_log[i].flags & 0x02, msg);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(first_seq, s_tap_log[i].seq, msg);
+        if (i > 0) {
+            TEST_ASSERT_GREATER_THAN_UINT32_MESSAGE(s_tap_log[i - 1].seq, s_tap_log[i].seq, msg);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, frames_in_use());
+}
+
+// Потребители пула со своими задачами: ссылка держится, пока кадр в очереди задачи
+#define REF_CONSUMERS   3
+#define REF_FRAMES      2000
+#define REF_QUEUE_LEN   8       // Три очереди держат больше кадров, чем есть в пуле
+
+typedef struct {
+    QueueHandle_t queue;
+    int id;
+    uint32_t frames;
+    uint32_t dropped;               // Очередь полна: ссылка возвращена сразу (пишет производитель)
+    uint32_t bad;
+} ref_consumer_t;
+
+static ref_consumer_t s_ref[REF_CONSUMERS];
+static TaskHandle_t s_ref_waiter;
+
+static void ref_cb(audio_frame_t *frame, void *ctx)
+{
+    ref_consumer_t *c = (ref_consumer_t *)ctx;
+    audio_frame_ref(frame);
+    if (xQueueSend(c->queue, &frame, 0) != pdTRUE) {
+        audio_frame_unref(frame);
+        c->dropped++;
+    }
+}
+
+// Кадр проверяется после паузы: если пул отдал его заново, пила внутри кадра рвется
+static void ref_task(void *arg)
+{
+    ref_consumer_t *c = (ref_consumer_t *)arg;
+    audio_frame_t *frame;
+    int16_t prev = 0;
+    while (xQueueReceive(c->queue, &frame, portMAX_DELAY) == pdTRUE && frame != NULL) {
+        usleep(1000);
+        bool ok = frame->count == 60 && frame->stream == AUDIO_FRAME_RX_RAW;
+        for (uint32_t i = 1; ok && i < frame->count; i++) {
+            ok = frame->samples[i] == (int16_t)(frame->samples[0] + i);
+        }
+        if (c->frames > 0 && (int16_t)(frame->samples[0] - prev) <= 0) {
+            ok = false;
+        }
+        if (!ok) {
+            c->bad++;
+        }
+        prev = frame->samples[0];
+        c->frames++;
+        audio_frame_unref(frame);
+    }
+    xTaskNotifyGive(s_ref_waiter);
+    vTaskDelete(NULL);
+}
+
+// Производитель в задаче обработки, три потребителя отпускают кадры из своих задач:
+// кадр не возвращается в пул, пока жива хоть одна ссылка, и в итоге пул пуст
+static void test_frame_refs_held_across_consumer_tasks(void)
+{
+    uint32_t next = 0;
+    uint32_t exhausted = 0;
+    rx_reset();
+    s_ref_waiter = xTaskGetCurrentTaskHandle();
+    audio_frame_usage(NULL, NULL, &exhausted);
+    for (int i = 0; i < REF_CONSUMERS; i++) {
+        memset(&s_ref[i], 0, sizeof(s_ref[i]));
+        s_ref[i].queue = xQueueCreate(REF_QUEUE_LEN, sizeof(audio_frame_t *));
+        TEST_ASSERT_NOT_NULL(s_ref[i].queue);
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(ref_task, "FrameRef", 4096, &s_ref[i], 5, NULL));
+        TEST_ASSERT_EQUAL(ESP_OK, audio_frame_subscribe(AUDIO_FRAME_RX_RAW, ref_cb, &s_ref[i], &s_ref[i].id));
+    }
+
+    uint32_t published = __atomic_load_n(&s_rx_published, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&s_rx_publish, true, __ATOMIC_RELAXED);
+    for (int i = 0; i < REF_FRAMES; i++) {
+        push_ramp(&next, 60);
+    }
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, next));
+    __atomic_store_n(&s_rx_publish, false, __ATOMIC_RELAXED);
+    published = __atomic_load_n(&s_rx_published, __ATOMIC_ACQUIRE) - published;
+
+    audio_frame_t *stop = NULL;
+    for (int i = 0; i < REF_CONSUMERS; i++) {
+        audio_frame_unsubscribe(s_ref[i].id);
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueSend(s_ref[i].queue, &stop, portMAX_DELAY));
+    }
+    for (uint32_t done = 0; done < REF_CONSUMERS;) {
+        uint32_t n = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WAIT_MS));
+        TEST_ASSERT_GREATER_THAN_UINT32(0, n);
+        done += n;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, s_rx_bad);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, published);
+    char msg[32];
+    for (int i = 0; i < REF_CONSUMERS; i++) {
+        snprintf(msg, sizeof(msg), "consumer %d", i);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, s_ref[i].bad, msg);
+        TEST_ASSERT_GREATER_THAN_UINT32_MESSAGE(0, s_ref[i].frames, msg);
+        // Каждый опубликованный кадр дошел до каждого потребителя: в очередь или обратно в пул
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(published, s_ref[i].frames + s_ref[i].dropped, msg);
+        vQueueDelete(s_ref[i].queue);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, frames_in_use());
+
+    uint32_t exhausted_now = 0;
+    audio_frame_usage(NULL, NULL, &exhausted_now);
+    char info[96];
+    snprintf(info, sizeof(info), "%" PRIu32 " frames published, %" PRIu32 " allocations failed on a full pool",
+             published, exhausted_now - exhausted);
+    TEST_MESSAGE(info);
+}
+
+// Нагрузка без пауз: RX и TX callbacks из задачи на ядре 0 против задачи обработки на ядре 1
+static struct {
+    TaskHandle_t waiter;
+    uint32_t rx_next;
+    uint32_t tx_served;
+    uint32_t tx_bad;
+} s_stress;
+
+static void stress_task(void *arg)
+{
+    int16_t buf[60];
+    int16_t prev = 0;
+    bool have_prev = false;
+    for (int i = 0; i < STRESS_FRAMES; i++) {
+        push_ramp(&s_stress.rx_next, 60);
+        if (audio_worker_pop_tx(buf, 60)) {
+            if (buf[1] != 6 || (have_prev && buf[0] != (int16_t)(prev + 1))) {
+                s_stress.tx_bad++;
+            }
+            prev = buf[0];
+            have_prev = true;
+            s_stress.tx_served++;
+        }
+    }
+    xTaskNotifyGive(s_stress.waiter);
+    vTaskDelete(NULL);
+}
+
+static void test_spsc_stress_two_cores(void)
+{
+    rx_reset();
+    new_session(6, 60);
+    memset(&s_stress, 0, sizeof(s_stress));
+    s_stress.waiter = xTaskGetCurrentTaskHandle();
+
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(stress_task, "HciCb", 4096, NULL, 19, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(60000)));
+    TEST_ASSERT_TRUE(wait_u32(&s_rx_samples, s_stress.rx_next));
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    TEST_ASSERT_EQUAL_UINT32(0, s_rx_bad);
+    TEST_ASSERT_EQUAL_UINT32(0, s_stress.tx_bad);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, s_stress.tx_served);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%d RX frames, %" PRIu32 " TX frames served in %" PRId64 " ms",
+             STRESS_FRAMES, s_stress.tx_served, elapsed / 1000);
+    TEST_MESSAGE(msg);
+}
+
+int main(void)
+{
+    metrics_init();
+    audio_frame_init();
+    call_qoe_init();
+    audio_mixer_init(8000);
+    if (audio_worker_init(worker_rx, worker_tx) != ESP_OK) {
+        return 1;
+    }
+    UNITY_BEGIN();
+    RUN_TEST(test_rx_frames_in_order);
+    RUN_TEST(test_rx_oversized_buffer_is_split);
+    RUN_TEST(test_tx_prepared_ahead_in_order);
+    RUN_TEST(test_new_session_drops_stale_frames);
+    RUN_TEST(test_tx_oversized_buffer_is_assembled);
+    RUN_TEST(test_deadline_miss_when_worker_is_late);
+    RUN_TEST(test_job_runs_on_worker_between_frames);
+    RUN_TEST(test_job_not_taken_is_withdrawn);
+    RUN_TEST(test_qoe_session_switches_on_worker);
+    RUN_TEST(test_loopback_stop_quiesces_path);
+    RUN_TEST(test_tap_stop_drains_queue_before_restart);
+    RUN_TEST(test_frame_refs_held_across_consumer_tasks);
+    RUN_TEST(test_spsc_stress_two_cores);
+    return UNITY_END();
+}
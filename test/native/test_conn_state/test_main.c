@@ -0,0 +1,226 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "conn_state.h"
+
+/*
+ * Таблица переходов под нагрузкой: несколько pthreads одновременно шлют
+ * события переподключения, GAP и аудио. Потоки не вызывают Unity -
+ * нарушения копятся в счетчиках и проверяются после join.
+ */
+
+#define STRESS_THREADS  4
+#define STRESS_ITERS    200000
+
+typedef struct {
+    uint32_t applied;       // Примененных событий этим потоком
+    uint32_t failures;      // Примененных PAGE_FAILED
+    uint32_t gave_up;       // Переходов в FAILED
+    uint32_t bad_words;     // Слов с несогласованными полями
+} worker_stats_t;
+
+static worker_stats_t s_stats[STRESS_THREADS * 2];
+static uint32_t s_page_owners;
+static uint32_t s_double_claims;
+
+// Инварианты слова, которые таблица обязана сохранять при любом чередовании
+static bool word_ok(uint32_t w)
+{
+    uint32_t flags = CONN_WORD_FLAGS(w);
+    if (CONN_WORD_STATE(w) >= CONN_STATE_COUNT || CONN_WORD_ATTEMPTS(w) >= CONN_MAX_ATTEMPTS) {
+        return false;
+    }
+    // Активное аудио всегда подготовлено
+    return !(flags & CONN_FLAG_AUDIO_ACTIVE) || (flags & CONN_FLAG_AUDIO_ARMED);
+}
+
+static bool dispatch(worker_stats_t *st, conn_event_t event, uint32_t *new_word)
+{
+    uint32_t old_word, word;
+    bool applied = conn_state_dispatch(event, &old_word, &word);
+    if (applied) {
+        st->applied++;
+        if (CONN_WORD_SEQ(word) != ((CONN_WORD_SEQ(old_word) + 1) & 0xFFF)) {
+            st->bad_words++;
+        }
+    }
+    if (!word_ok(word)) {
+        st->bad_words++;
+    }
+    if (new_word != NULL) {
+        *new_word = word;
+    }
+    return applied;
+}
+
+// Цикл переподключения без событий, сбрасывающих счетчик попыток
+static void *reconnect_thread(void *arg)
+{
+    worker_stats_t *st = (worker_stats_t *)arg;
+    for (uint32_t i = 0; i < STRESS_ITERS; i++) {
+        uint32_t w;
+        switch (i & 3) {
+            case 0:
+                dispatch(st, CONN_EVT_TIMER, NULL);
+                break;
+            case 1:
+                dispatch(st, (i & 4) ? CONN_EVT_PAGE_START : CONN_EVT_DISCOVERY_DONE, NULL);
+                break;
+            case 2:
+                if (dispatch(st, CONN_EVT_PAGE_FAILED, &w)) {
+                    st->failures++;
+                    if (CONN_WORD_STATE(w) == CONN_STATE_FAILED) {
+                        st->gave_up++;
+                    }
+                }
+                break;
+            default:
+                dispatch(st, CONN_EVT_PAGE_DONE, NULL);
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void *audio_thread(void *arg)
+{
+    static const conn_event_t events[] = {
+        CONN_EVT_AUDIO_ARM, CONN_EVT_AUDIO_ON, CONN_EVT_AUDIO_OFF, CONN_EVT_AUDIO_ON, CONN_EVT_AUDIO_DISARM,
+    };
+    worker_stats_t *st = (worker_stats_t *)arg;
+    for (uint32_t i = 0; i < STRESS_ITERS; i++) {
+        dispatch(st, events[i % 5], NULL);
+    }
+    return NULL;
+}
+
+// Захват page: между PAGE_START и PAGE_DONE владелец может быть только один
+static void *page_thread(void *arg)
+{
+    worker_stats_t *st = (worker_stats_t *)arg;
+    for (uint32_t i = 0; i < STRESS_ITERS; i++) {
+        if (!dispatch(st, CONN_EVT_PAGE_START, NULL)) {
+            continue;
+        }
+        if (__atomic_add_fetch(&s_page_owners, 1, __ATOMIC_ACQ_REL) != 1) {
+            __atomic_add_fetch(&s_double_claims, 1, __ATOMIC_RELAXED);
+        }
+        __atomic_sub_fetch(&s_page_owners, 1, __ATOMIC_ACQ_REL);
+        dispatch(st, CONN_EVT_PAGE_DONE, NULL);
+    }
+    return NULL;
+}
+
+static uint32_t run_threads(void *(*first)(void *), void *(*second)(void *))
+{
+    pthread_t threads[STRESS_THREADS * 2];
+    memset(s_stats, 0, sizeof(s_stats));
+    for (int i = 0; i < STRESS_THREADS * 2; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, i < STRESS_THREADS ? first : second, &s_stats[i]));
+    }
+    uint32_t applied = 0;
+    for (int i = 0; i < STRESS_THREADS * 2; i++) {
+        pthread_join(threads[i], NULL);
+        applied += s_stats[i].applied;
+        TEST_ASSERT_EQUAL_UINT32(0, s_stats[i].bad_words);
+    }
+    return applied;
+}
+
+void setUp(void)
+{
+    conn_state_init();
+    s_page_owners = 0;
+    s_double_claims = 0;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_failures_reach_failed_after_max_attempts(void)
+{
+    uint32_t w;
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_START, NULL, NULL));
+    for (int attempt = 1; attempt < CONN_MAX_ATTEMPTS; attempt++) {
+        // Прямой page цели из поиска переводит в CONNECTING так же, как page последнего устройства
+        TEST_ASSERT_TRUE(conn_state_dispatch((attempt & 1) ? CONN_EVT_PAGE_START : CONN_EVT_DISCOVERY_DONE,
+                                             NULL, NULL));
+        TEST_ASSERT_EQUAL(CONN_STATE_CONNECTING, conn_state_get());
+        TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_PAGE_FAILED, NULL, &w));
+        TEST_ASSERT_EQUAL(CONN_STATE_IDLE, CONN_WORD_STATE(w));
+        TEST_ASSERT_EQUAL_UINT32(attempt, CONN_WORD_ATTEMPTS(w));
+        TEST_ASSERT_EQUAL_UINT32(0, CONN_WORD_FLAGS(w) & CONN_FLAG_PAGE_PENDING);
+        TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_TIMER, NULL, NULL));
+    }
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_DISCOVERY_DONE, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_PAGE_FAILED, NULL, &w));
+    TEST_ASSERT_EQUAL(CONN_STATE_FAILED, CONN_WORD_STATE(w));
+    TEST_ASSERT_EQUAL_UINT32(0, CONN_WORD_ATTEMPTS(w));
+
+    // Вне CONNECTING разрыв - обычный DISCONNECTED, попытка не считается
+    TEST_ASSERT_FALSE(conn_state_dispatch(CONN_EVT_PAGE_FAILED, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_TIMER, NULL, NULL));
+    TEST_ASSERT_FALSE(conn_state_dispatch(CONN_EVT_PAGE_FAILED, NULL, NULL));
+}
+
+static void test_connected_resets_attempts(void)
+{
+    uint32_t w;
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_START, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_DISCOVERY_DONE, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_PAGE_FAILED, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_TIMER, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_PAGE_START, NULL, NULL));
+    TEST_ASSERT_TRUE(conn_state_dispatch(CONN_EVT_CONNECTED, NULL, &w));
+    TEST_ASSERT_EQUAL(CONN_STATE_CONNECTED, CONN_WORD_STATE(w));
+    TEST_ASSERT_EQUAL_UINT32(0, CONN_WORD_ATTEMPTS(w));
+    TEST_ASSERT_EQUAL_UINT32(0, CONN_WORD_FLAGS(w) & CONN_FLAG_PAGE_PENDING);
+}
+
+static void test_stress_failure_count_is_exact(void)
+{
+    uint32_t applied = run_threads(reconnect_thread, audio_thread);
+
+    // Ни один CAS не потерял попытку: каждые CONN_MAX_ATTEMPTS неудач - ровно один FAILED
+    uint32_t failures = 0;
+    uint32_t gave_up = 0;
+    for (int i = 0; i < STRESS_THREADS; i++) {
+        failures += s_stats[i].failures;
+        gave_up += s_stats[i].gave_up;
+    }
+    uint32_t w = conn_state_load();
+    TEST_ASSERT_GREATER_THAN_UINT32(CONN_MAX_ATTEMPTS, failures);
+    TEST_ASSERT_EQUAL_UINT32(failures, gave_up * CONN_MAX_ATTEMPTS + CONN_WORD_ATTEMPTS(w));
+    TEST_ASSERT_EQUAL_UINT32(applied & 0xFFF, CONN_WORD_SEQ(w));
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%" PRIu32 " transitions applied, %" PRIu32 " failures, %" PRIu32 " gave up",
+             applied, failures, gave_up);
+    TEST_MESSAGE(msg);
+}
+
+static void test_stress_page_claim_is_exclusive(void)
+{
+    uint32_t applied = run_threads(page_thread, audio_thread);
+
+    TEST_ASSERT_EQUAL_UINT32(0, s_double_claims);
+    uint32_t w = conn_state_load();
+    TEST_ASSERT_EQUAL(CONN_STATE_IDLE, CONN_WORD_STATE(w));
+    TEST_ASSERT_EQUAL_UINT32(0, CONN_WORD_FLAGS(w) & CONN_FLAG_PAGE_PENDING);
+    // Последнее событие каждого аудио потока - DISARM
+    TEST_ASSERT_EQUAL_UINT32(0, CONN_WORD_FLAGS(w) & (CONN_FLAG_AUDIO_ARMED | CONN_FLAG_AUDIO_ACTIVE));
+    TEST_ASSERT_EQUAL_UINT32(applied & 0xFFF, CONN_WORD_SEQ(w));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_failures_reach_failed_after_max_attempts);
+    RUN_TEST(test_connected_resets_attempts);
+    RUN_TEST(test_stress_failure_count_is_exact);
+    RUN_TEST(test_stress_page_claim_is_exclusive);
+    return UNITY_END();
+}
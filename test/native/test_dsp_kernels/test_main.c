@@ -0,0 +1,353 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsp_kernels.h"
+#include "dsp_kernels_impl.h"
+
+/*
+ * Каждый вариант ядер сверяется с эталоном бит в бит: все длины до 67
+ * (хвосты любых ширин векторов), рабочие блоки кадров, невыровненные
+ * указатели, случайные данные и граничные шаблоны. FIR проверяется по
+ * прямой формуле через выбранный dsp_init() вариант.
+ */
+
+#define MAX_N           256
+#define RANDOM_ROUNDS   4
+#define BENCH_N         240
+#define BENCH_REPS      2000
+
+typedef enum {
+    FILL_RANDOM = 0,        // Случайные отсчеты с частыми INT16_MIN/INT16_MAX
+    FILL_MAX,
+    FILL_MIN,
+    FILL_ALTERNATE,         // INT16_MIN, INT16_MAX, ... - худший случай насыщения и произведений
+    FILL_SMALL,             // -2..2: проверка округления
+    FILL_COUNT,
+} fill_t;
+
+static int16_t s_a[MAX_N + 1];
+static int16_t s_b[MAX_N + 1];
+static int16_t s_ref16[MAX_N + 1];
+static int16_t s_out16[MAX_N + 1];
+static int32_t s_src32[MAX_N + 1];
+static int32_t s_ref32[MAX_N + 1];
+static int32_t s_out32[MAX_N + 1];
+static uint32_t s_seed;
+
+static const int16_t s_scale_gains[] = { 0, 1, -1, 12345, 16384, -16384, INT16_MAX, INT16_MIN };
+static const int32_t s_mac_gains[] = { 0, 1, -1, 16384, 32767, -32768, 32768, 40000, 65536, -65535 };
+static const uint32_t s_blocks[] = { 60, 120, 240, MAX_N };
+
+static uint32_t xorshift32(void)
+{
+    uint32_t x = s_seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_seed = x;
+    return x;
+}
+
+static int16_t sample(fill_t fill, uint32_t i)
+{
+    uint32_t r = xorshift32();
+    switch (fill) {
+    case FILL_MAX:
+        return INT16_MAX;
+    case FILL_MIN:
+        return INT16_MIN;
+    case FILL_ALTERNATE:
+        return (i & 1) ? INT16_MAX : INT16_MIN;
+    case FILL_SMALL:
+        return (int16_t)((int32_t)(r % 5) - 2);
+    default:
+        return (r & 7) == 0 ? INT16_MIN : ((r & 7) == 1 ? INT16_MAX : (int16_t)(r >> 16));
+    }
+}
+
+// Значения для sat16: у границ int16, далеко за ними и внутри
+static int32_t wide_sample(uint32_t i)
+{
+    static const int32_t edges[] = { INT16_MAX, INT16_MAX + 1, INT16_MIN, INT16_MIN - 1, INT32_MAX, INT32_MIN, 0, -1 };
+    uint32_t r = xorshift32();
+    if ((r & 3) == 0) {
+        return edges[i % (sizeof(edges) / sizeof(edges[0]))];
+    }
+    return (r & 4) ? (int32_t)r >> 3 : (int16_t)(r >> 16);
+}
+
+static uint32_t variants(const dsp_kernels_t **list)
+{
+    uint32_t count = 0;
+#if DSP_HAVE_X86
+    list[count++] = &dsp_kernels_sse2;
+    if (dsp_x86_has_avx2()) {
+        list[count++] = &dsp_kernels_avx2;
+    }
+#endif
+    list[count++] = &dsp_kernels_unrolled;
+    return count;
+}
+
+static void fill(fill_t mode, int16_t *a, int16_t *b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        a[i] = sample(mode, i);
+        b[i] = sample(mode == FILL_ALTERNATE ? FILL_ALTERNATE : FILL_RANDOM, i + 1);
+    }
+}
+
+static void check_variant(const dsp_kernels_t *k, fill_t mode, uint32_t n, uint32_t off)
+{
+    int16_t *a = s_a + off, *b = s_b + off, *ref16 = s_ref16 + off, *out16 = s_out16 + off;
+    int32_t *src32 = s_src32 + off, *ref32 = s_ref32 + off, *out32 = s_out32 + off;
+    char what[96];
+    fill(mode, a, b, n);
+
+    snprintf(what, sizeof(what), "%s add_sat16 n=%" PRIu32 " off=%" PRIu32 " fill=%d", k->name, n, off, mode);
+    memcpy(ref16, a, n * sizeof(int16_t));
+    memcpy(out16, a, n * sizeof(int16_t));
+    dsp_ref_add_sat16(ref16, b, n);
+    k->add_sat16(out16, b, n);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref16, out16, n * sizeof(int16_t), what);
+
+    for (size_t g = 0; g < sizeof(s_scale_gains) / sizeof(s_scale_gains[0]); g++) {
+        snprintf(what, sizeof(what), "%s scale_q15 n=%" PRIu32 " off=%" PRIu32 " fill=%d gain=%d",
+                 k->name, n, off, mode, s_scale_gains[g]);
+        dsp_ref_scale_q15(ref16, a, n, s_scale_gains[g]);
+        k->scale_q15(out16, a, n, s_scale_gains[g]);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref16, out16, n * sizeof(int16_t), what);
+        // На месте (dst == src), как в agc_ramp_process
+        memcpy(out16, a, n * sizeof(int16_t));
+        k->scale_q15(out16, out16, n, s_scale_gains[g]);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref16, out16, n * sizeof(int16_t), what);
+    }
+
+    for (size_t g = 0; g < sizeof(s_mac_gains) / sizeof(s_mac_gains[0]); g++) {
+        snprintf(what, sizeof(what), "%s mac_q15 n=%" PRIu32 " off=%" PRIu32 " fill=%d gain=%" PRId32,
+                 k->name, n, off, mode, s_mac_gains[g]);
+        for (uint32_t i = 0; i < n; i++) {
+            ref32[i] = out32[i] = (int32_t)(xorshift32() >> 2) - (1 << 29);
+        }
+        dsp_ref_mac_q15(ref32, a, n, s_mac_gains[g]);
+        k->mac_q15(out32, a, n, s_mac_gains[g]);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref32, out32, n * sizeof(int32_t), what);
+    }
+
+    snprintf(what, sizeof(what), "%s sat16 n=%" PRIu32 " off=%" PRIu32, k->name, n, off);
+    for (uint32_t i = 0; i < n; i++) {
+        src32[i] = wide_sample(i);
+    }
+    uint32_t ref_clipped = dsp_ref_sat16(ref16, src32, n);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(ref_clipped, k->sat16(out16, src32, n), what);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref16, out16, n * sizeof(int16_t), what);
+
+    snprintf(what, sizeof(what), "%s dot_q15 n=%" PRIu32 " off=%" PRIu32 " fill=%d", k->name, n, off, mode);
+    TEST_ASSERT_TRUE_MESSAGE(dsp_ref_dot_q15(a, b, n) == k->dot_q15(a, b, n), what);
+    TEST_ASSERT_TRUE_MESSAGE(dsp_ref_dot_q15(a, a, n) == k->dot_q15(a, a, n), what);
+}
+
+static void check_all_lengths(const dsp_kernels_t *k, fill_t mode)
+{
+    for (uint32_t i = 0; i < 68 + sizeof(s_blocks) / sizeof(s_blocks[0]); i++) {
+        uint32_t n = i < 68 ? i : s_blocks[i - 68];
+        for (uint32_t off = 0; off < 2; off++) {
+            check_variant(k, mode, n, off);
+        }
+    }
+}
+
+void setUp(void)
+{
+    s_seed = 0x2545F491;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_variants_match_reference_on_random_data(void)
+{
+    const dsp_kernels_t *list[4];
+    uint32_t count = variants(list);
+    for (uint32_t v = 0; v < count; v++) {
+        for (int round = 0; round < RANDOM_ROUNDS; round++) {
+            check_all_lengths(list[v], FILL_RANDOM);
+        }
+    }
+}
+
+static void test_variants_match_reference_on_edge_patterns(void)
+{
+    const dsp_kernels_t *list[4];
+    uint32_t count = variants(list);
+    for (uint32_t v = 0; v < count; v++) {
+        for (int mode = FILL_MAX; mode < FILL_COUNT; mode++) {
+            check_all_lengths(list[v], (fill_t)mode);
+        }
+    }
+}
+
+static void test_dot_is_exact_at_full_scale(void)
+{
+    // 256 произведений (-32768)^2 = 2^38: переполнило бы 32-битный накопитель и madd_epi16
+    const dsp_kernels_t *list[4];
+    uint32_t count = variants(list);
+    for (uint32_t i = 0; i < MAX_N; i++) {
+        s_a[i] = INT16_MIN;
+    }
+    for (uint32_t v = 0; v < count; v++) {
+        TEST_ASSERT_TRUE_MESSAGE(list[v]->dot_q15(s_a, s_a, MAX_N) == (int64_t)MAX_N << 30, list[v]->name);
+    }
+    TEST_ASSERT_EQUAL_UINT32(32768, dsp_rms_q15(s_a, MAX_N));
+}
+
+static void test_fir_matches_direct_form(void)
+{
+    static const uint16_t taps_list[] = { 1, 7, 31, DSP_FIR_MAX_TAPS };
+    static int16_t x[3 * DSP_FIR_BLOCK + 17];
+    static int16_t y[sizeof(x) / sizeof(x[0])];
+    int16_t h[DSP_FIR_MAX_TAPS];
+    const uint32_t len = sizeof(x) / sizeof(x[0]);
+
+    for (size_t t = 0; t < sizeof(taps_list) / sizeof(taps_list[0]); t++) {
+        uint16_t taps = taps_list[t];
+        for (uint16_t k = 0; k < taps; k++) {
+            h[k] = sample(FILL_RANDOM, k);
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            x[i] = sample(FILL_RANDOM, i);
+        }
+        dsp_fir_t fir = {0};
+        TEST_ASSERT_EQUAL(ESP_OK, dsp_fir_init(&fir, h, taps));
+        // Вызовы разной длины, больше DSP_FIR_BLOCK и на месте: история переносится между ними
+        memcpy(y, x, sizeof(x));
+        uint32_t pos = 0;
+        for (uint32_t step = 1; pos < len; step = step * 3 + 1) {
+            uint32_t n = len - pos < step ? len - pos : step;
+            dsp_fir_process(&fir, y + pos, y + pos, n);
+            pos += n;
+        }
+        dsp_fir_free(&fir);
+
+        for (uint32_t i = 0; i < len; i++) {
+            int64_t acc = 0;
+            for (uint16_t k = 0; k < taps && k <= i; k++) {
+                acc += (int32_t)h[k] * x[i - k];
+            }
+            int64_t v = (acc + (1 << 14)) >> 15;
+            int16_t expect = v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : (int16_t)v);
+            TEST_ASSERT_EQUAL_INT16(expect, y[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, dsp_fir_init(&(dsp_fir_t){0}, h, DSP_FIR_MAX_TAPS + 1));
+}
+
+static void test_biquad_matches_direct_form(void)
+{
+    // ФВЧ ~100 Гц при 8 кГц, как в 'dsp bench'; вход с насыщением выхода
+    static const int16_t hp[5] = { 15734, -31468, 15734, -31418, 15136 };
+    int16_t x[MAX_N], y[MAX_N];
+    for (uint32_t i = 0; i < MAX_N; i++) {
+        x[i] = sample(FILL_RANDOM, i);
+    }
+    dsp_biquad_t bq;
+    dsp_biquad_init(&bq, hp);
+    dsp_biquad_process(&bq, y, x, MAX_N / 2);
+    dsp_biquad_process(&bq, y + MAX_N / 2, x + MAX_N / 2, MAX_N / 2);
+
+    int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    for (uint32_t i = 0; i < MAX_N; i++) {
+        int64_t acc = (int64_t)hp[0] * x[i] + (int64_t)hp[1] * x1 + (int64_t)hp[2] * x2
+                      - (int64_t)hp[3] * y1 - (int64_t)hp[4] * y2;
+        int64_t v = (acc + (1 << 13)) >> 14;
+        int16_t expect = v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : (int16_t)v);
+        TEST_ASSERT_EQUAL_INT16(expect, y[i]);
+        x2 = x1;
+        x1 = x[i];
+        y2 = y1;
+        y1 = expect;
+    }
+}
+
+// Такты на отсчет x100 на блоке mSBC; на хосте x86 - TSC, поэтому цифры ориентировочные
+static uint32_t bench(void (*run)(const dsp_kernels_t *k), const dsp_kernels_t *k)
+{
+    run(k);
+    uint32_t start = dsp_cycle_count();
+    for (int r = 0; r < BENCH_REPS; r++) {
+        run(k);
+    }
+    return (uint32_t)(((uint64_t)(dsp_cycle_count() - start) * 100) / (BENCH_REPS * BENCH_N));
+}
+
+static volatile int64_t s_sink;
+
+static void run_add(const dsp_kernels_t *k)
+{
+    k->add_sat16(s_out16, s_b, BENCH_N);
+}
+
+static void run_scale(const dsp_kernels_t *k)
+{
+    k->scale_q15(s_out16, s_a, BENCH_N, 12345);
+}
+
+static void run_mac(const dsp_kernels_t *k)
+{
+    k->mac_q15(s_out32, s_a, BENCH_N, 12345);
+}
+
+static void run_sat(const dsp_kernels_t *k)
+{
+    s_sink += k->sat16(s_out16, s_src32, BENCH_N);
+}
+
+static void run_dot(const dsp_kernels_t *k)
+{
+    s_sink += k->dot_q15(s_a, s_b, BENCH_N);
+}
+
+static void test_bench_cycles_per_sample(void)
+{
+    const dsp_kernels_t *list[4];
+    list[0] = &dsp_kernels_ref;
+    uint32_t count = 1 + variants(list + 1);
+    fill(FILL_RANDOM, s_a, s_b, BENCH_N);
+    for (uint32_t i = 0; i < BENCH_N; i++) {
+        s_src32[i] = wide_sample(i);
+        s_out32[i] = 0;
+    }
+
+    char line[160];
+    snprintf(line, sizeof(line), "dsp bench: %d-sample blocks, cycles per sample, selected backend %s",
+             BENCH_N, dsp_backend_name());
+    TEST_MESSAGE(line);
+    for (uint32_t v = 0; v < count; v++) {
+        uint32_t add = bench(run_add, list[v]);
+        uint32_t scale = bench(run_scale, list[v]);
+        uint32_t mac = bench(run_mac, list[v]);
+        uint32_t sat = bench(run_sat, list[v]);
+        uint32_t dot = bench(run_dot, list[v]);
+        snprintf(line, sizeof(line),
+                 "  %-8s add %3" PRIu32 ".%02" PRIu32 "  scale %3" PRIu32 ".%02" PRIu32 "  mac %3" PRIu32
+                 ".%02" PRIu32 "  sat %3" PRIu32 ".%02" PRIu32 "  dot %3" PRIu32 ".%02" PRIu32,
+                 list[v]->name, add / 100, add % 100, scale / 100, scale % 100, mac / 100, mac % 100,
+                 sat / 100, sat % 100, dot / 100, dot % 100);
+        TEST_MESSAGE(line);
+    }
+}
+
+int main(void)
+{
+    dsp_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_variants_match_reference_on_random_data);
+    RUN_TEST(test_variants_match_reference_on_edge_patterns);
+    RUN_TEST(test_dot_is_exact_at_full_scale);
+    RUN_TEST(test_fir_matches_direct_form);
+    RUN_TEST(test_biquad_matches_direct_form);
+    RUN_TEST(test_bench_cycles_per_sample);
+    return UNITY_END();
+}
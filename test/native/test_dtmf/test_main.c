@@ -0,0 +1,291 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "dtmf.h"
+#include "dsp_kernels.h"
+
+/*
+ * Детектор на сгенерированных сигналах: все клавиши на 8 и 16 кГц, twist,
+ * уход частоты, длительность тона, шум с заданным SNR, одиночные тоны и
+ * тоны факса. Сигнал подается кадрами нечетной длины, чтобы границы блоков
+ * Гёрцеля не совпадали с границами кадров.
+ */
+
+#define FRAME_LEN       37
+#define TONE_MS         100
+#define PAUSE_MS        100
+#define LEVEL           8000.0f     // Амплитуда каждого тона, -12 дБ от полной шкалы
+
+static const char s_all[] = "123A456B789C*0#D";
+static const float s_row_hz[4] = { 697.0f, 770.0f, 852.0f, 941.0f };
+static const float s_col_hz[4] = { 1209.0f, 1336.0f, 1477.0f, 1633.0f };
+
+typedef struct {
+    char digits[48];
+    uint32_t n_digits;
+    uint32_t cng;
+    uint32_t ced;
+    int8_t level_db;                // Уровень последней цифры
+} event_log_t;
+
+typedef struct {
+    float f1, f2;                   // Частоты, Гц (0 - нет тона)
+    float a1, a2;                   // Амплитуды, LSB
+    float noise_rms;                // Гауссов шум, LSB
+} signal_t;
+
+static dtmf_t s_dtmf;
+static event_log_t s_log;
+static uint32_t s_seed;
+static uint32_t s_frame_len;
+
+static void log_cb(const dtmf_event_t *event, void *ctx)
+{
+    event_log_t *log = (event_log_t *)ctx;
+    if (event->type == DTMF_EVENT_DIGIT) {
+        if (log->n_digits < sizeof(log->digits) - 1) {
+            log->digits[log->n_digits++] = event->digit;
+        }
+        log->level_db = event->level_db;
+    } else if (event->type == DTMF_EVENT_CNG) {
+        log->cng++;
+    } else {
+        log->ced++;
+    }
+}
+
+// Сумма 12 равномерных: приближение нормального распределения с единичной дисперсией
+static float gauss(void)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) {
+        s_seed = s_seed * 1664525u + 1013904223u;
+        sum += (float)(s_seed >> 8) / 16777216.0f;
+    }
+    return sum - 6.0f;
+}
+
+// Отрезок сигнала длиной ms, подается кадрами s_frame_len
+static void feed(uint32_t rate, const signal_t *sig, uint32_t ms)
+{
+    int16_t frame[1024];
+    uint32_t total = rate * ms / 1000;
+    float w1 = 2.0f * (float)M_PI * sig->f1 / (float)rate;
+    float w2 = 2.0f * (float)M_PI * sig->f2 / (float)rate;
+
+    for (uint32_t done = 0; done < total; ) {
+        uint32_t n = total - done < s_frame_len ? total - done : s_frame_len;
+        for (uint32_t i = 0; i < n; i++) {
+            float t = (float)(done + i);
+            float v = sig->a1 * sinf(w1 * t) + sig->a2 * sinf(w2 * t + 1.0f);
+            if (sig->noise_rms > 0.0f) {
+                v += sig->noise_rms * gauss();
+            }
+            frame[i] = (int16_t)(v > 32767.0f ? 32767.0f : (v < -32768.0f ? -32768.0f : v));
+        }
+        dtmf_process(&s_dtmf, frame, n, log_cb, &s_log);
+        done += n;
+    }
+}
+
+/*
+ * Все 16 клавиш подряд с паузами. twist_db > 0 - верхний тон тише нижнего,
+ * detune - относительный уход обеих частот, snr_db - отношение СКЗ каждого
+ * тона к СКЗ шума (INFINITY - без шума)
+ */
+static void play_keys(uint32_t rate, float amp, float twist_db, float detune, float snr_db, uint32_t tone_ms)
+{
+    float noise_rms = isinf(snr_db) ? 0.0f : amp / sqrtf(2.0f) / powf(10.0f, snr_db / 20.0f);
+
+    TEST_ASSERT_EQUAL(ESP_OK, dtmf_init(&s_dtmf, rate));
+    memset(&s_log, 0, sizeof(s_log));
+    for (int d = 0; s_all[d] != 0; d++) {
+        const signal_t tone = {
+            .f1 = s_row_hz[d / 4] * (1.0f + detune), .f2 = s_col_hz[d % 4] * (1.0f + detune),
+            .a1 = amp, .a2 = amp * powf(10.0f, -twist_db / 20.0f), .noise_rms = noise_rms,
+        };
+        const signal_t pause = { .noise_rms = noise_rms };
+        feed(rate, &tone, tone_ms);
+        feed(rate, &pause, PAUSE_MS);
+    }
+}
+
+static void expect_keys(uint32_t rate, float amp, float twist_db, float detune, float snr_db, uint32_t tone_ms,
+                        const char *expect)
+{
+    char what[96];
+    play_keys(rate, amp, twist_db, detune, snr_db, tone_ms);
+    snprintf(what, sizeof(what), "%" PRIu32 " Hz amp %d twist %+.1f dB detune %+.3f SNR %.1f dB tone %" PRIu32 " ms",
+             rate, (int)amp, (double)twist_db, (double)detune, (double)snr_db, tone_ms);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expect, s_log.digits, what);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, s_log.cng + s_log.ced, what);
+}
+
+static void play_tone(uint32_t rate, float hz, uint32_t ms)
+{
+    const signal_t tone = { .f1 = hz, .a1 = 6000.0f, .noise_rms = 170.0f };
+    TEST_ASSERT_EQUAL(ESP_OK, dtmf_init(&s_dtmf, rate));
+    memset(&s_log, 0, sizeof(s_log));
+    feed(rate, &tone, ms);
+}
+
+void setUp(void)
+{
+    s_seed = 12345;
+    s_frame_len = FRAME_LEN;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_all_keys_at_8_and_16_khz(void)
+{
+    expect_keys(8000, LEVEL, 0.0f, 0.0f, INFINITY, TONE_MS, s_all);
+    TEST_ASSERT_INT_WITHIN(2, -12, s_log.level_db);
+    expect_keys(16000, LEVEL, 0.0f, 0.0f, INFINITY, TONE_MS, s_all);
+    TEST_ASSERT_INT_WITHIN(2, -12, s_log.level_db);
+}
+
+// Решение принимается на границах блоков, а не кадров: длина кадра не меняет событий
+static void test_frame_length_does_not_change_events(void)
+{
+    static const uint32_t lengths[] = { 1, 37, 160, 1024 };
+    for (uint32_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        s_frame_len = lengths[i];
+        expect_keys(16000, LEVEL, 0.0f, 0.0f, INFINITY, TONE_MS, s_all);
+        TEST_ASSERT_EQUAL_UINT32(16 * (TONE_MS + PAUSE_MS) * DTMF_RATE / 1000 / DTMF_BLOCK, s_dtmf.blocks);
+    }
+}
+
+// Норма: нижний тон громче верхнего до 8 дБ, верхний громче нижнего до 4 дБ
+static void test_twist_limits(void)
+{
+    static const uint32_t rates[] = { 8000, 16000 };
+    for (int r = 0; r < 2; r++) {
+        expect_keys(rates[r], LEVEL, 6.0f, 0.0f, INFINITY, TONE_MS, s_all);
+        expect_keys(rates[r], LEVEL, -3.0f, 0.0f, INFINITY, TONE_MS, s_all);
+        expect_keys(rates[r], LEVEL, 10.0f, 0.0f, INFINITY, TONE_MS, "");
+        expect_keys(rates[r], LEVEL, 12.0f, 0.0f, INFINITY, TONE_MS, "");
+        expect_keys(rates[r], LEVEL, -6.0f, 0.0f, INFINITY, TONE_MS, "");
+        expect_keys(rates[r], LEVEL, -8.0f, 0.0f, INFINITY, TONE_MS, "");
+    }
+}
+
+// Уход частоты 1.5% принимается, 4-5% (почти середина между соседними тонами строк) - нет
+static void test_off_frequency(void)
+{
+    static const uint32_t rates[] = { 8000, 16000 };
+    for (int r = 0; r < 2; r++) {
+        expect_keys(rates[r], LEVEL, 0.0f, 0.015f, INFINITY, TONE_MS, s_all);
+        expect_keys(rates[r], LEVEL, 0.0f, -0.015f, INFINITY, TONE_MS, s_all);
+        expect_keys(rates[r], LEVEL, 0.0f, 0.04f, INFINITY, TONE_MS, "");
+        expect_keys(rates[r], LEVEL, 0.0f, -0.04f, INFINITY, TONE_MS, "");
+        expect_keys(rates[r], LEVEL, 0.0f, 0.05f, INFINITY, TONE_MS, "");
+        expect_keys(rates[r], LEVEL, 0.0f, -0.05f, INFINITY, TONE_MS, "");
+    }
+}
+
+// Два блока подряд: тон 40 мс распознается при любом положении относительно блоков,
+// 15 мс не покрывает двух блоков и отбрасывается
+static void test_tone_duration(void)
+{
+    static const uint32_t rates[] = { 8000, 16000 };
+    for (int r = 0; r < 2; r++) {
+        expect_keys(rates[r], LEVEL, 0.0f, 0.0f, INFINITY, 40, s_all);
+        expect_keys(rates[r], LEVEL, 0.0f, 0.0f, INFINITY, 15, "");
+        expect_keys(rates[r], LEVEL, 0.0f, 0.0f, INFINITY, 10, "");
+    }
+}
+
+static void test_noise_at_snr(void)
+{
+    static const uint32_t rates[] = { 8000, 16000 };
+    for (int r = 0; r < 2; r++) {
+        // Тоны -18 дБ от полной шкалы, шум на 10 и 15 дБ ниже каждого тона
+        for (uint32_t seed = 1; seed <= 4; seed++) {
+            s_seed = seed;
+            expect_keys(rates[r], 4000.0f, 0.0f, 0.0f, 10.0f, TONE_MS, s_all);
+            expect_keys(rates[r], 4000.0f, 0.0f, 0.0f, 15.0f, TONE_MS, s_all);
+        }
+        // Тихие тоны (~-44 дБ) ниже порога детектора
+        expect_keys(rates[r], 200.0f, 0.0f, 0.0f, INFINITY, TONE_MS, "");
+        // Тон тонет в шуме: шум на 16 дБ громче тона
+        expect_keys(rates[r], 1000.0f, 0.0f, 0.0f, -16.0f, TONE_MS, "");
+
+        // Только шум, 5 с на разных уровнях: ни одного ложного события
+        for (int level = 0; level < 3; level++) {
+            const signal_t noise = { .noise_rms = 300.0f * (float)(1 << (level * 2)) };
+            TEST_ASSERT_EQUAL(ESP_OK, dtmf_init(&s_dtmf, rates[r]));
+            memset(&s_log, 0, sizeof(s_log));
+            feed(rates[r], &noise, 5000);
+            TEST_ASSERT_EQUAL_UINT32(0, s_log.n_digits + s_log.cng + s_log.ced);
+        }
+    }
+}
+
+// Одиночный тон группы DTMF - не цифра; CNG и CED только после ~200 мс непрерывного тона
+static void test_single_tones_and_fax_tones(void)
+{
+    static const uint32_t rates[] = { 8000, 16000 };
+    for (int r = 0; r < 2; r++) {
+        play_tone(rates[r], 697.0f, 500);
+        TEST_ASSERT_EQUAL_UINT32(0, s_log.n_digits + s_log.cng + s_log.ced);
+        play_tone(rates[r], 1336.0f, 500);
+        TEST_ASSERT_EQUAL_UINT32(0, s_log.n_digits + s_log.cng + s_log.ced);
+
+        play_tone(rates[r], 1100.0f, 500);
+        TEST_ASSERT_EQUAL_UINT32(1, s_log.cng);
+        TEST_ASSERT_EQUAL_UINT32(0, s_log.ced + s_log.n_digits);
+        play_tone(rates[r], 2100.0f, 1000);
+        TEST_ASSERT_EQUAL_UINT32(1, s_log.ced);
+        TEST_ASSERT_EQUAL_UINT32(0, s_log.cng + s_log.n_digits);
+        play_tone(rates[r], 1100.0f, 100);
+        TEST_ASSERT_EQUAL_UINT32(0, s_log.n_digits + s_log.cng + s_log.ced);
+    }
+}
+
+static void test_unsupported_rate(void)
+{
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, dtmf_init(&s_dtmf, 44100));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, dtmf_init(&s_dtmf, 0));
+    TEST_ASSERT_EQUAL(ESP_OK, dtmf_init(&s_dtmf, 16000));
+}
+
+static void test_bench_cycles_per_sample(void)
+{
+    static int16_t frame[160];
+    for (int i = 0; i < 160; i++) {
+        frame[i] = (int16_t)(8000.0f * sinf(0.55f * (float)i) + 8000.0f * sinf(1.05f * (float)i));
+    }
+    char line[64];
+    static const uint32_t rates[] = { 8000, 16000 };
+    for (int r = 0; r < 2; r++) {
+        TEST_ASSERT_EQUAL(ESP_OK, dtmf_init(&s_dtmf, rates[r]));
+        uint32_t start = dsp_cycle_count();
+        for (int rep = 0; rep < 2000; rep++) {
+            dtmf_process(&s_dtmf, frame, 160, NULL, NULL);
+        }
+        uint32_t cycles = dsp_cycle_count() - start;
+        snprintf(line, sizeof(line), "%5" PRIu32 " Hz: %" PRIu32 ".%02" PRIu32 " cycles per input sample", rates[r],
+                 cycles / (2000 * 160), (uint32_t)((uint64_t)cycles * 100 / (2000 * 160)) % 100);
+        TEST_MESSAGE(line);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_all_keys_at_8_and_16_khz);
+    RUN_TEST(test_frame_length_does_not_change_events);
+    RUN_TEST(test_twist_limits);
+    RUN_TEST(test_off_frequency);
+    RUN_TEST(test_tone_duration);
+    RUN_TEST(test_noise_at_snr);
+    RUN_TEST(test_single_tones_and_fax_tones);
+    RUN_TEST(test_unsupported_rate);
+    RUN_TEST(test_bench_cycles_per_sample);
+    return UNITY_END();
+}
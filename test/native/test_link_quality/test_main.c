@@ -0,0 +1,200 @@
+#include <unity.h>
+#include "link_quality.h"
+
+/*
+ * Политика кодека на синтетических трассах потерь. Окно - один опрос
+ * LINK_QUALITY_POLL_MS; счетчики стека накопительные, как в
+ * ESP_HF_PKT_STAT_NUMS_GET_EVT. Первое окно SCO - только точка отсчета.
+ */
+
+#define WINDOW_FRAMES   200     // Кратно 1000/5: потери в промилле считаются точно
+
+static link_quality_t s_lq;
+static int64_t s_now_ms;
+static uint32_t s_total;
+static uint32_t s_bad;
+
+static link_quality_action_t window(audio_codec_t codec, uint32_t loss_permille)
+{
+    s_now_ms += LINK_QUALITY_POLL_MS;
+    s_total += WINDOW_FRAMES;
+    s_bad += loss_permille * WINDOW_FRAMES / 1000;
+    const link_quality_sample_t sample = { .rx_total = s_total, .rx_bad = s_bad };
+    return link_quality_update(&s_lq, codec, &sample, s_now_ms);
+}
+
+// Окна с одинаковыми потерями до первого решения; номер окна с решением - в *at
+static link_quality_action_t run(audio_codec_t codec, uint32_t loss_permille, int windows, int *at)
+{
+    for (int i = 1; i <= windows; i++) {
+        link_quality_action_t action = window(codec, loss_permille);
+        if (action != LINK_QUALITY_ACTION_NONE) {
+            if (at != NULL) {
+                *at = i;
+            }
+            return action;
+        }
+    }
+    return LINK_QUALITY_ACTION_NONE;
+}
+
+// Понижение, которое стек выполнил: дальше SCO идет на CVSD
+static void downgrade_to_cvsd(void)
+{
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 80, 10, NULL));
+    TEST_ASSERT_TRUE(link_quality_switch_done(&s_lq, AUDIO_CODEC_CVSD));
+    link_quality_sco_open(&s_lq);
+    window(AUDIO_CODEC_CVSD, 0);
+}
+
+void setUp(void)
+{
+    link_quality_init(&s_lq);
+    link_quality_sco_open(&s_lq);
+    s_now_ms = 100000;
+    s_total = 0;
+    s_bad = 0;
+    window(AUDIO_CODEC_MSBC, 0);
+}
+
+void tearDown(void)
+{
+}
+
+static void test_clean_link_stays_on_msbc(void)
+{
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 0, 600, NULL));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_GOOD, s_lq.level);
+    TEST_ASSERT_EQUAL_UINT32(0, s_lq.downgrades);
+}
+
+static void test_constant_3_percent_is_hysteresis_zone(void)
+{
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 30, 600, NULL));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_FAIR, s_lq.level);
+    TEST_ASSERT_EQUAL_UINT16(30, s_lq.loss);
+    // Сглаживание сдвигом останавливается чуть ниже точного значения
+    TEST_ASSERT_UINT_WITHIN(3, 30, s_lq.loss_avg);
+}
+
+static void test_8_percent_burst_downgrades_after_bad_windows(void)
+{
+    int at = 0;
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 0, 30, NULL));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 80, 10, &at));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_BAD_WINDOWS, at);
+    TEST_ASSERT_EQUAL(AUDIO_CODEC_CVSD, s_lq.switch_target);
+    TEST_ASSERT_EQUAL(AUDIO_CODEC_MSBC, s_lq.wide_codec);
+    TEST_ASSERT_TRUE(s_lq.fallback);
+
+    // Пока смена идет, новых решений нет
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 80, 10, NULL));
+}
+
+static void test_upgrade_after_hold_on_clean_cvsd(void)
+{
+    downgrade_to_cvsd();
+    int64_t switched_ms = s_lq.last_switch_ms;
+    int at = 0;
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_UPGRADE, run(AUDIO_CODEC_CVSD, 0, 600, &at));
+    TEST_ASSERT_GREATER_OR_EQUAL(LINK_QUALITY_GOOD_WINDOWS, at);
+    TEST_ASSERT_TRUE(s_now_ms - switched_ms >= LINK_QUALITY_HOLD_MS);
+    TEST_ASSERT_EQUAL(AUDIO_CODEC_MSBC, s_lq.switch_target);
+}
+
+static void test_on_off_flapping_never_switches(void)
+{
+    for (int i = 0; i < 300; i++) {
+        TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, window(AUDIO_CODEC_MSBC, (i & 1) ? 80 : 0));
+    }
+    // Серия из двух плохих окон короче порога
+    for (int i = 0; i < 300; i++) {
+        TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, window(AUDIO_CODEC_MSBC, (i % 3) != 0 ? 80 : 0));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, s_lq.downgrades);
+}
+
+static void test_failed_upgrade_doubles_hold(void)
+{
+    downgrade_to_cvsd();
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_UPGRADE, run(AUDIO_CODEC_CVSD, 0, 600, NULL));
+    TEST_ASSERT_TRUE(link_quality_switch_done(&s_lq, AUDIO_CODEC_MSBC));
+    link_quality_sco_open(&s_lq);
+    window(AUDIO_CODEC_MSBC, 0);
+
+    // Помехи вернулись сразу после повышения: откат и вдвое большая выдержка
+    uint32_t hold = s_lq.hold_ms;
+    int64_t dwell_end = s_lq.last_switch_ms + LINK_QUALITY_DWELL_MS;
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 80, 60, NULL));
+    TEST_ASSERT_TRUE(s_now_ms >= dwell_end);
+    TEST_ASSERT_EQUAL_UINT32(hold * 2, s_lq.hold_ms);
+}
+
+static void test_weak_rssi_makes_moderate_loss_bad(void)
+{
+    int at = 0;
+    // 2% при сильном сигнале - среднее окно
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 20, 60, NULL));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_FAIR, s_lq.level);
+
+    link_quality_set_rssi(&s_lq, LINK_QUALITY_WEAK_RSSI - 2);
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 20, 10, &at));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_BAD_WINDOWS, at);
+}
+
+static void test_weak_rssi_without_loss_is_not_good(void)
+{
+    link_quality_set_rssi(&s_lq, LINK_QUALITY_WEAK_RSSI);
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 0, 60, NULL));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_FAIR, s_lq.level);
+
+    // Гистерезис RSSI: хорошим окно становится только с запасом над порогом
+    link_quality_set_rssi(&s_lq, LINK_QUALITY_WEAK_RSSI + LINK_QUALITY_RSSI_MARGIN);
+    window(AUDIO_CODEC_MSBC, 0);
+    TEST_ASSERT_EQUAL(LINK_QUALITY_FAIR, s_lq.level);
+    link_quality_set_rssi(&s_lq, LINK_QUALITY_WEAK_RSSI + LINK_QUALITY_RSSI_MARGIN + 1);
+    window(AUDIO_CODEC_MSBC, 0);
+    TEST_ASSERT_EQUAL(LINK_QUALITY_GOOD, s_lq.level);
+}
+
+static void test_stack_refusal_blocks_policy(void)
+{
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 80, 10, NULL));
+    // Стек снова согласовал mSBC
+    TEST_ASSERT_FALSE(link_quality_switch_done(&s_lq, AUDIO_CODEC_MSBC));
+    TEST_ASSERT_TRUE(s_lq.blocked);
+    TEST_ASSERT_FALSE(s_lq.fallback);
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_NONE, run(AUDIO_CODEC_MSBC, 80, 600, NULL));
+    TEST_ASSERT_EQUAL(LINK_QUALITY_BAD, s_lq.level);
+}
+
+static void test_advisory_decision_repeats_after_dwell(void)
+{
+    int64_t first = 0;
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 80, 10, NULL));
+    first = s_now_ms;
+    // hf_handler только журналирует решение и отменяет его
+    link_quality_switch_failed(&s_lq);
+    TEST_ASSERT_FALSE(s_lq.fallback);
+    TEST_ASSERT_EQUAL(AUDIO_CODEC_COUNT, s_lq.switch_target);
+
+    TEST_ASSERT_EQUAL(LINK_QUALITY_ACTION_DOWNGRADE, run(AUDIO_CODEC_MSBC, 80, 60, NULL));
+    TEST_ASSERT_TRUE(s_now_ms - first >= LINK_QUALITY_DWELL_MS);
+    TEST_ASSERT_EQUAL_UINT32(2, s_lq.downgrades);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_link_stays_on_msbc);
+    RUN_TEST(test_constant_3_percent_is_hysteresis_zone);
+    RUN_TEST(test_8_percent_burst_downgrades_after_bad_windows);
+    RUN_TEST(test_upgrade_after_hold_on_clean_cvsd);
+    RUN_TEST(test_on_off_flapping_never_switches);
+    RUN_TEST(test_failed_upgrade_doubles_hold);
+    RUN_TEST(test_weak_rssi_makes_moderate_loss_bad);
+    RUN_TEST(test_weak_rssi_without_loss_is_not_good);
+    RUN_TEST(test_stack_refusal_blocks_policy);
+    RUN_TEST(test_advisory_decision_repeats_after_dwell);
+    return UNITY_END();
+}
@@ -0,0 +1,1059 @@
+// Сгенерировано tools/gen_msbc_vectors.py, не редактировать.
+// Эталон: FFmpeg libavcodec 62.28.102 (sbc, режим msbc), кодер и декодер из BlueZ libsbc.
+// Сигнал: chirp x16, noise x8, square x4, silence x4, quiet x4, impulse x4.
+
+#ifndef MSBC_VECTORS_H
+#define MSBC_VECTORS_H
+
+#define MSBC_VECTOR_FRAMES 40
+
+static const int16_t msbc_vector_pcm[MSBC_VECTOR_FRAMES * MSBC_SAMPLES_PER_FRAME] = {
+     -1024,    927,    842,    769,    706,   2700,   2656,   2617,   2584,   4603,   4576,   4549,
+      4519,   4486,   6492,   6440,   6375,   6295,   8242,   8119,   7970,   7791,   7578,   9377,
+      9086,   8753,   8370,   9986,   9499,   8955,   8353,   7689,   9011,   8220,   7366,   6446,
+      7513,   6468,   5365,   4206,   2995,   3785,   2487,   1155,   -203,    470,   -912,  -2291,
+     -3656,  -4997,  -4252,  -5505,  -6697,  -7814,  -6799,  -7734,  -8563,  -9274,  -9862,  -8270,
+     -8592,  -8774,  -8820,  -6679,  -6457,  -6108,  -5647,  -5083,  -2386,  -1669,   -903,   -112,
+      2730,   3499,   4219,   4863,   5407,   7871,   8138,   8235,   8145,   9900,   9398,   8678,
+      7744,   6601,   7309,   5788,   4113,   2310,   2462,    511,  -1455,  -3392,  -5257,  -4956,
+     -6546,  -7937,  -9098,  -7951,  -8572,  -8901,  -8936,  -8683,  -6114,  -5350,  -4382,  -3257,
+        20,   1292,   2544,   3710,   4727,   7580,   8121,   8349,   8233,   9797,   8940,   7718,
+      6158,   4299,   4248,   1975,   -391,  -2765,  -3009,  -5132,  -7002,  -8546,  -9705,  -8386,
+     -8667,  -8497,  -7903,  -4882,  -3599,  -2093,   -467,   1168,   4743,   6050,   7032,   7603,
+      9740,   9310,   8348,   6877,   4949,   4696,   2128,   -577,  -3278,  -3784,  -6050,  -7906,
+     -9251, -10019,  -8129,  -7690,  -6704,  -5266,  -1453,    484,   2423,   4187,   7661,   8600,
+      8941,   8613,   7597,   7974,   5732,   3055,    110,   -853,  -3727,  -6259,  -8273,  -9630,
+     -8198,  -8045,  -7169,  -5672,  -1672,    528,   2740,   4724,   6252,   9184,   9288,   8550,
+      6986,   6737,   3877,    679,  -2591,  -5655,  -6201,  -8104,  -9158,  -9292,  -6478,  -4930,
+     -2799,   -356,   2096,   6287,   7836,   8560,   8321,   9128,   6962,   4055,    677,  -2838,
+     -4090,  -6834,  -8749,  -9647,  -7417,  -6217,  -4193,  -1638,   1077,   5608,   7482,   8447,
+      8306,   9056,   6697,   3513,   -142,  -3849,  -5124,  -7672,  -9148,  -9404,  -6403,  -4426,
+     -1754,   1177,   3888,   7969,   8957,   8678,   7094,   6403,   2838,  -1097,  -4879,  -8003,
+     -8003,  -8720,  -8051,  -6157,  -1349,   1777,   4700,   6876,   7868,   9479,   7592,   4480,
+       571,  -1517,  -5261,  -8051,  -9479,  -9363,  -5741,  -3047,    224,   3419,   7937,   9149,
+      8792,   6832,   3529,   1439,  -2859,  -6605,  -9177,  -8118,  -7407,  -5205,  -2005,   1491,
+      6569,   8443,   8694,   7166,   6103,   1930,  -2568,  -6570,  -9349,  -8368,  -7582,  -5184,
+     -1758,   3937,   6935,   8545,   8310,   6167,   4512,    -55,  -4592,  -8197,  -8116,  -8092,
+     -6170,  -2870,    966,   6409,   8475,   8616,   6678,   5037,    344,  -4361,  -8066,  -7940,
+     -7710,  -5477,  -1878,   2105,   7433,   9079,   8556,   5863,   3593,  -1388,  -5888,  -8868,
+     -9671,  -6139,  -2856,   1265,   5029,   9368,   9445,   7151,   2957,  -2143,  -4851,  -8088,
+     -9035,  -7539,  -2074,   2203,   6023,   8181,   7928,   7234,   2638,  -2641,  -7216,  -7844,
+     -7959,  -5595,  -1562,   2824,   8178,   9271,   7673,   3705,    464,  -4685,  -8258,  -9287,
+     -7574,  -1728,   2845,   6621,   8262,   9137,   5357,     16,  -5332,  -9106,  -8174,  -6397,
+     -2440,   2263,   8060,   9454,   7857,   3634,  -1967,  -5168,  -8434,  -8745,  -6132,    416,
+      5102,   8186,   8422,   5547,   2442,  -3343,  -7868,  -9673,  -6206,  -2221,   2741,   6715,
+      8077,   8189,   3482,  -2444,  -7560,  -8075,  -7278,  -3570,   1488,   5813,   9619,   7949,
+      3293,  -2741,  -5949,  -8550,  -7639,  -3732,   1464,   7765,   9190,   7019,   1917,  -2210,
+     -7148,  -9017,  -7222,  -2665,   4654,   8272,   8535,   5122,   1299,  -4769,  -8663,  -8913,
+     -5585,   1772,   6598,   8659,   6852,   3787,  -2618,  -7717,  -9459,  -7258,   -220,   5147,
+      8293,   7588,   5168,  -1268,  -6969,  -9538,  -7992,  -1179,   4414,   8038,   7784,   5586,
+      -902,  -6804,  -9548,  -8030,  -1120,   4566,   8133,   7633,   5115,  -1549,  -7298,  -9542,
+     -7384,    -41,   5567,   8479,   7004,   3675,  -3155,  -8238,  -9224,  -3776,   2070,   7153,
+      8629,   5481,   1127,  -5465,  -9053,  -7984,   -988,   5016,   8669,   7780,   2556,  -2432,
+     -7763,  -8759,  -5108,   3039,   8033,   8945,   5003,  -1900,  -6180,  -8678,  -6196,   -346,
+      7412,   9520,   6565,    -68,  -6893,  -8241,  -6512,   -886,   5161,   9925,   7460,    953,
+     -6087,  -9815,  -6245,   -614,   5550,   8324,   7819,   1164,  -5901,  -9405,  -7497,    469,
+      6545,   8804,   5566,    562,  -6269,  -8941,  -6066,    315,   8003,   9089,   4629,  -2879,
+     -6952,  -8089,  -3788,   2944,   7517,   8744,   2738,  -4892,  -9505,  -6338,   -488,   5988,
+      8544,   5177,   -167,  -7008,  -9051,  -5217,   3698,   8697,   8148,   2089,  -5709,  -8219,
+     -6726,   -488,   5922,   9831,   5523,  -2314,  -8572,  -9201,  -2010,   5006,   8650,   6018,
+       667,  -6591,  -8870,  -4847,   2296,   9166,   7854,   1001,  -6783,  -8128,  -4970,   2121,
+      7629,   7160,   2747,  -5289,  -9281,  -6584,   2527,   8342,   8197,   1832,  -6315,  -8380,
+     -5662,   1492,   7288,   8976,   2362,  -5787,  -9530,  -6301,   3109,   8525,   7395,    223,
+     -5688,  -8519,  -4325,   3235,   7795,   7394,   -502,  -7894,  -9205,  -1672,   5828,   8898,
+      4650,  -3850,  -7990,  -7157,   -336,   6492,   9351,   3069,  -5486,  -9570,  -4082,   3639,
+      8784,   6618,  -1440,  -6920,  -7903,  -1870,   5660,   9895,   4448,  -4362,  -9329,  -6531,
+      3280,   8868,   6994,  -1128,  -6743,  -7600,  -1275,   6259,   7913,   3839,  -5035,  -9141,
+     -5190,   4932,   9454,   5912,  -2928,  -9466,  -6108,   1465,   7971,   7014,   1077,  -7014,
+     -8147,  -1673,   5993,   9327,   2586,  -6324,  -9466,  -2245,   5958,   9002,   3548,  -5678,
+     -8276,  -4321,   4035,   8338,   6036,  -3235,  -8910,  -5908,   2431,   9595,   6025,  -3206,
+     -9493,  -5033,   3272,   8816,   5632,  -3593,  -8086,  -5849,   2494,   8122,   6944,  -2367,
+     -8821,  -6325,   2149,   9561,   5859,  -3616,  -9618,  -4383,   4266,   8974,   4375,  -5256,
+     -8328,  -4055,   4692,   8269,   4468,  -5154,  -8874,  -3220,   5352,   9292,   1976,  -7240,
+     -8978,    212,   8079,   7692,  -1050,  -9189,  -6329,   2082,   8432,   5270,  -2419,  -8549,
+     -4811,   4194,   8009,   3928,  -5867,  -8934,  -2337,   8105,   8371,   -327,  -8727,  -7856,
+      2859,   8992,   5091,  -4948,  -8149,  -3107,   5947,   8087,    303,  -6925,  -7485,    814,
+      7818,   6878,  -3176,  -9081,  -4436,   4793,   9255,   1447,  -7915,  -8272,   2328,   9087,
+      5434,  -4835,  -9977,  -2299,   6803,   7856,   -989,  -7547,  -6016,   3259,   8434,   2613,
+     -5613,  -8306,   -644,   7392,   7365,  -2848,  -9118,  -4209,   7274,   8900,     93,  -8710,
+     -7024,   4529,   9311,   2735,  -7478,  -6907,   1671,   8819,   4820,  -5819,  -8014,   -976,
+      7721,   6272,  -2018,  -8466,  -3238,   6304,   7137,   -396,  -8477,  -5056,   4801,   9580,
+       961,  -8247,  -6452,   3384,   9642,   1992,  -7941,  -7486,   4210,   9500,   2689,  -7685,
+     -8229,   3247,   9264,   3060,  -7564,  -6700,   2577,   9003,   3126,  -7630,  -7037,   2211,
+      8762,   2898,  -5854,  -7209,   2155,   8548,   2376,  -6328,  -7208,   2404,   8333,   3597,
+     -6973,  -6993,   2941,   8059,   2446,  -7728,  -6506,   3729,   9681,    959,  -8492,  -5675,
+      4699,   8981,   -853,  -9128,  -4432,   7780,   7872,  -2935,  -9452,  -2746,   8696,   6223,
+     -5156,  -9259,   1397,   9249,   3948,  -7293,  -8344,   3759,   9149,   1064,  -9022,  -4518,
+      6099,   8106,  -2259,  -9943,  -1876,   7987,   5913,  -5643,  -7613,   1402,   8883,   2573,
+     -8504,  -5859,   4804,   8265,  -1590,  -8080,  -2666,   7536,   5821,  -5860,  -7812,   1471,
+      8682,   1685,  -7134,  -5351,   5547,   7487,  -3373,  -8379,  -1054,   8196,   3775,  -5913,
+     -6791,   3893,   8134,  -1693,  -8356,  -2521,   7637,   4805,  -5112,  -7382,   3036,   8300,
+     -1016,  -8285,  -2972,   7455,   4973,  -5034,  -7397,   3125,   8245,    681,  -8366,  -2448,
+      7761,   4328,  -5708,  -6839,   4146,   7896,   -687,  -8443,   -898,   8339,   2723,  -6903,
+     -5435,   5898,   6856,  -2965,  -8013,   1702,   8614,    -44,  -8024,  -2790,   7828,   4533,
+     -5696,  -6296,   5053,   7658,  -3877,  -8028,   1241,   8832,    509,  -7774,  -2596,   8105,
+      4481,  -7847,  -5649,   5914,   7384,  -4714,  -7438,   2893,   8912,  -1078,  -9868,   -320,
+      9070,   2467,  -8973,  -3200,   8085,   5485,  -7101,  -7453,   6304,   7726,  -4617,  -8822,
+      4095,   9111,  -1876,  -9350,   -265,   9696,    832,  -9139,  -2430,   9617,   3302,  -8349,
+     -4288,   6999,   5417,  -7159,  -5760,   6118,   7131,  -5738,  -6832,   5082,   6407,  -4232,
+     -7533,   4021,   7388,  -2751,  -7921,   3027,   8088,  -3421,  -8065,   2166,   8578,  -2198,
+     -8032,   1476,   8925,  -1158,  -9933,    978,   9186,   -316,  -9725,    681,   9406,    323,
+     -9492,  -1460,   9615,    759,  -9261,  -1352,   9833,    991,  -9041,  -1039,   8016,   1021,
+     -8831,   -524,   8249,    848,  -8614,    195,   8462,  -1576,  -8360,   1115,   8618,  -2151,
+     -8026,   2229,   8665,  -2911,  -9601,   3517,   8544,  -3830,  -8927,   4943,   8186,  -4859,
+     -7980,   4397,   7522,  -5924,  -6696,   5885,   6493,  -6916,  -5025,   7233,   3017,  -7696,
+     -2953,   8288,   1198,  -8095,   -517,   8873,   -940,  -7934,   2173,   8812,  -3246,  -9097,
+      4923,   7962,  -5481,  -7377,   7450,   6258,  -7327,  -4814,   7359,   3760,  -8416,  -1550,
+      8377,    698,  -8396,   2093,   8145,  -4558,  -7022,   5609,   6508,  -7334,  -4260,   8366,
+      3574,  -9022,  -2427,   9722,   -212,  -9040,   1956,   9209,  -4073,  -7080,   5930,   4678,
+     -7011,  -3294,   8471,    660,  -8050,   1589,   8738,  -3887,  -8624,   6332,   6425,  -7565,
+     -4714,   9473,   2045,  -8974,    676,   7772,  -3034,  -7273,   5842,   4963,  -6899,  -2684,
+      8837,   -143,  -9827,   3314,   8285,  -5536,  -6945,   8345,   4174,  -8719,  -1149,   8039,
+     -1797,  -7854,   5131,   5436,  -6701,  -2899,   8817,   -423,  -9776,   3959,   7797,  -6457,
+     -5895,   9110,   2392,  -9026,   1128,   7409,  -4327,  -6134,   7298,   2498,  -8018,    906,
+      8641,  -4653,  -7867,   7751,   4029,  -9053,   -751,   9643,  -3457,  -7118,   6508,   2939,
+     -8158,    263,   8449,  -4866,  -5977,   7692,   3330,  -9425,   -150,   9115,  -4755,  -6430,
+      7128,   3111,  -8622,   2088,   7386,  -7112,  -4247,   8707,    185,  -9585,   4843,   7103,
+     -7605,  -3369,   7982,  -1324,  -7842,   5825,   3898,  -7855,    352,   8556,  -5285,  -7084,
+      8639,   1718,  -9290,   2609,   7831,  -7036,  -2966,   8421,  -1284,  -7106,   6838,   3402,
+     -9728,   2258,   8374,  -6364,  -4926,   9827,   -402,  -8153,   5575,   3812,  -7992,   1055,
+      8160,  -6474,  -3659,   9309,   -768,  -8613,   5216,   5152,  -8545,   1113,   7416,  -5466,
+     -3325,   9013,  -2387,  -8478,   7766,   3275,  -9168,   2388,   7946,  -7190,  -1729,   8500,
+     -5129,  -5253,   8644,     47,  -9157,   6631,   5065,  -8822,   1232,   6827,  -6364,  -2411,
+      8789,  -4392,  -5354,   8753,    350,  -8926,   4973,   4924,  -8694,   2154,   6535,  -6758,
+     -1010,   8804,  -5535,  -5855,   9521,  -1481,  -7737,   6766,   2745,  -8379,   4973,   4546,
+     -9747,   2551,   7599,  -7868,  -2065,   9619,  -5061,  -4356,   8494,  -3727,  -6042,   8402,
+      -134,  -8975,   7487,   3339,  -8984,   3951,   4385,  -8152,   2158,   6922,  -8638,    310,
+      8815,  -6509,  -3433,   8004,  -3995,  -4821,   8630,  -3323,  -5804,   8735,   -559,  -8382,
+      6379,   2122,  -8462,   5780,   2574,  -8120,   4999,   4832,  -9458,   2091,   6818,  -8449,
+      1235,   6476,  -7210,    445,   7916,  -7860,  -2281,   9115,  -6363,  -2821,   8062,  -4824,
+     -3208,   8888,  -5335,  -5487,   9587,  -3833,  -5569,   8147,  -2396,  -5511,   8697,  -3089,
+     -7376,   9219,  -1831,  -7081,   7688,   -675,  -6691,   8221,  -1678,  -6215,   8784,   -745,
+     -7712,   7338,     75,  -7093,   7989,  -1267,  -6408,   8688,   -674,  -7707,   7387,   -196,
+     -6888,   8175,  -1878,  -5993,   8996,  -1623,  -7059,   7786,  -1475,  -5977,   8623,  -3475,
+     -4782,   9437,  -3518,  -5507,   8148,  -3633,  -4043,   8823,  -5848,  -2426,   9374,  -6034,
+     -2704,   7717,  -6202,   -781,   7909,  -8347,   1277,   7865,  -8314,   1391,   5511,  -8088,
+      3611,   4926,  -9643,   5819,   4065,  -8815,   5885,    907,  -7590,   7797,   -394,  -7973,
+      9396,  -1796,  -5852,   8515,  -5224,  -3295,   9142,  -6423,  -2426,   9147,  -7268,    728,
+      6444,  -9619,   3933,   5156,  -9217,   4912,   3336,  -7986,   7496,   -871,  -7925,   9375,
+     -3095,  -4996,   8275,  -5046,  -1424,   8149,  -8401,    436,   6938,  -8726,   4268,   2745,
+     -7817,   7546,     -2,  -7631,   7756,  -2858,  -4199,   8631,  -7279,     68,   7956,  -8569,
+      2533,   3798,  -8304,   6569,    680,  -8311,   9392,  -2736,  -4636,   8391,  -7618,    133,
+      7430,  -9007,   3069,   4699,  -8333,   7214,  -1123,  -7487,   9556,  -4842,  -2805,   7459,
+     -7280,   2663,   5060,  -9492,   5516,   1066,  -6970,   8509,  -5216,  -2169,   8725,  -8104,
+      1650,   4093,  -8350,   6861,   -328,  -7507,   9748,  -4842,  -2108,   7299,  -9539,   4141,
+      3836,  -8904,   7020,  -1195,  -4783,   8794,  -7537,   1561,   6772,  -8896,   5710,    -99,
+     -6245,   9236,  -5334,  -2342,   8612,  -8182,   4534,   2213,  -8827,   9285,  -3510,  -3336,
+      7659,  -7333,   3904,   3681,  -8787,   7353,  -2341,  -3522,   8317,  -8742,   3992,   4378,
+     -8404,   7765,  -3970,  -2962,   8681,  -8435,   2793,   4333,  -7724,   8493,  -4299,  -3691,
+      8693,  -8377,   4353,   1445,  -6591,   9347,  -5271,  -1539,   6062,  -8265,   6441,   -252,
+     -6737,   9911,  -6594,   1463,   4526,  -9616,   8625,  -2724,  -3721,   7504,  -7667,   5065,
+      1770,  -7641,   8068,  -5490,    514,   5537,  -9572,   8496,  -2036,  -3820,   7784,  -9503,
+      5409,   1662,  -7129,   8309,  -5849,   1702,   4820,  -9069,   7348,  -3356,  -1908,   7008,
+     -9683,   7402,   -589,  -4958,   8123,  -9250,   4873,   1991,  -7238,   8285,  -6086,   2223,
+      4116,  -8742,   7731,  -4635,   -257,   5686,  -9591,   8776,  -3131,  -2403,   6718,  -9959,
+      7564,  -1762,  -4157,   7301,  -7982,   6332,   -644,  -5525,   7545,  -7916,   5218,    171,
+     -6547,   9611,  -7838,   4305,    667,  -7278,   9492,  -7838,   3646,    843,  -5711,   9298,
+     -7965,   3266,    704,  -5970,   9059,  -8245,   3172,   2302,  -6008,   8774,  -8666,   3357,
+      1535,  -5803,   8404,  -9189,   5844,    448,  -5318,   7884,  -7694,   6487,   -957,  -4499,
+      7117,  -8168,   7248,  -2649,  -3300,   8039,  -8414,   7992,  -4556,  -1706,   6444,  -8258,
+      8532,  -6537,   2290,   4302,  -7515,   8627,  -8366,   4453,   1612,  -6036,   8010,  -7686,
+      6571,  -1496,  -3766,   6445,  -8229,   8253,  -4722,   -817,   5853,  -7599,   9012,  -7571,
+      2454,   2241,  -5593,   8371,  -9412,   7478,  -1923,  -2296,   6031,  -9610,   9344,  -5860,
+      1774,   2079,  -5717,   9287,  -8536,   5633,  -2825,  -1959,   6828,  -8953,   7993,  -5387,
+      2847,   2194,  -6592,   7678,  -8129,   7118,  -3437,  -1891,   6271,  -7698,   8989,  -8077,
+      3538,    481,  -3842,   7147,  -9618,   9310,  -5467,   2067,   1776,  -6945,   9108,  -8716,
+      7181,  -4955,   1053,   4404,  -7226,   8394,  -9533,   7141,  -2774,  -1403,   4314,  -6946,
+      9412,  -8304,   5364,  -3178,  -1182,   5700,  -8333,   8278,  -7267,   6076,  -2127,  -2395,
+      4535,  -7382,   9174,  -8533,   5217,  -1677,   -948,   4911,  -8171,   7964,  -7953,   6829,
+     -3849,   -923,   4709,  -6474,   8575,  -9440,   6659,  -4448,   1770,   1782,  -6186,   8677,
+     -8579,   8496,  -7335,   2919,    191,  -3015,   5884,  -9026,   9817,  -7975,   6287,  -4001,
+    -32720, -18519,  -4317,   9885,  24086, -27248, -13046,   1156,  15357,  29559, -21775,  -7574,
+      6628,  20830, -30505, -16303,  -2101,  12100,  26302, -25032, -10830,   3371,  17573,  31775,
+    -19560,  -5358,   8844,  23045, -28289, -14087,    114,  14316,  28518, -22816,  -8615,   5587,
+     19789, -31546, -17344,  -3142,  11059,  25261, -26073, -11872,   2330,  16532,  30734, -20601,
+     -6399,   7803,  22004, -29330, -15128,   -927,  13275,  27477, -23858,  -9656,   4546,  18748,
+    -32587, -18385,  -4183,  10018,  24220, -27114, -12913,   1289,  15491,  29692, -21642,  -7440,
+      6762,  20963, -30371, -16169,  -1968,  12234,  26436, -24899, -10697,   3505,  17706,  31908,
+    -19426,  -5225,   8977,  23179, -28155, -13954,    248,  14450,  28651, -22683,  -8481,   5720,
+     19922, -31412, -17211,  -3009,  11193,  25395, -25940, -11738,   2464,  16665,  30867, -20467,
+     -6266,   7936,  22138, -29197, -14995,   -793,  13409,  27610, -23724,  -9522,   4679,  18881,
+    -32453, -18252,  -4050,  10152,  24353, -26981, -12779,   1423,  15624,  29826, -21508,  -7307,
+      6895,  21097, -30238, -16036,  -1834,  12367,  26569, -24765, -10563,   3638,  17840,  32042,
+    -19293,  -5091,   9111,  23312, -28022, -13820,    381,  14583,  28785, -22549,  -8348,   5854,
+     20056, -31279, -17077,  -2875,  11326,  25528, -25806, -11605,   2597,  16799,  31000, -20334,
+     -6132,   8070,  22271, -29063, -14861,   -660,  13542,  27744, -23591,  -9389,   4813,  19014,
+    -32320, -18118,  -3916,  10285,  24487, -26847, -12646,   1556,  15758,  29959, -21375,  -7173,
+      7028,  21230, -30104, -15902,  -1701,  12501,  26703, -24632, -10430,   3772,  17973,  32175,
+    -19159,  -4958,   9244,  23446, -27888, -13687,    515,  14717,  28918, -22416,  -8214,   5987,
+     20189, -31145, -16944,  -2742,  11460,  25662, -25673, -11471,   2731,  16932,  31134, -20200,
+     -5999,   8203,  22405, -28930, -14728,   -526,  13676,  27877, -23457,  -9255,   4946,  19148,
+    -32186, -17985,  -3783,  10419,  24620, -26714, -12512,   1690,  15891,  30093, -21241,  -7040,
+      7162,  21364, -29971, -15769,  -1567,  12634,  26836, -24498, -10297,   3905,  18107,  32309,
+    -19026,  -4824,   9378,  23579, -27755, -13553,    648,  14850,  29052, -22283,  -8081,   6121,
+     20323, -31012, -16810,  -2608,  11593,  25795, -25539, -11338,   2864,  17066,  31267, -20067,
+     -5865,   8337,  22538, -28796, -14594,   -393,  13809,  28011, -23324,  -9122,   5080,  19281,
+    -32053, -17851,  -3649,  10552,  24754, -26580, -12379,   1823,  16025,  30226, -21108,  -6906,
+      7295,  21497, -29837, -15635,  -1434,  12768,  26970, -24365, -10163,   4039,  18240,  32442,
+    -18892,  -4691,   9511,  23713, -27621, -13420,    782,  14984,  29185, -22149,  -7947,   6254,
+     20456, -30878, -16677,  -2475,  11727,  25928, -25406, -11204,   2998,  17199,  31401, -19933,
+     -5732,   8470,  22672, -28663, -14461,   -259,  13942,  28144, -23190,  -8988,   5213,  19415,
+    -31919, -17718,  -3516,  10686,  24887, -26447, -12245,   1956,  16158,  30360, -20974,  -6773,
+      7429,  21631, -29704, -15502,  -1300,  12901,  27103, -24231, -10030,   4172,  18374,  32576,
+    -18759,  -4557,   9645,  23846, -27488, -13286,    915,  15117,  29319, -22016,  -7814,   6388,
+     20590, -30745, -16543,  -2341,  11860,  26062, -25272, -11071,   3131,  17333,  31534, -19800,
+     -5598,   8604,  22805, -28529, -14327,   -126,  14076,  28278, -23057,  -8855,   5347,  19548,
+    -31786, -17584,  -3383,  10819,  25021, -26313, -12112,   2090,  16292,  30493, -20841,  -6639,
+      7562,  21764, -29570, -15369,  -1167,  13035,  27237, -24098,  -9896,   4306,  18507,  32709,
+    -18625,  -4424,   9778,  23980, -27355, -13153,   1049,  15251,  29452, -21882,  -7680,   6521,
+     20723, -30611, -16410,  -2208,  11994,  26195, -25139, -10937,   3265,  17466,  31668, -19666,
+     -5465,   8737,  22939, -28396, -14194,      8,  14209,  28411, -22923,  -8721,   5480,  19682,
+    -31652, -17451,  -3249,  10953,  25154, -26180, -11978,   2223,  16425,  30627, -20707,  -6506,
+      7696,  21898, -29437, -15235,  -1033,  13168,  27370, -23964,  -9763,   4439,  18641, -32693,
+    -18492,  -4290,   9912,  24113, -27221, -13019,   1182,  15384,  29586, -21749,  -7547,   6655,
+     20856, -30478, -16276,  -2074,  12127,  26329, -25005, -10804,   3398,  17600,  31801, -19533,
+     -5331,   8870,  23072, -28262, -14060,    141,  14343,  28545, -22790,  -8588,   5614,  19815,
+    -31519, -17317,  -3116,  11086,  25288, -26046, -11845,   2357,  16559,  30760, -20574,  -6372,
+      7829,  22031, -29303, -15102,   -900,  13302,  27504, -23831,  -9629,   4573,  18774, -32560,
+    -18358,  -4157,  10045,  24247, -27088, -12886,   1316,  15518,  29719, -21615,  -7413,   6788,
+     20990, -30344, -16143,  -1941,  12261,  26462, -24872, -10670,   3532,  17733,  31935, -19399,
+     -5198,   9004,  23206, -28129, -13927,    275,  14476,  28678, -22656,  -8455,   5747,  19949,
+    -31385, -17184,  -2982,  11220,  25421, -25913, -11711,   2490,  16692,  30894, -20441,  -6239,
+      7963,  22165, -29170, -14968,   -766,  13435,  27637, -23697,  -9496,   4706,  18908, -32427,
+    -18225,  -4023,  10179,  24380, -26954, -12752,   1449,  15651,  29853, -21482,  -7280,   6922,
+     21123, -30211, -16009,  -1807,  12394,  26596, -24738, -10537,   3665,  17867,  32068, -19266,
+     -5064,   9137,  23339, -27995, -13793,    408,  14610,  28812, -22523,  -8321,   5881,  20082,
+    -31252, -17050,  -2849,  11353,  25555, -25779, -11578,   2624,  16826,  31027, -20307,  -6105,
+      8096,  22298, -29036, -14835,   -633,  13569,  27770, -23564,  -9362,   4840,  19041, -32293,
+    -18091,  -3890,  10312,  24514, -26821, -12619,   1583,  15784,  29986, -21348,  -7146,   7055,
+     21257, -30077, -15876,  -1674,  12528,  26729, -24605, -10403,   3798,  18000,  32202, -19132,
+     -4931,   9271,  23473, -27862, -13660,    542,  14743,  28945, -22389,  -8188,   6014,  20216,
+    -31118, -16917,  -2715,  11487,  25688, -25646, -11444,   2757,  16959,  31161, -20174,  -5972,
+      8230,  22432, -28903, -14701,   -499,  13702,  27904, -23430,  -9229,   4973,  19175, -32160,
+    -17958,  -3756,  10446,  24647, -26687, -12485,   1716,  15918,  30120, -21215,  -7013,   7189,
+     21390, -29944, -15742,  -1540,  12661,  26863, -24471, -10270,   3932,  18134,  32335, -18999,
+     -4797,   9404,  23606, -27728, -13527,    675,  14877,  29079, -22256,  -8054,   6148,  20349,
+    -30985, -16783,  -2582,  11620,  25822, -25513, -11311,   2891,  17093,  31294, -20040,  -5838,
+      8363,  22565, -28769, -14568,   -366,  13836,  28037, -23297,  -9095,   5107,  19308, -32026,
+    -17824,  -3623,  10579,  24781, -26554, -12352,   1850,  16051,  30253, -21081,  -6879,   7322,
+     21524, -29810, -15609,  -1407,  12795,  26996, -24338, -10136,   4065,  18267,  32469, -18865,
+     -4664,   9538,  23740, -27595, -13393,    809,  15010,  29212, -22122,  -7921,   6281,  20483,
+    -30851, -16650,  -2448,  11754,  25955, -25379, -11177,   3024,  17226,  31428, -19907,  -5705,
+      8497,  22698, -28636, -14434,   -232,  13969,  28171, -23163,  -8962,   5240,  19442, -31893,
+    -17691,  -3489,  10712,  24914, -26420, -12218,   1983,  16185,  30387, -20948,  -6746,   7456,
+     21657, -29677, -15475,  -1274,  12928,  27130, -24204, -10003,   4199,  18401,  32602, -18732,
+     -4530,   9671,  23873, -27461, -13260,    942,  15144,  29346, -21989,  -7787,   6415,  20616,
+    -30718, -16516,  -2315,  11887,  26089, -25246, -11044,   3158,  17360,  31561, -19773,  -5571,
+      8630,  22832, -28502, -14301,    -99,  14103,  28304, -23030,  -8828,   5374,  19575, -31759,
+    -17557,  -3356,  10846,  25048, -26287, -12085,   2117,  16318,  30520, -20814,  -6613,   7589,
+     21791, -29543, -15342,  -1140,  13062,  27263, -24071,  -9869,   4332,  18534,  32736, -18599,
+     -4397,   9805,  24007, -27328, -13126,   1076,  15277,  29479, -21855,  -7654,   6548,  20750,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+    -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,     12,     23,     32,     38,     40,     38,     33,     25,     14,      2,    -11,
+       -22,    -31,    -37,    -40,    -39,    -34,    -26,    -15,     -3,      9,     20,     30,
+        37,     40,     39,     35,     27,     17,      5,     -7,    -19,    -29,    -36,    -40,
+       -39,    -36,    -28,    -18,     -7,      6,     18,     28,     35,     39,     40,     36,
+        29,     20,      8,     -4,    -16,    -26,    -34,    -39,    -40,    -37,    -31,    -21,
+       -10,      2,     14,     25,     33,     39,     40,     38,     32,     23,     11,     -1,
+       -13,    -24,    -33,    -38,    -40,    -38,    -33,    -24,    -13,     -1,     11,     22,
+        32,     38,     40,     39,     34,     25,     15,      3,    -10,    -21,    -30,    -37,
+       -40,    -39,    -34,    -27,    -16,     -4,      8,     20,     29,     36,     40,     39,
+        35,     28,     18,      6,     -6,    -18,    -28,    -36,    -39,    -40,    -36,    -29,
+       -19,     -8,      5,     17,     27,     35,     39,     40,     37,     30,     21,      9,
+        -3,    -15,    -26,    -34,    -39,    -40,    -37,    -31,    -22,    -11,      2,     14,
+        24,     33,     38,     40,     38,     32,     23,     12,      0,    -12,    -23,    -32,
+       -38,    -40,    -38,    -33,    -25,    -14,     -2,     10,     22,     31,     37,     40,
+        39,     34,     26,     15,      3,     -9,    -20,    -30,    -37,    -40,    -39,    -35,
+       -27,    -17,     -5,      7,     19,     29,     36,     40,     39,     36,     28,     18,
+         7,     -6,    -17,    -28,    -35,    -39,    -40,    -36,    -30,    -20,     -8,      4,
+        16,     26,     34,     39,     40,     37,     31,     21,     10,     -2,    -14,    -25,
+       -33,    -39,    -40,    -38,    -32,    -23,    -12,      1,     13,     24,     32,     38,
+        40,     38,     33,     24,     13,      1,    -11,    -22,    -31,    -37,    -40,    -39,
+       -34,    -25,    -15,     -3,     10,     21,     30,     37,     40,     39,     34,     27,
+        16,      4,     -8,    -20,    -29,    -36,    -40,    -39,    -35,    -28,    -18,     -6,
+         6,     18,     28,     35,     39,     40,     36,     29,     19,      8,     -5,    -17,
+       -27,    -35,    -39,    -40,    -37,    -30,    -21,     -9,      3,     15,     26,     34,
+        39,     40,     37,     31,     22,     11,     -1,    -13,    -24,    -33,    -38,    -40,
+       -38,    -32,    -23,    -12,      0,     12,     23,     32,     38,     40,     38,     33,
+        25,     14,      2,    -10,    -22,    -31,    -37,    -40,    -39,    -34,    -26,    -16,
+        -4,      9,     20,     30,     36,     40,     39,     35,     27,     17,      5,     -7,
+       -19,    -29,    -36,    -40,    -40,    -36,    -29,    -19,     -7,      5,     17,     27,
+        35,     39,     40,     36,     30,     20,      9,     -4,    -16,    -26,    -34,    -39,
+       -40,    -37,    -31,    -21,    -10,      2,     14,     25,     33,     38,     40,     38,
+        32,     23,     12,      0,    -13,    -24,    -32,    -38,    -40,    -38,    -33,    -24,
+       -13,     -1,     11,     22,     31,     37,     40,     39,     34,     26,     15,      3,
+        -9,    -21,    -30,    -37,    -40,    -39,    -35,    -27,    -16,     -5,      8,     19,
+        29,     36,     40,     39,     35,     28,     18,      6,     -6,    -18,    -28,    -35,
+       -39,    -40,    -36,    -29,    -19,     -8,      5,     16,     27,     35,     39,     40,
+        37,     30,     21,      9,     -3,    -15,    -26,    -34,    -39,    -40,    -37,    -31,
+       -22,    -11,      1,     13,     24,     33,     38,     40,     38,     32,     24,     13,
+         0,    -12,    -23,    -32,    -38,    -40,    -38,    -33,    -25,    -14,     -2,     10,
+        21,     31,     37,     40,     39,     34,     26,     16,      4,     -9,    -20,    -30,
+     32767,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0, -32768,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,  32767,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0, -32768,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,  32767,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0, -32768,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,  32767,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0, -32768,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,  32767,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0, -32768,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+};
+
+static const uint8_t msbc_vector_frames[MSBC_VECTOR_FRAMES][MSBC_FRAME_LEN] = {
+    {
+        0xad, 0x00, 0x00, 0x44, 0xd7, 0x69, 0x88, 0x78, 0x7e, 0xdb, 0x6d, 0x5f, 0xb6, 0xdb, 0x58, 0x0d,
+        0xb6, 0xd6, 0x0c, 0x8d, 0xb5, 0x8c, 0xf3, 0x29, 0xaa, 0x99, 0x0b, 0x5b, 0xf9, 0x56, 0x53, 0x06,
+        0x91, 0xc6, 0xa9, 0x61, 0x6d, 0x1e, 0x38, 0x99, 0x64, 0x86, 0x57, 0x00, 0xf8, 0x75, 0xb9, 0x6c,
+        0x12, 0x64, 0x6b, 0xa4, 0x5c, 0x9b, 0xd1, 0x36, 0xc8,
+    },
+    {
+        0xad, 0x00, 0x00, 0x45, 0xda, 0x79, 0x68, 0x78, 0x77, 0x16, 0xa6, 0x0e, 0xc5, 0x8c, 0x66, 0xd0,
+        0x4a, 0xd3, 0x03, 0xd4, 0x96, 0x90, 0xe6, 0xb0, 0x0e, 0x31, 0xab, 0x98, 0x4f, 0x52, 0x46, 0xfc,
+        0x12, 0xc9, 0x4a, 0xc5, 0xac, 0x9b, 0x50, 0xb2, 0x8c, 0x2e, 0x68, 0xe9, 0x11, 0xd4, 0x91, 0x8d,
+        0xb4, 0xb2, 0x68, 0x11, 0x6b, 0x24, 0x36, 0x6a, 0x60,
+    },
+    {
+        0xad, 0x00, 0x00, 0xa6, 0xdd, 0x79, 0x77, 0x78, 0xc1, 0x0b, 0x19, 0x92, 0x36, 0x95, 0x4a, 0x73,
+        0x29, 0x19, 0x9a, 0xcd, 0x60, 0x8d, 0x4b, 0x56, 0x5d, 0xa6, 0xa4, 0x18, 0x75, 0xa5, 0xa5, 0xd2,
+        0x4b, 0x52, 0x8f, 0x63, 0x52, 0x1a, 0x28, 0xc6, 0x69, 0x73, 0x25, 0x51, 0x9b, 0xea, 0x46, 0x90,
+        0xb3, 0x59, 0x1d, 0x5c, 0xd5, 0x97, 0xe7, 0xce, 0x68,
+    },
+    {
+        0xad, 0x00, 0x00, 0xd8, 0x9d, 0x89, 0x48, 0x78, 0xf4, 0xf0, 0x71, 0x07, 0x3c, 0x21, 0x6b, 0x1b,
+        0x15, 0x02, 0x54, 0x3d, 0xb9, 0x5d, 0x0c, 0xa4, 0x64, 0x73, 0x14, 0x98, 0x3c, 0xee, 0xc9, 0xd8,
+        0xbe, 0x18, 0x7b, 0xcf, 0x11, 0x9e, 0x73, 0x1b, 0x47, 0x3a, 0xe8, 0x59, 0xd7, 0xd5, 0x40, 0x7d,
+        0x59, 0x6e, 0x5c, 0xbd, 0x29, 0x17, 0x1c, 0x45, 0x24,
+    },
+    {
+        0xad, 0x00, 0x00, 0x92, 0x7d, 0xc9, 0x78, 0x78, 0x55, 0x35, 0xac, 0x96, 0x2d, 0xa9, 0x84, 0xb3,
+        0xa3, 0x19, 0x6f, 0x02, 0xb4, 0x5a, 0xcd, 0x29, 0xb2, 0x55, 0x83, 0x59, 0x7d, 0xaa, 0x52, 0x59,
+        0x78, 0xc6, 0x95, 0xdc, 0xad, 0x21, 0x57, 0x49, 0x68, 0x55, 0xeb, 0x02, 0x17, 0x8a, 0xb9, 0x86,
+        0x65, 0x24, 0x5d, 0xbc, 0x2c, 0x97, 0x77, 0x9a, 0xc8,
+    },
+    {
+        0xad, 0x00, 0x00, 0x57, 0x7b, 0xd9, 0x68, 0x78, 0x78, 0xde, 0xa6, 0x1a, 0xb5, 0x8c, 0x66, 0xbc,
+        0x8a, 0xd1, 0xac, 0xd4, 0x96, 0x59, 0x22, 0xb0, 0x15, 0xc7, 0xab, 0x95, 0x63, 0x12, 0x45, 0x5b,
+        0x42, 0xc9, 0x57, 0x5d, 0xac, 0xa2, 0x10, 0xb2, 0x8c, 0x79, 0xe8, 0xea, 0x5e, 0xa4, 0x91, 0x97,
+        0xd4, 0xb2, 0x65, 0xf5, 0x6b, 0x29, 0x82, 0x2a, 0x60,
+    },
+    {
+        0xad, 0x00, 0x00, 0x75, 0x67, 0xdb, 0x47, 0x78, 0x9c, 0xbc, 0x29, 0xa6, 0xe0, 0xe1, 0x48, 0x6e,
+        0xb1, 0x19, 0xca, 0x31, 0x60, 0x71, 0x7c, 0xc6, 0x58, 0x38, 0xa4, 0x15, 0x4a, 0x41, 0xa5, 0x66,
+        0x10, 0x12, 0x4c, 0x8b, 0x12, 0x13, 0x4d, 0xaa, 0x63, 0xb0, 0x00, 0x50, 0x9b, 0x1b, 0x46, 0x13,
+        0x49, 0x58, 0x08, 0x27, 0xb1, 0x91, 0x35, 0x94, 0x04,
+    },
+    {
+        0xad, 0x00, 0x00, 0xdc, 0x67, 0xcd, 0x57, 0x78, 0xea, 0x4c, 0x71, 0x39, 0xe6, 0xc8, 0xab, 0x27,
+        0x51, 0x82, 0xc5, 0x8a, 0xc9, 0xa0, 0xc5, 0x80, 0x69, 0x42, 0x76, 0x99, 0x91, 0x5d, 0x0a, 0x33,
+        0x0c, 0x08, 0x8d, 0x33, 0xb9, 0x9e, 0xb7, 0x5c, 0x46, 0x70, 0x1a, 0x19, 0x8c, 0x33, 0xe0, 0x50,
+        0xed, 0x52, 0x50, 0x40, 0x68, 0x14, 0x4f, 0xc3, 0xa4,
+    },
+    {
+        0xad, 0x00, 0x00, 0xe4, 0x77, 0x7d, 0xb8, 0x78, 0x58, 0x2e, 0xec, 0x97, 0x45, 0xb9, 0x84, 0xd1,
+        0x2f, 0x19, 0x6b, 0xa3, 0xb4, 0x55, 0x6c, 0xe9, 0xb1, 0x36, 0x3b, 0x59, 0xcc, 0xee, 0x52, 0x73,
+        0x6b, 0x46, 0x9b, 0x2a, 0xed, 0x25, 0xcb, 0xc1, 0x68, 0x2e, 0x53, 0x02, 0x03, 0x5c, 0xb9, 0x80,
+        0xce, 0xe4, 0x5d, 0x23, 0xac, 0x97, 0x89, 0x46, 0xc8,
+    },
+    {
+        0xad, 0x00, 0x00, 0xf4, 0x77, 0x7c, 0xd8, 0x78, 0x7c, 0xb5, 0x86, 0x1b, 0x32, 0x5c, 0x66, 0xad,
+        0x16, 0xd1, 0x9b, 0x75, 0x96, 0x52, 0xe5, 0x70, 0x14, 0x39, 0x5b, 0x95, 0x0d, 0x94, 0x45, 0x13,
+        0x34, 0xc9, 0x48, 0xc9, 0x0c, 0x92, 0xb1, 0x39, 0x47, 0xa3, 0x91, 0x0b, 0x08, 0xb5, 0x21, 0x96,
+        0xa9, 0xf2, 0x66, 0x2c, 0xa4, 0x29, 0xcb, 0xee, 0x60,
+    },
+    {
+        0xad, 0x00, 0x00, 0x24, 0x67, 0x59, 0xd9, 0x78, 0xac, 0xdd, 0x91, 0xa6, 0xce, 0xeb, 0x48, 0x73,
+        0x9e, 0x9a, 0x0d, 0x69, 0x40, 0x70, 0xcc, 0xce, 0x58, 0x09, 0x82, 0x16, 0x41, 0x3d, 0x25, 0x61,
+        0x07, 0x32, 0x4c, 0xe3, 0xea, 0x13, 0x31, 0x84, 0x63, 0xb1, 0x32, 0xd0, 0x9c, 0x88, 0xa6, 0x23,
+        0x55, 0xd4, 0x0c, 0x57, 0x01, 0x92, 0x22, 0xa0, 0x84,
+    },
+    {
+        0xad, 0x00, 0x00, 0x6d, 0x67, 0x69, 0xdc, 0x78, 0xeb, 0x1b, 0xc5, 0x39, 0xc9, 0x8c, 0xac, 0x2d,
+        0x64, 0xc2, 0xc3, 0x6c, 0xd9, 0xa0, 0xa3, 0xb8, 0x69, 0x06, 0xd3, 0x99, 0x83, 0x52, 0x4a, 0x33,
+        0x67, 0x78, 0x8c, 0xc6, 0x99, 0x9e, 0xa6, 0x3a, 0x46, 0x72, 0x70, 0x99, 0x8b, 0x63, 0xc0, 0x50,
+        0xd6, 0x8e, 0x50, 0x2a, 0x59, 0x14, 0x41, 0x62, 0x64,
+    },
+    {
+        0xad, 0x00, 0x00, 0xfc, 0x77, 0x79, 0xbd, 0x88, 0x58, 0xbd, 0x7a, 0x97, 0x34, 0xe7, 0x05, 0xcc,
+        0x94, 0x39, 0x6a, 0x5e, 0xec, 0x65, 0x25, 0x5b, 0xb1, 0x32, 0x18, 0xd9, 0xcd, 0x6b, 0xb2, 0xb3,
+        0x1d, 0x4e, 0x9a, 0x98, 0x5b, 0x25, 0xa9, 0xee, 0xe8, 0x2d, 0x77, 0xa2, 0x03, 0x5c, 0xf1, 0x80,
+        0xa7, 0x8a, 0x5d, 0x25, 0xf1, 0x57, 0x8b, 0x77, 0xa8,
+    },
+    {
+        0xad, 0x00, 0x00, 0x95, 0x77, 0x79, 0x7d, 0xb8, 0x7c, 0xea, 0x67, 0x1b, 0x38, 0xad, 0xa6, 0xb0,
+        0xb4, 0x71, 0x9c, 0x4d, 0xe2, 0x52, 0xeb, 0x39, 0x14, 0x3a, 0xb2, 0x55, 0x0d, 0x27, 0x75, 0x52,
+        0x29, 0xd5, 0x48, 0x9a, 0xa3, 0x96, 0xaa, 0xb8, 0x47, 0xa6, 0x52, 0x0b, 0x09, 0x4c, 0xc5, 0x96,
+        0x8b, 0x52, 0x66, 0x26, 0xd4, 0xa9, 0xce, 0xb4, 0x30,
+    },
+    {
+        0xad, 0x00, 0x00, 0x99, 0x67, 0x59, 0x4c, 0xd8, 0xac, 0xc6, 0xac, 0xa6, 0xc7, 0x8b, 0x09, 0x72,
+        0x58, 0xaa, 0x0d, 0x54, 0xa4, 0x70, 0xdc, 0x67, 0x5c, 0x0a, 0xe1, 0xd6, 0x41, 0x34, 0x95, 0x60,
+        0xec, 0x3a, 0x5c, 0xe3, 0x34, 0x13, 0x30, 0xf5, 0xe3, 0xb1, 0xc1, 0x50, 0xdc, 0x90, 0x36, 0x23,
+        0x54, 0x27, 0x0c, 0x56, 0xfa, 0x92, 0x22, 0xbb, 0x44,
+    },
+    {
+        0xad, 0x00, 0x00, 0x0f, 0x67, 0x69, 0x58, 0xdb, 0xeb, 0x4d, 0xdd, 0xb9, 0xe4, 0x4d, 0x8c, 0x32,
+        0xa9, 0xda, 0xc3, 0xb9, 0x27, 0xb0, 0x94, 0xd9, 0xe9, 0x22, 0x89, 0x69, 0x89, 0xe2, 0xe2, 0x72,
+        0xc3, 0x87, 0x8c, 0xe2, 0x2d, 0x9e, 0xc3, 0x6b, 0x87, 0x71, 0x0d, 0xe1, 0x8c, 0xa8, 0x84, 0x50,
+        0xed, 0xca, 0xd4, 0x25, 0x31, 0x24, 0x48, 0xa2, 0xac,
+    },
+    {
+        0xad, 0x00, 0x00, 0x2a, 0xcc, 0xde, 0xcc, 0xdd, 0x76, 0xdd, 0xba, 0xdd, 0xb7, 0x6c, 0xb6, 0x6d,
+        0xdb, 0x8d, 0xa3, 0x66, 0xd3, 0x27, 0x65, 0xa4, 0xa5, 0x35, 0x42, 0xc6, 0xa9, 0x29, 0x2e, 0x8a,
+        0xb8, 0xe4, 0x46, 0xe9, 0xe4, 0x5e, 0x13, 0x8e, 0x48, 0x29, 0x48, 0x68, 0xd2, 0xb6, 0x9d, 0x78,
+        0xa4, 0xe6, 0x9c, 0xb2, 0x79, 0x49, 0x92, 0x2c, 0xac,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc9, 0xbc, 0xce, 0xcc, 0xdd, 0x79, 0x31, 0x84, 0xc8, 0xd6, 0xaa, 0x2b, 0x78,
+        0xd4, 0x2d, 0x2b, 0x95, 0xa3, 0x17, 0x71, 0x13, 0x2d, 0xb5, 0x22, 0xc6, 0xa5, 0x29, 0x2f, 0x48,
+        0xb8, 0xe4, 0x26, 0xa9, 0xe4, 0x5e, 0x03, 0x8e, 0x4a, 0x29, 0x48, 0x68, 0x12, 0xb6, 0x9d, 0x88,
+        0xa4, 0xe6, 0x9c, 0xc2, 0x79, 0x4c, 0x9a, 0x2c, 0xac,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc9, 0xbc, 0xce, 0xcc, 0xdd, 0x89, 0x31, 0x84, 0xc8, 0xd6, 0xaa, 0x2c, 0x78,
+        0xd4, 0x2d, 0x2b, 0x95, 0xa3, 0x27, 0x71, 0x13, 0x2d, 0xb5, 0x22, 0xc7, 0xa5, 0x29, 0x2f, 0x88,
+        0xb8, 0xe4, 0x36, 0xa9, 0xe4, 0x5e, 0x03, 0x8e, 0x4a, 0x29, 0x48, 0x68, 0x12, 0xb6, 0x9d, 0x98,
+        0xa4, 0xe6, 0x9c, 0xc2, 0x79, 0x4d, 0x9a, 0x2c, 0xac,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc9, 0xbc, 0xce, 0xcc, 0xdd, 0x89, 0x31, 0x84, 0xcc, 0xd6, 0xaa, 0x2c, 0x78,
+        0xd4, 0x2d, 0x6b, 0x95, 0xa3, 0x27, 0x71, 0x13, 0x2d, 0xb5, 0x22, 0xc7, 0xa5, 0x29, 0x2f, 0x88,
+        0xb8, 0xe4, 0x36, 0xa9, 0xe4, 0x62, 0x03, 0x8e, 0x4b, 0x29, 0x48, 0x68, 0x52, 0xb6, 0x9d, 0x98,
+        0xa4, 0xe6, 0xa0, 0xc2, 0x79, 0x4d, 0x9a, 0x2c, 0xac,
+    },
+    {
+        0xad, 0x00, 0x00, 0x32, 0xcc, 0xce, 0xcc, 0xdd, 0x89, 0x31, 0x84, 0xd4, 0xd6, 0xaa, 0x2a, 0x78,
+        0xd4, 0x2d, 0xb3, 0x95, 0xa3, 0x57, 0x6d, 0x13, 0x25, 0xb4, 0x22, 0xc5, 0xcc, 0xda, 0x49, 0x63,
+        0xa3, 0xab, 0x84, 0x6a, 0xd4, 0x9e, 0x83, 0x8e, 0x49, 0x29, 0x48, 0x69, 0x12, 0xb6, 0x9d, 0x78,
+        0x64, 0x56, 0xa0, 0xc2, 0x79, 0x43, 0x09, 0x91, 0x64,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc9, 0xbc, 0xce, 0xcc, 0xdd, 0x99, 0x31, 0x84, 0xd5, 0x56, 0xaa, 0xad, 0x78,
+        0xd4, 0x2d, 0xab, 0x95, 0xa3, 0x37, 0x6d, 0x13, 0x2d, 0xb4, 0x22, 0xc3, 0xcc, 0xda, 0x48, 0xe3,
+        0xa3, 0xab, 0xa4, 0x6a, 0xd4, 0xa2, 0x83, 0x8e, 0x4c, 0x29, 0x48, 0x68, 0x92, 0xb6, 0x9d, 0x88,
+        0x64, 0x56, 0xa4, 0xc2, 0x79, 0x40, 0x09, 0x91, 0x64,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc9, 0xbc, 0xce, 0xcc, 0xdd, 0xa9, 0x31, 0x84, 0xd9, 0x56, 0xaa, 0xad, 0x78,
+        0xd4, 0x2d, 0xab, 0x95, 0xa3, 0x37, 0x6d, 0x13, 0x31, 0xb4, 0x22, 0xc3, 0xcc, 0xda, 0x48, 0xe3,
+        0xa3, 0xab, 0xa4, 0x6a, 0xd4, 0xa2, 0x83, 0x8e, 0x4d, 0x29, 0x48, 0x68, 0x92, 0xb6, 0x9d, 0x98,
+        0x64, 0x56, 0xa4, 0xc2, 0x79, 0x40, 0x09, 0x91, 0x64,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc9, 0xbc, 0xce, 0xcc, 0xdd, 0xa9, 0x31, 0x84, 0xd9, 0x56, 0xaa, 0xae, 0x78,
+        0xd4, 0x2d, 0xeb, 0x95, 0xa3, 0x47, 0x6d, 0x13, 0x31, 0xb4, 0x22, 0xc3, 0xcc, 0xda, 0x49, 0x23,
+        0xa3, 0xab, 0xb4, 0x6a, 0xd4, 0xa6, 0x83, 0x8e, 0x4d, 0x29, 0x48, 0x68, 0xd2, 0xb6, 0x9d, 0x98,
+        0x64, 0x56, 0xa8, 0xc2, 0x79, 0x41, 0x09, 0x91, 0x64,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc5, 0xfd, 0xde, 0xcc, 0xdc, 0x7b, 0x98, 0xc2, 0x5e, 0xa3, 0x55, 0x47, 0xb8,
+        0x4a, 0x15, 0xd1, 0xcb, 0xd1, 0x41, 0x54, 0x8a, 0x90, 0xe3, 0x96, 0xd5, 0x97, 0x0d, 0x37, 0x14,
+        0xbd, 0x4a, 0xbc, 0x6c, 0xe3, 0x65, 0x63, 0xa4, 0xe2, 0xba, 0xb2, 0xa5, 0x09, 0xbc, 0x8d, 0x69,
+        0x4c, 0x9b, 0xb4, 0x5c, 0x1a, 0x9a, 0xc8, 0xed, 0xb4,
+    },
+    {
+        0xad, 0x00, 0x00, 0x67, 0xfe, 0xdd, 0xcc, 0xbc, 0x81, 0xe4, 0x96, 0x89, 0xa3, 0x14, 0x54, 0xdd,
+        0xb4, 0xd6, 0x29, 0x92, 0xda, 0xd4, 0xe2, 0x8a, 0x6a, 0x76, 0xd3, 0x56, 0x0c, 0xa4, 0xe8, 0xba,
+        0x6e, 0x19, 0x51, 0xa3, 0x70, 0x6a, 0xb8, 0x89, 0x6c, 0x99, 0x44, 0xa6, 0x99, 0x4e, 0x31, 0x40,
+        0xe5, 0x64, 0x8e, 0x78, 0xd3, 0x95, 0x95, 0xc6, 0x84,
+    },
+    {
+        0xad, 0x00, 0x00, 0x0b, 0xfd, 0xdc, 0xcc, 0xcc, 0xc6, 0x97, 0x51, 0xae, 0x8d, 0x38, 0xd9, 0xac,
+        0x69, 0x38, 0xb7, 0x44, 0xa5, 0x45, 0x39, 0x23, 0x5b, 0x28, 0xa7, 0x2d, 0x4b, 0xa6, 0xa6, 0xc9,
+        0x1b, 0x6d, 0x81, 0xcb, 0x2c, 0x89, 0xc6, 0xa8, 0xd4, 0xdb, 0x69, 0xb6, 0x2b, 0x2d, 0xb6, 0xd4,
+        0x43, 0x14, 0x6a, 0x6d, 0xa6, 0xd6, 0x01, 0x09, 0xc8,
+    },
+    {
+        0xad, 0x00, 0x00, 0x3e, 0xfe, 0xdd, 0xcc, 0xcc, 0x2d, 0x37, 0x0c, 0x54, 0xd1, 0xb8, 0x9a, 0x5c,
+        0x44, 0xbb, 0x0c, 0xa2, 0x51, 0xa4, 0xa7, 0x1a, 0x50, 0x72, 0xb2, 0xa3, 0xbc, 0x69, 0xc5, 0x6a,
+        0xe3, 0x49, 0xc4, 0x97, 0x51, 0xaf, 0x0d, 0x38, 0xd9, 0x4c, 0x69, 0x38, 0xaf, 0x4c, 0xa5, 0x43,
+        0x37, 0x23, 0x5a, 0xa9, 0x27, 0x2d, 0x2b, 0x86, 0xa4,
+    },
+    {
+        0xad, 0x00, 0x00, 0x32, 0xfd, 0xcc, 0xbc, 0xbb, 0xb2, 0x29, 0xad, 0x60, 0x7a, 0xb5, 0xa2, 0x78,
+        0x29, 0x15, 0x24, 0x86, 0x35, 0x7a, 0xd5, 0x31, 0x22, 0x75, 0x73, 0x57, 0xdd, 0xda, 0xd5, 0xf7,
+        0x76, 0xb5, 0x7d, 0xdd, 0xad, 0x5f, 0x77, 0x6b, 0x57, 0xdd, 0xda, 0xd5, 0xf7, 0x76, 0xb5, 0x7d,
+        0xdd, 0xad, 0x5f, 0x77, 0x6b, 0x57, 0xdd, 0xda, 0xd4,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc5, 0x00, 0x00, 0x00, 0x00, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76,
+        0xdb, 0x6d, 0xdd, 0xb6, 0xdb, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6d, 0xdd,
+        0xb6, 0xdb, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6d, 0xdd, 0xb6, 0xdb, 0x77,
+        0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6c,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc5, 0x00, 0x00, 0x00, 0x00, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76,
+        0xdb, 0x6d, 0xdd, 0xb6, 0xdb, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6d, 0xdd,
+        0xb6, 0xdb, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6d, 0xdd, 0xb6, 0xdb, 0x77,
+        0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6c,
+    },
+    {
+        0xad, 0x00, 0x00, 0xc5, 0x00, 0x00, 0x00, 0x00, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76,
+        0xdb, 0x6d, 0xdd, 0xb6, 0xdb, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6d, 0xdd,
+        0xb6, 0xdb, 0x77, 0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6d, 0xdd, 0xb6, 0xdb, 0x77,
+        0x6d, 0xb6, 0xdd, 0xdb, 0x6d, 0xb7, 0x76, 0xdb, 0x6c,
+    },
+    {
+        0xad, 0x00, 0x00, 0xd6, 0x53, 0x10, 0x00, 0x00, 0x7f, 0xef, 0xef, 0xdf, 0xfb, 0xfb, 0xf8, 0x49,
+        0x15, 0x0e, 0x03, 0xb8, 0xc8, 0xa6, 0x96, 0xf9, 0x61, 0xe9, 0x2c, 0xc4, 0x57, 0x57, 0x27, 0x35,
+        0xbe, 0x3e, 0x3f, 0xaa, 0xd0, 0x26, 0x26, 0x1c, 0x39, 0xc0, 0x79, 0x00, 0xf6, 0xd2, 0xbe, 0xce,
+        0x11, 0x31, 0x11, 0xf2, 0x64, 0x18, 0xab, 0x84, 0xf4,
+    },
+    {
+        0xad, 0x00, 0x00, 0xce, 0x53, 0x00, 0x00, 0x00, 0xa7, 0x10, 0x56, 0x4d, 0xf9, 0xc5, 0x5c, 0xbe,
+        0x45, 0x55, 0x44, 0x42, 0x55, 0x7d, 0xf2, 0x55, 0x6c, 0x54, 0xa5, 0x53, 0x4a, 0x41, 0x57, 0x19,
+        0x9a, 0x55, 0x5c, 0x50, 0x15, 0x5c, 0x4c, 0x35, 0x5b, 0x9d, 0x3d, 0x54, 0xc7, 0x84, 0x55, 0xbf,
+        0x6a, 0x15, 0x59, 0xd3, 0xb5, 0x56, 0x3f, 0x09, 0x54,
+    },
+    {
+        0xad, 0x00, 0x00, 0xce, 0x53, 0x00, 0x00, 0x00, 0xc2, 0x16, 0x55, 0x4c, 0x77, 0x55, 0x5b, 0x76,
+        0xd9, 0x55, 0xd4, 0x3c, 0x55, 0x58, 0xef, 0x15, 0x71, 0xd6, 0x05, 0x53, 0x3d, 0xb5, 0x56, 0xb6,
+        0xb9, 0x55, 0x81, 0xcd, 0x55, 0x53, 0x9b, 0x45, 0x5c, 0xb9, 0xb5, 0x54, 0xe7, 0x62, 0x55, 0xa3,
+        0x6f, 0x95, 0x63, 0xc3, 0x85, 0x54, 0x4e, 0xad, 0x50,
+    },
+    {
+        0xad, 0x00, 0x00, 0xce, 0x53, 0x00, 0x00, 0x00, 0xcd, 0x1e, 0xd5, 0x4f, 0xe5, 0x65, 0x59, 0x73,
+        0x09, 0x56, 0x6f, 0x3c, 0x55, 0x3d, 0xa9, 0x55, 0x73, 0x58, 0x85, 0x54, 0x89, 0x21, 0x56, 0x2a,
+        0xc2, 0x55, 0xa7, 0x90, 0xd5, 0x4d, 0xc9, 0xb5, 0x5c, 0xb2, 0x59, 0x55, 0x48, 0x45, 0x55, 0x7d,
+        0x31, 0x95, 0x6c, 0x54, 0xa5, 0x53, 0x42, 0x45, 0x54,
+    },
+    {
+        0xad, 0x00, 0x00, 0xed, 0xcb, 0xcb, 0xbc, 0xbc, 0x7b, 0x76, 0xdd, 0x5e, 0xdd, 0xb7, 0x58, 0x37,
+        0x6d, 0xd6, 0x29, 0xe2, 0x79, 0xb2, 0x33, 0x6d, 0x19, 0x5c, 0xd7, 0x17, 0xb7, 0x6d, 0xd5, 0xed,
+        0xdb, 0x75, 0x73, 0x76, 0xdd, 0x5e, 0xda, 0x28, 0x53, 0x85, 0x52, 0x6a, 0x06, 0x86, 0x49, 0x7b,
+        0x76, 0xdd, 0x5e, 0xdd, 0xb7, 0x58, 0x37, 0x6d, 0xd4,
+    },
+    {
+        0xad, 0x00, 0x00, 0xfd, 0xcb, 0xbc, 0xcb, 0xbc, 0x82, 0x8e, 0xf1, 0x6f, 0x49, 0x99, 0xa6, 0xe1,
+        0x10, 0x25, 0xed, 0xbb, 0xb5, 0x7b, 0x6e, 0xed, 0x5c, 0xdb, 0xbb, 0x57, 0xb6, 0xee, 0xd4, 0xe0,
+        0x19, 0x80, 0x7b, 0x6e, 0xed, 0x60, 0xdb, 0xbb, 0x57, 0xb6, 0xee, 0xd6, 0x0d, 0xbb, 0xb5, 0x7b,
+        0x8d, 0x09, 0x6f, 0xac, 0x31, 0x07, 0x51, 0x49, 0x84,
+    },
+    {
+        0xad, 0x00, 0x00, 0x55, 0xbb, 0xbc, 0xcb, 0xbb, 0x76, 0xdd, 0xdb, 0x5d, 0xb7, 0x76, 0xd6, 0x6d,
+        0xdd, 0xb5, 0xdb, 0x77, 0x6d, 0x00, 0x5a, 0x2e, 0x96, 0x8b, 0x3c, 0x59, 0x8d, 0xdd, 0xa5, 0xdb,
+        0x77, 0x6d, 0x86, 0xdd, 0xdb, 0x5d, 0xb7, 0x76, 0xde, 0xda, 0xef, 0x69, 0xdb, 0x77, 0x6d, 0x66,
+        0xdd, 0xdb, 0x5d, 0xb7, 0x76, 0xd6, 0x6d, 0xdd, 0xb4,
+    },
+    {
+        0xad, 0x00, 0x00, 0x49, 0xbc, 0xcc, 0xcc, 0xcb, 0x77, 0x76, 0xdb, 0x49, 0xa2, 0x48, 0x84, 0xb3,
+        0x90, 0xd2, 0x5d, 0xd2, 0x6d, 0x77, 0x76, 0xdb, 0x61, 0xdd, 0xb6, 0xd7, 0x77, 0x6d, 0xb7, 0xaa,
+        0x5b, 0x48, 0x95, 0xa3, 0x4c, 0x55, 0x9d, 0xb6, 0xd7, 0x77, 0x6d, 0xb5, 0xdd, 0xdb, 0x6d, 0x77,
+        0x76, 0xdb, 0x4d, 0xe6, 0x24, 0xe2, 0xb6, 0x35, 0x98,
+    },
+};
+
+static const int16_t msbc_vector_decoded[MSBC_VECTOR_FRAMES * MSBC_SAMPLES_PER_FRAME] = {
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,     -1,     -1,     -1,      0,      0,      1,      2,
+         2,      3,      3,      2,      1,      0,     -2,     -3,     -4,     -5,     -3,      1,
+         4,      7,     17,     22,     27,      9,     21,     -1,    -18,    -38,    -56,    -33,
+       -64,    -72,    -64,    -23,    -34,    -39,     33,     91,    110,     20,    101,    170,
+       102,     60,    -88,    406,    -43,   -140,    -69,    207,     34,   -263,     -1,    158,
+       -78,  -1203,    787,    834,    874,    448,   2597,   2600,   2761,   2536,   4399,   4513,
+      4436,   4773,   4452,   6399,   6429,   6615,   6400,   8498,   7891,   8053,   7724,   7811,
+      9504,   8837,   8806,   8370,  10134,   9539,   8793,   8352,   7703,   9052,   8210,   7537,
+      6384,   7404,   6456,   5314,   4347,   2687,   3687,   2547,   1134,   -403,    279,  -1037,
+     -2248,  -3936,  -5238,  -4212,  -5709,  -6519,  -8282,  -6713,  -7826,  -8533,  -9480,  -9733,
+     -8351,  -8309,  -8766,  -8615,  -6480,  -6349,  -5953,  -5491,  -5078,  -2311,  -1734,   -807,
+      -106,   2597,   3404,   4012,   4874,   5360,   7893,   7819,   8606,   7937,  10218,   9123,
+      8619,   7768,   6509,   7208,   5521,   3916,   2400,   2557,    376,  -1632,  -3564,  -5131,
+     -4926,  -6670,  -7768,  -8991,  -7713,  -8542,  -9076,  -9000,  -8767,  -6183,  -5461,  -4336,
+     -3394,   -164,   1264,   2503,   3907,   4500,   7551,   8226,   8378,   8125,   9773,   9074,
+      8072,   6196,   4333,   4503,   1953,    -32,  -3025,  -2701,  -5022,  -6849,  -8729,  -9638,
+     -8594,  -8563,  -8714,  -7955,  -4944,  -3723,  -2099,   -371,   1161,   4810,   5989,   7119,
+      7624,   9627,   9356,   8363,   7151,   5201,   4900,   1814,   -349,  -3543,  -3551,  -6194,
+     -7928,  -9306, -10018,  -8239,  -7895,  -7093,  -5193,  -1559,    547,   2404,   4246,   7673,
+      8871,   8781,   8647,   7594,   8291,   5767,   3263,    -26,   -721,  -3823,  -6081,  -8165,
+     -9576,  -8138,  -8146,  -7213,  -5788,  -1937,    451,   2563,   4877,   6260,   9237,   8875,
+      8818,   6705,   7080,   3724,    811,  -2354,  -5523,  -6093,  -8110,  -9107,  -9010,  -6233,
+     -5059,  -3131,   -702,   1952,   6050,   7599,   8685,   8508,   9558,   7237,   4177,    888,
+     -2571,  -3839,  -6783,  -8476,  -9776,  -7813,  -6286,  -4420,  -1562,   1121,   5762,   7887,
+      8935,   8349,   9158,   6908,   3718,   -180,  -3893,  -4990,  -7775,  -8897,  -9795,  -6301,
+     -4456,  -1690,    880,   4125,   7983,   9239,   8888,   7227,   6326,   2803,  -1318,  -4961,
+     -7881,  -7840,  -8463,  -7542,  -5969,  -1332,   1701,   4410,   6880,   7878,   9615,   7317,
+      4897,    361,  -1312,  -5389,  -7864,  -9155,  -8790,  -5305,  -2937,    471,   3541,   7975,
+      9124,   8583,   6801,   3850,   1399,  -3157,  -6762,  -9530,  -8195,  -7470,  -5233,  -1726,
+      1859,   6928,   8508,   8921,   7012,   5755,   1913,  -2729,  -6465,  -9595,  -8371,  -7575,
+     -4954,  -1732,   3875,   7483,   8767,   8388,   6209,   4449,   -281,  -4436,  -8498,  -7751,
+     -8025,  -5934,  -3021,   1060,   6149,   8215,   8299,   6647,   5061,    327,  -4151,  -8098,
+     -7875,  -8046,  -5627,  -2000,   1919,   7679,   9054,   8821,   6302,   3594,  -1447,  -6157,
+     -9054, -10024,  -6231,  -2942,   1422,   5427,   9816,   9564,   7192,   2782,  -2345,  -5037,
+     -8519,  -8784,  -7673,  -1699,   2242,   6168,   8072,   7996,   6961,   2754,  -2712,  -7062,
+     -7699,  -7956,  -5676,  -1734,   2594,   8215,   9274,   7855,   3883,    609,  -4590,  -8528,
+     -9461,  -7690,  -1631,   2565,   6938,   8065,   9645,   5340,     63,  -5412,  -9346,  -8266,
+     -6508,  -2518,   2332,   8161,   9564,   8081,   3692,  -1893,  -5245,  -8561,  -8631,  -6295,
+       314,   4963,   8033,   8458,   5614,   2561,  -3302,  -7701,  -9637,  -6272,  -2424,   2296,
+      6687,   7968,   8335,   3628,  -2301,  -7403,  -8063,  -7597,  -3789,   1300,   5886,   9838,
+      7812,   3644,  -3022,  -5905,  -8844,  -7708,  -3881,   1634,   7647,   9444,   7037,   2149,
+     -1964,  -7010,  -8968,  -7341,  -2976,   4438,   7871,   8298,   5071,   1573,  -4224,  -8398,
+     -8770,  -5754,   1545,   5986,   8825,   6656,   4310,  -2605,  -7480,  -9180,  -7223,   -421,
+      4602,   7789,   7576,   5496,   -876,  -6531,  -9270,  -7816,  -1492,   3772,   7695,   7562,
+      5736,   -631,  -6540,  -9176,  -7682,  -1114,   4115,   7821,   7182,   4917,  -1400,  -6776,
+     -9077,  -7278,   -203,   5306,   8577,   6633,   3457,  -3156,  -7982,  -9159,  -3818,   2414,
+      7254,   8922,   5315,    889,  -5803,  -9357,  -8505,  -1173,   4783,   9265,   8556,   3530,
+     -2040,  -8292,  -9329,  -5705,   2867,   8073,   8968,   5182,  -1891,  -6391,  -9061,  -6247,
+      -252,   7844,  10177,   6969,    124,  -7492,  -8758,  -6805,  -1105,   4946,   9938,   7768,
+      1567,  -5856,  -9775,  -6191,   -982,   5474,   7544,   7597,    954,  -5583,  -8910,  -6606,
+       704,   6452,   7982,   5004,    421,  -6103,  -8576,  -5718,    511,   8299,   9138,   4526,
+     -3400,  -7645,  -8392,  -3711,   3536,   8031,   9116,   2541,  -4613, -10022,  -6438,  -1022,
+      6081,   9076,   5551,   -221,  -7608,  -9540,  -4991,   4273,   8961,   8008,   1747,  -5568,
+     -7866,  -6548,   -473,   5380,   9394,   5412,  -1986,  -7918,  -8932,  -2296,   4389,   8398,
+      6082,   1073,  -6049,  -8742,  -4972,   1516,   8767,   8045,   1500,  -6372,  -7931,  -5044,
+      1988,   7175,   6927,   3004,  -5179,  -8865,  -6991,   2527,   8165,   8264,   1809,  -5988,
+     -8435,  -5623,   1080,   7131,   9087,   2676,  -5305,  -9193,  -6475,   2701,   7975,   7256,
+       366,  -5479,  -8220,  -4345,   3170,   7625,   7407,   -606,  -7178,  -9037,  -1355,   5407,
+      8471,   4337,  -3847,  -7870,  -6991,   -300,   6907,   9340,   2896,  -5934,  -9822,  -4022,
+      4267,   8986,   6708,  -1731,  -7002,  -8137,  -1763,   5456,   9930,   4348,  -3976,  -8936,
+     -6454,   2953,   8297,   6905,   -759,  -6489,  -7660,  -1884,   6132,   8224,   4505,  -5156,
+     -9130,  -5870,   5245,   9592,   6153,  -3026,  -9847,  -6286,   1488,   8156,   7275,   1152,
+     -7212,  -8274,  -1587,   6342,   9424,   2346,  -6448,  -9543,  -2075,   5891,   8815,   3617,
+     -5472,  -8201,  -4613,   4021,   8327,   6151,  -2873,  -9086,  -5959,   2347,   9451,   5927,
+     -3073,  -9426,  -4776,   3424,   8723,   5229,  -3923,  -8048,  -5730,   3219,   8046,   6862,
+     -2842,  -8925,  -6450,   2526,   9518,   6040,  -3506,  -9671,  -4644,   4275,   9024,   4507,
+     -5242,  -8537,  -4161,   4988,   8299,   4329,  -5234,  -9012,  -3132,   5321,   9484,   1892,
+     -6788,  -9419,    157,   7871,   7860,   -892,  -8966,  -6361,   1710,   8281,   5248,  -2176,
+     -8234,  -4948,   3890,   8117,   4021,  -5851,  -8900,  -2535,   8237,   8514,   -306,  -8810,
+     -8065,   2797,   9065,   5575,  -4888,  -8498,  -3212,   5719,   8279,    496,  -6847,  -7415,
+       882,   7497,   6656,  -3180,  -8859,  -4296,   4859,   9256,   1117,  -7764,  -8617,   2518,
+      9172,   5739,  -4894,  -9980,  -2753,   6631,   8153,   -710,  -7693,  -6250,   3123,   8695,
+      2847,  -5729,  -8588,   -431,   7386,   7105,  -2914,  -8753,  -3930,   6940,   8590,    282,
+     -8545,  -7048,   4441,   9392,   2965,  -7832,  -7055,   1704,   9143,   5034,  -6244,  -8155,
+     -1007,   8151,   6097,  -1926,  -8622,  -2982,   5970,   6963,   -502,  -8028,  -4730,   4747,
+      9174,    902,  -8139,  -6344,   3250,   9548,   2192,  -7707,  -7731,   3961,   9439,   2855,
+     -7336,  -8377,   3287,   8950,   3329,  -7737,  -6358,   2548,   9072,   2793,  -7809,  -6835,
+      2376,   8824,   2664,  -5924,  -7046,   2180,   8464,   2380,  -6282,  -7041,   2364,   8019,
+      3722,  -6818,  -6884,   2809,   7853,   2676,  -7768,  -6529,   3732,   9737,   1161,  -8798,
+     -5717,   4825,   9057,  -1019,  -9228,  -4307,   8161,   7677,  -3270,  -9444,  -2536,   8934,
+      5929,  -5108,  -9374,   1778,   9149,   3958,  -7723,  -8256,   3889,   9464,    993,  -9180,
+     -4641,   6288,   8177,  -2348, -10125,  -1877,   8202,   6025,  -6038,  -7684,   1810,   9042,
+      2396,  -9053,  -5614,   5229,   8660,  -2459,  -8023,  -2404,   7896,   5443,  -6306,  -7381,
+      1893,   8323,   1251,  -6829,  -4830,   5400,   6929,  -3161,  -7965,  -1236,   7908,   3705,
+     -5619,  -6801,   3704,   8259,  -1586,  -8611,  -2663,   8154,   4783,  -5501,  -7418,   3455,
+      8372,  -1374,  -8506,  -2912,   7961,   4802,  -5438,  -7582,   3688,   8584,    104,  -8716,
+     -2185,   8392,   3789,  -6158,  -6506,   4486,   7549,   -598,  -8537,   -845,   8281,   2904,
+     -7129,  -5710,   6350,   6791,  -3286,  -7955,   1857,   8638,   -175,  -8122,  -2926,   8125,
+      4709,  -5883,  -6522,   5110,   8081,  -4097,  -8261,   1249,   9124,    775,  -7945,  -3114,
+      8221,   4952,  -7719,  -6100,   5425,   8138,  -4622,  -7551,   2347,   8975,   -750,  -9480,
+      -977,   8772,   2901,  -8225,  -3585,   7359,   5800,  -6489,  -7654,   5961,   7597,  -4370,
+     -8640,   4052,   8925,  -2083,  -9047,   -140,   9480,    349,  -8468,  -2409,   9603,   2802,
+     -8010,  -4091,   6512,   5474,  -6675,  -5980,   5693,   7550,  -5316,  -7243,   4703,   6888,
+     -4109,  -7892,   4190,   7422,  -2854,  -7938,   3102,   8022,  -3681,  -8024,   2431,   8869,
+     -2449,  -8401,   1595,   9164,   -999, -10326,   1079,   9474,   -405,  -9901,    828,   9413,
+       231,  -9550,  -1282,   9684,    459,  -8988,  -1770,  10076,   1249,  -9131,  -1684,   8323,
+      1336,  -8868,   -951,   8625,   1166,  -8878,     16,   8570,  -1652,  -8277,   1247,   8624,
+     -2357,  -8007,   2466,   8430,  -3042,  -9531,   3865,   8345,  -3755,  -9419,   5135,   8475,
+     -4987,  -8535,   4960,   7799,  -6304,  -7072,   6235,   6901,  -7402,  -4989,   7031,   2957,
+     -7499,  -2826,   7833,   1557,  -7886,   -918,   8925,   -771,  -7940,   1893,   9160,  -3493,
+     -9146,   5267,   7827,  -5768,  -7018,   7555,   5666,  -7436,  -4137,   7246,   3689,  -8528,
+     -1171,   7899,    874,  -8363,   2104,   7846,  -4282,  -6741,   5071,   6338,  -6797,  -4109,
+      7938,   3633,  -8649,  -2609,   9498,    153,  -9019,   1558,   9523,  -3982,  -7276,   5925,
+      4640,  -6870,  -3291,   8442,    632,  -7981,   1614,   8564,  -3670,  -8882,   6232,   6828,
+     -7569,  -5176,   9698,   2253,  -9108,    528,   7816,  -2844,  -7476,   6038,   4890,  -6696,
+     -3123,   8975,     -6,  -9765,   3007,   8481,  -5587,  -6860,   8471,   4049,  -8858,   -944,
+      7881,  -1984,  -7599,   5241,   5065,  -6588,  -2597,   8597,   -537,  -9752,   4237,   7488,
+     -6121,  -6031,   9215,   2130,  -8763,   1033,   7208,  -4127,  -6168,   7120,   2570,  -7870,
+       834,   8603,  -4659,  -7817,   7750,   3966,  -8985,   -688,   9597,  -3637,  -6867,   6523,
+      2614,  -7967,    329,   8493,  -4942,  -6093,   7932,   3208,  -9560,   -108,   9289,  -4925,
+     -6472,   7241,   3195,  -8780,   2027,   7411,  -7044,  -4273,   8514,    546,  -9847,   5094,
+      6983,  -7605,  -3365,   8091,  -1491,  -7655,   5702,   3729,  -7679,    355,   8451,  -5049,
+     -7211,   8730,   1857,  -9566,   2596,   8146,  -7427,  -2902,   8863,  -1594,  -7214,   6994,
+      3399,  -9721,   1978,   8635,  -6002,  -5650,  10061,   -155,  -8519,   5836,   3823,  -8120,
+      1086,   8474,  -6844,  -3512,   9213,   -436,  -8925,   5042,   5296,  -8208,    779,   7447,
+     -5163,  -3548,   8737,  -1903,  -8624,   7344,   3666,  -9170,   1887,   8498,  -6951,  -2425,
+      8637,  -4692,  -5305,   7875,    693,  -8830,   6554,   4443,  -8638,   1570,   6784,  -6900,
+     -2266,   9379,  -4936,  -5516,   9308,    192,  -9160,   4993,   4903,  -8240,   1988,   5849,
+     -6094,   -652,   8148,  -5786,  -5492,  10002,  -1833,  -8199,   7189,   3136,  -8912,   4692,
+      5188,  -9895,   2235,   7518,  -7580,  -1648,   9148,  -5710,  -3485,   8756,  -4603,  -5808,
+      8789,   -124,  -9398,   7678,   3253,  -8558,   3618,   3996,  -7965,   2799,   6462,  -8908,
+       787,   8901,  -7056,  -3251,   8257,  -4252,  -4925,   8710,  -3319,  -5531,   8621,   -989,
+     -8103,   6537,   2122,  -8849,   6248,   2527,  -8137,   4678,   5000,  -9339,   2134,   6457,
+     -8305,   1434,   5944,  -6714,    771,   7157,  -7625,  -1836,   8705,  -6197,  -2814,   7856,
+     -4317,  -3483,   8631,  -4978,  -5465,   9424,  -3936,  -5220,   7990,  -2656,  -5267,   8880,
+     -3108,  -7533,   8938,  -1398,  -6782,   6887,   -205,  -6488,   7852,  -1345,  -6292,   8596,
+      -726,  -7611,   7231,    150,  -7435,   8011,  -1033,  -6169,   8191,   -584,  -7521,   7186,
+      -279,  -6559,   8075,  -2178,  -5543,   9037,  -1940,  -7127,   7819,  -1179,  -6079,   8542,
+     -3366,  -4706,   9164,  -3705,  -4897,   7950,  -3939,  -3670,   8924,  -6104,  -2373,   9174,
+     -5705,  -2527,   7042,  -5787,   -647,   7531,  -8237,   1420,   7513,  -7753,    736,   5706,
+     -7961,   3287,   5438,  -9667,   5423,   4683,  -9290,   5788,   1378,  -8092,   8021,   -120,
+     -8457,   9859,  -2156,  -6194,   9242,  -5727,  -3105,   9261,  -6659,  -2520,   9752,  -8052,
+       967,   6805, -10049,   4161,   5150,  -9571,   5071,   3862,  -8398,   7351,   -485,  -8235,
+      9647,  -3189,  -5145,   8231,  -4937,  -1253,   7656,  -8013,    327,   6655,  -8394,   4115,
+      2788,  -7675,   7349,     57,  -7366,   7213,  -2566,  -4094,   8635,  -7164,   -221,   8033,
+     -8516,   2650,   3444,  -8105,   6753,    297,  -8117,   9439,  -3127,  -3994,   7799,  -7669,
+       464,   7304,  -9113,   3535,   4225,  -8200,   7338,  -1317,  -7407,   9664,  -5123,  -2763,
+      7960,  -7855,   3140,   5009,  -9873,   6139,    693,  -7165,   8906,  -5511,  -1932,   8527,
+     -8152,   1401,   4748,  -8976,   7089,    104,  -8102,  10562,  -5289,  -2519,   7685,  -9560,
+      3937,   4052,  -8812,   6774,  -1085,  -4421,   8101,  -7211,   1983,   5849,  -8407,   6040,
+      -466,  -6300,   9605,  -5790,  -2280,   8982,  -8673,   4620,   2530,  -9112,   9520,  -3736,
+     -3085,   7323,  -6713,   3291,   3601,  -8320,   6929,  -2240,  -3375,   8146,  -8880,   4621,
+      3810,  -8418,   8515,  -4897,  -2310,   8325,  -8280,   2990,   3898,  -7209,   7800,  -3725,
+     -3924,   8681,  -8345,   4295,   1648,  -6857,   9810,  -6033,   -887,   5708,  -8121,   6583,
+      -688,  -6125,   9439,  -6180,   1016,   4802,  -9674,   8577,  -2459,  -4205,   8113,  -8142,
+      5164,   1922,  -8152,   8752,  -6171,   1059,   5276,  -9534,   8674,  -2047,  -4012,   8007,
+     -9711,   5278,   2189,  -7792,   8850,  -6034,   1638,   5087,  -9641,   7871,  -3482,  -2078,
+      7401, -10157,   7893,   -952,  -4725,   7782,  -9055,   4948,   1640,  -6714,   7768,  -5818,
+      2412,   3730,  -8245,   7359,  -4564,   -187,   5660,  -9420,   8549,  -3043,  -2511,   6761,
+     -9901,   7540,  -1953,  -3904,   7170,  -7914,   6541,  -1282,  -4856,   7094,  -7665,   5309,
+      -262,  -5936,   9151,  -7551,   4140,    495,  -6929,   9178,  -7742,   3770,    644,  -5373,
+      9016,  -7885,   3327,    669,  -6048,   9299,  -8594,   3331,   2333,  -6278,   9176,  -8876,
+      3500,   1704,  -6303,   8911,  -9533,   6038,    279,  -5342,   8021,  -7501,   6031,   -494,
+     -4851,   7013,  -7552,   6364,  -1917,  -3729,   8151,  -8120,   7292,  -3967,  -1949,   6514,
+     -8143,   8379,  -6477,   2518,   3752,  -6969,   8092,  -8065,   4415,   1497,  -5821,   7880,
+     -7568,   6682,  -1789,  -3437,   6002,  -7902,   8170,  -4756,   -823,   6098,  -8016,   9501,
+     -8172,   2868,   2258,  -5825,   8690,  -9873,   8095,  -2377,  -2135,   6047,  -9991,   9732,
+     -6030,   1728,   2339,  -6004,   9538,  -8630,   5589,  -2584,  -2380,   7244,  -9170,   8178,
+     -5494,   2736,   2260,  -6667,   7774,  -8122,   6954,  -3284,  -1855,   6130,  -7339,   8223,
+     -7266,   2877,   1032,  -4101,   7010,  -9185,   8885,  -5068,   1730,   1826,  -6732,   8922,
+     -8658,   7246,  -5033,   1112,   4387,  -7433,   8543,  -9568,   6896,  -2220,  -2077,   4999,
+     -7318,   9637,  -8456,   5320,  -3560,   -497,   5222,  -8132,   8320,  -7975,   7196,  -3302,
+     -1989,   5223,  -8562,  10531,  -9447,   6054,  -1677,  -3843,   8590, -11025,  12927, -10530,
+      6586,  -1363,  -2874,   7307,  -8758,   8548,  -8845,   4144,   -609,   1970,   1605,  -9658,
+      4347,  -5052,  10894,  -5107,  -2997,    452,  -1963,   6492,  -8157,   5579,  -1771,   3639,
+     -3653, -30617, -18078,  -3532,   4184,  25646, -27241,  -6240,  -4648,  17278,  27301, -16154,
+     -7928,   1497,  18233, -32768, -10668,  -4421,  12047,  23632, -23673,  -8390,   2381,  22677,
+     28769, -21307,  -7964,   8848,  23820, -26322, -12154,   -498,  13075,  25931, -27090,  -1510,
+      3952,  19017, -32768, -19119,  -2424,  16892,  29513, -27918, -11615,  -3728,  17694,  25331,
+    -14932,  -4063,  11962,  22724, -32768, -18387,   2019,   7472,  27464, -22995,  -5413,   6386,
+     13968, -32768, -15744,  -4690,  11628,  26601, -30007, -12341,  -3439,  17647,  23212, -19294,
+     -7050,  12305,  23749, -28607, -19646,  -5499,  11231,  29422, -22665, -14283,   7518,  15165,
+     30509, -19091,  -9639,  12069,  23282, -24447, -20622,   -721,  14566,  29286, -19278,  -8409,
+      7033,  19456, -32655, -18024,  -3661,  10109,  24362, -20143,  -9554,  -3242,  16600,  29731,
+    -17298,  -9213,   7825,  23604, -28357, -12560,  -1325,  18288,  21132, -25819, -11294,   6887,
+     22119, -32768, -16553,  -3197,  12118,  22788, -27217, -13992,   3170,  16079,  29387, -18861,
+     -4213,   3990,  20068, -32768, -10567,  -4659,  13988,  24956, -21799,  -9726,    216,  20834,
+     30329, -18771,  -5328,   9085,  21450, -29500, -12827,   1950,  17460,  28280, -28029,  -4680,
+      1999,  20382, -30708, -15853,  -2534,  13699,  25971, -29159,  -9902,   -536,  20176,  25782,
+    -16418,  -6375,  10310,  22919, -30692, -14880,   4929,   8232,  25813, -25774,  -7305,   6845,
+     16804, -31423, -12844,  -4064,  10025,  24157, -31427, -11538,   -604,  21115,  25555, -19213,
+     -9165,   9257,  21621, -28383, -17045,  -2127,  13096,  28522, -25492, -16683,   7549,  17676,
+     32767, -17183,  -9625,  11166,  22842, -23842, -19382,    451,  15338,  29737, -19031,  -8396,
+      6788,  19125, -32768, -17855,  -3304,  10453,  24633, -19841,  -9098,  -2631,  17274,  30370,
+    -16740,  -8761,   8135,  23742, -28371, -12662,  -1435,  18228,  21155, -25686, -11029,   7294,
+     22648, -32768, -15910,  -2578,  12664,  23222, -26916, -13829,   3211,  16027,  29287, -18966,
+     -4277,   4002,  20183, -32768, -10237,  -4238,  14478,  25485, -21257,  -9190,    732,  21324,
+     30800, -18307,  -4856,   9583,  21989, -28911, -12187,   2636,  18176,  29007, -27316,  -4006,
+      2609,  20911, -30272, -15513,  -2284,  13873,  26086, -29079,  -9838,   -470,  20256,  25880,
+    -16308,  -6265,  10404,  22978, -30684, -14934,   4812,   8061,  25610, -25980,  -7477,   6744,
+     16808, -31292, -12575,  -3664,  10531,  24731, -30832, -10977,   -122,  21481,  25787, -19117,
+     -9183,   9164,  21505, -28466, -17045,  -2004,  13366,  28939, -24952, -16059,   8202,  18302,
+     32767, -16765,  -9353,  11291,  22842, -23925, -19494,    368,  15338,  29861, -18761,  -7979,
+      7328,  19747, -32148, -17231,  -2762,  10875,  24912, -19703,  -9081,  -2694,  17179,  30297,
+    -16740,  -8650,   8379,  24122, -27872, -12072,   -795,  18873,  21761, -25152, -10591,   7625,
+     22875, -32768, -15843,  -2555,  12664,  23221, -26906, -13798,   3263,  16097,  29366, -18886,
+     -4206,   4060,  20222, -32768, -10230,  -4242,  14470,  25481, -21253,  -9175,    758,  21358,
+     30835, -18280,  -4847,   9563,  21932, -29008, -12323,   2468,  17989,  28817, -27485,  -4133,
+      2545,  20928, -30165, -15312,  -1994,  14239,  26510, -28617,  -9360,      7,  20720,  26329,
+    -15871,  -5828,  10855,  23466, -30146, -14334,   5475,   8778,  26359, -25228,  -6759,   7391,
+     17350, -30878, -12299,  -3518,  10571,  24703, -30880, -10993,    -58,  21662,  26102, -18666,
+     -8619,   9806,  22173, -27830, -16499,  -1593,  13617,  29037, -24973, -16139,   8105,  18229,
+     32767, -16600,  -9071,  11673,  23415, -23102, -18593,   1101,  15852,  30158, -18801,  -8255,
+      7248,  19899, -32317, -17855,  -3067,  11171,  25076, -19541,  -8162,   -139,  19498,  31716,
+    -15700,  -8933,   5180,  20099, -28025, -10414,  -1164,  16737,  24607, -18078,  -8927,   3033,
+     20086, -31734, -12727,  -6601,   9222,  26690, -21882, -16462,   5367,  14458,  32767, -22280,
+     -8656,   7453,  24390, -27817, -17236,  -4567,  16225,  32336, -24203, -11462,   3922,  19205,
+    -28688, -18227,  -3575,   6393,  24842, -22457, -13316,  -1493,  14685,  32300, -20073,  -8035,
+      7781,  16068, -29543, -17125,  -1373,  11877,  27020, -25532,  -7184,    881,  20523,  25576,
+    -17313,  -6822,  10698,  22658, -29041, -14614,   4926,   9548,  25717, -26251,  -3833,   9784,
+     17521, -32768, -16626,  -2329,  11633,  22240, -27702, -11797,    -15,  21183,  29201, -21848,
+     -8430,  11316,  20727, -28000, -15947,   -733,  15055,  28737, -23133, -10734,   6321,  18236,
+    -32768, -16443, -11573,  14048,  26586, -25497, -13511,   -308,  15916,  31970, -25307,  -4574,
+      2733,  22102, -28392, -18732,  -2868,  10691,  27924, -18720, -11472,   -649,  15778,  30785,
+    -15696,  -7489,   7737,  23313, -26033,  -9121,  -1149,  15122,  23342, -19421,  -8926,   3735,
+     21014, -30540, -12059,  -6299,   9226,  26654, -21928, -16237,   5500,  14577,  32767, -22472,
+     -8809,   7319,  24390, -27727, -17115,  -4475,  16258,  32313, -24263, -11542,   3825,  19085,
+    -28837, -18395,  -3741,   6260,  24770, -22448, -13216,  -1302,  14957,  32647, -19665,  -7584,
+      8260,  16560, -29051, -16640,   -897,  12344,  27484, -25068,  -6710,   1369,  21028,  26100,
+    -16773,  -6271,  11254,  23210, -28498, -14085,   5441,  10052,  26217, -25743,  -3304,  10347,
+     18127, -32764, -15923,  -1590,  12389,  22988, -26992, -11155,    531,  21615,  29509, -21659,
+     -8344,  11327,  20698, -28030, -15944,   -664,  15211,  28991, -22785, -10305,   6812,  18765,
+    -32768, -15907, -11054,  14544,  27063, -25027, -13033,    194,  16458,  32561, -24666,  -3889,
+      3449,  22830, -27680, -18058,  -2258,  11220,  28360, -18380, -11222,   -475,  15894,  30864,
+    -15632,  -7424,   7815,  23406, -25929,  -9018,  -1064,  15174,  23346, -19474,  -9037,   3577,
+     20827, -30727, -12213,  -6389,   9229,  26772, -21688, -15878,   5961,  15111,  32767, -21896,
+     -8267,   7799,  24787, -27421, -16898,  -4338,  16331,  32342, -24259, -11547,   3824,  19094,
+    -28814, -18359,  -3694,   6317,  24834, -22379, -13144,  -1232,  15021,  32695, -19643,  -7598,
+      8199,  16449, -29212, -16840,  -1119,  12130,  27309, -25168,  -6706,   1499,  21292,  26491,
+    -16280,  -5711,  11833,  23759, -28023, -13721,   5677,  10160,  26217, -25815,  -3402,  10275,
+     18127, -32655, -15683,  -1215,  12884,  23572, -26359, -10516,   1134,  22148,  29948, -21324,
+     -8111,  11472,  20774, -28002, -15940,   -667,  15215,  29009, -22750, -10255,   6874,  18834,
+    -32768, -15836, -10987,  14603,  27110, -24998, -13028,    169,  16398,  32463, -24800,  -4052,
+      3268,  22648, -27842, -18180,  -2318,  11238,  28466, -18182, -10938,   -117,  16311,  31320,
+    -15158,  -6944,   8289,  23872, -25468,  -8556,   -585,  15679,  23888, -18887,  -8407,   4245,
+     21520, -30026, -11524,  -5733,   9837,  27312, -21223, -15497,   6257,  15324,  32767, -21830,
+     -8263,   7752,  24700, -27534, -17022,  -4456,  16236,  32288, -24255, -11473,   3978,  19330,
+    -28501, -17977,  -3260,   6783,  25316, -21898, -12675,   -778,  15465,  32767, -19185,  -7106,
+      8741,  17050, -28548, -16122,   -368,  12882,  28028, -24521,  -6164,   1915,  21572,  26642,
+    -16233,  -5734,  11784,  23738, -27955, -13515,   6027,  10619,  26739, -25262,  -2824,  10850,
+     18657, -32202, -15304,   -902,  13024,  23463, -26757, -10918,   1055,  22536,  30507, -21044,
+     -8075,  11471,  21028, -27606, -15218,    672,  17142,  31322, -21118, -10330,   4699,  16632,
+    -32768, -11910,  -6402,  15601,  24626, -30301, -18296,  -3922,  15754,  32767, -25503,  -3716,
+      6820,  29231, -26260, -19466,  -4727,  12999,  26432, -22972, -14537,   5290,  19037,  27664,
+    -20393,  -4356,  12933,  22634, -24356, -11744,   1666,  14782,  24367, -22270, -11602,   8697,
+     15524, -32768, -32768, -32581, -32768, -32520, -24898, -30970, -26541, -32768, -30359, -32768,
+    -31348, -30158, -32768, -30831, -32768, -26559, -30790, -28922, -32768, -32768, -31469, -28512,
+     32767,  32049,  32767,  30732,  32767,  32767,  32767,  30223,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  31227,  32767,  26891,  29914,  24859,  32767,  32177,  32767, -32768,
+    -32768, -30225, -32768, -31415, -31623, -27707, -31112, -31752, -32768, -32768, -32768, -32768,
+    -29811, -32768, -26891, -32768, -30681, -32768, -32762, -31634, -32127, -32768,  31425,  31654,
+     32767,  32767,  32767,  32767,  29716,  32767,  32767,  32767,  29840,  29052,  31943,  32767,
+     32767,  31282,  32767,  28823,  29810,  27232,  32767,  31585,  32767, -31197, -32768, -31729,
+    -28250, -28824, -31554, -32768, -32768, -32768, -32509, -29198, -32768, -32768, -32768, -31846,
+    -27485, -29871, -29252, -32768, -32768, -32768, -30798, -30767,  32767,  32076,  31453,  32767,
+     32767,  31302,  32767,  29044,  32114,  32767,  32767,  32767,  31120,  31679,  32767,  31831,
+     28482,  27395,  32767,  32767,  32767,  30177,  31226, -32736, -32768, -32768, -32507, -30686,
+    -28042, -32768, -32768, -28585, -29131, -32768, -30135, -32768, -32768, -32768, -32768, -32768,
+    -31312, -29630, -32768, -32768, -29192, -28938,  32767,  31356,  29710,  27258,  32767,  30461,
+     32725,  31313,  32767,  32767,  32767,  30621,  32767,  32767,  32236,  32767,  27626,  32767,
+     32063,  32767,  32767,  32767,  30893, -32768, -32768, -32768, -28821, -32768, -32768, -32768,
+    -29352, -32768, -29355, -31459, -31307, -32768, -32768, -32768, -32768, -30851, -32768, -27528,
+    -32768, -32579, -32768, -29453,  32767,  29687,  32767,  31151,  32767,  30850,  32767,  29420,
+     32105,  28141,  29790,  32742,  32767,  32767,  32767,  30476,  32767,  27189,  31614,  27290,
+     32767,  32153,  32767, -30885, -32768, -32213, -32768, -28576, -29603, -28911, -32768, -29691,
+    -32768, -32768, -32768, -32768, -27051, -32768, -30277, -30757, -30302, -32768, -29667, -32768,
+    -29907, -32768,  29019,  32767,  32767,  32767,  32367,  32767,  31991,  32767,  32767,  32767,
+     29855,  31985,  32767,  32767,  32767,  32085,  32767,  29556,  30936,  28058,  32767,  32107,
+     32767, -31627, -32768, -32589, -28963, -28690, -30590, -32768, -32768, -32768, -32768, -29870,
+    -32768, -32768, -32227, -32681, -27869, -29710, -32360, -32768, -32768, -32768, -27278, -29963,
+     32767,  28942,  28862,  32767,  32767,  31076,  32767,  32537,  32767,  32767,  32767,  32767,
+     31737,  32767,  32767,  31038,  28901,  27691,  32224,  29802,  32044,  31417,  32767, -29156,
+    -32503, -32768, -30355, -31946, -31088, -32768, -32768, -29299, -29951, -32542, -30001, -32687,
+    -32768, -30766, -32768, -31286, -28872, -28183, -32768, -32768, -29918, -29528,  32767,  30021,
+     27788,  25212,  32767,  28049,  31244,  29275,  32767,  32767,  32070,  29836,  32197,  32282,
+     31327,  32767,  27666,  32767,  32431,  32767,  32767,  32767,  31095, -32768, -32416, -32768,
+    -27312, -32407, -31603, -32768, -27825, -32454, -28268, -30258, -30111, -32768, -32768, -32202,
+    -32768, -28972, -32768, -26318, -32768, -31037, -31915, -28783,  32767,  31378,  32767,  28798,
+     32767,  32767,  32767,  30112,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  31881,
+     32767,  27216,  29744,  23574,  32767,  32355,  32767, -32768, -32768, -29357, -32768, -31358,
+    -32648, -27640, -31812, -31866, -32768, -32768, -32768, -32768, -29992, -32768, -29777, -31312,
+    -32141, -32768, -28708, -32768, -29302, -32768,  28759,  32767,  32767,  32767,  32488,  32767,
+     32767,  32767,  32767,  32767,  32767,  32717,  32767,  31757,  32767,  29360,  32767,  32767,
+     32756,  32767,  32369,  32767,  31278, -28845, -32768, -29945, -32768, -31895, -32768, -32768,
+    -29898, -32768, -28521, -30324, -32516, -32768, -32768, -32768, -32595, -32768, -32049, -32768,
+    -30625,  -1755,  -3402,  -1645,  -2035,   3152,  -2931,   1315,   -381,   1671,  -2019,   -630,
+      2713,    549,    245,   2954,   1725,    212,   -540,    725,    -19,    215,    -68,    200,
+        26,    436,    111,    266,    563,    228,    130,    352,    174,     86,      2,     47,
+        11,     48,     -9,     18,    127,    126,     48,     39,     44,     19,     11,     11,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+         0,      0,      0,      0,      0,      0,     -1,     -1,      0,      0,      0,      0,
+        -1,      0,      0,      0,      0,      0,      0,      0,     -1,     -1,     -1,     -1,
+         0,     -1,      0,      0,      0,      0,      0,      0,      0,      0,      0,      1,
+         0,      1,      1,      2,      1,      0,      0,      0,      0,      2,      1,      0,
+         0,      3,     11,     22,     31,     38,     40,     39,     34,     25,     13,      2,
+       -12,    -22,    -30,    -37,    -40,    -39,    -34,    -26,    -15,     -4,      9,     20,
+        30,     37,     40,     39,     33,     27,     17,      6,     -8,    -19,    -29,    -35,
+       -40,    -39,    -34,    -28,    -18,     -6,      6,     19,     28,     37,     41,     41,
+        36,     31,     21,      9,     -4,    -16,    -26,    -34,    -38,    -39,    -36,    -30,
+       -21,     -9,      4,     15,     25,     33,     39,     41,     39,     34,     24,     11,
+        -1,    -13,    -24,    -33,    -38,    -40,    -37,    -33,    -24,    -12,      0,      9,
+        22,     32,     38,     40,     41,     35,     25,     16,      3,    -10,    -22,    -30,
+       -37,    -40,    -39,    -34,    -26,    -15,     -4,      9,     20,     30,     36,     41,
+        40,     36,     29,     19,      7,     -7,    -17,    -28,    -37,    -40,    -41,    -36,
+       -30,    -19,     -7,      5,     16,     27,     35,     39,     40,     36,     31,     21,
+         9,     -3,    -14,    -25,    -34,    -38,    -40,    -37,    -31,    -21,    -10,      3,
+        14,     25,     33,     39,     39,     38,     32,     23,     12,      0,    -12,    -23,
+       -33,    -38,    -39,    -38,    -33,    -24,    -14,     -3,      9,     22,     31,     38,
+        40,     39,     34,     26,     15,      4,     -9,    -20,    -30,    -36,    -40,    -39,
+       -35,    -27,    -17,     -5,      6,     19,     29,     36,     39,     40,     37,     28,
+        18,      7,     -5,    -18,    -29,    -36,    -40,    -40,    -36,    -30,    -21,     -9,
+         3,     16,     26,     35,     39,     40,     37,     30,     20,     11,     -2,    -14,
+       -24,    -33,    -38,    -40,    -39,    -33,    -23,    -13,      0,     13,     25,     33,
+        38,     40,     38,     32,     24,     13,      1,    -10,    -23,    -31,    -37,    -40,
+       -39,    -33,    -26,    -16,     -3,     10,     22,     31,     38,     40,     39,     34,
+        26,     15,      4,     -8,    -19,    -30,    -37,    -40,    -40,    -35,    -28,    -18,
+        -7,      6,     17,     28,     35,     40,     41,     37,     29,     19,      8,     -5,
+       -17,    -26,    -34,    -39,    -40,    -37,    -30,    -21,    -10,      3,     16,     26,
+        34,     38,     40,     36,     31,     22,     10,     -1,    -14,    -24,    -33,    -38,
+       -40,    -36,    -32,    -22,    -11,      1,     12,     23,     32,     38,     41,     40,
+        33,     24,     15,      1,    -10,    -20,    -31,    -36,    -38,    -41,    -33,    -25,
+       -17,     -3,     10,     20,     31,     37,     40,     40,     34,     27,     18,      6,
+        -8,    -19,    -28,    -35,    -40,    -39,    -35,    -28,    -18,     -7,      5,     17,
+        27,     36,     40,     41,     36,     31,     21,      9,     -4,    -16,    -26,    -34,
+       -38,    -39,    -36,    -30,    -21,     -9,      3,     14,     25,     33,     39,     40,
+        38,     33,     24,     14,      1,    -12,    -24,    -33,    -38,    -40,    -37,    -32,
+       -24,    -13,      0,     11,     22,     32,     38,     41,     39,     34,     27,     16,
+         2,    -10,    -21,    -30,    -37,    -40,    -39,    -33,    -27,    -16,     -5,      8,
+        19,     29,     36,     41,     40,     37,     29,     18,      7,     -6,    -19,    -28,
+       -36,    -39,    -39,    -35,    -28,    -18,     -7,      5,     16,     27,     35,     42,
+        44,     34,     41,     29,     17,      5,    -23,     64,    -45,    -43,    -26,    -67,
+       -15,    -18,    -16,     15,     34,    -53,     62,     -6,    -82,    -87,   -262,    -79,
+      -237,   -210,   -185,     19,   -325,    440,   -192,    265,    628,  -1737,   1332,    247,
+       865,    263,   -169,  -1597,    -75,    115,   1480,  -1702,   2811,  -2179,   2193,    863,
+      -193,  31341,  -2413,   1182,  -2835,   3570,  -1874,   1800,  -1225,    698,  -1470,   1591,
+     -1642,   1377,  -1128,    177,   -530,  -1784,   -352,    740,   -276,    -77,    -55,   1056,
+        28,    427,   -117,    285,   -208,    248,   -206,   -892,   -341,  -1655,   -544,   2264,
+      -593,    796,   -674,   1956,   -981,   2149,   -998,   -970,   -121,   -107,   1137,  -1386,
+      1588,  -1328,   1005, -32768,    387,    744,    473,     80,    849,  -2065,   1063,  -1585,
+       917,  -1344,    537,   -812,    260,    107,    145,    824,     -3,  -2465,    -74,     -9,
+      -172,   -326,    118,   -265,    -89,     57,    286,    -55,    694,   -424,   -516,   -130,
+       367,   1623,  -3977,   2217,   -404,   1014,    687,   -438,   1640,   -359,  -3520,    546,
+      -482,    454,  32767,   -849,   1380,  -2021,   1136,  -2060,   1789,  -1222,   1641,   -469,
+       541,   -397,   1470,   -674,    662,   -657,  -1494,   -296,     -7,    -12,   1637,     21,
+       519,    -24,    482,    -31,     51,    -66,   -226,   -230,   -744,   -472,   -488,   -583,
+      3202,   -594,   -364,   -829,   1787,  -1123,    789,   -638,      2,    734,  -1194,   1703,
+     -4289,   1354,   -700,    498, -31373,    372,   -655,    533,  -2223,    375,   -513,     49,
+         0,     96,    212,    534,     71,    787,    467,    479,  -3263,    765,    191,    -33,
+      -103,   -204,    -20,   -108,     -7,    -47,     69,   1040,    276,   1635,    575,  -2161,
+       427,   -757,    704,  -1845,    984,  -2318,    983,    759,    107,    734,  -1137,    848,
+     -1582,   1465,  -1009,  32767,   -387,   -532,   -428,   -751,   -855,   2855,  -1069,   1301,
+      -907,   1035,   -554,   1253,   -247,   -415,    -81,  -1007,      6,   2435,    100,    114,
+       158,    437,     82,    164,   -116,    103,   -344,   -171,   -514,   -462,   -548,   1966,
+      -406,    404,   -146,   -982,     93,   -323,    194,   -703,    121,    671,   -104,    289,
+      -441,   1530,   -844,  -1163,  -1266, -32652,  -1622,   1724,  -1784,   1555,  -1611,   1804,
+     -1078,   -624,   -312,  -1747,    456,   1075,    849,  -2338,   1093,   1686,    561,    240,
+        55,   -919,    -98,   -262,   -129,    258,     43,    326,    572,    685,    627,    742,
+     -2780,    270,   1106,    -30,   -229,   -298,    730,   -150,     -8,    199,   -960,    660,
+      1046,   1080,  -2213,   1254,  29059,   1136,  -1365,    839,    724,    489,    -86,    158,
+         0,   -150,   -250,   -363,   -405,   -427,   -972,   -407,   2962,   -247,   -485,    -63,
+        68,    194,   -149,    261,      2,   -326,    111,   -554,   -588,   -549,    836,   -695,
+      -344,   -518,    618,   -653,    210,    844,  -2209,   1457,    -37,  -2021,   3502,  -1937,
+     -1071,    504,   2309,   -315,   -414,    714, -32768,   1355,   1305,   -282,  -2590,    480,
+       307,   1202,   1441,   1060,  -2884,   1616,  -1829,   1389,  -3685,    999,   2498,    526,
+     -1576,    146,    447,   -126,     35,    432,    115,    323,    141,    740,    949,  -1739,
+      -123,    113,    -75,    288,    150,    722,    527,  -1713,     20,   2121,  -1055,   -711,
+      -642,    708,   2501,  -1812,   2142,  32335,    464,  -1110,   2084,  -1667,   1165,    -43,
+      -154,    244,   1911,    -34,    937,  -1480,  -1725,   3467,  -1929,  -1077,  -1034,   -524,
+};
+
+#endif /* MSBC_VECTORS_H */
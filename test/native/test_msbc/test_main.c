@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "msbc.h"
+#include "msbc_vectors.h"
+
+/*
+ * Сверка с внешним эталоном: кадры и PCM в msbc_vectors.h получены кодером и
+ * декодером FFmpeg (BlueZ libsbc), tools/gen_msbc_vectors.py. Кодер обязан
+ * выдать те же кадры из того же PCM, декодер - тот же PCM из тех же кадров,
+ * бит в бит. Ошибка в таблицах, распределении бит, квантовании, упаковке или
+ * CRC ломает совпадение.
+ */
+
+static msbc_enc_t s_enc;
+static msbc_dec_t s_dec;
+
+void setUp(void)
+{
+    msbc_enc_init(&s_enc);
+    msbc_dec_init(&s_dec);
+}
+
+void tearDown(void)
+{
+}
+
+// Пакет H2 вокруг эталонного кадра: libavcodec выдает кадр без заголовка
+static void make_packet(uint8_t *packet, uint32_t f)
+{
+    msbc_h2_write(packet, (uint8_t)(f & 3));
+    memcpy(packet + 2, msbc_vector_frames[f], MSBC_FRAME_LEN);
+    packet[MSBC_PACKET_LEN - 1] = 0;
+}
+
+static void test_encoder_matches_reference_frames(void)
+{
+    uint8_t packet[MSBC_PACKET_LEN];
+    char what[48];
+
+    for (uint32_t f = 0; f < MSBC_VECTOR_FRAMES; f++) {
+        msbc_encode(&s_enc, &msbc_vector_pcm[f * MSBC_SAMPLES_PER_FRAME], packet);
+        snprintf(what, sizeof(what), "frame %" PRIu32, f);
+        uint8_t seq = 0xFF;
+        TEST_ASSERT_TRUE_MESSAGE(msbc_h2_parse(packet, &seq), what);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(f & 3, seq, what);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(msbc_vector_frames[f], packet + 2, MSBC_FRAME_LEN, what);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, packet[MSBC_PACKET_LEN - 1], what);
+    }
+}
+
+static void test_decoder_matches_reference_pcm(void)
+{
+    uint8_t packet[MSBC_PACKET_LEN];
+    int16_t pcm[MSBC_SAMPLES_PER_FRAME];
+    char what[48];
+
+    for (uint32_t f = 0; f < MSBC_VECTOR_FRAMES; f++) {
+        make_packet(packet, f);
+        snprintf(what, sizeof(what), "frame %" PRIu32, f);
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, msbc_decode(&s_dec, packet, pcm), what);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&msbc_vector_decoded[f * MSBC_SAMPLES_PER_FRAME], pcm, sizeof(pcm), what);
+    }
+    TEST_ASSERT_EQUAL_UINT32(MSBC_VECTOR_FRAMES, s_dec.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dec.crc_errors);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dec.sync_errors);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dec.seq_gaps);
+}
+
+// Поврежденный кадр не попадает в выход: затухание фильтра, счетчики, нумерация H2
+static void test_decoder_rejects_damaged_packets(void)
+{
+    uint8_t packet[MSBC_PACKET_LEN];
+    int16_t pcm[MSBC_SAMPLES_PER_FRAME];
+
+    make_packet(packet, 0);
+    TEST_ASSERT_EQUAL(ESP_OK, msbc_decode(&s_dec, packet, pcm));
+
+    make_packet(packet, 1);
+    packet[2 + 5] ^= 0x01;  // Масштабный множитель под CRC
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, msbc_decode(&s_dec, packet, pcm));
+    TEST_ASSERT_EQUAL_UINT32(1, s_dec.crc_errors);
+
+    make_packet(packet, 2);
+    packet[2] = 0x9C;       // Синхрослово SBC вместо mSBC
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_RESPONSE, msbc_decode(&s_dec, packet, pcm));
+    TEST_ASSERT_EQUAL_UINT32(1, s_dec.sync_errors);
+
+    // Пакет 2 потерян: следующий за ним номер 3 засчитывается как пропуск
+    make_packet(packet, 3);
+    TEST_ASSERT_EQUAL(ESP_OK, msbc_decode(&s_dec, packet, pcm));
+    TEST_ASSERT_EQUAL_UINT32(1, s_dec.seq_gaps);
+}
+
+// Поиск пакета в потоке: эталонный кадр со сдвигом и ложным синхрословом перед ним
+static void test_find_packet_in_stream(void)
+{
+    uint8_t stream[MSBC_PACKET_LEN + 16];
+    memset(stream, 0x55, sizeof(stream));
+    stream[3] = 0x01;
+    stream[4] = 0x08;
+    stream[5] = 0xAD;
+    make_packet(stream + 11, 7);
+    TEST_ASSERT_EQUAL(11, msbc_find_packet(stream, sizeof(stream)));
+    TEST_ASSERT_EQUAL(-1, msbc_find_packet(stream, MSBC_PACKET_LEN + 10));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_encoder_matches_reference_frames);
+    RUN_TEST(test_decoder_matches_reference_pcm);
+    RUN_TEST(test_decoder_rejects_damaged_packets);
+    RUN_TEST(test_find_packet_in_stream);
+    return UNITY_END();
+}
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+"""Receive the audio tap stream sent by src/audio_tap.c and rebuild WAV files.
+
+Usage:
+    tools/audio_tap_rx.py -p /dev/ttyUSB1 -o tap/          # live, Ctrl-C to stop
+    tools/audio_tap_rx.py -i capture.bin -o tap/           # stream saved earlier
+    tools/audio_tap_rx.py -p /dev/ttyUSB1 --save capture.bin --seconds 30
+
+Enable the tap on the device console with 'tap on [raw] [rx] [tx]'. Each tap
+point (raw capture, capture after DSP, outgoing) is written to its own
+POINT_NNN.wav; a new file starts when the device restarts the tap or changes
+the sample rate. Frames missing from the sequence are filled with silence so
+the files stay time-aligned; --no-fill drops them instead.
+
+The report splits missing frames into those the device dropped on purpose
+(tap queue full, link too slow) and those lost on the wire (CRC errors,
+overflowed host buffers).
+
+Packet layout (little-endian), CRC-16/CCITT-FALSE over header and payload:
+    header  <HBBBBHHHIII magic "AT", version, point, codec, flags, samples,
+            sample_rate, payload_len, seq, dropped, timestamp_us (24 bytes)
+    payload PCM16, or IMA-ADPCM: predictor i16, step_index u8, pad u8,
+            4-bit codes low nibble first
+    crc     <H
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import wave
+
+MAGIC = b"AT"
+VERSION = 1
+HEADER = struct.Struct("<HBBBBHHHIII")
+CRC = struct.Struct("<H")
+POINTS = ("raw", "rx", "tx")
+CODEC_PCM, CODEC_ADPCM = 0, 1
+FLAG_START = 0x02
+MAX_SAMPLES = 240
+DEFAULT_BAUD = 921600
+
+STEP_TABLE = (
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+)
+INDEX_TABLE = (-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8)
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+        crc &= 0xFFFF
+    return crc
+
+
+def adpcm_decode(payload, count):
+    predictor, index = struct.unpack_from("<hB", payload)
+    out = bytearray()
+    for i in range(count):
+        code = (payload[4 + i // 2] >> (4 * (i & 1))) & 0x0F
+        step = STEP_TABLE[index]
+        diff = step >> 3
+        if code & 4:
+            diff += step
+        if code & 2:
+            diff += step >> 1
+        if code & 1:
+            diff += step >> 2
+        predictor = predictor - diff if code & 8 else predictor + diff
+        predictor = max(-32768, min(32767, predictor))
+        index = max(0, min(88, index + INDEX_TABLE[code]))
+        out += struct.pack("<h", predictor)
+    return bytes(out)
+
+
+class Point:
+    def __init__(self, name, outdir, fill):
+        self.name = name
+        self.outdir = outdir
+        self.fill = fill
+        self.wav = None
+        self.files = 0
+        self.rate = 0
+        self.next_seq = None
+        self.last_dropped = 0
+        self.frames = 0
+        self.samples = 0
+        self.missing = 0
+        self.device_dropped = 0
+        self.adpcm_frames = 0
+
+    def open(self, rate):
+        self.close()
+        path = os.path.join(self.outdir, f"{self.name}_{self.files:03d}.wav")
+        self.files += 1
+        self.rate = rate
+        self.wav = wave.open(path, "wb")
+        self.wav.setnchannels(1)
+        self.wav.setsampwidth(2)
+        self.wav.setframerate(rate)
+        print(f"{self.name}: writing {path} at {rate} Hz")
+
+    def close(self):
+        if self.wav is not None:
+            self.wav.close()
+            self.wav = None
+
+    def add(self, flags, rate, count, seq, dropped, pcm):
+        restart = flags & FLAG_START or dropped < self.last_dropped
+        if self.wav is None or restart or rate != self.rate:
+            self.open(rate)
+            self.next_seq = None
+            self.last_dropped = dropped
+        if self.next_seq is not None and seq != self.next_seq:
+            gap = (seq - self.next_seq) & 0xFFFFFFFF
+            if gap < 0x80000000:
+                self.missing += gap
+                if self.fill:
+                    self.wav.writeframes(bytes(2 * count) * gap)
+        self.device_dropped += dropped - self.last_dropped
+        self.last_dropped = dropped
+        self.next_seq = (seq + 1) & 0xFFFFFFFF
+        self.wav.writeframes(pcm)
+        self.frames += 1
+        self.samples += count
+
+    def report(self):
+        seconds = self.samples / self.rate if self.rate else 0.0
+        wire = max(0, self.missing - self.device_dropped)
+        total = self.frames + self.missing
+        loss = 100.0 * self.missing / total if total else 0.0
+        print(f"{self.name:>3}: {self.frames} frames ({seconds:.1f} s, {self.adpcm_frames} ADPCM), "
+              f"{self.missing} missing ({loss:.2f}%): {self.device_dropped} dropped on device, "
+              f"{wire} lost on the link")
+
+
+class Receiver:
+    def __init__(self, outdir, fill):
+        self.buf = bytearray()
+        self.points = [Point(name, outdir, fill) for name in POINTS]
+        self.packets = 0
+        self.crc_errors = 0
+        self.skipped = 0
+
+    def feed(self, data):
+        self.buf += data
+        pos = 0
+        while True:
+            start = self.buf.find(MAGIC, pos)
+            if start < 0:
+                keep = 1 if self.buf.endswith(MAGIC[:1]) else 0
+                self.skipped += len(self.buf) - pos - keep
+                del self.buf[:len(self.buf) - keep]
+                return
+            self.skipped += start - pos
+            pos = start
+            if len(self.buf) - pos < HEADER.size:
+                break
+            (_, version, point, codec, flags, count, rate, payload_len,
+             seq, dropped, _ts) = HEADER.unpack_from(self.buf, pos)
+            if (version != VERSION or point >= len(POINTS) or codec > CODEC_ADPCM
+                    or count > MAX_SAMPLES or payload_len > 2 * MAX_SAMPLES or rate == 0):
+                self.skipped += 1
+                pos += 1
+                continue
+            end = pos + HEADER.size + payload_len
+            if len(self.buf) < end + CRC.size:
+                break
+            if crc16(self.buf[pos:end]) != CRC.unpack_from(self.buf, end)[0]:
+                self.crc_errors += 1
+                self.skipped += 1
+                pos += 1
+                continue
+            payload = bytes(self.buf[pos + HEADER.size:end])
+            if codec == CODEC_ADPCM:
+                pcm = adpcm_decode(payload, count)
+                self.points[point].adpcm_frames += 1
+            else:
+                pcm = payload
+            self.points[point].add(flags, rate, count, seq, dropped, pcm)
+            self.packets += 1
+            pos = end + CRC.size
+        del self.buf[:pos]
+
+    def close(self):
+        for point in self.points:
+            point.close()
+
+    def report(self):
+        print(f"{self.packets} packets, {self.crc_errors} CRC errors, {self.skipped} bytes skipped")
+        for point in self.points:
+            if point.frames:
+                point.report()
+
+
+def open_serial(port, baud):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial is required for -p (pip install pyserial)")
+    return serial.Serial(port, baud, timeout=0.1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("-p", "--port", help="serial port connected to the tap UART")
+    source.add_argument("-i", "--input", help="raw stream saved with --save")
+    parser.add_argument("-b", "--baud", type=int, default=DEFAULT_BAUD)
+    parser.add_argument("-o", "--outdir", default=".")
+    parser.add_argument("--save", help="also write the raw stream to this file")
+    parser.add_argument("--seconds", type=float, help="stop after this long (serial only)")
+    parser.add_argument("--no-fill", action="store_true", help="do not fill missing frames with silence")
+    args = parser.parse_args()
+
+    os.makedirs(args.outdir, exist_ok=True)
+    rx = Receiver(args.outdir, not args.no_fill)
+    save = open(args.save, "wb") if args.save else None
+    try:
+        if args.input:
+            with open(args.input, "rb") as f:
+                while chunk := f.read(65536):
+                    rx.feed(chunk)
+        else:
+            port = open_serial(args.port, args.baud)
+            deadline = time.monotonic() + args.seconds if args.seconds else None
+            while deadline is None or time.monotonic() < deadline:
+                chunk = port.read(4096)
+                if save:
+                    save.write(chunk)
+                rx.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        rx.close()
+        if save:
+            save.close()
+    rx.report()
+
+
+if __name__ == "__main__":
+    main()
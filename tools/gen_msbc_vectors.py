@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Reference mSBC vectors for test/native/test_msbc from an external codec.
+
+Usage:
+    tools/gen_msbc_vectors.py > test/native/test_msbc/msbc_vectors.h
+
+The stimulus (chirp with noise, full-scale noise, a clipping square wave,
+silence, a quiet tone and impulses) is encoded by the FFmpeg SBC encoder in
+mSBC mode and the resulting frames are decoded by the FFmpeg SBC decoder.
+Both come from BlueZ libsbc, the implementation most HFP stacks ship, so the
+frames and the decoded PCM are the values src/msbc.c must reproduce bit for
+bit. The frames are stored without the H2 header, as libavcodec emits them.
+
+Requires PyAV (FFmpeg libavcodec with the sbc encoder and decoder).
+"""
+
+import math
+import struct
+import sys
+from fractions import Fraction
+
+import av
+
+RATE = 16000
+FRAME = 120
+FRAME_LEN = 57
+
+# (name, frames): the order is the order of the vector
+SEGMENTS = (
+    ('chirp', 16),
+    ('noise', 8),
+    ('square', 4),
+    ('silence', 4),
+    ('quiet', 4),
+    ('impulse', 4),
+)
+
+
+def lcg(n):
+    return (n * 2654435761 + 12345) & 0xFFFFFFFF
+
+
+def sample(kind, n, length):
+    if kind == 'chirp':
+        # 100 Hz .. 7 kHz sweep over the segment plus noise
+        t = n / RATE
+        span = length / RATE
+        v = 9000 * math.sin(2 * math.pi * (100 * t + 6900 * t * t / (2 * span)))
+        v += ((lcg(n) >> 16) & 2047) - 1024
+        return max(-32768, min(32767, int(round(v))))
+    if kind == 'noise':
+        return ((lcg(n) >> 8) & 0xFFFF) - 32768
+    if kind == 'square':
+        return 32767 if (n // 23) % 2 else -32768
+    if kind == 'quiet':
+        return int(round(40 * math.sin(n * 0.31)))
+    if kind == 'impulse':
+        return 32767 if n % 97 == 0 else (-32768 if n % 97 == 50 else 0)
+    return 0
+
+
+def stimulus():
+    pcm = []
+    for kind, frames in SEGMENTS:
+        length = frames * FRAME
+        pcm += [sample(kind, n, length) for n in range(length)]
+    return pcm
+
+
+def encode(pcm):
+    enc = av.CodecContext.create('sbc', 'w')
+    enc.sample_rate = RATE
+    enc.layout = 'mono'
+    enc.format = 's16'
+    enc.options = {'msbc': '1'}
+    enc.open()
+    frames = []
+    for i in range(0, len(pcm), FRAME):
+        f = av.AudioFrame(format='s16', layout='mono', samples=FRAME)
+        f.planes[0].update(struct.pack('<%dh' % FRAME, *pcm[i:i + FRAME]))
+        f.sample_rate = RATE
+        f.pts = i
+        f.time_base = Fraction(1, RATE)
+        frames += [bytes(p) for p in enc.encode(f)]
+    frames += [bytes(p) for p in enc.encode(None)]
+    return frames
+
+
+def decode(frames):
+    dec = av.CodecContext.create('sbc', 'r')
+    dec.sample_rate = RATE
+    dec.layout = 'mono'
+    dec.open()
+    out = []
+    for frame in frames:
+        for f in dec.decode(av.Packet(frame)):
+            raw = bytes(f.planes[0])[:f.samples * 2]
+            out += struct.unpack('<%dh' % f.samples, raw)
+    return out
+
+
+def c_array(values, fmt, per_line, indent='    '):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ' '.join(fmt % v for v in values[i:i + per_line]))
+    return '\n'.join(lines)
+
+
+def main():
+    pcm = stimulus()
+    frames = encode(pcm)
+    decoded = decode(frames)
+    count = len(pcm) // FRAME
+    if len(frames) != count or any(len(f) != FRAME_LEN for f in frames) or len(decoded) != len(pcm):
+        sys.exit('unexpected libavcodec output: %d frames, %d samples' % (len(frames), len(decoded)))
+
+    w = sys.stdout.write
+    w('// Сгенерировано tools/gen_msbc_vectors.py, не редактировать.\n')
+    w('// Эталон: FFmpeg libavcodec %s (sbc, режим msbc), кодер и декодер из BlueZ libsbc.\n'
+      % '.'.join(str(x) for x in av.library_versions['libavcodec']))
+    w('// Сигнал: %s.\n\n' % ', '.join('%s x%d' % s for s in SEGMENTS))
+    w('#ifndef MSBC_VECTORS_H\n#define MSBC_VECTORS_H\n\n')
+    w('#define MSBC_VECTOR_FRAMES %d\n\n' % count)
+    w('static const int16_t msbc_vector_pcm[MSBC_VECTOR_FRAMES * MSBC_SAMPLES_PER_FRAME] = {\n')
+    w(c_array(pcm, '%6d,', 12) + '\n};\n\n')
+    w('static const uint8_t msbc_vector_frames[MSBC_VECTOR_FRAMES][MSBC_FRAME_LEN] = {\n')
+    for frame in frames:
+        w('    {\n' + c_array(list(frame), '0x%02x,', 16, ' ' * 8) + '\n    },\n')
+    w('};\n\n')
+    w('static const int16_t msbc_vector_decoded[MSBC_VECTOR_FRAMES * MSBC_SAMPLES_PER_FRAME] = {\n')
+    w(c_array(decoded, '%6d,', 12) + '\n};\n\n')
+    w('#endif /* MSBC_VECTORS_H */\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,324 @@
+#!/usr/bin/env python3
+"""Loopback audio measurement on the host, same stimuli and analysis as src/loopback.c.
+
+Usage:
+    tools/loopback_analyze.py --simulate --rate 16000 --delay-ms 40 --loss 1
+    tools/loopback_analyze.py --tx tap/tx_000.wav --rx tap/raw_000.wav
+
+--simulate plays the device timeline (silence, MLS, log sweep, multitone)
+through a model of the SCO loop: delay, codec band limit, gain, cubic
+distortion, noise and lost frames replaced by silence. It checks the analysis
+against known impairments and shows how a change of the link model moves the
+numbers before anything is flashed.
+
+--tx/--rx measures a device run offline: start the tap with 'tap on raw tx',
+run 'loopback' on the device console, stop the tap and pass the tx and raw
+WAV files written by tools/audio_tap_rx.py. The stimuli are located in the tx
+stream, so the round trip covers the same path as the device report.
+
+Requires numpy.
+"""
+
+import argparse
+import math
+import sys
+import wave
+
+LEVEL = 8192
+MLS_ORDER = 12
+MLS_POLY = 0x829
+MLS_LEN = (1 << MLS_ORDER) - 1
+MAX_LATENCY_MS = 300
+MIN_PNR_DB = 15
+NOISE_MS = 250
+CHIRP_MS = 500
+CHIRP_START_HZ = 100
+CHIRP_BLOCK_MS = 10
+TONES_PERIOD = 2048
+TONES_PLAYED = 4
+TONE_TARGETS = (200, 315, 500, 800, 1250, 2000, 3150, 5000, 8000, 12500)
+RESPONSE_POINTS = (125, 250, 500, 1000, 2000, 3000, 4000, 6000, 8000, 12000)
+BAND_EDGE_PCT = 45
+SETTLE_MS = 100
+STAGE_GAP_MS = 150
+DEFAULT_BANDS = {8000: (300, 3400), 16000: (100, 7000), 32000: (50, 14000)}
+
+
+def need_numpy():
+    try:
+        import numpy
+    except ImportError:
+        sys.exit("numpy is required (pip install numpy)")
+    return numpy
+
+
+np = need_numpy()
+
+
+def mls():
+    out = np.empty(MLS_LEN, dtype=np.int16)
+    lfsr = 1
+    for i in range(MLS_LEN):
+        out[i] = LEVEL if lfsr & 1 else -LEVEL
+        lfsr = (lfsr >> 1) ^ (MLS_POLY if lfsr & 1 else 0)
+    return out
+
+
+def chirp_end_hz(rate):
+    return rate * BAND_EDGE_PCT // 100
+
+
+def chirp_len(rate):
+    return CHIRP_MS * rate // 1000
+
+
+def chirp(rate):
+    n = np.arange(chirp_len(rate))
+    ratio = chirp_end_hz(rate) / CHIRP_START_HZ
+    mul = ratio ** (1.0 / chirp_len(rate))
+    inc = 2 * math.pi * CHIRP_START_HZ / rate * mul ** n
+    phase = np.concatenate(([0.0], np.cumsum(inc)[:-1]))
+    return (LEVEL * np.sin(phase)).astype(np.int16)
+
+
+def is_prime(n):
+    return n >= 2 and all(n % d for d in range(2, math.isqrt(n) + 1))
+
+
+def tone_bins(rate):
+    bins = []
+    for target in TONE_TARGETS:
+        if target >= rate * BAND_EDGE_PCT // 100:
+            break
+        b = (target * TONES_PERIOD + rate // 2) // rate
+        d = 0
+        while not (is_prime(b + d) or is_prime(b - d)):
+            d += 1
+        bins.append(b + d if is_prime(b + d) else b - d)
+    return bins
+
+
+def tones(rate):
+    bins = tone_bins(rate)
+    n = np.arange(TONES_PERIOD)
+    v = np.zeros(TONES_PERIOD)
+    for k, b in enumerate(bins):
+        v += np.cos(2 * math.pi * ((b * n) % TONES_PERIOD) / TONES_PERIOD + math.pi * k * k / len(bins))
+    period = np.round(v * LEVEL / np.abs(v).max()).astype(np.int16)
+    return period, bins
+
+
+def db10(ratio):
+    return 10 * math.log10(ratio) if ratio > 1e-12 else -120.0
+
+
+def stimuli(rate):
+    period, _ = tones(rate)
+    return {"mls": mls(), "chirp": chirp(rate), "tones": np.tile(period, TONES_PLAYED)}
+
+
+def analyze_noise(cap):
+    power = float(np.mean(cap.astype(np.float64) ** 2))
+    return power, round(db10(power / 32768.0 ** 2))
+
+
+def analyze_mls(cap, ref, rate):
+    lags = MAX_LATENCY_MS * rate // 1000 + 1
+    cap = cap.astype(np.float64)
+    corr = np.correlate(cap[:MLS_LEN + lags - 1], ref.astype(np.float64), mode="valid")[:lags]
+    lag = int(np.argmax(np.abs(corr)))
+    peak = corr[lag]
+    pnr = round(db10(peak * peak / np.mean(corr * corr)))
+    gain = abs(peak) / (MLS_LEN * LEVEL * LEVEL)
+    return lag, pnr, round(2 * db10(gain)), peak < 0
+
+
+def chirp_block_hz(rate, block):
+    block_len = CHIRP_BLOCK_MS * rate // 1000
+    t = (block + 0.5) * block_len / chirp_len(rate)
+    return CHIRP_START_HZ * (chirp_end_hz(rate) / CHIRP_START_HZ) ** t
+
+
+def analyze_chirp(cap, rate):
+    block_len = CHIRP_BLOCK_MS * rate // 1000
+    blocks = CHIRP_MS // CHIRP_BLOCK_MS
+    tx_rms = LEVEL / math.sqrt(2)
+    raw = []
+    for b in range(blocks):
+        seg = cap[b * block_len:(b + 1) * block_len].astype(np.float64)
+        rms = max(1.0, math.floor(math.sqrt(np.mean(seg * seg))))
+        raw.append(2 * db10(rms / tx_rms))
+    first, last = 1, blocks - 2
+    gain = {b: sorted(raw[b - 1:b + 2])[1] for b in range(first, last + 1)}
+    freq = {b: chirp_block_hz(rate, b) for b in gain}
+    ref = min(gain, key=lambda b: abs(math.log2(freq[b] / 1000)))
+    points = []
+    for hz in RESPONSE_POINTS:
+        if freq[first] <= hz <= freq[last]:
+            best = min(gain, key=lambda b: abs(math.log2(freq[b] / hz)))
+            points.append((hz, round(gain[best] - gain[ref])))
+    lo = ref
+    while lo > first and gain[lo - 1] >= gain[ref] - 3:
+        lo -= 1
+    hi = ref
+    while hi < last and gain[hi + 1] >= gain[ref] - 3:
+        hi += 1
+    return points, int(freq[lo]), int(freq[hi])
+
+
+def goertzel_power(x, bin_index):
+    n = len(x)
+    k = np.arange(n)
+    re = float(np.dot(x, np.cos(2 * math.pi * bin_index * k / n)))
+    im = float(np.dot(x, np.sin(2 * math.pi * bin_index * k / n)))
+    return 2 * (re * re + im * im) / (n * n)
+
+
+def analyze_tones(cap, rate, noise_power):
+    x = cap.astype(np.float64)
+    x = x - x.mean()
+    total = float(np.mean(x * x))
+    signal = sum(goertzel_power(x, 2 * b) for b in tone_bins(rate))
+    if signal <= 0:
+        raise ValueError("multitone not received")
+    residual = max(total - signal, signal * 1e-9)
+    snr = round(db10(signal / noise_power)) if noise_power > 0 else 120
+    return round(db10(residual / signal)), 100 * math.sqrt(residual / signal), snr
+
+
+def measure(rx, starts, rate, stim):
+    """Run the device analysis on a capture, given where each stimulus left the AG."""
+    res = {}
+    noise_len = NOISE_MS * rate // 1000
+    noise_from = max(0, starts["mls"] - noise_len)
+    res["noise_power"], res["noise_dbfs"] = analyze_noise(rx[noise_from:starts["mls"]])
+    lag, pnr, gain, inverted = analyze_mls(rx[starts["mls"]:], stim["mls"], rate)
+    res.update(latency_ms=1000.0 * lag / rate, pnr=pnr, loop_gain=gain, inverted=inverted)
+    if pnr < MIN_PNR_DB:
+        res["error"] = f"no loopback: MLS peak {pnr} dB over average (need {MIN_PNR_DB} dB)"
+        return res
+    c0 = starts["chirp"] + lag
+    res["points"], res["band_low"], res["band_high"] = analyze_chirp(rx[c0:c0 + chirp_len(rate)], rate)
+    t0 = starts["tones"] + lag + TONES_PERIOD
+    res["thdn_db"], res["thdn_pct"], res["snr"] = analyze_tones(rx[t0:t0 + 2 * TONES_PERIOD], rate,
+                                                                res["noise_power"])
+    return res
+
+
+def report(res, rate):
+    print(f"=== Loopback: {rate // 1000} kHz ===")
+    if "error" in res:
+        print(f"Measurement failed: {res['error']}")
+        return
+    print(f"Round trip {res['latency_ms']:.1f} ms (peak {res['pnr']} dB over average), "
+          f"loop gain {res['loop_gain']} dB{', polarity inverted' if res['inverted'] else ''}")
+    print(f"Noise floor {res['noise_dbfs']} dBFS, SNR {res['snr']} dB, "
+          f"THD+N {res['thdn_db']} dB ({res['thdn_pct']:.1f}%)")
+    print("Response re 1 kHz, Hz:dB " + " ".join(f"{hz}:{db:+d}" for hz, db in res["points"]))
+    print(f"Band -3 dB: {res['band_low']}..{res['band_high']} Hz")
+
+
+def timeline(rate, stim):
+    """Device stage order with idle gaps where the device is analysing."""
+    gap = np.zeros(STAGE_GAP_MS * rate // 1000, dtype=np.int16)
+    parts = [np.zeros((SETTLE_MS + NOISE_MS) * rate // 1000, dtype=np.int16)]
+    starts = {}
+    for name in ("mls", "chirp", "tones"):
+        parts.append(gap)
+        starts[name] = sum(len(p) for p in parts)
+        parts.append(stim[name])
+    parts.append(np.zeros(MAX_LATENCY_MS * rate // 1000 + TONES_PERIOD, dtype=np.int16))
+    return np.concatenate(parts), starts
+
+
+def one_pole(x, alpha, highpass):
+    y = np.empty_like(x)
+    state = 0.0
+    prev = 0.0
+    for i, v in enumerate(x):
+        if highpass:
+            state = alpha * (state + v - prev)
+            prev = v
+        else:
+            state = alpha * state + (1 - alpha) * v
+        y[i] = state
+    return y
+
+
+def simulate_link(tx, rate, args):
+    """SCO loop model: codec band, gain, cubic distortion, noise, lost frames, delay."""
+    rng = np.random.default_rng(args.seed)
+    low, high = args.band or DEFAULT_BANDS.get(rate, (100, rate * 0.45))
+    y = tx.astype(np.float64) / 32768.0 * 10 ** (args.gain_db / 20)
+    y = y + args.distortion * y ** 3
+    y = one_pole(y, math.exp(-2 * math.pi * low / rate), True)
+    for _ in range(2):
+        y = one_pole(y, math.exp(-2 * math.pi * high / rate), False)
+    y = y * 32768.0 + rng.normal(0.0, 32768.0 * 10 ** (args.noise_dbfs / 20), len(y))
+    frame = int(rate * 0.0075)
+    lost = rng.random(len(y) // frame + 1) < args.loss / 100
+    for f in np.flatnonzero(lost):
+        y[f * frame:(f + 1) * frame] = 0
+    delay = round(args.delay_ms * rate / 1000)
+    y = np.concatenate((np.zeros(delay), y))[:len(y)]
+    return np.clip(np.round(y), -32768, 32767).astype(np.int16)
+
+
+def read_wav(path):
+    with wave.open(path, "rb") as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            sys.exit(f"{path}: need mono 16-bit PCM")
+        return w.getframerate(), np.frombuffer(w.readframes(w.getnframes()), dtype="<i2").astype(np.int16)
+
+
+def locate(tx, ref, rate, after):
+    """Start of a stimulus in the tx stream: energy onset, refined by correlation."""
+    active = np.flatnonzero(np.abs(tx[after:]) > np.abs(tx).max() / 8)
+    if len(active) == 0:
+        sys.exit("stimulus not found in the tx stream (was 'loopback' run while the tap was on?)")
+    onset = after + int(active[0])
+    lo = max(0, onset - rate // 50)
+    window = tx[lo:onset + rate // 50 + len(ref)].astype(np.float64)
+    corr = np.correlate(window, ref.astype(np.float64), mode="valid")
+    return lo + int(np.argmax(np.abs(corr)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--simulate", action="store_true", help="measure a modelled SCO loop")
+    parser.add_argument("--tx", help="tap WAV of the outgoing stream")
+    parser.add_argument("--rx", help="tap WAV of the capture (raw or rx point)")
+    parser.add_argument("--rate", type=int, default=16000, choices=(8000, 16000, 32000))
+    parser.add_argument("--delay-ms", type=float, default=40.0)
+    parser.add_argument("--gain-db", type=float, default=-6.0)
+    parser.add_argument("--noise-dbfs", type=float, default=-70.0)
+    parser.add_argument("--distortion", type=float, default=0.0, help="cubic term, 0.1 is mild")
+    parser.add_argument("--loss", type=float, default=0.0, help="lost SCO frames, percent")
+    parser.add_argument("--band", type=int, nargs=2, metavar=("LOW", "HIGH"),
+                        help="codec band in Hz (default by rate)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.simulate:
+        rate = args.rate
+        stim = stimuli(rate)
+        tx, starts = timeline(rate, stim)
+        rx = simulate_link(tx, rate, args)
+        print(f"Model: delay {args.delay_ms} ms, gain {args.gain_db} dB, noise {args.noise_dbfs} dBFS, "
+              f"distortion {args.distortion}, loss {args.loss}%")
+    elif args.tx and args.rx:
+        rate, tx = read_wav(args.tx)
+        rx_rate, rx = read_wav(args.rx)
+        if rx_rate != rate:
+            sys.exit("tx and rx WAV sample rates differ")
+        stim = stimuli(rate)
+        starts = {"mls": locate(tx, stim["mls"], rate, 0)}
+        starts["chirp"] = locate(tx, stim["chirp"], rate, starts["mls"] + MLS_LEN)
+        starts["tones"] = locate(tx, stim["tones"][:TONES_PERIOD], rate, starts["chirp"] + chirp_len(rate))
+    else:
+        parser.error("use --simulate or both --tx and --rx")
+    report(measure(rx, starts, rate, stim), rate)
+
+
+if __name__ == "__main__":
+    main()
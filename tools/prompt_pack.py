@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Pack WAV voice prompts into the container read by src/prompts.c.
+
+Usage:
+    tools/prompt_pack.py -o prompts.bin ringback.wav busy=tones/busy_16k.wav
+    parttool.py write_partition --partition-name prompts --input prompts.bin
+
+Each input is PATH or NAME=PATH; the name defaults to the file stem.
+Inputs must be mono 16-bit PCM at 8000, 16000 or 32000 Hz. Clips are stored
+at their native rate and resampled to the link rate on playback.
+
+Layout (little-endian):
+    header  <IHHII  magic "PRMT", version, count, total_size, reserved
+    entries <20sIIHH name, offset, samples, sample_rate, flags (32 bytes each)
+    data    PCM16 clips, each aligned to 4 bytes
+"""
+
+import argparse
+import os
+import struct
+import sys
+import wave
+
+MAGIC = 0x544D5250
+VERSION = 1
+NAME_LEN = 20
+HEADER = struct.Struct("<IHHII")
+ENTRY = struct.Struct("<20sIIHH")
+RATES = (8000, 16000, 32000)
+DEFAULT_PARTITION_SIZE = 0x80000
+
+
+def load_clip(spec):
+    name, sep, path = spec.partition("=")
+    if not sep:
+        path = spec
+        name = os.path.splitext(os.path.basename(spec))[0]
+    if len(name.encode()) >= NAME_LEN:
+        sys.exit(f"{spec}: name '{name}' longer than {NAME_LEN - 1} bytes")
+
+    with wave.open(path, "rb") as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            sys.exit(f"{path}: must be mono 16-bit PCM")
+        if w.getframerate() not in RATES:
+            sys.exit(f"{path}: rate {w.getframerate()} Hz, expected one of {RATES}")
+        return name, w.getframerate(), w.readframes(w.getnframes())
+
+
+def pack(clips):
+    offset = HEADER.size + ENTRY.size * len(clips)
+    entries, blobs = [], []
+    for name, rate, pcm in clips:
+        offset = (offset + 3) & ~3
+        entries.append(ENTRY.pack(name.encode(), offset, len(pcm) // 2, rate, 0))
+        blobs.append((offset, pcm))
+        offset += len(pcm)
+
+    image = bytearray(offset)
+    image[0:HEADER.size] = HEADER.pack(MAGIC, VERSION, len(clips), offset, 0)
+    for i, entry in enumerate(entries):
+        pos = HEADER.size + i * ENTRY.size
+        image[pos:pos + ENTRY.size] = entry
+    for pos, pcm in blobs:
+        image[pos:pos + len(pcm)] = pcm
+    return bytes(image)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", required=True, help="output image")
+    parser.add_argument("--size", type=lambda v: int(v, 0), default=DEFAULT_PARTITION_SIZE,
+                        help="partition size (default 0x80000)")
+    parser.add_argument("inputs", nargs="+", help="PATH or NAME=PATH")
+    args = parser.parse_args()
+
+    clips = [load_clip(spec) for spec in args.inputs]
+    names = [c[0] for c in clips]
+    if len(set(names)) != len(names):
+        sys.exit("duplicate prompt names")
+
+    image = pack(clips)
+    if len(image) > args.size:
+        sys.exit(f"image is {len(image)} bytes, partition holds {args.size}")
+
+    with open(args.output, "wb") as f:
+        f.write(image)
+    for name, rate, pcm in clips:
+        print(f"  {name:<{NAME_LEN}} {rate:>5} Hz {len(pcm) // 2 * 1000 // rate:>6} ms")
+    print(f"{args.output}: {len(clips)} prompts, {len(image)} of {args.size} bytes")
+
+
+if __name__ == "__main__":
+    main()